@@ -43,6 +43,7 @@ enum AvailableInfoType {
     AltitudeAvailable = 1 << 2,
     HeadingAvailable = 1 << 3,
     AlertAvailable = 1 << 4,
+    VelocityAvailable = 1 << 5,
 };
 Q_FLAG_NS(AvailableInfoType)
 Q_DECLARE_FLAGS(AvailableInfoTypes, AvailableInfoType)
@@ -55,8 +56,43 @@ struct VehicleInfo_t {
     double altitude; // TODO: Use Altitude in QGeoCoordinate?
     double heading;
     bool alert;
+    double groundSpeed; // m/s along heading
+    double verticalRate; // m/s, positive up
     AvailableInfoTypes availableFlags;
 };
+
+/// Enum for predicted conflicts between traffic and our own vehicles, in increasing priority.
+enum ConflictLevel {
+    NoConflict = 0,
+    ConflictAdvisory = 1,
+    ConflictWarning = 2
+};
+Q_ENUM_NS(ConflictLevel)
+
+/// Merges the values available in update into info.
+inline void mergeVehicleInfo(VehicleInfo_t &info, const VehicleInfo_t &update)
+{
+    if (update.availableFlags & CallsignAvailable) {
+        info.callsign = update.callsign;
+    }
+    if (update.availableFlags & LocationAvailable) {
+        info.location = update.location;
+    }
+    if (update.availableFlags & AltitudeAvailable) {
+        info.altitude = update.altitude;
+    }
+    if (update.availableFlags & HeadingAvailable) {
+        info.heading = update.heading;
+    }
+    if (update.availableFlags & AlertAvailable) {
+        info.alert = update.alert;
+    }
+    if (update.availableFlags & VelocityAvailable) {
+        info.groundSpeed = update.groundSpeed;
+        info.verticalRate = update.verticalRate;
+    }
+    info.availableFlags |= update.availableFlags;
+}
 } // namespace ADSB
 
 Q_DECLARE_METATYPE(ADSB::VehicleInfo_t)
@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBConflictDetector.h"
+#include "ADSBSpatialGrid.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(ADSBConflictDetectorLog, "qgc.adsb.adsbconflictdetector")
+
+void ADSBConflictDetector::Traffic_t::reserve(qsizetype count)
+{
+    icaoAddress.reserve(count);
+    latitude.reserve(count);
+    longitude.reserve(count);
+    altitude.reserve(count);
+    velocityNorth.reserve(count);
+    velocityEast.reserve(count);
+    velocityUp.reserve(count);
+}
+
+void ADSBConflictDetector::Traffic_t::append(const ADSB::VehicleInfo_t &vehicleInfo)
+{
+    icaoAddress.append(vehicleInfo.icaoAddress);
+    latitude.append(vehicleInfo.location.latitude());
+    longitude.append(vehicleInfo.location.longitude());
+    altitude.append((vehicleInfo.availableFlags & ADSB::AltitudeAvailable) ? vehicleInfo.altitude : qQNaN());
+
+    // Without a velocity the aircraft is treated as stationary, which still catches our vehicles flying towards it
+    if ((vehicleInfo.availableFlags & ADSB::VelocityAvailable) && (vehicleInfo.availableFlags & ADSB::HeadingAvailable)) {
+        const double heading = qDegreesToRadians(vehicleInfo.heading);
+        velocityNorth.append(vehicleInfo.groundSpeed * qCos(heading));
+        velocityEast.append(vehicleInfo.groundSpeed * qSin(heading));
+        velocityUp.append(vehicleInfo.verticalRate);
+    } else {
+        velocityNorth.append(0);
+        velocityEast.append(0);
+        velocityUp.append(0);
+    }
+}
+
+ADSBConflictDetector::ADSBConflictDetector(QObject *parent)
+    : QObject(parent)
+    , _thread(new QThread(this))
+    , _worker(new QObject())
+{
+    (void) qRegisterMetaType<QList<ADSBConflictDetector::Conflict_t>>("QList<ADSBConflictDetector::Conflict_t>");
+
+    _thread->setObjectName(QStringLiteral("ADSBConflictDetector"));
+    _worker->moveToThread(_thread);
+    (void) connect(_thread, &QThread::finished, _worker, &QObject::deleteLater);
+    _thread->start(QThread::LowPriority);
+}
+
+ADSBConflictDetector::~ADSBConflictDetector()
+{
+    _thread->quit();
+    _thread->wait();
+}
+
+bool ADSBConflictDetector::submit(const QList<Ownship_t> &ownships, const Traffic_t &traffic, const Thresholds_t &thresholds)
+{
+    if (_busy.exchange(true)) {
+        qCDebug(ADSBConflictDetectorLog) << "Previous pass still running, dropping";
+        return false;
+    }
+
+    (void) QMetaObject::invokeMethod(_worker, [this, ownships, traffic, thresholds]() {
+        QElapsedTimer timer;
+        timer.start();
+        const QList<Conflict_t> conflicts = detect(ownships, traffic, thresholds);
+        qCDebug(ADSBConflictDetectorLog) << "Pass traffic:" << traffic.count() << "conflicts:" << conflicts.count() << "usecs:" << timer.nsecsElapsed() / 1000;
+
+        _busy = false;
+        emit conflictsDetected(conflicts);
+    }, Qt::QueuedConnection);
+
+    return true;
+}
+
+QList<ADSBConflictDetector::Conflict_t> ADSBConflictDetector::detect(const QList<Ownship_t> &ownships, const Traffic_t &traffic, const Thresholds_t &thresholds)
+{
+    QList<Conflict_t> conflicts;
+
+    const qsizetype trafficCount = traffic.count();
+    if (ownships.isEmpty() || (trafficCount == 0)) {
+        return conflicts;
+    }
+
+    // Broad phase: bucket the traffic once, then each vehicle only looks at the cells it could reach
+    ADSBSpatialGrid grid(_gridCellSizeDegrees);
+    double maxTrafficSpeed = 0;
+    for (qsizetype i = 0; i < trafficCount; i++) {
+        grid.insert(static_cast<uint32_t>(i), QGeoCoordinate(traffic.latitude[i], traffic.longitude[i]));
+        maxTrafficSpeed = qMax(maxTrafficSpeed, std::hypot(traffic.velocityNorth[i], traffic.velocityEast[i]));
+    }
+
+    const double lookahead = thresholds.lookaheadSecs;
+    const double separation = thresholds.horizontalSeparation;
+
+    QList<uint32_t> candidates;
+    QList<double> rx, ry, rz, vx, vy, vz, tcpa, hcpa, vcpa, lossStart;
+
+    for (const Ownship_t &ownship : ownships) {
+        if (!ownship.location.isValid()) {
+            continue;
+        }
+
+        const double searchRadius = separation + ((std::hypot(ownship.velocityNorth, ownship.velocityEast) + maxTrafficSpeed) * lookahead);
+        candidates.clear();
+        grid.query(ownship.location, searchRadius, candidates);
+
+        const qsizetype count = candidates.count();
+        if (count == 0) {
+            continue;
+        }
+        for (QList<double> *column : { &rx, &ry, &rz, &vx, &vy, &vz, &tcpa, &hcpa, &vcpa, &lossStart }) {
+            column->resize(count);
+        }
+
+        // Relative state in a local east/north/up frame around the vehicle. Flat earth is plenty for the
+        // distances a lookahead covers.
+        constexpr double metersPerDegree = 111319.49;
+        const double ownLat = ownship.location.latitude();
+        const double ownLon = ownship.location.longitude();
+        const double ownAlt = ownship.location.altitude();
+        const double metersPerDegreeLon = metersPerDegree * qCos(qDegreesToRadians(ownLat));
+        for (qsizetype k = 0; k < count; k++) {
+            const qsizetype i = candidates[k];
+            double deltaLon = traffic.longitude[i] - ownLon;
+            if (deltaLon > 180) {
+                deltaLon -= 360;
+            } else if (deltaLon < -180) {
+                deltaLon += 360;
+            }
+            rx[k] = deltaLon * metersPerDegreeLon;
+            ry[k] = (traffic.latitude[i] - ownLat) * metersPerDegree;
+            rz[k] = traffic.altitude[i] - ownAlt;
+            vx[k] = traffic.velocityEast[i] - ownship.velocityEast;
+            vy[k] = traffic.velocityNorth[i] - ownship.velocityNorth;
+            vz[k] = traffic.velocityUp[i] - ownship.velocityUp;
+        }
+
+        // Narrow phase: straight line loop over the columns with no branches so the compiler can vectorise it.
+        // Separation is lost while both the horizontal distance and the altitude difference are inside their
+        // thresholds. Each is an interval in time, and a conflict is an overlap of the two within the lookahead. The
+        // vertical interval can start before or end after the horizontal CPA, so checking the altitudes only at the
+        // CPA would miss traffic climbing through our level or converging after it.
+        const double separationSquared = separation * separation;
+        const double verticalSeparation = thresholds.verticalSeparation;
+        const double *prx = rx.constData(), *pry = ry.constData(), *prz = rz.constData();
+        const double *pvx = vx.constData(), *pvy = vy.constData(), *pvz = vz.constData();
+        double *ptcpa = tcpa.data(), *phcpa = hcpa.data(), *pvcpa = vcpa.data();
+        double *plossStart = lossStart.data();
+        for (qsizetype k = 0; k < count; k++) {
+            const double rr = (prx[k] * prx[k]) + (pry[k] * pry[k]);
+            const double vv = (pvx[k] * pvx[k]) + (pvy[k] * pvy[k]);
+            const double rv = (prx[k] * pvx[k]) + (pry[k] * pvy[k]);
+            const double t = std::clamp((vv > 1e-6) ? (-rv / vv) : 0.0, 0.0, lookahead);
+            const double cx = prx[k] + (pvx[k] * t);
+            const double cy = pry[k] + (pvy[k] * t);
+            ptcpa[k] = t;
+            phcpa[k] = std::sqrt((cx * cx) + (cy * cy));
+            pvcpa[k] = std::fabs(prz[k] + (pvz[k] * t));
+
+            // Horizontal: roots of |r + v t| = separation, or all or nothing without relative motion
+            const bool horizontalMoving = vv > 1e-6;
+            const double discriminant = (rv * rv) - (vv * (rr - separationSquared));
+            const double root = std::sqrt(std::max(discriminant, 0.0));
+            const bool horizontalLost = horizontalMoving ? (discriminant > 0) : (rr < separationSquared);
+            const double horizontalIn = horizontalMoving ? ((-rv - root) / vv) : 0.0;
+            const double horizontalOut = horizontalMoving ? ((-rv + root) / vv) : lookahead;
+
+            // Vertical: |rz + vz t| < verticalSeparation. Unknown altitudes count as lost the whole time.
+            const bool altitudeUnknown = std::isnan(prz[k]);
+            const bool verticalMoving = std::fabs(pvz[k]) > 1e-6;
+            const double crossingLow = (-verticalSeparation - prz[k]) / pvz[k];
+            const double crossingHigh = (verticalSeparation - prz[k]) / pvz[k];
+            const bool verticalLost = altitudeUnknown || verticalMoving || (std::fabs(prz[k]) < verticalSeparation);
+            const double verticalIn = (altitudeUnknown || !verticalMoving) ? 0.0 : std::min(crossingLow, crossingHigh);
+            const double verticalOut = (altitudeUnknown || !verticalMoving) ? lookahead : std::max(crossingLow, crossingHigh);
+
+            const double start = std::max({ horizontalIn, verticalIn, 0.0 });
+            const double end = std::min({ horizontalOut, verticalOut, lookahead });
+            const bool lost = horizontalLost && verticalLost && (start <= end);
+            plossStart[k] = lost ? start : qInf();
+        }
+
+        for (qsizetype k = 0; k < count; k++) {
+            if (std::isinf(lossStart[k])) {
+                continue;
+            }
+
+            // The alert level is based on when separation is first lost rather than on the CPA, since a slow
+            // closure can be inside the separation long before its CPA
+            const double timeToLoss = lossStart[k];
+
+            Conflict_t conflict;
+            conflict.vehicleId = ownship.vehicleId;
+            conflict.icaoAddress = traffic.icaoAddress[candidates[k]];
+            conflict.level = (timeToLoss <= thresholds.warningSecs) ? ADSB::ConflictWarning : ADSB::ConflictAdvisory;
+            conflict.timeToLoss = timeToLoss;
+            conflict.timeToCpa = tcpa[k];
+            conflict.horizontalCpa = hcpa[k];
+            conflict.verticalCpa = qIsNaN(rz[k]) ? qQNaN() : vcpa[k];
+            conflict.distance = std::hypot(rx[k], ry[k]);
+            conflicts.append(conflict);
+        }
+    }
+
+    std::sort(conflicts.begin(), conflicts.end(), [](const Conflict_t &a, const Conflict_t &b) {
+        if (a.level != b.level) {
+            return a.level > b.level;
+        }
+        if (a.timeToLoss != b.timeToLoss) {
+            return a.timeToLoss < b.timeToLoss;
+        }
+        if (a.timeToCpa != b.timeToCpa) {
+            return a.timeToCpa < b.timeToCpa;
+        }
+        if (a.horizontalCpa != b.horizontalCpa) {
+            return a.horizontalCpa < b.horizontalCpa;
+        }
+        return (a.vehicleId != b.vehicleId) ? (a.vehicleId < b.vehicleId) : (a.icaoAddress < b.icaoAddress);
+    });
+
+    return conflicts;
+}
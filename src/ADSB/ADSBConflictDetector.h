@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <atomic>
+
+#include "ADSB.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ADSBConflictDetectorLog)
+
+class QThread;
+
+/// The ADSBConflictDetector class predicts conflicts between ADS-B traffic and our own vehicles.
+/// Both are extrapolated at constant velocity. A pair is in conflict if, within the lookahead time, there is a time at
+/// which both the horizontal and the vertical separation are lost. The closest point of approach (CPA) is reported
+/// along with it. A spatial grid limits the pairs looked at per vehicle,
+/// the remaining ones are computed in one pass over flat arrays.
+/// Detection runs on a worker thread owned by the detector, results are delivered through conflictsDetected.
+class ADSBConflictDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Ownship_t {
+        int vehicleId = 0;
+        QGeoCoordinate location;    ///< Altitude is AMSL, NaN if unknown. Traffic altitudes are usually barometric.
+        double velocityNorth = 0;   ///< m/s
+        double velocityEast = 0;    ///< m/s
+        double velocityUp = 0;      ///< m/s
+    };
+
+    /// Traffic as parallel arrays, one entry per aircraft.
+    struct Traffic_t {
+        QList<uint32_t> icaoAddress;
+        QList<double> latitude;
+        QList<double> longitude;
+        QList<double> altitude;         ///< NaN if unknown
+        QList<double> velocityNorth;
+        QList<double> velocityEast;
+        QList<double> velocityUp;
+
+        void reserve(qsizetype count);
+        void append(const ADSB::VehicleInfo_t &vehicleInfo);
+        qsizetype count() const { return icaoAddress.count(); }
+    };
+
+    struct Thresholds_t {
+        double horizontalSeparation = 600;  ///< m
+        double verticalSeparation = 100;    ///< m
+        double lookaheadSecs = 60;          ///< Conflicts losing separation further out are ignored
+        double warningSecs = 20;            ///< Conflicts losing separation sooner than this are warnings
+    };
+
+    struct Conflict_t {
+        int vehicleId = 0;
+        uint32_t icaoAddress = 0;
+        ADSB::ConflictLevel level = ADSB::NoConflict;
+        double timeToLoss = 0;      ///< secs until both horizontal and vertical separation are lost, 0 if already lost
+        double timeToCpa = 0;       ///< secs
+        double horizontalCpa = 0;   ///< m, horizontal distance at CPA
+        double verticalCpa = 0;     ///< m, altitude difference at CPA, NaN if unknown
+        double distance = 0;        ///< m, current horizontal distance
+    };
+
+    explicit ADSBConflictDetector(QObject *parent = nullptr);
+    ~ADSBConflictDetector();
+
+    /// Queues a detection pass on the worker thread. Dropped if the previous pass has not finished yet, the next
+    /// call will have newer positions anyway.
+    ///     @return false if the pass was dropped
+    bool submit(const QList<Ownship_t> &ownships, const Traffic_t &traffic, const Thresholds_t &thresholds);
+
+    /// Detects the conflicts for the specified positions.
+    ///     @return Conflicts in priority order: warnings before advisories, then by time until separation is lost
+    static QList<Conflict_t> detect(const QList<Ownship_t> &ownships, const Traffic_t &traffic, const Thresholds_t &thresholds);
+
+signals:
+    /// Emitted from the worker thread at the end of every pass.
+    void conflictsDetected(const QList<ADSBConflictDetector::Conflict_t> &conflicts);
+
+private:
+    QThread *_thread = nullptr;
+    QObject *_worker = nullptr;     ///< Lives on _thread
+    std::atomic<bool> _busy{false};
+
+    static constexpr double _gridCellSizeDegrees = 0.1;
+};
+
+Q_DECLARE_METATYPE(ADSBConflictDetector::Conflict_t)
@@ -0,0 +1,211 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBSBSParser.h"
+#include "QGCLoggingCategory.h"
+
+#include <array>
+
+QGC_LOGGING_CATEGORY(ADSBSBSParserLog, "qgc.adsb.adsbsbsparser")
+
+ADSBSBSParser::ADSBSBSParser()
+{
+    _partialLine.reserve(_maxLineLength);
+}
+
+void ADSBSBSParser::append(QByteArrayView bytes)
+{
+    qsizetype start = 0;
+
+    if (!_partialLine.isEmpty()) {
+        const qsizetype end = bytes.indexOf('\n');
+        if (end < 0) {
+            _partialLine.append(bytes);
+            if (_partialLine.size() > _maxLineLength) {
+                qCDebug(ADSBSBSParserLog) << "Dropping overlong line";
+                _partialLine.clear();
+            }
+            return;
+        }
+        _partialLine.append(bytes.first(end));
+        _parseCompleteLine(_partialLine);
+        _partialLine.clear();
+        start = end + 1;
+    }
+
+    while (start < bytes.size()) {
+        const qsizetype end = bytes.indexOf('\n', start);
+        if (end < 0) {
+            const QByteArrayView rest = bytes.sliced(start);
+            if (rest.size() <= _maxLineLength) {
+                _partialLine.append(rest);
+            }
+            break;
+        }
+        _parseCompleteLine(bytes.sliced(start, end - start));
+        start = end + 1;
+    }
+}
+
+void ADSBSBSParser::_parseCompleteLine(QByteArrayView line)
+{
+    _lineCount++;
+
+    ADSB::VehicleInfo_t vehicleInfo{};
+    if (!parseLine(line, vehicleInfo)) {
+        return;
+    }
+
+    const auto it = _batchIndex.constFind(vehicleInfo.icaoAddress);
+    if (it != _batchIndex.constEnd()) {
+        ADSB::mergeVehicleInfo(_batch[it.value()], vehicleInfo);
+    } else {
+        (void) _batchIndex.insert(vehicleInfo.icaoAddress, _batch.size());
+        _batch.append(vehicleInfo);
+    }
+}
+
+QList<ADSB::VehicleInfo_t> ADSBSBSParser::takeBatch()
+{
+    QList<ADSB::VehicleInfo_t> batch;
+    batch.swap(_batch);
+    _batchIndex.clear();
+    return batch;
+}
+
+void ADSBSBSParser::reset()
+{
+    _partialLine.clear();
+    _batch.clear();
+    _batchIndex.clear();
+}
+
+bool ADSBSBSParser::parseLine(QByteArrayView line, ADSB::VehicleInfo_t &vehicleInfo)
+{
+    line = line.trimmed();
+    if ((line.size() <= 4) || !line.startsWith("MSG")) {
+        return false;
+    }
+
+    std::array<QByteArrayView, _fieldCount> fields;
+    int fieldCount = 0;
+    qsizetype start = 0;
+    while (fieldCount < _fieldCount) {
+        const qsizetype comma = line.indexOf(',', start);
+        if (comma < 0) {
+            fields[fieldCount++] = line.sliced(start);
+            break;
+        }
+        fields[fieldCount++] = line.sliced(start, comma - start);
+        start = comma + 1;
+    }
+
+    if (fieldCount <= 4) {
+        return false;
+    }
+
+    bool msgTypeOk;
+    const int msgType = fields[1].toInt(&msgTypeOk);
+    if (!msgTypeOk) {
+        qCDebug(ADSBSBSParserLog) << "ADSB Invalid message type" << fields[1];
+        return false;
+    }
+
+    bool icaoOk;
+    const uint32_t icaoAddress = fields[4].toUInt(&icaoOk, 16);
+    if (!icaoOk) {
+        return false;
+    }
+    vehicleInfo.icaoAddress = icaoAddress;
+
+    switch (msgType) {
+    case ADSB::IdentificationAndCategory:
+    case ADSB::SurveillanceAltitude:
+    case ADSB::SurveillanceId:
+    {
+        if (fieldCount <= 10) {
+            return false;
+        }
+
+        const QByteArrayView callsign = fields[10].trimmed();
+        if (callsign.isEmpty()) {
+            return false;
+        }
+
+        vehicleInfo.callsign = QString::fromLatin1(callsign);
+        vehicleInfo.availableFlags = ADSB::CallsignAvailable;
+        return true;
+    }
+    case ADSB::AirbornePosition:
+    {
+        if (fieldCount <= 19) {
+            return false;
+        }
+
+        // Altitude is either Barometric - based on pressure, in ft
+        // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
+        // If altitude ends with H, we have HAE
+        // There's a slight difference between Barometric alt and HAE, but it would require
+        // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
+        QByteArrayView altitudeField = fields[11];
+        if (altitudeField.endsWith('H')) {
+            altitudeField.chop(1);
+        }
+
+        bool altOk, latOk, lonOk, alertOk;
+        const int modeCAltitude = altitudeField.toInt(&altOk);
+        const double lat = fields[14].toDouble(&latOk);
+        const double lon = fields[15].toDouble(&lonOk);
+        const int alert = fields[19].toInt(&alertOk);
+
+        if (!altOk || !latOk || !lonOk || !alertOk) {
+            return false;
+        }
+
+        if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
+            return false;
+        }
+
+        vehicleInfo.location = QGeoCoordinate(lat, lon);
+        vehicleInfo.altitude = modeCAltitude * 0.3048;
+        vehicleInfo.alert = (alert == 1);
+        vehicleInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
+        return true;
+    }
+    case ADSB::AirborneVelocity:
+    {
+        if (fieldCount <= 13) {
+            return false;
+        }
+
+        bool headingOk;
+        const double heading = fields[13].toDouble(&headingOk);
+        if (!headingOk) {
+            return false;
+        }
+
+        vehicleInfo.heading = heading;
+        vehicleInfo.availableFlags = ADSB::HeadingAvailable;
+
+        // Ground speed in knots, vertical rate in ft/min
+        bool speedOk, verticalRateOk = false;
+        const double groundSpeed = fields[12].toDouble(&speedOk);
+        const double verticalRate = (fieldCount > 16) ? fields[16].toDouble(&verticalRateOk) : 0;
+        if (speedOk) {
+            vehicleInfo.groundSpeed = groundSpeed * 0.514444;
+            vehicleInfo.verticalRate = verticalRateOk ? (verticalRate * 0.3048 / 60.0) : 0;
+            vehicleInfo.availableFlags |= ADSB::VelocityAvailable;
+        }
+        return true;
+    }
+    default:
+        // Surface position and anything past surveillance id are not used
+        return false;
+    }
+}
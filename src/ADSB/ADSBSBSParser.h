@@ -0,0 +1,63 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+
+#include "ADSB.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ADSBSBSParserLog)
+
+/// Parses the SBS-1 (BaseStation) text format. Lines are parsed in place from the received bytes, fields are views
+/// into the line so nothing is allocated per line apart from the callsign string. Updates are merged per aircraft into
+/// a batch which the owner collects with takeBatch.
+/// Not thread-safe: use from a single thread.
+class ADSBSBSParser
+{
+public:
+    ADSBSBSParser();
+
+    /// Parses all complete lines in bytes. A trailing partial line is kept and completed by the next call.
+    ///     @param bytes Raw bytes as received from the server.
+    void append(QByteArrayView bytes);
+
+    /// @return The updates merged since the last call, at most one per aircraft in the order they first arrived.
+    QList<ADSB::VehicleInfo_t> takeBatch();
+
+    /// @return true if there are updates waiting to be collected
+    bool hasBatch() const { return !_batch.isEmpty(); }
+
+    /// Drops the pending batch and any partial line, for example after a reconnect.
+    void reset();
+
+    /// @return Number of lines seen, including the ones which were skipped
+    quint64 lineCount() const { return _lineCount; }
+
+    /// Parses a single SBS-1 line.
+    ///     @param line The line, with or without the line terminator.
+    ///     @param vehicleInfo Filled in with the values available in the line.
+    ///     @return true if the line contained a supported update
+    static bool parseLine(QByteArrayView line, ADSB::VehicleInfo_t &vehicleInfo);
+
+private:
+    void _parseCompleteLine(QByteArrayView line);
+
+    QByteArray _partialLine;                    ///< Start of a line whose end has not been received yet
+    QList<ADSB::VehicleInfo_t> _batch;
+    QHash<uint32_t, qsizetype> _batchIndex;     ///< ICAO address to index in _batch
+    quint64 _lineCount = 0;
+
+    static constexpr int _fieldCount = 22;          ///< Fields in a complete SBS-1 MSG line
+    static constexpr qsizetype _maxLineLength = 512;    ///< Longer partial lines are garbage and dropped
+};
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBSpatialGrid.h"
+
+#include <QtCore/QtMath>
+
+ADSBSpatialGrid::ADSBSpatialGrid(double cellSizeDegrees)
+    : _cellSizeDegrees(cellSizeDegrees)
+    , _lonCellCount(qCeil(360.0 / cellSizeDegrees))
+{
+
+}
+
+int ADSBSpatialGrid::_latIndex(double latitude) const
+{
+    return qFloor((qBound(-90.0, latitude, 90.0) + 90.0) / _cellSizeDegrees);
+}
+
+int ADSBSpatialGrid::_lonIndex(double longitude) const
+{
+    // Wraps around the antimeridian
+    const int index = qFloor((longitude + 180.0) / _cellSizeDegrees) % _lonCellCount;
+    return (index < 0) ? (index + _lonCellCount) : index;
+}
+
+quint64 ADSBSpatialGrid::_cellKey(int latIndex, int lonIndex)
+{
+    return (static_cast<quint64>(static_cast<quint32>(latIndex)) << 32) | static_cast<quint32>(lonIndex);
+}
+
+void ADSBSpatialGrid::insert(uint32_t icaoAddress, const QGeoCoordinate &location)
+{
+    const quint64 cellKey = _cellKey(_latIndex(location.latitude()), _lonIndex(location.longitude()));
+
+    const auto it = _itemCells.constFind(icaoAddress);
+    if (it != _itemCells.constEnd()) {
+        if (it.value() == cellKey) {
+            return;
+        }
+        (void) _cells[it.value()].removeOne(icaoAddress);
+    }
+
+    _itemCells[icaoAddress] = cellKey;
+    _cells[cellKey].append(icaoAddress);
+}
+
+void ADSBSpatialGrid::remove(uint32_t icaoAddress)
+{
+    const auto it = _itemCells.constFind(icaoAddress);
+    if (it == _itemCells.constEnd()) {
+        return;
+    }
+
+    QList<uint32_t> &cell = _cells[it.value()];
+    (void) cell.removeOne(icaoAddress);
+    if (cell.isEmpty()) {
+        (void) _cells.remove(it.value());
+    }
+    (void) _itemCells.erase(it);
+}
+
+void ADSBSpatialGrid::clear()
+{
+    _cells.clear();
+    _itemCells.clear();
+}
+
+void ADSBSpatialGrid::query(const QGeoCoordinate &center, double radiusMeters, QList<uint32_t> &result) const
+{
+    constexpr double metersPerDegree = 111319.49;
+
+    const double radiusLatDegrees = radiusMeters / metersPerDegree;
+    const double lonScale = qMax(qCos(qDegreesToRadians(center.latitude())), 0.01);
+    const double radiusLonDegrees = qMin(radiusMeters / (metersPerDegree * lonScale), 180.0);
+
+    const int minLat = _latIndex(center.latitude() - radiusLatDegrees);
+    const int maxLat = _latIndex(center.latitude() + radiusLatDegrees);
+    const int lonSpan = qMin(qFloor((2.0 * radiusLonDegrees) / _cellSizeDegrees) + 1, _lonCellCount - 1);
+    const int minLon = _lonIndex(center.longitude() - radiusLonDegrees);
+
+    for (int latIndex = minLat; latIndex <= maxLat; latIndex++) {
+        for (int i = 0; i <= lonSpan; i++) {
+            const auto it = _cells.constFind(_cellKey(latIndex, (minLon + i) % _lonCellCount));
+            if (it != _cells.constEnd()) {
+                result.append(it.value());
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtPositioning/QGeoCoordinate>
+
+/// The ADSBSpatialGrid class buckets aircraft into fixed size latitude/longitude cells
+/// so range queries only look at the aircraft near the query position.
+class ADSBSpatialGrid
+{
+public:
+    /// Constructs an empty grid.
+    ///     @param cellSizeDegrees Size of a cell in both latitude and longitude.
+    explicit ADSBSpatialGrid(double cellSizeDegrees = 0.5);
+
+    /// Adds an aircraft or moves it to the cell for its new location.
+    void insert(uint32_t icaoAddress, const QGeoCoordinate &location);
+
+    /// Removes an aircraft from the grid.
+    void remove(uint32_t icaoAddress);
+
+    void clear();
+
+    int count() const { return _itemCells.count(); }
+
+    /// Appends all aircraft in the cells touched by a circle to result. The result is a superset of the aircraft
+    /// within the circle, callers check the exact distance themselves.
+    ///     @param center Center of the circle.
+    ///     @param radiusMeters Radius of the circle.
+    ///     @param result List to append the aircraft to.
+    void query(const QGeoCoordinate &center, double radiusMeters, QList<uint32_t> &result) const;
+
+private:
+    int _latIndex(double latitude) const;
+    int _lonIndex(double longitude) const;
+    static quint64 _cellKey(int latIndex, int lonIndex);
+
+    const double _cellSizeDegrees;
+    const int _lonCellCount;
+
+    QHash<quint64, QList<uint32_t>> _cells;
+    QHash<uint32_t, quint64> _itemCells;
+};
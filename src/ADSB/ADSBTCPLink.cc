@@ -11,6 +11,7 @@
 // #include "DeviceInfo.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QTcpSocket>
 
@@ -20,40 +21,16 @@ ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject
     : QObject(parent)
     , _hostAddress(hostAddress)
     , _port(port)
-    , _socket(new QTcpSocket(this))
-    , _processTimer(new QTimer(this))
+    , _thread(new QThread(this))
+    , _worker(new QObject())
 {
-#ifdef QT_DEBUG
-    (void) connect(_socket, &QTcpSocket::stateChanged, this, [](QTcpSocket::SocketState state) {
-        switch (state) {
-        case QTcpSocket::UnconnectedState:
-            qCDebug(ADSBTCPLinkLog) << "ADSB Socket disconnected";
-            break;
-        case QTcpSocket::SocketState::ConnectingState:
-            qCDebug(ADSBTCPLinkLog) << "ADSB Socket connecting...";
-            break;
-        case QTcpSocket::SocketState::ConnectedState:
-            qCDebug(ADSBTCPLinkLog) << "ADSB Socket connected";
-            break;
-        case QTcpSocket::SocketState::ClosingState:
-            qCDebug(ADSBTCPLinkLog) << "ADSB Socket closing...";
-            break;
-        default:
-            break;
-        }
-    }, Qt::AutoConnection);
-#endif
+    (void) qRegisterMetaType<QList<ADSB::VehicleInfo_t>>("QList<ADSB::VehicleInfo_t>");
 
-    (void) QObject::connect(_socket, &QTcpSocket::errorOccurred, this, [this](QTcpSocket::SocketError error) {
-        qCDebug(ADSBTCPLinkLog) << error << _socket->errorString();
-        // TODO: Check if it is a critical error or not and send if the socket is stopped/recoverable
-        emit errorOccurred(_socket->errorString(), false);
-    }, Qt::AutoConnection);
-
-    (void) connect(_socket, &QTcpSocket::readyRead, this, &ADSBTCPLink::_readBytes);
-
-    _processTimer->setInterval(_processInterval); // Set an interval for processing lines
-    (void) connect(_processTimer, &QTimer::timeout, this, &ADSBTCPLink::_processLines);
+    _thread->setObjectName(QStringLiteral("ADSBTCPLink"));
+    _worker->moveToThread(_thread);
+    (void) connect(_thread, &QThread::finished, _worker, &QObject::deleteLater);
+    (void) QMetaObject::invokeMethod(_worker, [this]() { _createSocket(); }, Qt::QueuedConnection);
+    _thread->start();
 
     init();
 
@@ -62,6 +39,9 @@ ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject
 
 ADSBTCPLink::~ADSBTCPLink()
 {
+    _thread->quit();
+    _thread->wait();
+
     // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 }
 
@@ -74,165 +54,78 @@ bool ADSBTCPLink::init()
         return false;
     }
 
-    _socket->connectToHost(_hostAddress, _port);
+    (void) QMetaObject::invokeMethod(_worker, [this]() {
+        _parser.reset();
+        _socket->connectToHost(_hostAddress, _port);
+    }, Qt::QueuedConnection);
 
     return true;
 }
 
-void ADSBTCPLink::_readBytes()
+void ADSBTCPLink::_createSocket()
 {
-    while (_socket && _socket->canReadLine()) {
-        const QByteArray bytes = _socket->readLine();
-        (void) _lineBuffer.append(QString::fromLocal8Bit(bytes));
-    }
-
-    // Start or restart the timer to process lines
-    if (!_processTimer->isActive()) {
-        _processTimer->start();
-    }
-}
-
-void ADSBTCPLink::_processLines()
-{
-    int linesProcessed = 0;
-    while (!_lineBuffer.isEmpty() && (linesProcessed < _maxLinesToProcess)) {
-        const QString line = _lineBuffer.takeFirst();
-        _parseLine(line);
-        ++linesProcessed;
-    }
-
-    // Stop the timer if there are no more lines to process
-    if (_lineBuffer.isEmpty()) {
-        _processTimer->stop();
-    }
-}
-
-void ADSBTCPLink::_parseLine(const QString &line)
-{
-    if (line.size() <= 4) {
-        return;
-    }
-
-    if (!line.startsWith(QStringLiteral("MSG"))) {
-        return;
-    }
-
-    const int msgType = line.at(4).digitValue();
-    if (msgType == ADSB::Unsupported) {
-        qCDebug(ADSBTCPLinkLog) << "ADSB Invalid message type" << msgType;
-        return;
-    }
+    _socket = new QTcpSocket(_worker);
+    _batchTimer = new QTimer(_worker);
+    _readBuffer.resize(_readChunkSize);
 
-    // Skip unsupported mesg types to avoid parsing
-    if ((msgType == ADSB::SurfacePosition) || (msgType > ADSB::SurveillanceId)) {
-        return;
-    }
-
-    qCDebug(ADSBTCPLinkLog) << "ADSB SBS-1" << line;
-
-    const QStringList values = line.split(QChar(','));
-    if (values.size() <= 4) {
-        return;
-    }
-
-    bool icaoOk;
-    const uint32_t icaoAddress = values.at(4).toUInt(&icaoOk, 16);
-    if (!icaoOk) {
-        return;
-    }
-
-    ADSB::VehicleInfo_t adsbInfo;
-    adsbInfo.icaoAddress = icaoAddress;
-
-    switch (msgType) {
-    case ADSB::IdentificationAndCategory:
-    case ADSB::SurveillanceAltitude:
-    case ADSB::SurveillanceId:
-        _parseAndEmitCallsign(adsbInfo, values);
-        break;
-    case ADSB::AirbornePosition:
-        _parseAndEmitLocation(adsbInfo, values);
-        break;
-    case ADSB::AirborneVelocity:
-        _parseAndEmitHeading(adsbInfo, values);
-        break;
-    default:
-        break;
-    }
-}
-
-void ADSBTCPLink::_parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
-{
-    if (values.size() <= 10) {
-        return;
-    }
+#ifdef QT_DEBUG
+    (void) connect(_socket, &QTcpSocket::stateChanged, _worker, [](QTcpSocket::SocketState state) {
+        switch (state) {
+        case QTcpSocket::UnconnectedState:
+            qCDebug(ADSBTCPLinkLog) << "ADSB Socket disconnected";
+            break;
+        case QTcpSocket::SocketState::ConnectingState:
+            qCDebug(ADSBTCPLinkLog) << "ADSB Socket connecting...";
+            break;
+        case QTcpSocket::SocketState::ConnectedState:
+            qCDebug(ADSBTCPLinkLog) << "ADSB Socket connected";
+            break;
+        case QTcpSocket::SocketState::ClosingState:
+            qCDebug(ADSBTCPLinkLog) << "ADSB Socket closing...";
+            break;
+        default:
+            break;
+        }
+    }, Qt::AutoConnection);
+#endif
 
-    const QString callsign = values.at(10).trimmed();
-    if (callsign.isEmpty()) {
-        return;
-    }
+    (void) QObject::connect(_socket, &QTcpSocket::errorOccurred, _worker, [this](QTcpSocket::SocketError error) {
+        qCDebug(ADSBTCPLinkLog) << error << _socket->errorString();
+        // TODO: Check if it is a critical error or not and send if the socket is stopped/recoverable
+        emit errorOccurred(_socket->errorString(), false);
+    }, Qt::AutoConnection);
 
-    adsbInfo.callsign = callsign;
-    adsbInfo.availableFlags = ADSB::CallsignAvailable;
+    (void) connect(_socket, &QTcpSocket::readyRead, _worker, [this]() { _readBytes(); });
 
-    emit adsbVehicleUpdate(adsbInfo);
+    _batchTimer->setSingleShot(true);
+    _batchTimer->setInterval(_batchInterval);
+    (void) connect(_batchTimer, &QTimer::timeout, _worker, [this]() { _emitBatch(); });
 }
 
-void ADSBTCPLink::_parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+void ADSBTCPLink::_readBytes()
 {
-    if (values.size() <= 19) {
-        return;
-    }
-
-    // Altitude is either Barometric - based on pressure, in ft
-    // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
-    // If altitude ends with H, we have HAE
-    // There's a slight difference between Barometric alt and HAE, but it would require
-    // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
-    QString altitudeStr = values.at(11);
-    if (altitudeStr.endsWith('H')) {
-        (void) altitudeStr.chop(1);
-    }
-
-    bool altOk, latOk, lonOk, alertOk;
-    const int modeCAltitude = altitudeStr.toInt(&altOk);
-    const double lat = values.at(14).toDouble(&latOk);
-    const double lon = values.at(15).toDouble(&lonOk);
-    const int alert = values.at(19).toInt(&alertOk);
-
-    if (!altOk || !latOk || !lonOk || !alertOk) {
-        return;
+    while (_socket->bytesAvailable() > 0) {
+        const qint64 bytesRead = _socket->read(_readBuffer.data(), _readBuffer.size());
+        if (bytesRead <= 0) {
+            break;
+        }
+        _parser.append(QByteArrayView(_readBuffer.constData(), bytesRead));
     }
 
-    if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
-        return;
+    // Updates arriving within one interval go out together
+    if (_parser.hasBatch() && !_batchTimer->isActive()) {
+        _batchTimer->start();
     }
-
-    const double altitude = modeCAltitude * 0.3048;
-    const QGeoCoordinate location(lat, lon);
-
-    adsbInfo.location = location;
-    adsbInfo.altitude = altitude;
-    adsbInfo.alert = (alert == 1);
-    adsbInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
-
-    emit adsbVehicleUpdate(adsbInfo);
 }
 
-void ADSBTCPLink::_parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+void ADSBTCPLink::_emitBatch()
 {
-    if (values.size() <= 13) {
-        return;
-    }
-
-    bool headingOk;
-    const double heading = values.at(13).toDouble(&headingOk);
-    if (!headingOk) {
+    const QList<ADSB::VehicleInfo_t> batch = _parser.takeBatch();
+    if (batch.isEmpty()) {
         return;
     }
 
-    adsbInfo.heading = heading;
-    adsbInfo.availableFlags = ADSB::HeadingAvailable;
+    qCDebug(ADSBTCPLinkLog) << "ADSB batch" << batch.size() << "lines total" << _parser.lineCount();
 
-    emit adsbVehicleUpdate(adsbInfo);
+    emit adsbVehicleUpdates(batch);
 }
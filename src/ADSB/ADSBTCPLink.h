@@ -14,14 +14,17 @@
 #include <QtNetwork/QHostAddress>
 
 #include "ADSB.h"
+#include "ADSBSBSParser.h"
 
 Q_DECLARE_LOGGING_CATEGORY(ADSBTCPLinkLog)
 
 class QTcpSocket;
+class QThread;
 class QTimer;
 
 /// The ADSBTCPLink class handles the TCP connection to an ADS-B server
-/// and processes incoming ADS-B data.
+/// and processes incoming ADS-B data. The socket and the SBS-1 parsing run on
+/// a worker thread owned by the link, updates are delivered in batches.
 class ADSBTCPLink : public QObject
 {
     Q_OBJECT
@@ -33,55 +36,44 @@ public:
     ///     @param parent The parent object.
     explicit ADSBTCPLink(const QHostAddress &hostAddress, quint16 port = 30003, QObject *parent = nullptr);
 
-    /// Destroys the ADSBTCPLink object.
+    /// Destroys the ADSBTCPLink object. Stops the worker thread.
     ~ADSBTCPLink();
 
     /// Attempts connection to a host.
     bool init();
 
 signals:
-    /// Emitted when an ADS-B vehicle update is received.
-    ///     @param vehicleInfo The updated vehicle information.
-    void adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo);
+    /// Emitted from the worker thread every _batchInterval with the updates received since the last batch, at most
+    /// one per aircraft.
+    ///     @param vehicleInfos The merged updates.
+    void adsbVehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
 
     /// Emitted when an error occurs.
     ///     @param errorMsg The error message.
     void errorOccurred(const QString &errorMsg, bool stopped = false);
 
-private slots:
-    /// Reads bytes from the TCP socket.
-    void _readBytes();
-
-    /// Processes buffered lines of ADS-B data.
-    void _processLines();
-
 private:
-    /// Parses a line of ADS-B data.
-    ///     @param line The line to parse.
-    void _parseLine(const QString &line);
+    /// Creates the socket and batch timer. Runs on the worker thread.
+    void _createSocket();
 
-    /// Parses and emits the callsign from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
-    /// Parses and emits the location from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
+    /// Reads bytes from the TCP socket and parses them. Runs on the worker thread.
+    void _readBytes();
 
-    /// Parses and emits the heading from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
+    /// Emits the updates collected since the last batch. Runs on the worker thread.
+    void _emitBatch();
 
     QHostAddress _hostAddress;
     quint16 _port = 30003;
 
+    QThread *_thread = nullptr;        ///< Worker thread for the socket and parsing
+    QObject *_worker = nullptr;        ///< Lives on _thread, parent of everything below
+
+    // Only accessed from the worker thread
     QTcpSocket *_socket = nullptr;     ///< Pointer to the TCP socket used for connection
-    QTimer *_processTimer = nullptr;   ///< Timer for periodic processing of ADS-B data
-    QStringList _lineBuffer;           ///< Buffer for storing incoming lines of ADS-B data
+    QTimer *_batchTimer = nullptr;     ///< Timer for emitting batches of updates
+    ADSBSBSParser _parser;
+    QByteArray _readBuffer;            ///< Reused for every read to avoid allocations
 
-    static constexpr int _processInterval = 50;     ///< Interval for processing lines
-    static constexpr int _maxLinesToProcess = 100;  ///< Maximum number of lines to process per timer timeout
+    static constexpr int _batchInterval = 50;       ///< Interval for emitting batches of updates
+    static constexpr qint64 _readChunkSize = 16384; ///< Maximum bytes parsed per read
 };
@@ -72,6 +72,12 @@ void ADSBVehicle::update(const ADSB::VehicleInfo_t &vehicleInfo)
             emit alertChanged();
         }
     }
+}
 
-    (void) _lastUpdateTimer.restart();
+void ADSBVehicle::setConflictLevel(int conflictLevel)
+{
+    if (conflictLevel != _conflictLevel) {
+        _conflictLevel = conflictLevel;
+        emit conflictLevelChanged();
+    }
 }
@@ -9,7 +9,6 @@
 
 #pragma once
 
-#include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QtNumeric>
 #include <QtCore/QObject>
@@ -31,6 +30,7 @@ class ADSBVehicle : public QObject
     Q_PROPERTY(double         altitude    READ altitude    NOTIFY altitudeChanged)
     Q_PROPERTY(double         heading     READ heading     NOTIFY headingChanged)
     Q_PROPERTY(bool           alert       READ alert       NOTIFY alertChanged)
+    Q_PROPERTY(int            conflictLevel READ conflictLevel NOTIFY conflictLevelChanged) ///< ADSB::ConflictLevel
 
 public:
     explicit ADSBVehicle(const ADSB::VehicleInfo_t &vehicleInfo, QObject *parent = nullptr);
@@ -42,7 +42,8 @@ public:
     double altitude() const { return _info.altitude; }
     double heading() const { return _info.heading; }
     bool alert() const { return _info.alert; }
-    bool expired() const { return _lastUpdateTimer.hasExpired(_expirationTimeoutMs); }
+    int conflictLevel() const { return _conflictLevel; }
+    void setConflictLevel(int conflictLevel);
     void update(const ADSB::VehicleInfo_t &vehicleInfo);
 
 signals:
@@ -51,10 +52,9 @@ signals:
     void altitudeChanged();
     void headingChanged();
     void alertChanged();
+    void conflictLevelChanged();
 
 private:
     ADSB::VehicleInfo_t _info{};
-    QElapsedTimer _lastUpdateTimer;
-
-    static constexpr qint64 _expirationTimeoutMs = 120000; ///< timeout with no update in ms after which the vehicle is removed.
+    int _conflictLevel = ADSB::NoConflict;
 };
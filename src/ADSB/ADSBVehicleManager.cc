@@ -13,9 +13,13 @@
 #include "SettingsManager.h"
 #include "ADSBVehicleManagerSettings.h"
 #include "ADSBTCPLink.h"
+#include "AudioOutput.h"
 #include "ADSBVehicle.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
 #include "QmlObjectListModel.h"
 #include "QGCLoggingCategory.h"
+#include "QGCSignalCoalescer.h"
 
 #include <QtCore/qapplicationstatic.h>
 #include <QtCore/QTimer>
@@ -30,12 +34,17 @@ ADSBVehicleManager::ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QOb
     , _adsbSettings(settings)
     , _adsbVehicleCleanupTimer(new QTimer(this))
     , _adsbVehicles(new QmlObjectListModel(this))
+    , _conflictTimer(new QTimer(this))
 {
     (void) qRegisterMetaType<ADSB::VehicleInfo_t>("ADSB::VehicleInfo_t");
 
+    _clock.start();
+
     _adsbVehicleCleanupTimer->setSingleShot(false);
     _adsbVehicleCleanupTimer->setInterval(1000);
     (void) connect(_adsbVehicleCleanupTimer, &QTimer::timeout, this, &ADSBVehicleManager::_cleanupStaleVehicles);
+    // Traffic from vehicles arrives without a server connection
+    _adsbVehicleCleanupTimer->start();
 
     Fact* const adsbEnabled = _adsbSettings->adsbServerConnectEnabled();
     Fact* const hostAddress = _adsbSettings->adsbServerHostAddress();
@@ -49,10 +58,18 @@ ADSBVehicleManager::ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QOb
         }
     });
 
+    (void) connect(_adsbSettings->adsbMaxDisplayDistance(), &Fact::rawValueChanged, this, &ADSBVehicleManager::_schedulePublish);
+    (void) connect(_adsbSettings->adsbMaxDisplayAltitudeDifference(), &Fact::rawValueChanged, this, &ADSBVehicleManager::_schedulePublish);
+
     if (adsbEnabled->rawValue().toBool()) {
         _start(hostAddress->rawValue().toString(), port->rawValue().toUInt());
     }
 
+    _conflictTimer->setInterval(_conflictIntervalMs);
+    (void) connect(_conflictTimer, &QTimer::timeout, this, &ADSBVehicleManager::_runConflictDetection);
+    (void) connect(_adsbSettings->adsbConflictDetectionEnabled(), &Fact::rawValueChanged, this, &ADSBVehicleManager::_conflictDetectionEnabledChanged);
+    _conflictDetectionEnabledChanged();
+
     // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 }
 
@@ -69,27 +86,185 @@ ADSBVehicleManager *ADSBVehicleManager::instance()
 void ADSBVehicleManager::adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo)
 {
     const uint32_t icaoAddress = vehicleInfo.icaoAddress;
-    if (_adsbICAOMap.contains(icaoAddress)) {
-        _adsbICAOMap[icaoAddress]->update(vehicleInfo);
-        return;
+
+    auto it = _aircraft.find(icaoAddress);
+    if (it == _aircraft.end()) {
+        // Aircraft are only tracked once their location is known
+        if (!(vehicleInfo.availableFlags & ADSB::LocationAvailable)) {
+            return;
+        }
+        it = _aircraft.insert(icaoAddress, Aircraft_t());
+        it->info.icaoAddress = icaoAddress;
+        qCDebug(ADSBVehicleManagerLog) << "Added" << QString::number(icaoAddress);
     }
 
+    Aircraft_t &aircraft = it.value();
+    ADSB::mergeVehicleInfo(aircraft.info, vehicleInfo);
+    aircraft.lastUpdateMSecs = _clock.elapsed();
     if (vehicleInfo.availableFlags & ADSB::LocationAvailable) {
-        ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
-        _adsbICAOMap[icaoAddress] = adsbVehicle;
-        (void) _adsbVehicles->append(adsbVehicle);
-        qCDebug(ADSBVehicleManagerLog) << "Added" << QString::number(adsbVehicle->icaoAddress());
+        _grid.insert(icaoAddress, aircraft.info.location);
+    }
+
+    if (!aircraft.dirty) {
+        aircraft.dirty = true;
+        _dirtyAircraft.append(icaoAddress);
+        _schedulePublish();
     }
 }
 
+void ADSBVehicleManager::adsbVehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos)
+{
+    for (const ADSB::VehicleInfo_t &vehicleInfo : vehicleInfos) {
+        adsbVehicleUpdate(vehicleInfo);
+    }
+}
+
+void ADSBVehicleManager::_schedulePublish()
+{
+    static const int publishKey = QGCSignalCoalescer::newKey();
+    QGCSignalCoalescer::instance()->post(this, publishKey, [this]() { _publishUpdates(); });
+}
+
+void ADSBVehicleManager::_publishUpdates()
+{
+    const double maxDistance = _adsbSettings->adsbMaxDisplayDistance()->rawValue().toDouble();
+    const double maxAltitudeDifference = _adsbSettings->adsbMaxDisplayAltitudeDifference()->rawValue().toDouble();
+    const QList<QGeoCoordinate> references = ((maxDistance > 0) || (maxAltitudeDifference > 0)) ? _referencePositions() : QList<QGeoCoordinate>();
+    const bool rangeFiltered = !references.isEmpty();
+
+    QList<QObject*> added;
+
+    if (rangeFiltered) {
+        QSet<uint32_t> inRange;
+        if (maxDistance > 0) {
+            // Only the aircraft in the grid cells around our vehicles need an exact check
+            QList<uint32_t> candidates;
+            for (const QGeoCoordinate &reference : references) {
+                _grid.query(reference, maxDistance, candidates);
+            }
+            for (const uint32_t icaoAddress : candidates) {
+                if (_inDisplayRange(_aircraft[icaoAddress].info, references, maxDistance, maxAltitudeDifference)) {
+                    (void) inRange.insert(icaoAddress);
+                }
+            }
+        } else {
+            for (auto it = _aircraft.constBegin(); it != _aircraft.constEnd(); it++) {
+                if (_inDisplayRange(it->info, references, maxDistance, maxAltitudeDifference)) {
+                    (void) inRange.insert(it.key());
+                }
+            }
+        }
+
+        // Traffic in conflict is shown no matter how far away it currently is
+        for (auto it = _conflictLevels.constBegin(); it != _conflictLevels.constEnd(); it++) {
+            if (_aircraft.contains(it.key())) {
+                (void) inRange.insert(it.key());
+            }
+        }
+
+        const QSet<uint32_t> materialized = _materialized;
+        for (const uint32_t icaoAddress : materialized) {
+            if (!inRange.contains(icaoAddress)) {
+                _dematerialize(_aircraft[icaoAddress]);
+            }
+        }
+        for (const uint32_t icaoAddress : inRange) {
+            _materialize(_aircraft[icaoAddress], added);
+        }
+    } else if (_rangeFiltered) {
+        // Filter was just turned off, everything is shown again
+        for (Aircraft_t &aircraft : _aircraft) {
+            _materialize(aircraft, added);
+        }
+    } else {
+        for (const uint32_t icaoAddress : _dirtyAircraft) {
+            const auto it = _aircraft.find(icaoAddress);
+            if (it != _aircraft.end()) {
+                _materialize(it.value(), added);
+            }
+        }
+    }
+    _rangeFiltered = rangeFiltered;
+
+    for (const uint32_t icaoAddress : _dirtyAircraft) {
+        const auto it = _aircraft.find(icaoAddress);
+        if (it == _aircraft.end()) {
+            continue;
+        }
+        it->dirty = false;
+        if (it->vehicle) {
+            it->vehicle->update(it->info);
+        }
+    }
+    _dirtyAircraft.clear();
+
+    if (!added.isEmpty()) {
+        _adsbVehicles->append(added);
+    }
+}
+
+void ADSBVehicleManager::_materialize(Aircraft_t &aircraft, QList<QObject*> &added)
+{
+    if (aircraft.vehicle) {
+        return;
+    }
+
+    aircraft.vehicle = new ADSBVehicle(aircraft.info, this);
+    aircraft.vehicle->setConflictLevel(_conflictLevels.value(aircraft.info.icaoAddress, ADSB::NoConflict));
+    (void) _materialized.insert(aircraft.info.icaoAddress);
+    added.append(aircraft.vehicle);
+}
+
+void ADSBVehicleManager::_dematerialize(Aircraft_t &aircraft)
+{
+    if (!aircraft.vehicle) {
+        return;
+    }
+
+    (void) _adsbVehicles->removeOne(aircraft.vehicle);
+    aircraft.vehicle->deleteLater();
+    aircraft.vehicle = nullptr;
+    (void) _materialized.remove(aircraft.info.icaoAddress);
+}
+
+QList<QGeoCoordinate> ADSBVehicleManager::_referencePositions() const
+{
+    QList<QGeoCoordinate> positions;
+
+    QmlObjectListModel* const vehicles = qgcApp()->toolbox()->multiVehicleManager()->vehicles();
+    for (int i = 0; i < vehicles->count(); i++) {
+        Vehicle* const vehicle = vehicles->value<Vehicle*>(i);
+        if (vehicle && vehicle->coordinate().isValid()) {
+            positions.append(vehicle->coordinate());
+        }
+    }
+
+    return positions;
+}
+
+bool ADSBVehicleManager::_inDisplayRange(const ADSB::VehicleInfo_t &info, const QList<QGeoCoordinate> &references, double maxDistance, double maxAltitudeDifference)
+{
+    for (const QGeoCoordinate &reference : references) {
+        if ((maxDistance > 0) && (reference.distanceTo(info.location) > maxDistance)) {
+            continue;
+        }
+        if ((maxAltitudeDifference > 0) && (info.availableFlags & ADSB::AltitudeAvailable) && !qIsNaN(reference.altitude())) {
+            if (qAbs(info.altitude - reference.altitude()) > maxAltitudeDifference) {
+                continue;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
 void ADSBVehicleManager::_start(const QString &hostAddress, quint16 port)
 {
     Q_ASSERT(!_adsbTcpLink);
     _adsbTcpLink = new ADSBTCPLink(QHostAddress(hostAddress), port, this);
-    (void) connect(_adsbTcpLink, &ADSBTCPLink::adsbVehicleUpdate, this, &ADSBVehicleManager::adsbVehicleUpdate, Qt::AutoConnection);
+    (void) connect(_adsbTcpLink, &ADSBTCPLink::adsbVehicleUpdates, this, &ADSBVehicleManager::adsbVehicleUpdates, Qt::QueuedConnection);
     (void) connect(_adsbTcpLink, &ADSBTCPLink::errorOccurred, this, &ADSBVehicleManager::_linkError, Qt::AutoConnection);
-
-    _adsbVehicleCleanupTimer->start();
 }
 
 void ADSBVehicleManager::_stop()
@@ -98,23 +273,39 @@ void ADSBVehicleManager::_stop()
     _adsbTcpLink->deleteLater();
     _adsbTcpLink = nullptr;
 
-    _adsbVehicleCleanupTimer->stop();
+    _clearTraffic();
+}
 
+void ADSBVehicleManager::_clearTraffic()
+{
     _adsbVehicles->clearAndDeleteContents();
-    _adsbICAOMap.clear();
+    _aircraft.clear();
+    _grid.clear();
+    _dirtyAircraft.clear();
+    _materialized.clear();
+    _rangeFiltered = false;
+    _clearConflicts();
 }
 
 void ADSBVehicleManager::_cleanupStaleVehicles()
 {
-    for (qsizetype i = _adsbVehicles->count() - 1; i >= 0; i--) {
-        ADSBVehicle* const adsbVehicle = _adsbVehicles->value<ADSBVehicle*>(i);
-        if (adsbVehicle->expired()) {
-            qCDebug(ADSBVehicleManagerLog) << "Expired" << QString::number(adsbVehicle->icaoAddress());
-            (void) _adsbVehicles->removeAt(i);
-            (void) _adsbICAOMap.remove(adsbVehicle->icaoAddress());
-            adsbVehicle->deleteLater();
+    const qint64 expiredBefore = _clock.elapsed() - _expirationTimeoutMs;
+
+    for (auto it = _aircraft.begin(); it != _aircraft.end();) {
+        if (it->lastUpdateMSecs < expiredBefore) {
+            qCDebug(ADSBVehicleManagerLog) << "Expired" << QString::number(it.key());
+            _dematerialize(it.value());
+            _grid.remove(it.key());
+            it = _aircraft.erase(it);
+        } else {
+            it++;
         }
     }
+
+    // Our own vehicles move even when no traffic updates arrive
+    if (_rangeFiltered) {
+        _schedulePublish();
+    }
 }
 
 void ADSBVehicleManager::_linkError(const QString &errorMsg, bool stopped)
@@ -130,3 +321,201 @@ void ADSBVehicleManager::_linkError(const QString &errorMsg, bool stopped)
 
     qgcApp()->showAppMessage(msg);
 }
+
+void ADSBVehicleManager::_conflictDetectionEnabledChanged()
+{
+    if (_adsbSettings->adsbConflictDetectionEnabled()->rawValue().toBool()) {
+        if (!_conflictDetector) {
+            _conflictDetector = new ADSBConflictDetector(this);
+            (void) connect(_conflictDetector, &ADSBConflictDetector::conflictsDetected, this, &ADSBVehicleManager::_conflictsDetected, Qt::QueuedConnection);
+        }
+        _conflictTimer->start();
+    } else {
+        _conflictTimer->stop();
+        _clearConflicts();
+    }
+}
+
+void ADSBVehicleManager::_runConflictDetection()
+{
+    const QList<ADSBConflictDetector::Ownship_t> ownships = _ownships();
+    if (ownships.isEmpty() || _aircraft.isEmpty()) {
+        _clearConflicts();
+        return;
+    }
+
+    ADSBConflictDetector::Traffic_t traffic;
+    traffic.reserve(_aircraft.count());
+    for (const Aircraft_t &aircraft : std::as_const(_aircraft)) {
+        traffic.append(aircraft.info);
+    }
+
+    ADSBConflictDetector::Thresholds_t thresholds;
+    thresholds.horizontalSeparation = _adsbSettings->adsbConflictHorizontalSeparation()->rawValue().toDouble();
+    thresholds.verticalSeparation = _adsbSettings->adsbConflictVerticalSeparation()->rawValue().toDouble();
+    thresholds.lookaheadSecs = _adsbSettings->adsbConflictLookahead()->rawValue().toDouble();
+    thresholds.warningSecs = qMin(_warningSecs, thresholds.lookaheadSecs);
+
+    (void) _conflictDetector->submit(ownships, traffic, thresholds);
+}
+
+QList<ADSBConflictDetector::Ownship_t> ADSBVehicleManager::_ownships() const
+{
+    QList<ADSBConflictDetector::Ownship_t> ownships;
+
+    QmlObjectListModel* const vehicles = qgcApp()->toolbox()->multiVehicleManager()->vehicles();
+    for (int i = 0; i < vehicles->count(); i++) {
+        Vehicle* const vehicle = vehicles->value<Vehicle*>(i);
+        if (!vehicle || !vehicle->coordinate().isValid()) {
+            continue;
+        }
+
+        ADSBConflictDetector::Ownship_t ownship;
+        ownship.vehicleId = vehicle->id();
+        // Traffic altitudes are usually barometric pressure altitudes, which can differ from AMSL by tens of meters
+        // or more with the local pressure. Vehicles do not report a pressure altitude, so the vertical separation
+        // threshold has to allow for the difference.
+        ownship.location = QGeoCoordinate(vehicle->coordinate().latitude(), vehicle->coordinate().longitude(), vehicle->altitudeAMSL()->rawValue().toDouble());
+
+        // Local position has the actual direction of travel, heading is only a fallback since multirotors can
+        // fly sideways
+        VehicleLocalPositionFactGroup* const localPosition = qobject_cast<VehicleLocalPositionFactGroup*>(vehicle->localPositionFactGroup());
+        const double vx = localPosition ? localPosition->vx()->rawValue().toDouble() : qQNaN();
+        const double vy = localPosition ? localPosition->vy()->rawValue().toDouble() : qQNaN();
+        if (!qIsNaN(vx) && !qIsNaN(vy)) {
+            ownship.velocityNorth = vx;
+            ownship.velocityEast = vy;
+            ownship.velocityUp = -localPosition->vz()->rawValue().toDouble();
+        } else {
+            const double groundSpeed = vehicle->groundSpeed()->rawValue().toDouble();
+            const double heading = qDegreesToRadians(vehicle->heading()->rawValue().toDouble());
+            if (!qIsNaN(groundSpeed) && !qIsNaN(heading)) {
+                ownship.velocityNorth = groundSpeed * qCos(heading);
+                ownship.velocityEast = groundSpeed * qSin(heading);
+            }
+            ownship.velocityUp = vehicle->climbRate()->rawValue().toDouble();
+        }
+        if (qIsNaN(ownship.velocityUp)) {
+            ownship.velocityUp = 0;
+        }
+
+        ownships.append(ownship);
+    }
+
+    return ownships;
+}
+
+void ADSBVehicleManager::_conflictsDetected(const QList<ADSBConflictDetector::Conflict_t> &conflicts)
+{
+    if (!_conflictTimer->isActive()) {
+        // Detection was turned off while the pass was running
+        return;
+    }
+
+    QHash<uint32_t, ADSB::ConflictLevel> conflictLevels;
+    QVariantList conflictList;
+    for (const ADSBConflictDetector::Conflict_t &conflict : conflicts) {
+        const auto it = _aircraft.constFind(conflict.icaoAddress);
+        if (it == _aircraft.constEnd()) {
+            // Expired while the pass was running
+            continue;
+        }
+
+        ADSB::ConflictLevel &level = conflictLevels[conflict.icaoAddress];
+        level = qMax(level, conflict.level);
+
+        QVariantMap conflictMap;
+        conflictMap[QStringLiteral("vehicleId")] = conflict.vehicleId;
+        conflictMap[QStringLiteral("icaoAddress")] = conflict.icaoAddress;
+        conflictMap[QStringLiteral("callsign")] = it->info.callsign;
+        conflictMap[QStringLiteral("level")] = conflict.level;
+        conflictMap[QStringLiteral("timeToLoss")] = conflict.timeToLoss;
+        conflictMap[QStringLiteral("timeToCpa")] = conflict.timeToCpa;
+        conflictMap[QStringLiteral("horizontalCpa")] = conflict.horizontalCpa;
+        conflictMap[QStringLiteral("verticalCpa")] = conflict.verticalCpa;
+        conflictMap[QStringLiteral("distance")] = conflict.distance;
+        conflictList.append(conflictMap);
+    }
+
+    // Update the markers whose level changed, conflicts away from our vehicles need to be brought into the model
+    bool publish = false;
+    for (auto it = _conflictLevels.constBegin(); it != _conflictLevels.constEnd(); it++) {
+        if (!conflictLevels.contains(it.key())) {
+            const auto aircraft = _aircraft.constFind(it.key());
+            if ((aircraft != _aircraft.constEnd()) && aircraft->vehicle) {
+                aircraft->vehicle->setConflictLevel(ADSB::NoConflict);
+            }
+            publish = true;
+        }
+    }
+    for (auto it = conflictLevels.constBegin(); it != conflictLevels.constEnd(); it++) {
+        const Aircraft_t &aircraft = _aircraft[it.key()];
+        if (aircraft.vehicle) {
+            aircraft.vehicle->setConflictLevel(it.value());
+        } else {
+            publish = true;
+        }
+    }
+    _conflictLevels = conflictLevels;
+    if (publish) {
+        _schedulePublish();
+    }
+
+    if (conflictList != _conflicts) {
+        _conflicts = conflictList;
+        emit conflictsChanged();
+    }
+
+    _announceConflicts(conflicts);
+}
+
+void ADSBVehicleManager::_announceConflicts(const QList<ADSBConflictDetector::Conflict_t> &conflicts)
+{
+    QHash<QPair<int, uint32_t>, ADSB::ConflictLevel> announcedConflicts;
+    const ADSBConflictDetector::Conflict_t *announce = nullptr;
+
+    for (const ADSBConflictDetector::Conflict_t &conflict : conflicts) {
+        const QPair<int, uint32_t> key(conflict.vehicleId, conflict.icaoAddress);
+        const ADSB::ConflictLevel previousLevel = _announcedConflicts.value(key, ADSB::NoConflict);
+        announcedConflicts[key] = qMax(previousLevel, conflict.level);
+
+        // Only new or escalated conflicts are called out, and only the most urgent one per pass so callouts
+        // do not queue up behind each other
+        if (!announce && (conflict.level > previousLevel)) {
+            announce = &conflict;
+        }
+    }
+    _announcedConflicts = announcedConflicts;
+
+    if (!announce) {
+        return;
+    }
+
+    const auto aircraft = _aircraft.constFind(announce->icaoAddress);
+    const QString callsign = ((aircraft != _aircraft.constEnd()) && !aircraft->info.callsign.isEmpty()) ? aircraft->info.callsign : QString::number(announce->icaoAddress, 16);
+    QString text = (announce->level == ADSB::ConflictWarning) ? tr("Traffic warning, %1, %2 seconds") : tr("Traffic advisory, %1, %2 seconds");
+    text = text.arg(callsign).arg(qRound(announce->timeToCpa));
+    if (qgcApp()->toolbox()->multiVehicleManager()->vehicles()->count() > 1) {
+        text = tr("Vehicle %1 %2").arg(announce->vehicleId).arg(text);
+    }
+
+    qCDebug(ADSBVehicleManagerLog) << text;
+    AudioOutput::instance()->say(text.toLower());
+}
+
+void ADSBVehicleManager::_clearConflicts()
+{
+    for (auto it = _conflictLevels.constBegin(); it != _conflictLevels.constEnd(); it++) {
+        const auto aircraft = _aircraft.constFind(it.key());
+        if ((aircraft != _aircraft.constEnd()) && aircraft->vehicle) {
+            aircraft->vehicle->setConflictLevel(ADSB::NoConflict);
+        }
+    }
+    _conflictLevels.clear();
+    _announcedConflicts.clear();
+
+    if (!_conflicts.isEmpty()) {
+        _conflicts.clear();
+        emit conflictsChanged();
+    }
+}
@@ -9,10 +9,16 @@
 
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QVariant>
 
 #include "ADSB.h"
+#include "ADSBConflictDetector.h"
+#include "ADSBSpatialGrid.h"
 
 Q_DECLARE_LOGGING_CATEGORY(ADSBVehicleManagerLog)
 
@@ -22,12 +28,18 @@ class QmlObjectListModel;
 class QTimer;
 class ADSBVehicleManagerSettings;
 
+/// Tracks ADS-B traffic. Updates only touch plain per aircraft records, the QML model is brought up to date with the
+/// changes in one batch per ui tick. Only aircraft within the configured distance/altitude band of one of our own
+/// vehicles get an ADSBVehicle object in the model. When enabled, conflicts between the traffic and our vehicles are
+/// checked at a fixed rate and announced; aircraft in conflict are always in the model.
 class ADSBVehicleManager : public QObject
 {
     Q_OBJECT
     Q_MOC_INCLUDE("QmlObjectListModel.h")
+    friend class ADSBTest;
 
     Q_PROPERTY(const QmlObjectListModel *adsbVehicles READ adsbVehicles CONSTANT)
+    Q_PROPERTY(QVariantList conflicts READ conflicts NOTIFY conflictsChanged)
 
 public:
     ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QObject *parent = nullptr);
@@ -37,21 +49,66 @@ public:
 
     const QmlObjectListModel *adsbVehicles() const { return _adsbVehicles; }
 
+    /// @return Number of aircraft being tracked, including the ones outside the display range
+    int trackedCount() const { return _aircraft.count(); }
+
+    /// @return Current conflicts in priority order, one map per traffic/vehicle pair
+    QVariantList conflicts() const { return _conflicts; }
+
+signals:
+    void conflictsChanged();
+
 public slots:
     void adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo);
+    void adsbVehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
 
 private slots:
     void _cleanupStaleVehicles();
     void _linkError(const QString &errorMsg, bool stopped = false);
+    void _conflictDetectionEnabledChanged();
+    void _runConflictDetection();
+    void _conflictsDetected(const QList<ADSBConflictDetector::Conflict_t> &conflicts);
 
 private:
+    struct Aircraft_t {
+        ADSB::VehicleInfo_t info{};
+        qint64 lastUpdateMSecs = 0;
+        ADSBVehicle *vehicle = nullptr; ///< Only set while the aircraft is within the display range
+        bool dirty = false;
+    };
+
     void _start(const QString &hostAddress, quint16 port);
     void _stop();
+    void _clearTraffic();
+    void _schedulePublish();
+    void _publishUpdates();
+    void _materialize(Aircraft_t &aircraft, QList<QObject*> &added);
+    void _dematerialize(Aircraft_t &aircraft);
+    QList<QGeoCoordinate> _referencePositions() const;
+    QList<ADSBConflictDetector::Ownship_t> _ownships() const;
+    void _announceConflicts(const QList<ADSBConflictDetector::Conflict_t> &conflicts);
+    void _clearConflicts();
+    static bool _inDisplayRange(const ADSB::VehicleInfo_t &info, const QList<QGeoCoordinate> &references, double maxDistance, double maxAltitudeDifference);
 
     ADSBVehicleManagerSettings *_adsbSettings = nullptr;
     QTimer *_adsbVehicleCleanupTimer = nullptr;
     QmlObjectListModel *_adsbVehicles = nullptr;
-
-    QMap<uint32_t, ADSBVehicle*> _adsbICAOMap;
     ADSBTCPLink *_adsbTcpLink = nullptr;
+
+    QHash<uint32_t, Aircraft_t> _aircraft;
+    ADSBSpatialGrid _grid;
+    QList<uint32_t> _dirtyAircraft;
+    QSet<uint32_t> _materialized;
+    bool _rangeFiltered = false;
+    QElapsedTimer _clock;
+
+    ADSBConflictDetector *_conflictDetector = nullptr;
+    QTimer *_conflictTimer = nullptr;
+    QVariantList _conflicts;
+    QHash<uint32_t, ADSB::ConflictLevel> _conflictLevels;                     ///< Highest level per aircraft
+    QHash<QPair<int, uint32_t>, ADSB::ConflictLevel> _announcedConflicts;     ///< (vehicle id, icao) to the level last announced
+
+    static constexpr qint64 _expirationTimeoutMs = 120000; ///< timeout with no update in ms after which the vehicle is removed.
+    static constexpr int _conflictIntervalMs = 1000;
+    static constexpr double _warningSecs = 20;
 };
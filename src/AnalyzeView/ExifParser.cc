@@ -12,6 +12,9 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
 
 #include <exif.h>
 #include <exiv2/exiv2.hpp>
@@ -20,14 +23,19 @@ QGC_LOGGING_CATEGORY(ExifParserLog, "qgc.analyzeview.exifparser")
 
 namespace ExifParser {
 
-double readTime(const QByteArray &buf)
-{
-    easyexif::EXIFInfo result;
-    if (result.parseFrom(reinterpret_cast<const unsigned char*>(buf.constData()), buf.size()) != PARSE_EXIF_SUCCESS) {
-        qCWarning(ExifParserLog) << "Could not parse buffer";
-        return -1.0;
-    }
+namespace {
+
+constexpr quint8 kJpegMarker = 0xFF;
+constexpr quint8 kJpegSOI = 0xD8;
+constexpr quint8 kJpegEOI = 0xD9;
+constexpr quint8 kJpegSOS = 0xDA;
+constexpr quint8 kJpegAPP1 = 0xE1;
+constexpr char kExifHeader[] = { 'E', 'x', 'i', 'f', '\0', '\0' };
+constexpr qint64 kCopyChunkSize = 1024 * 1024;
+constexpr int kMaxSegmentLength = 0xFFFF;
 
+double _decodeTime(const easyexif::EXIFInfo &result)
+{
     const QString createDate = QString(result.DateTimeOriginal.c_str());
 
     const QStringList createDateList = createDate.split(' ');
@@ -56,6 +64,221 @@ double readTime(const QByteArray &buf)
     return (tagTime.toMSecsSinceEpoch() / 1000.0);
 }
 
+void _setGpsTags(Exiv2::ExifData &exifData, const GeoTagWorker::cameraFeedbackPacket &geotag)
+{
+    // Set GPSVersionID
+    exifData["Exif.GPSInfo.GPSVersionID"] = "2 2 0 0";
+
+    // Set GPS map datum
+    exifData["Exif.GPSInfo.GPSMapDatum"] = "WGS-84";
+
+    // Latitude in degrees, minutes, seconds
+    const double latitude = std::fabs(geotag.latitude); // Absolute value for conversion
+    const int latDegrees = static_cast<int>(latitude);
+    const int latMinutes = static_cast<int>((latitude - latDegrees) * 60);
+    const double latSeconds = (latitude - latDegrees - latMinutes / 60.0) * 3600.0;
+
+    // Set GPS latitude
+    exifData["Exif.GPSInfo.GPSLatitudeRef"] = (geotag.latitude > 0) ? "N" : "S";
+    exifData["Exif.GPSInfo.GPSLatitude"] =
+        std::to_string(latDegrees) + "/1 " +
+        std::to_string(latMinutes) + "/1 " +
+        std::to_string(static_cast<int>(latSeconds * 1000)) + "/1000";
+
+    // Longitude in degrees, minutes, seconds
+    const double longitude = std::fabs(geotag.longitude);
+    const int lonDegrees = static_cast<int>(longitude);
+    const int lonMinutes = static_cast<int>((longitude - lonDegrees) * 60);
+    const double lonSeconds = (longitude - lonDegrees - lonMinutes / 60.0) * 3600.0;
+
+    // Set GPS longitude
+    exifData["Exif.GPSInfo.GPSLongitudeRef"] = (geotag.longitude > 0) ? "E" : "W";
+    exifData["Exif.GPSInfo.GPSLongitude"] =
+        std::to_string(lonDegrees) + "/1 " +
+        std::to_string(lonMinutes) + "/1 " +
+        std::to_string(static_cast<int>(lonSeconds * 1000)) + "/1000";
+
+    // Set GPS altitude
+    exifData["Exif.GPSInfo.GPSAltitudeRef"] = (geotag.altitude < 0) ? 1 : 0;
+    exifData["Exif.GPSInfo.GPSAltitude"] = std::to_string(static_cast<uint32_t>(geotag.altitude * 100)) + "/100";
+}
+
+bool _copy(QIODevice &source, QIODevice &destination, qint64 bytes)
+{
+    QByteArray chunk(qMin(bytes, kCopyChunkSize), Qt::Uninitialized);
+    while (bytes > 0) {
+        const qint64 bytesRead = source.read(chunk.data(), qMin(bytes, kCopyChunkSize));
+        if ((bytesRead <= 0) || (destination.write(chunk.constData(), bytesRead) != bytesRead)) {
+            return false;
+        }
+        bytes -= bytesRead;
+    }
+    return true;
+}
+
+} // namespace
+
+double readTime(const QByteArray &buf)
+{
+    easyexif::EXIFInfo result;
+    if (result.parseFrom(reinterpret_cast<const unsigned char*>(buf.constData()), buf.size()) != PARSE_EXIF_SUCCESS) {
+        qCWarning(ExifParserLog) << "Could not parse buffer";
+        return -1.0;
+    }
+
+    return _decodeTime(result);
+}
+
+double readTimeFromSegment(const QByteArray &segment)
+{
+    easyexif::EXIFInfo result;
+    if (result.parseFromEXIFSegment(reinterpret_cast<const unsigned char*>(segment.constData()), static_cast<unsigned>(segment.size())) != PARSE_EXIF_SUCCESS) {
+        qCWarning(ExifParserLog) << "Could not parse Exif segment";
+        return -1.0;
+    }
+
+    return _decodeTime(result);
+}
+
+QByteArray readExifSegment(QIODevice &device, qint64 &segmentOffset)
+{
+    segmentOffset = -1;
+
+    uchar header[4];
+    if ((device.read(reinterpret_cast<char*>(header), 2) != 2) || (header[0] != kJpegMarker) || (header[1] != kJpegSOI)) {
+        qCWarning(ExifParserLog) << "Not a JPEG";
+        return QByteArray();
+    }
+
+    // Exif is in the first few segments, ahead of the image data
+    while (device.read(reinterpret_cast<char*>(header), 4) == 4) {
+        if (header[0] != kJpegMarker) {
+            qCWarning(ExifParserLog) << "Invalid JPEG segment marker";
+            break;
+        }
+        const quint8 marker = header[1];
+        if ((marker == kJpegSOS) || (marker == kJpegEOI)) {
+            break;
+        }
+        const quint16 length = qFromBigEndian<quint16>(header + 2);
+        if (length < 2) {
+            break;
+        }
+        const qint64 payloadOffset = device.pos();
+        if (marker == kJpegAPP1) {
+            const QByteArray payload = device.read(length - 2);
+            if ((payload.size() == length - 2) && payload.startsWith(QByteArrayView(kExifHeader, sizeof(kExifHeader)))) {
+                segmentOffset = payloadOffset;
+                return payload;
+            }
+        }
+        if (!device.seek(payloadOffset + length - 2)) {
+            break;
+        }
+    }
+
+    return QByteArray();
+}
+
+WriteMethod writeFile(const QString &sourceFile, const QString &destinationFile, const GeoTagWorker::cameraFeedbackPacket &geotag)
+{
+    QFile source(sourceFile);
+    if (!source.open(QIODevice::ReadOnly)) {
+        qCWarning(ExifParserLog) << "Could not open" << sourceFile << source.errorString();
+        return WriteFailed;
+    }
+
+    // The result is only moved over the destination once it is complete. Until then the destination, which may be
+    // the source itself, is untouched.
+    QSaveFile destination(destinationFile);
+    const auto commit = [&source, &destination, &destinationFile]() {
+        source.close();
+        if (!destination.commit()) {
+            qCWarning(ExifParserLog) << "Could not write" << destinationFile << destination.errorString();
+            return false;
+        }
+        return true;
+    };
+
+    qint64 segmentOffset;
+    QByteArray segment = readExifSegment(source, segmentOffset);
+    if (segment.isEmpty()) {
+        // Exif has to be created from scratch, which Exiv2 does on the whole image
+        (void) source.seek(0);
+        QByteArray imageBuffer = source.readAll();
+        if (!write(imageBuffer, geotag) || !destination.open(QIODevice::WriteOnly) || (destination.write(imageBuffer) != imageBuffer.size()) || !commit()) {
+            return WriteFailed;
+        }
+        return WriteWholeFile;
+    }
+
+    QByteArray tiff;
+    (void) segment.detach();
+    try {
+        const Exiv2::byte *tiffData = reinterpret_cast<const Exiv2::byte*>(segment.constData() + sizeof(kExifHeader));
+        const size_t tiffSize = static_cast<size_t>(segment.size() - sizeof(kExifHeader));
+
+        Exiv2::ExifData exifData;
+        const Exiv2::ByteOrder byteOrder = Exiv2::ExifParser::decode(exifData, tiffData, tiffSize);
+        _setGpsTags(exifData, geotag);
+
+        // Updates the original tiff data if the tags only changed value, otherwise encodes a new one into blob
+        Exiv2::Blob blob;
+        if (Exiv2::ExifParser::encode(blob, tiffData, tiffSize, byteOrder, exifData) == Exiv2::wmNonIntrusive) {
+            tiff = segment.mid(sizeof(kExifHeader));
+        } else {
+            tiff = QByteArray(reinterpret_cast<const char*>(blob.data()), static_cast<qsizetype>(blob.size()));
+        }
+    } catch (Exiv2::Error& e) {
+        qCWarning(ExifParserLog) << "Error writing EXIF GPS data:" << e.what();
+        return WriteFailed;
+    }
+
+    const qsizetype room = segment.size() - static_cast<qsizetype>(sizeof(kExifHeader));
+    const bool inPlace = (tiff.size() <= room);
+    const qsizetype newLength = 2 + static_cast<qsizetype>(sizeof(kExifHeader)) + tiff.size();
+    if (!inPlace && (newLength > kMaxSegmentLength)) {
+        qCWarning(ExifParserLog) << "Exif data too large for a JPEG segment" << sourceFile;
+        return WriteFailed;
+    }
+
+    if (!destination.open(QIODevice::WriteOnly)) {
+        qCWarning(ExifParserLog) << "Could not open" << destinationFile << destination.errorString();
+        return WriteFailed;
+    }
+
+    bool written;
+    if (inPlace) {
+        // Segment keeps its size and every offset in the file stays the same. Readers stop at the end of the tiff
+        // structure, so padding the rest of the segment is harmless.
+        written = source.seek(0) && _copy(source, destination, segmentOffset + static_cast<qint64>(sizeof(kExifHeader))) &&
+                  (destination.write(tiff) == tiff.size()) &&
+                  (destination.write(QByteArray(room - tiff.size(), '\0')) == (room - tiff.size()));
+    } else {
+        // Everything ahead of the old segment, the new segment, then everything after the old segment
+        const qint64 markerOffset = segmentOffset - 4;
+        QByteArray app1Header(4, Qt::Uninitialized);
+        app1Header[0] = static_cast<char>(kJpegMarker);
+        app1Header[1] = static_cast<char>(kJpegAPP1);
+        qToBigEndian<quint16>(static_cast<quint16>(newLength), app1Header.data() + 2);
+        written = source.seek(0) && _copy(source, destination, markerOffset) &&
+                  (destination.write(app1Header) == app1Header.size()) &&
+                  (destination.write(kExifHeader, sizeof(kExifHeader)) == sizeof(kExifHeader)) &&
+                  (destination.write(tiff) == tiff.size());
+    }
+    written = written && source.seek(segmentOffset + segment.size()) && _copy(source, destination, source.size() - source.pos());
+    if (!written) {
+        qCWarning(ExifParserLog) << "Could not write" << destinationFile << destination.errorString();
+        destination.cancelWriting();
+        return WriteFailed;
+    }
+    if (!commit()) {
+        return WriteFailed;
+    }
+
+    return (inPlace ? WriteInPlace : WriteStreamed);
+}
+
 double readTime2(const QByteArray &buf)
 {
     try {
@@ -115,42 +338,7 @@ bool write(QByteArray &buf, const GeoTagWorker::cameraFeedbackPacket &geotag)
         image->readMetadata();
 
         Exiv2::ExifData &exifData = image->exifData();
-
-        // Set GPSVersionID
-        exifData["Exif.GPSInfo.GPSVersionID"] = "2 2 0 0";
-
-        // Set GPS map datum
-        exifData["Exif.GPSInfo.GPSMapDatum"] = "WGS-84";
-
-        // Latitude in degrees, minutes, seconds
-        const double latitude = std::fabs(geotag.latitude); // Absolute value for conversion
-        const int latDegrees = static_cast<int>(latitude);
-        const int latMinutes = static_cast<int>((latitude - latDegrees) * 60);
-        const double latSeconds = (latitude - latDegrees - latMinutes / 60.0) * 3600.0;
-
-        // Set GPS latitude
-        exifData["Exif.GPSInfo.GPSLatitudeRef"] = (geotag.latitude > 0) ? "N" : "S";
-        exifData["Exif.GPSInfo.GPSLatitude"] =
-            std::to_string(latDegrees) + "/1 " +
-            std::to_string(latMinutes) + "/1 " +
-            std::to_string(static_cast<int>(latSeconds * 1000)) + "/1000";
-
-        // Longitude in degrees, minutes, seconds
-        const double longitude = std::fabs(geotag.longitude);
-        const int lonDegrees = static_cast<int>(longitude);
-        const int lonMinutes = static_cast<int>((longitude - lonDegrees) * 60);
-        const double lonSeconds = (longitude - lonDegrees - lonMinutes / 60.0) * 3600.0;
-
-        // Set GPS longitude
-        exifData["Exif.GPSInfo.GPSLongitudeRef"] = (geotag.longitude > 0) ? "E" : "W";
-        exifData["Exif.GPSInfo.GPSLongitude"] =
-            std::to_string(lonDegrees) + "/1 " +
-            std::to_string(lonMinutes) + "/1 " +
-            std::to_string(static_cast<int>(lonSeconds * 1000)) + "/1000";
-
-        // Set GPS altitude
-        exifData["Exif.GPSInfo.GPSAltitudeRef"] = (geotag.altitude < 0) ? 1 : 0;
-        exifData["Exif.GPSInfo.GPSAltitude"] = std::to_string(static_cast<uint32_t>(geotag.altitude * 100)) + "/100";
+        _setGpsTags(exifData, geotag);
 
         // Write the updated metadata back to the buffer
         image->setExifData(exifData);
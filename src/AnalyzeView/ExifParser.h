@@ -14,6 +14,8 @@
 #include "GeoTagWorker.h"
 
 class QByteArray;
+class QIODevice;
+class QString;
 
 Q_DECLARE_LOGGING_CATEGORY(ExifParserLog)
 
@@ -21,4 +23,25 @@ namespace ExifParser {
     double readTime(const QByteArray &buf);
     double readTime2(const QByteArray &buf);
     bool write(QByteArray &buf, const GeoTagWorker::cameraFeedbackPacket &geotag);
+
+    /// Reads the APP1 Exif segment of a JPEG by walking the segment headers, without reading any image data
+    ///     @param segmentOffset Set to the file offset of the segment payload, which starts with "Exif\0\0"
+    ///     @return Segment payload, empty if the image has no Exif segment
+    QByteArray readExifSegment(QIODevice &device, qint64 &segmentOffset);
+
+    /// Reads the capture time from an Exif segment returned by readExifSegment
+    ///     @return Seconds since the epoch, -1 on error
+    double readTimeFromSegment(const QByteArray &segment);
+
+    enum WriteMethod {
+        WriteFailed,
+        WriteInPlace,           ///< Exif segment rewritten at its original size, the file layout is unchanged
+        WriteStreamed,          ///< Exif segment grew, image data streamed in after the new segment
+        WriteWholeFile,         ///< No Exif segment to update, image loaded and rewritten
+    };
+
+    /// Writes a copy of sourceFile to destinationFile with the geotag in its Exif data. Only the Exif segment is
+    /// read and updated, the image data is streamed through. The destination is replaced only once the copy is
+    /// complete, so it may be the source file itself.
+    WriteMethod writeFile(const QString &sourceFile, const QString &destinationFile, const GeoTagWorker::cameraFeedbackPacket &geotag);
 } // namespace ExifParser
@@ -23,6 +23,7 @@ GeoTagController::GeoTagController()
     connect(&_worker, &GeoTagWorker::error,             this, &GeoTagController::_workerError);
     connect(&_worker, &GeoTagWorker::started,           this, &GeoTagController::inProgressChanged);
     connect(&_worker, &GeoTagWorker::finished,          this, &GeoTagController::inProgressChanged);
+    connect(&_worker, &GeoTagWorker::matchingComplete,  this, &GeoTagController::_workerMatchingComplete);
 }
 
 GeoTagController::~GeoTagController()
@@ -90,7 +91,8 @@ void GeoTagController::startTagging()
     }
     if(_worker.saveDirectory() == "") {
         QDir oldTaggedFolder = QDir(_worker.imageDirectory() + kTagged);
-        if(oldTaggedFolder.exists()) {
+        // Images tagged by the last run are kept if only new images were added since
+        if(oldTaggedFolder.exists() && !_worker.canResume()) {
             oldTaggedFolder.removeRecursively();
             if(!imageDirectory.mkdir(_worker.imageDirectory() + kTagged)) {
                 _setErrorMessage(tr("Couldn't replace the previously tagged images"));
@@ -119,6 +121,12 @@ void GeoTagController::_workerError(QString errorMessage)
     emit errorMessageChanged(errorMessage);
 }
 
+void GeoTagController::_workerMatchingComplete(QStringList unmatchedImages, int unmatchedTriggers)
+{
+    _unmatchedImages = unmatchedImages;
+    _unmatchedTriggers = unmatchedTriggers;
+    emit matchingComplete();
+}
 
 void GeoTagController::_setErrorMessage(const QString& error)
 {
@@ -41,6 +41,12 @@ public:
     /// true: Currently in the process of tagging
     Q_PROPERTY(bool     inProgress      READ inProgress     NOTIFY inProgressChanged)
 
+    /// File names of the images which could not be matched to a camera trigger in the log
+    Q_PROPERTY(QStringList unmatchedImages      READ unmatchedImages    NOTIFY matchingComplete)
+
+    /// Number of camera triggers in the log with no matching image
+    Q_PROPERTY(int      unmatchedTriggers   READ unmatchedTriggers  NOTIFY matchingComplete)
+
     Q_INVOKABLE void startTagging();
     Q_INVOKABLE void cancelTagging() { _worker.cancelTagging(); }
 
@@ -50,6 +56,8 @@ public:
     double  progress            () const { return _progress; }
     bool    inProgress          () const { return _worker.isRunning(); }
     QString errorMessage        () const { return _errorMessage; }
+    QStringList unmatchedImages () const { return _unmatchedImages; }
+    int     unmatchedTriggers   () const { return _unmatchedTriggers; }
 
     void    setLogFile          (QString file);
     void    setImageDirectory   (QString dir);
@@ -62,16 +70,20 @@ signals:
     void progressChanged        (double progress);
     void inProgressChanged      ();
     void errorMessageChanged    (QString errorMessage);
+    void matchingComplete       ();
 
 private slots:
     void _workerProgressChanged (double progress);
     void _workerError           (QString errorMsg);
+    void _workerMatchingComplete(QStringList unmatchedImages, int unmatchedTriggers);
     void _setErrorMessage       (const QString& error);
 
 private:
     QString             _errorMessage;
     double              _progress;
     bool                _inProgress;
+    QStringList         _unmatchedImages;
+    int                 _unmatchedTriggers = 0;
 
     GeoTagWorker        _worker;
 
@@ -0,0 +1,266 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoTagMatcher.h"
+#include "QGCLoggingCategory.h"
+
+#include <algorithm>
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(GeoTagMatcherLog, "qgc.analyzeview.geotagmatcher")
+
+GeoTagMatcher::GeoTagMatcher(double toleranceSecs)
+    : _toleranceSecs(toleranceSecs)
+    , _matchToleranceSecs(toleranceSecs)
+{
+
+}
+
+void GeoTagMatcher::setTriggers(const QList<double>& triggerSecs)
+{
+    _triggerSecs = triggerSecs;
+    _imageSecs.clear();
+    _imageTrigger.clear();
+    _triggerImage.fill(-1, _triggerSecs.count());
+    _matchCount = 0;
+    _offsetSecs = 0;
+    _matchToleranceSecs = _toleranceSecs;
+    _valid = false;
+}
+
+void GeoTagMatcher::_clearMatches(void)
+{
+    _imageTrigger.fill(-1, _imageSecs.count());
+    _triggerImage.fill(-1, _triggerSecs.count());
+    _matchCount = 0;
+}
+
+QList<int> GeoTagMatcher::_sortedImages(int firstImage) const
+{
+    QList<int> images;
+    images.reserve(_imageSecs.count() - firstImage);
+    for (int i = firstImage; i < _imageSecs.count(); i++) {
+        if (_imageSecs[i] >= 0) {
+            images.append(i);
+        }
+    }
+    std::stable_sort(images.begin(), images.end(), [this](int a, int b) { return _imageSecs[a] < _imageSecs[b]; });
+    return images;
+}
+
+QList<int> GeoTagMatcher::_sortedTriggers(bool freeOnly) const
+{
+    QList<int> triggers;
+    triggers.reserve(_triggerSecs.count());
+    for (int i = 0; i < _triggerSecs.count(); i++) {
+        if (!freeOnly || (_triggerImage[i] < 0)) {
+            triggers.append(i);
+        }
+    }
+    std::stable_sort(triggers.begin(), triggers.end(), [this](int a, int b) { return _triggerSecs[a] < _triggerSecs[b]; });
+    return triggers;
+}
+
+double GeoTagMatcher::_medianInterval(const QList<int>& triggers) const
+{
+    if (triggers.count() < 2) {
+        return 0;
+    }
+
+    QList<double> intervals;
+    intervals.reserve(triggers.count() - 1);
+    for (int i = 1; i < triggers.count(); i++) {
+        intervals.append(_triggerSecs[triggers[i]] - _triggerSecs[triggers[i - 1]]);
+    }
+    std::nth_element(intervals.begin(), intervals.begin() + (intervals.count() / 2), intervals.end());
+    return intervals[intervals.count() / 2];
+}
+
+double GeoTagMatcher::_estimateOffset(const QList<int>& images, const QList<int>& triggers, bool& found) const
+{
+    found = false;
+    const int imageCount = images.count();
+    const int triggerCount = triggers.count();
+    if ((imageCount == 0) || (triggerCount == 0)) {
+        return 0;
+    }
+
+    // Pairs are looked for around three places in time order: the same rank from the start, the same rank from the
+    // end, and the same fraction of the way through. Which one holds depends on whether the images cover the start of
+    // the flight, the end, or all of it with drops along the way. Drops move the true pair by at most the count
+    // difference, give or take the slack.
+    const int window = qMin(std::abs(imageCount - triggerCount) + _candidateSlack, _maxCandidateWindow);
+    const double scale = (imageCount > 1) ? (static_cast<double>(triggerCount - 1) / (imageCount - 1)) : 0;
+
+    QList<double> candidates;
+    candidates.reserve(static_cast<qsizetype>(imageCount) * qMin((2 * window) + 1, triggerCount));
+    for (int i = 0; i < imageCount; i++) {
+        int centers[3] = { i, i + (triggerCount - imageCount), qRound(i * scale) };
+        std::sort(std::begin(centers), std::end(centers));
+
+        // Each trigger is only a candidate once, however many of the windows it is in
+        const double imageSecs = _imageSecs[images[i]];
+        int next = 0;
+        for (const int center: centers) {
+            const int first = qMax(next, center - window);
+            const int last = qMin(triggerCount - 1, center + window);
+            for (int j = first; j <= last; j++) {
+                candidates.append(_triggerSecs[triggers[j]] - imageSecs);
+            }
+            next = qMax(next, last + 1);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    // Densest span of candidates no wider than the tolerance
+    qsizetype bestFirst = 0;
+    qsizetype bestCount = 0;
+    qsizetype first = 0;
+    for (qsizetype last = 0; last < candidates.count(); last++) {
+        while ((candidates[last] - candidates[first]) > _matchToleranceSecs) {
+            first++;
+        }
+        if ((last - first + 1) > bestCount) {
+            bestCount = last - first + 1;
+            bestFirst = first;
+        }
+    }
+
+    found = true;
+    return candidates[bestFirst + (bestCount / 2)];
+}
+
+void GeoTagMatcher::_merge(const QList<int>& images, double offsetSecs)
+{
+    const QList<int> triggers = _sortedTriggers(true /* freeOnly */);
+
+    int i = 0;
+    int j = 0;
+    while ((i < images.count()) && (j < triggers.count())) {
+        const double imageSecs = _imageSecs[images[i]] + offsetSecs;
+        const double triggerSecs = _triggerSecs[triggers[j]];
+        const double difference = triggerSecs - imageSecs;
+
+        if (difference < -_matchToleranceSecs) {
+            j++;
+            continue;
+        }
+        if (difference > _matchToleranceSecs) {
+            i++;
+            continue;
+        }
+
+        // Both neighbours could be within the tolerance as well, each item goes to whichever is closest
+        if (((i + 1) < images.count()) && (std::fabs(triggerSecs - (_imageSecs[images[i + 1]] + offsetSecs)) < std::fabs(difference))) {
+            i++;
+            continue;
+        }
+        if (((j + 1) < triggers.count()) && (std::fabs(_triggerSecs[triggers[j + 1]] - imageSecs) < std::fabs(difference))) {
+            j++;
+            continue;
+        }
+
+        _imageTrigger[images[i]] = triggers[j];
+        _triggerImage[triggers[j]] = images[i];
+        _matchCount++;
+        i++;
+        j++;
+    }
+}
+
+bool GeoTagMatcher::match(const QList<double>& imageSecs)
+{
+    _imageSecs = imageSecs;
+    _clearMatches();
+    _valid = false;
+
+    const QList<int> images = _sortedImages(0);
+    const QList<int> triggers = _sortedTriggers(false /* freeOnly */);
+
+    // A wider tolerance would let an image reach the trigger after its own. Triggers closer together than the image
+    // time resolution leave several of them with the same image time, and only their order can tell them apart.
+    _matchToleranceSecs = _toleranceSecs;
+    if (triggers.count() > 1) {
+        const double medianInterval = _medianInterval(triggers);
+        if (medianInterval < _toleranceSecs) {
+            qCDebug(GeoTagMatcherLog) << "Median trigger interval" << medianInterval << "secs is under the image time resolution";
+            return false;
+        }
+        _matchToleranceSecs = qMin(_toleranceSecs, medianInterval / 2);
+    }
+
+    bool found;
+    _offsetSecs = _estimateOffset(images, triggers, found);
+    if (!found) {
+        qCDebug(GeoTagMatcherLog) << "No images or triggers with a time";
+        return false;
+    }
+    _merge(images, _offsetSecs);
+
+    // The cluster center can be off by up to half the tolerance, the median of the real pairs is not
+    QList<double> residuals;
+    residuals.reserve(_matchCount);
+    for (const int image: images) {
+        if (_imageTrigger[image] >= 0) {
+            residuals.append(_triggerSecs[_imageTrigger[image]] - _imageSecs[image]);
+        }
+    }
+    if (!residuals.isEmpty()) {
+        std::nth_element(residuals.begin(), residuals.begin() + (residuals.count() / 2), residuals.end());
+        _offsetSecs = residuals[residuals.count() / 2];
+        _clearMatches();
+        _merge(images, _offsetSecs);
+    }
+
+    const int required = qMax(1, qMin(images.count(), triggers.count()) / 2);
+    _valid = _matchCount >= required;
+    qCDebug(GeoTagMatcherLog) << "Offset" << _offsetSecs << "matched" << _matchCount << "of" << images.count() << "images with a time and" << triggers.count() << "triggers";
+    if (!_valid) {
+        _clearMatches();
+    }
+
+    return _valid;
+}
+
+int GeoTagMatcher::addImages(const QList<double>& imageSecs)
+{
+    const int firstImage = _imageSecs.count();
+    _imageSecs.append(imageSecs);
+    _imageTrigger.resize(_imageSecs.count(), -1);
+
+    if (_valid) {
+        const int previousMatchCount = _matchCount;
+        _merge(_sortedImages(firstImage), _offsetSecs);
+        qCDebug(GeoTagMatcherLog) << "Matched" << (_matchCount - previousMatchCount) << "of" << imageSecs.count() << "added images";
+    }
+
+    return firstImage;
+}
+
+QList<int> GeoTagMatcher::unmatchedImages(void) const
+{
+    QList<int> images;
+    for (int i = 0; i < _imageTrigger.count(); i++) {
+        if (_imageTrigger[i] < 0) {
+            images.append(i);
+        }
+    }
+    return images;
+}
+
+QList<int> GeoTagMatcher::unmatchedTriggers(void) const
+{
+    QList<int> triggers;
+    for (int i = 0; i < _triggerImage.count(); i++) {
+        if (_triggerImage[i] < 0) {
+            triggers.append(i);
+        }
+    }
+    return triggers;
+}
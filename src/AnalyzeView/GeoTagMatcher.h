@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(GeoTagMatcherLog)
+
+/// Pairs images with camera triggers by time. The camera clock and the log clock differ by an unknown offset, which
+/// can be anything from a time zone to the vehicle boot time, so the offset is estimated first.
+/// Candidate offsets come from pairing every image with the triggers close to it in time order. The densest cluster
+/// of candidates is the offset. A single sorted merge then pairs each image with the nearest trigger within the
+/// tolerance. Dropped frames and dropped log entries only leave the affected items unmatched. Sorting dominates the
+/// cost, so matching is O(n log n).
+/// The images have to run from the first trigger or up to the last one, or cover the whole flight. A run of images
+/// from the middle of a flight with evenly spaced triggers can line up with the wrong triggers.
+/// Images are identified by the order they were added in. Not thread-safe.
+class GeoTagMatcher
+{
+public:
+    /// @param toleranceSecs Largest difference between an image and its trigger once the offset is applied. Exif
+    ///                      times only have a resolution of one second. It is capped at half the median trigger
+    ///                      interval so an image can't reach past the trigger nearest to it. Triggers closer together
+    ///                      than this can't be told apart by time at all, match fails on them and the caller has to
+    ///                      pair by sequence.
+    explicit GeoTagMatcher(double toleranceSecs = 1.0);
+
+    /// Sets the trigger times and clears all images and matches
+    void setTriggers(const QList<double>& triggerSecs);
+
+    /// Replaces the images and matches them, estimating the clock offset
+    ///     @param imageSecs Capture times, negative if unknown. Images without a time are never matched.
+    ///     @return false: Too few images could be matched to trust the offset, or the median trigger interval is
+    ///                    under the tolerance. There are no matches.
+    bool match(const QList<double>& imageSecs);
+
+    /// Adds images and matches them to the triggers which are still free, using the offset from match. Existing
+    /// matches are not changed.
+    ///     @return Index of the first added image
+    int addImages(const QList<double>& imageSecs);
+
+    bool    valid           (void) const { return _valid; }
+    double  offsetSecs      (void) const { return _offsetSecs; }    ///< Trigger time minus image time
+    int     imageCount      (void) const { return _imageSecs.count(); }
+    int     triggerCount    (void) const { return _triggerSecs.count(); }
+    int     matchCount      (void) const { return _matchCount; }
+
+    /// @return Trigger matched to the image, -1 if unmatched
+    int     trigger         (int image) const { return _imageTrigger[image]; }
+
+    /// @return Image matched to the trigger, -1 if unmatched
+    int     image           (int trigger) const { return _triggerImage[trigger]; }
+
+    QList<int> unmatchedImages  (void) const;
+    QList<int> unmatchedTriggers(void) const;
+
+private:
+    double      _estimateOffset (const QList<int>& images, const QList<int>& triggers, bool& found) const;
+    void        _merge          (const QList<int>& images, double offsetSecs);
+    void        _clearMatches   (void);
+    QList<int>  _sortedImages   (int firstImage) const;             ///< Images with a time, in time order
+    QList<int>  _sortedTriggers (bool freeOnly) const;
+    double      _medianInterval (const QList<int>& triggers) const; ///< Of the triggers in time order, 0 if fewer than 2
+
+    double          _toleranceSecs;
+    double          _matchToleranceSecs;    ///< _toleranceSecs capped for the current triggers
+    double          _offsetSecs     = 0;
+    bool            _valid          = false;
+    int             _matchCount     = 0;
+    QList<double>   _triggerSecs;
+    QList<double>   _imageSecs;
+    QList<int>      _imageTrigger;
+    QList<int>      _triggerImage;
+
+    /// Candidate offsets are taken from triggers this many places either side of the image's place in time order,
+    /// on top of the difference between the image and trigger counts
+    static constexpr int _candidateSlack = 8;
+    static constexpr int _maxCandidateWindow = 256;
+};
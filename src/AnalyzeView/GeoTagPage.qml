@@ -61,6 +61,13 @@ AnalyzePage {
                 Layout.alignment:   Qt.AlignHCenter
                 Layout.columnSpan:  2
             }
+            QGCLabel {
+                text:               qsTr("%1 images without a camera trigger, %2 camera triggers without an image").arg(geoController.unmatchedImages.length).arg(geoController.unmatchedTriggers)
+                visible:            geoController.unmatchedImages.length > 0 || geoController.unmatchedTriggers > 0
+                horizontalAlignment:Text.AlignHCenter
+                Layout.alignment:   Qt.AlignHCenter
+                Layout.columnSpan:  2
+            }
             //-----------------------------------------------------------------
             //-- Log File
             QGCButton {
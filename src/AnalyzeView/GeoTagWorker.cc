@@ -14,18 +14,43 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
 
 QGC_LOGGING_CATEGORY(GeoTagWorkerLog, "qgc.analyzeview.geotagworker")
 
+namespace {
+
+void _logThroughput(const char* stage, int images, qint64 bytes, qint64 msecs)
+{
+    const double secs = qMax<qint64>(msecs, 1) / 1000.0;
+    qCDebug(GeotaggingLog) << stage << images << "images" << bytes / (1024 * 1024) << "MB in" << msecs << "ms -"
+                           << images / secs << "images/s" << (bytes / (1024.0 * 1024.0)) / secs << "MB/s";
+}
+
+} // namespace
+
 GeoTagWorker::GeoTagWorker()
     : _cancel(false)
 {
 
 }
 
+bool GeoTagWorker::canResume() const
+{
+    return _matcher.valid() && !_parsedLogFile.isEmpty() && (_parsedLogFile == _logFile) &&
+            (_resumeImageDirectory == _imageDirectory) && (_resumeSaveDirectory == _saveDirectory);
+}
+
 void GeoTagWorker::run()
 {
     _cancel = false;
+    _resumeImageDirectory.clear();
+    _resumeSaveDirectory.clear();
     emit progressChanged(1);
     double nSteps = 5;
 
@@ -45,58 +70,28 @@ void GeoTagWorker::run()
     emit progressChanged((100/nSteps));
 
     // Parse EXIF
-    _imageTime.clear();
-    for (int i = 0; i < _imageList.size(); ++i) {
-        QFile file(_imageList.at(i).absoluteFilePath());
-        if (!file.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open an image."));
-            return;
-        }
-        QByteArray imageBuffer = file.readAll();
-        file.close();
-
-        _imageTime.append(ExifParser::readTime(imageBuffer));
-
-        emit progressChanged((100/nSteps) + ((100/nSteps) / _imageList.size())*i);
-
+    bool imagesChanged = false;
+    if (!_readImageTimes(100/nSteps, 100/nSteps, imagesChanged)) {
         if (_cancel) {
             qCDebug(GeotaggingLog) << "Tagging cancelled";
             emit error(tr("Tagging cancelled"));
-            return;
+        } else {
+            emit error(tr("Geotagging failed. Couldn't open an image."));
         }
-    }
-
-    // Load log
-    bool isULog = _logFile.endsWith(".ulg", Qt::CaseSensitive);
-    QFile file(_logFile);
-    if (!file.open(QIODevice::ReadOnly)) {
-        emit error(tr("Geotagging failed. Couldn't open log file."));
         return;
     }
-    QByteArray log = file.readAll();
-    file.close();
 
-    // Instantiate appropriate parser
-    _triggerList.clear();
-    bool parseComplete = false;
+    // Load log
+    bool triggersReused = false;
     QString errorString;
-    if (isULog) {
-        parseComplete = ULogParser::getTagsFromLog(log, _triggerList, errorString);
-    } else {
-        parseComplete = PX4LogParser::getTagsFromLog(log, _triggerList);
-    }
-
-    if (!parseComplete) {
+    if (!_loadTriggers(triggersReused, errorString)) {
         if (_cancel) {
             qCDebug(GeotaggingLog) << "Tagging cancelled";
             emit error(tr("Tagging cancelled"));
-            return;
         } else {
-            qCDebug(GeotaggingLog) << "Log parsing failed";
-            errorString = tr("%1 - tagging cancelled").arg(errorString.isEmpty() ? tr("Log parsing failed") : errorString);
             emit error(errorString);
-            return;
         }
+        return;
     }
     emit progressChanged(3*(100/nSteps));
 
@@ -109,7 +104,7 @@ void GeoTagWorker::run()
     }
 
     // Filter Trigger
-    if (!triggerFiltering()) {
+    if (!triggerFiltering(triggersReused && !imagesChanged)) {
         qCDebug(GeotaggingLog) << "Geotagging failed in trigger filtering";
         emit error(tr("Geotagging failed in trigger filtering"));
         return;
@@ -125,59 +120,328 @@ void GeoTagWorker::run()
     // Tag images
     auto maxIndex = std::min(_imageIndices.count(), _triggerIndices.count());
     maxIndex = std::min(maxIndex, _imageList.count());
-    for(int i = 0; i < maxIndex; i++) {
-        int imageIndex = _imageIndices[i];
-        if (imageIndex >= _imageList.count()) {
-            emit error(tr("Geotagging failed. Requesting image #%1, but only %2 images present.").arg(imageIndex).arg(_imageList.count()));
-            return;
+    QString errorMessage;
+    if (!_tagImages(maxIndex, 4*(100/nSteps), 100/nSteps, errorMessage)) {
+        if (errorMessage.isEmpty()) {
+            qCDebug(GeotaggingLog) << "Tagging cancelled";
+            emit error(tr("Tagging cancelled"));
+        } else {
+            emit error(errorMessage);
         }
-        QFile fileRead(_imageList.at(_imageIndices[i]).absoluteFilePath());
-        if (!fileRead.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open an image."));
-            return;
+        return;
+    }
+
+    if (_cancel) {
+        qCDebug(GeotaggingLog) << "Tagging cancelled";
+        emit error(tr("Tagging cancelled"));
+        return;
+    }
+
+    _resumeImageDirectory = _imageDirectory;
+    _resumeSaveDirectory = _saveDirectory;
+
+    emit progressChanged(100);
+}
+
+bool GeoTagWorker::_loadTriggers(bool& triggersReused, QString& errorString)
+{
+    triggersReused = false;
+
+    const QFileInfo logInfo(_logFile);
+    if ((_logFile == _parsedLogFile) && (logInfo.size() == _parsedLogSize) && (logInfo.lastModified() == _parsedLogModified)) {
+        qCDebug(GeotaggingLog) << "Log unchanged, reusing" << _triggerList.count() << "triggers";
+        triggersReused = true;
+        return true;
+    }
+
+    _parsedLogFile.clear();
+    for (ImageState_t& imageState: _imageStates) {
+        imageState.taggedTrigger = -1;
+    }
+
+    // ULogs can be GBs so they are streamed from the file
+    bool isULog = _logFile.endsWith(".ulg", Qt::CaseSensitive);
+    QFile file(_logFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorString = tr("Geotagging failed. Couldn't open log file.");
+        return false;
+    }
+
+    // Instantiate appropriate parser
+    _triggerList.clear();
+    bool parseComplete = false;
+    if (isULog) {
+        file.close();
+        parseComplete = ULogParser::getTagsFromLogFile(_logFile, _triggerList, errorString);
+    } else {
+        QByteArray log = file.readAll();
+        file.close();
+        parseComplete = PX4LogParser::getTagsFromLog(log, _triggerList);
+    }
+
+    if (!parseComplete) {
+        qCDebug(GeotaggingLog) << "Log parsing failed";
+        errorString = tr("%1 - tagging cancelled").arg(errorString.isEmpty() ? tr("Log parsing failed") : errorString);
+        return false;
+    }
+
+    _parsedLogFile = _logFile;
+    _parsedLogSize = logInfo.size();
+    _parsedLogModified = logInfo.lastModified();
+    return true;
+}
+
+void GeoTagWorker::_waitForPool(QThreadPool& pool, const std::atomic<int>& done, int total, double progressStart, double progressSpan)
+{
+    bool cleared = false;
+    while (!pool.waitForDone(100)) {
+        if (_cancel && !cleared) {
+            pool.clear();
+            cleared = true;
         }
-        QByteArray imageBuffer = fileRead.readAll();
-        fileRead.close();
+        emit progressChanged(progressStart + (progressSpan * done) / total);
+    }
+}
 
-        if (!ExifParser::write(imageBuffer, _triggerList[_triggerIndices[i]])) {
-            emit error(tr("Geotagging failed. Couldn't write to image."));
-            return;
+bool GeoTagWorker::_readImageTimes(double progressStart, double progressSpan, bool& imagesChanged)
+{
+    imagesChanged = false;
+
+    // Times from an earlier run are kept as long as the file is unchanged
+    _imageTime.fill(-1.0, _imageList.size());
+    QList<int> readIndices;
+    for (int i = 0; i < _imageList.size(); ++i) {
+        const QFileInfo& imageInfo = _imageList.at(i);
+        const auto it = _imageStates.constFind(imageInfo.absoluteFilePath());
+        if (it == _imageStates.constEnd()) {
+            readIndices.append(i);
+        } else if ((it->size != imageInfo.size()) || (it->lastModified != imageInfo.lastModified())) {
+            readIndices.append(i);
+            imagesChanged = true;
         } else {
-            QFile fileWrite;
-            if(_saveDirectory == "") {
-                fileWrite.setFileName(_imageDirectory + "/TAGGED/" + _imageList.at(_imageIndices[i]).fileName());
-            } else {
-                fileWrite.setFileName(_saveDirectory + "/" + _imageList.at(_imageIndices[i]).fileName());
+            _imageTime[i] = it->time;
+        }
+    }
+
+    // Only the segment headers and the Exif segment are read, never the image data
+    double* imageTime = _imageTime.data();
+
+    std::atomic<int>    imagesDone  = 0;
+    std::atomic<qint64> bytesRead   = 0;
+    std::atomic<bool>   openFailed  = false;
+
+    QElapsedTimer stageTimer;
+    stageTimer.start();
+
+    QThreadPool pool;
+    for (const int i: readIndices) {
+        const QString fileName = _imageList.at(i).absoluteFilePath();
+        pool.start([this, fileName, i, imageTime, &imagesDone, &bytesRead, &openFailed]() {
+            if (_cancel || openFailed) {
+                return;
             }
-            if (!fileWrite.open(QFile::WriteOnly)) {
-                emit error(tr("Geotagging failed. Couldn't write to an image."));
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qCWarning(GeotaggingLog) << "Could not open" << fileName << file.errorString();
+                openFailed = true;
                 return;
             }
-            fileWrite.write(imageBuffer);
-            fileWrite.close();
+            qint64 segmentOffset;
+            const QByteArray segment = ExifParser::readExifSegment(file, segmentOffset);
+            imageTime[i] = segment.isEmpty() ? -1.0 : ExifParser::readTimeFromSegment(segment);
+            bytesRead += file.pos();
+            imagesDone++;
+        });
+    }
+    _waitForPool(pool, imagesDone, qMax(readIndices.count(), 1), progressStart, progressSpan);
+
+    _logThroughput("Read image times:", imagesDone, bytesRead, stageTimer.elapsed());
+    qCDebug(GeotaggingLog) << "Image times reused:" << (_imageList.size() - readIndices.count());
+
+    if (openFailed || _cancel) {
+        return false;
+    }
+
+    for (const int i: readIndices) {
+        const QFileInfo& imageInfo = _imageList.at(i);
+        ImageState_t imageState;
+        imageState.lastModified = imageInfo.lastModified();
+        imageState.size = imageInfo.size();
+        imageState.time = _imageTime[i];
+        _imageStates.insert(imageInfo.absoluteFilePath(), imageState);
+    }
+
+    return true;
+}
+
+bool GeoTagWorker::_tagImages(int count, double progressStart, double progressSpan, QString& errorMessage)
+{
+    struct Job_t {
+        QString     source;
+        QString     destination;
+        qint64      size;
+        int         trigger;
+    };
+
+    // Everything the pool needs is resolved up front, the file list and trigger list are not touched from the pool
+    QList<Job_t> jobs;
+    jobs.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const int imageIndex = _imageIndices[i];
+        if (imageIndex >= _imageList.count()) {
+            errorMessage = tr("Geotagging failed. Requesting image #%1, but only %2 images present.").arg(imageIndex).arg(_imageList.count());
+            return false;
         }
-        emit progressChanged(4*(100/nSteps) + ((100/nSteps) / maxIndex)*i);
+        const QFileInfo& imageInfo = _imageList.at(imageIndex);
+        const QString destination = _saveDirectory.isEmpty() ?
+                    (_imageDirectory + "/TAGGED/" + imageInfo.fileName()) :
+                    (_saveDirectory + "/" + imageInfo.fileName());
 
-        if (_cancel) {
-            qCDebug(GeotaggingLog) << "Tagging cancelled";
-            emit error(tr("Tagging cancelled"));
-            return;
+        // Left alone if a previous run already tagged it with the same trigger
+        const ImageState_t& imageState = _imageStates[imageInfo.absoluteFilePath()];
+        if ((imageState.taggedTrigger == _triggerIndices[i]) && (imageState.taggedFile == destination) && QFile::exists(destination)) {
+            continue;
         }
+
+        jobs.append({ imageInfo.absoluteFilePath(), destination, imageInfo.size(), _triggerIndices[i] });
     }
+    qCDebug(GeotaggingLog) << "Already tagged:" << (count - jobs.count());
 
-    if (_cancel) {
-        qCDebug(GeotaggingLog) << "Tagging cancelled";
-        emit error(tr("Tagging cancelled"));
-        return;
+    // Written from the pool, one element per job
+    QList<char> jobTagged(jobs.count(), false);
+    char* tagged = jobTagged.data();
+
+    std::atomic<int>    imagesDone      = 0;
+    std::atomic<int>    inPlaceCount    = 0;
+    std::atomic<qint64> bytesTagged     = 0;
+    std::atomic<bool>   writeFailed     = false;
+    QMutex              errorMutex;
+
+    QElapsedTimer stageTimer;
+    stageTimer.start();
+
+    QThreadPool pool;
+    for (int jobIndex = 0; jobIndex < jobs.count(); jobIndex++) {
+        const Job_t& job = jobs[jobIndex];
+        const cameraFeedbackPacket trigger = _triggerList[job.trigger];
+        pool.start([this, job, jobIndex, tagged, trigger, &imagesDone, &inPlaceCount, &bytesTagged, &writeFailed, &errorMutex, &errorMessage]() {
+            if (_cancel || writeFailed) {
+                return;
+            }
+            const ExifParser::WriteMethod writeMethod = ExifParser::writeFile(job.source, job.destination, trigger);
+            if (writeMethod == ExifParser::WriteFailed) {
+                // The first failure is reported, the rest of the queue is dropped
+                QMutexLocker locker(&errorMutex);
+                if (errorMessage.isEmpty()) {
+                    errorMessage = tr("Geotagging failed. Couldn't write to image.");
+                }
+                writeFailed = true;
+                return;
+            }
+            if (writeMethod == ExifParser::WriteInPlace) {
+                inPlaceCount++;
+            }
+            tagged[jobIndex] = true;
+            bytesTagged += job.size;
+            imagesDone++;
+        });
     }
+    _waitForPool(pool, imagesDone, qMax(jobs.count(), 1), progressStart, progressSpan);
 
-    emit progressChanged(100);
+    for (int jobIndex = 0; jobIndex < jobs.count(); jobIndex++) {
+        if (jobTagged[jobIndex]) {
+            ImageState_t& imageState = _imageStates[jobs[jobIndex].source];
+            imageState.taggedTrigger = jobs[jobIndex].trigger;
+            imageState.taggedFile = jobs[jobIndex].destination;
+        }
+    }
+
+    _logThroughput("Tag images:", imagesDone, bytesTagged, stageTimer.elapsed());
+    qCDebug(GeotaggingLog) << "Exif patched in place:" << inPlaceCount << "streamed:" << (imagesDone - inPlaceCount);
+
+    return !writeFailed && !_cancel;
 }
 
-bool GeoTagWorker::triggerFiltering()
+bool GeoTagWorker::triggerFiltering(bool triggersReused)
 {
     _imageIndices.clear();
     _triggerIndices.clear();
+
+    QHash<QString, int> imageIndices;
+    imageIndices.reserve(_imageList.count());
+    for (int i = 0; i < _imageList.count(); i++) {
+        imageIndices.insert(_imageList.at(i).absoluteFilePath(), i);
+    }
+
+    // Continue the last match if the triggers and every image it matched are unchanged
+    bool resume = triggersReused && _matcher.valid() && (_matcher.triggerCount() == _triggerList.count());
+    for (int i = 0; resume && (i < _matcherImages.count()); i++) {
+        resume = imageIndices.contains(_matcherImages[i]);
+    }
+
+    if (resume) {
+        QSet<QString> matcherImages(_matcherImages.cbegin(), _matcherImages.cend());
+        QList<double> addedTimes;
+        for (int i = 0; i < _imageList.count(); i++) {
+            const QString imagePath = _imageList.at(i).absoluteFilePath();
+            if (!matcherImages.contains(imagePath)) {
+                _matcherImages.append(imagePath);
+                addedTimes.append(_imageTime[i]);
+            }
+        }
+        qCDebug(GeotaggingLog) << "Matching" << addedTimes.count() << "added images";
+        (void) _matcher.addImages(addedTimes);
+    } else {
+        // UTC is only used if every trigger has it, the clock offset takes care of either
+        bool haveUTC = true;
+        for (const cameraFeedbackPacket& trigger: _triggerList) {
+            haveUTC &= trigger.timestampUTC > 0;
+        }
+        QList<double> triggerSecs;
+        triggerSecs.reserve(_triggerList.count());
+        for (const cameraFeedbackPacket& trigger: _triggerList) {
+            triggerSecs.append(haveUTC ? trigger.timestampUTC : trigger.timestamp);
+        }
+
+        _matcherImages.clear();
+        for (const QFileInfo& imageInfo: _imageList) {
+            _matcherImages.append(imageInfo.absoluteFilePath());
+        }
+        _matcher.setTriggers(triggerSecs);
+        (void) _matcher.match(_imageTime);
+    }
+
+    if (!_matcher.valid()) {
+        qCDebug(GeotaggingLog) << "Image times don't line up with the triggers, matching by sequence number";
+        _sequenceFiltering();
+        emit matchingComplete(QStringList(), 0);
+        return true;
+    }
+
+    QStringList unmatchedImages;
+    for (int i = 0; i < _matcherImages.count(); i++) {
+        const int trigger = _matcher.trigger(i);
+        if (trigger >= 0) {
+            _imageIndices.append(imageIndices[_matcherImages[i]]);
+            _triggerIndices.append(trigger);
+        } else {
+            unmatchedImages.append(QFileInfo(_matcherImages[i]).fileName());
+        }
+    }
+    const int unmatchedTriggers = _matcher.unmatchedTriggers().count();
+
+    qCDebug(GeotaggingLog) << "Clock offset" << _matcher.offsetSecs() << "secs, matched" << _matcher.matchCount() << "images";
+    if (!unmatchedImages.isEmpty() || (unmatchedTriggers > 0)) {
+        qCWarning(GeotaggingLog) << "Images without a trigger:" << unmatchedImages.count() << unmatchedImages.mid(0, 20)
+                                 << "Triggers without an image:" << unmatchedTriggers;
+    }
+    emit matchingComplete(unmatchedImages, unmatchedTriggers);
+
+    return true;
+}
+
+void GeoTagWorker::_sequenceFiltering()
+{
     if(_imageList.count() > _triggerList.count()) {             // Logging dropouts
         qCDebug(GeotaggingLog) << "Detected missing feedback packets.";
     } else if (_imageList.count() < _triggerList.count()) {     // Camera skipped frames
@@ -187,5 +451,4 @@ bool GeoTagWorker::triggerFiltering()
         _imageIndices.append(static_cast<int>(_triggerList[i].imageSequence));
         _triggerIndices.append(i);
     }
-    return true;
 }
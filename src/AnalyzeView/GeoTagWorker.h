@@ -11,10 +11,19 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QThread>
+#include <QtCore/QDateTime>
 #include <QtCore/QFileInfoList>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 
+#include "GeoTagMatcher.h"
+
+#include <atomic>
+
+class QThreadPool;
+
 Q_DECLARE_LOGGING_CATEGORY(GeoTagWorkerLog)
 
 class GeoTagWorker : public QThread
@@ -34,6 +43,10 @@ public:
 
     void cancelTagging      () { _cancel = true; }
 
+    /// @return true: The next run continues the last one. Images it matched and tagged are kept, only images added
+    ///               to the directory since then are read, matched and tagged.
+    bool canResume          () const;
+
     struct cameraFeedbackPacket {
         double timestamp;
         double timestampUTC;
@@ -53,11 +66,28 @@ signals:
     void error              (QString errorMsg);
     void taggingComplete    ();
     void progressChanged    (double progress);
+    /// @param unmatchedImages File names of the images which could not be matched to a trigger
+    void matchingComplete   (QStringList unmatchedImages, int unmatchedTriggers);
 
 private:
-    bool triggerFiltering();
+    struct ImageState_t {
+        QDateTime   lastModified;
+        qint64      size;
+        double      time;                   ///< Exif capture time, -1 if unknown
+        int         taggedTrigger = -1;     ///< Trigger the image was last tagged with
+        QString     taggedFile;
+    };
+
+    bool triggerFiltering(bool triggersReused);
+    void _sequenceFiltering();
+    bool _loadTriggers(bool& triggersReused, QString& errorString);
+    bool _readImageTimes(double progressStart, double progressSpan, bool& imagesChanged);
+    bool _tagImages(int count, double progressStart, double progressSpan, QString& errorMessage);
 
-    bool                    _cancel;
+    /// Waits for the pool to finish while reporting progress. Queued work is dropped if tagging is cancelled.
+    void _waitForPool(QThreadPool& pool, const std::atomic<int>& done, int total, double progressStart, double progressSpan);
+
+    std::atomic<bool>       _cancel;
     QString                 _logFile;
     QString                 _imageDirectory;
     QString                 _saveDirectory;
@@ -66,4 +96,14 @@ private:
     QList<cameraFeedbackPacket> _triggerList;
     QList<int>              _imageIndices;
     QList<int>              _triggerIndices;
+
+    // Kept between runs so a run with only new images skips the work already done
+    QHash<QString, ImageState_t> _imageStates;      ///< By absolute file path
+    QString                 _parsedLogFile;
+    QDateTime               _parsedLogModified;
+    qint64                  _parsedLogSize = -1;
+    GeoTagMatcher           _matcher;
+    QStringList             _matcherImages;         ///< Absolute file paths in the order they were given to _matcher
+    QString                 _resumeImageDirectory;
+    QString                 _resumeSaveDirectory;
 };
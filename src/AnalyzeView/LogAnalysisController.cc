@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LogAnalysisController.h"
+#include "LogAnalysisIndex.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCharts/QXYSeries>
+#include <QtCore/QThread>
+#include <QtCore/QUrl>
+
+QGC_LOGGING_CATEGORY(LogAnalysisControllerLog, "qgc.analyzeview.loganalysiscontroller")
+
+LogAnalysisController::LogAnalysisController(QObject* parent)
+    : QObject(parent)
+{
+
+}
+
+LogAnalysisController::~LogAnalysisController()
+{
+    if (_indexThread) {
+        _indexThread->wait();
+    }
+}
+
+void LogAnalysisController::openLog(const QString& logFile)
+{
+    if (_indexThread) {
+        qCWarning(LogAnalysisControllerLog) << "Already indexing" << _pendingLogFile;
+        return;
+    }
+
+    const QUrl url(logFile);
+    _pendingLogFile = url.isLocalFile() ? url.toLocalFile() : logFile;
+    _pendingIndex = std::make_unique<LogAnalysisIndex>();
+    _pendingError.clear();
+
+    _indexThread = QThread::create([this]() {
+        (void) _pendingIndex->open(_pendingLogFile, _pendingError);
+    });
+    _indexThread->setObjectName(QStringLiteral("LogAnalysisIndex"));
+    (void) connect(_indexThread, &QThread::finished, this, &LogAnalysisController::_indexFinished);
+    (void) connect(_indexThread, &QThread::finished, _indexThread, &QObject::deleteLater);
+    _indexThread->start(QThread::LowPriority);
+    emit busyChanged();
+}
+
+void LogAnalysisController::_indexFinished(void)
+{
+    _indexThread = nullptr;
+
+    if (_pendingError.isEmpty()) {
+        _index = std::move(_pendingIndex);
+        _logFile = _pendingLogFile;
+        _messageNames.clear();
+        for (int i = 0; i < _index->messageCount(); i++) {
+            _messageNames.append(_index->messageName(i));
+        }
+        _messageNames.sort();
+        emit logFileChanged();
+    } else {
+        qCWarning(LogAnalysisControllerLog) << "Unable to index" << _pendingLogFile << _pendingError;
+        _pendingIndex.reset();
+    }
+
+    if (_errorMessage != _pendingError) {
+        _errorMessage = _pendingError;
+        emit errorMessageChanged();
+    }
+    emit busyChanged();
+}
+
+qreal LogAnalysisController::durationSecs(void) const
+{
+    return _index ? (_index->endUSecs() - _index->startUSecs()) / 1e6 : 0;
+}
+
+qint64 LogAnalysisController::_usecs(qreal secs) const
+{
+    return _index->startUSecs() + static_cast<qint64>(secs * 1e6);
+}
+
+bool LogAnalysisController::_lookup(const QString& messageName, const QString& fieldName, int& messageIndex, int& fieldIndex) const
+{
+    if (!_index) {
+        return false;
+    }
+    messageIndex = _index->messageIndex(messageName);
+    if (messageIndex < 0) {
+        return false;
+    }
+    fieldIndex = _index->fieldIndex(messageIndex, fieldName);
+    return fieldIndex >= 0;
+}
+
+QStringList LogAnalysisController::fieldNames(const QString& messageName) const
+{
+    QStringList names;
+    const int messageIndex = _index ? _index->messageIndex(messageName) : -1;
+    if (messageIndex >= 0) {
+        for (int i = 0; i < _index->fieldCount(messageIndex); i++) {
+            names.append(_index->fieldName(messageIndex, i));
+        }
+    }
+    return names;
+}
+
+bool LogAnalysisController::updateSeries(QAbstractSeries* series, const QString& messageName, const QString& fieldName, qreal startSecs, qreal endSecs, int pixelWidth)
+{
+    QXYSeries* xySeries = qobject_cast<QXYSeries*>(series);
+    int messageIndex;
+    int fieldIndex;
+    if (!xySeries || !_lookup(messageName, fieldName, messageIndex, fieldIndex)) {
+        return false;
+    }
+
+    _index->points(messageIndex, fieldIndex, _usecs(startSecs), _usecs(endSecs), pixelWidth, _points);
+    for (QPointF& point: _points) {
+        point.setX((point.x() - _index->startUSecs()) / 1e6);
+    }
+    xySeries->replace(_points);
+    return true;
+}
+
+QVariantMap LogAnalysisController::statistics(const QString& messageName, const QString& fieldName, qreal startSecs, qreal endSecs) const
+{
+    QVariantMap map;
+    int messageIndex;
+    int fieldIndex;
+    if (!_lookup(messageName, fieldName, messageIndex, fieldIndex)) {
+        return map;
+    }
+
+    const LogAnalysisIndex::Statistics_t statistics = _index->statistics(messageIndex, fieldIndex, _usecs(startSecs), _usecs(endSecs));
+    map[QStringLiteral("count")]    = statistics.count;
+    map[QStringLiteral("min")]      = statistics.min;
+    map[QStringLiteral("max")]      = statistics.max;
+    map[QStringLiteral("mean")]     = statistics.mean;
+    map[QStringLiteral("stdDev")]   = statistics.stdDev;
+    return map;
+}
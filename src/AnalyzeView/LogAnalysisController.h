@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QPointF>
+#include <QtCore/QStringList>
+#include <QtCore/QVariantMap>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+#include <memory>
+
+Q_DECLARE_LOGGING_CATEGORY(LogAnalysisControllerLog)
+
+class LogAnalysisIndex;
+class QAbstractSeries;
+class QThread;
+
+/// Serves series and statistics from a tlog or ULog to charts for post flight analysis. The log is indexed once on a
+/// worker thread, after which every query runs on the gui thread against the index. Times are in seconds from the
+/// start of the log.
+class LogAnalysisController : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_MOC_INCLUDE(<QtCharts/qabstractseries.h>)
+
+public:
+    LogAnalysisController(QObject* parent = nullptr);
+    ~LogAnalysisController();
+
+    Q_PROPERTY(QString      logFile         READ logFile        NOTIFY logFileChanged)
+    Q_PROPERTY(bool         busy            READ busy           NOTIFY busyChanged)
+    Q_PROPERTY(QString      errorMessage    READ errorMessage   NOTIFY errorMessageChanged)
+    Q_PROPERTY(QStringList  messageNames    READ messageNames   NOTIFY logFileChanged)
+    Q_PROPERTY(qreal        durationSecs    READ durationSecs   NOTIFY logFileChanged)
+
+    /// Starts indexing the log, replacing the current one when done
+    Q_INVOKABLE void        openLog         (const QString& logFile);
+    Q_INVOKABLE QStringList fieldNames      (const QString& messageName) const;
+
+    /// Replaces the points of a line series with the field over [startSecs, endSecs], decimated to pixelWidth
+    ///     @return false: unknown message or field
+    Q_INVOKABLE bool        updateSeries    (QAbstractSeries* series, const QString& messageName, const QString& fieldName, qreal startSecs, qreal endSecs, int pixelWidth);
+
+    /// @return count, min, max, mean and stdDev of the field over [startSecs, endSecs], empty for an unknown field
+    Q_INVOKABLE QVariantMap statistics      (const QString& messageName, const QString& fieldName, qreal startSecs, qreal endSecs) const;
+
+    QString     logFile         (void) const { return _logFile; }
+    bool        busy            (void) const { return _indexThread != nullptr; }
+    QString     errorMessage    (void) const { return _errorMessage; }
+    QStringList messageNames    (void) const { return _messageNames; }
+    qreal       durationSecs    (void) const;
+
+signals:
+    void logFileChanged         (void);
+    void busyChanged            (void);
+    void errorMessageChanged    (void);
+
+private slots:
+    void _indexFinished         (void);
+
+private:
+    bool _lookup                (const QString& messageName, const QString& fieldName, int& messageIndex, int& fieldIndex) const;
+    qint64 _usecs               (qreal secs) const;
+
+    std::unique_ptr<LogAnalysisIndex>   _index;
+    std::unique_ptr<LogAnalysisIndex>   _pendingIndex;      ///< Being built by _indexThread
+    QThread*                            _indexThread    = nullptr;
+    QString                             _pendingLogFile;
+    QString                             _pendingError;
+    QString                             _logFile;
+    QString                             _errorMessage;
+    QStringList                         _messageNames;
+    QList<QPointF>                      _points;            ///< Reused for every series update
+};
@@ -0,0 +1,623 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LogAnalysisIndex.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QStringList>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+QGC_LOGGING_CATEGORY(LogAnalysisIndexLog, "qgc.analyzeview.loganalysisindex")
+
+namespace {
+
+template<typename T>
+double _read(const uchar* data)
+{
+    T v;
+    memcpy(&v, data, sizeof(T));
+    return static_cast<double>(v);
+}
+
+constexpr char _ulogMagic[] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35 };
+constexpr int _ulogHeaderSize = 16;
+constexpr int _ulogMessageHeaderSize = 3;
+constexpr int _ulogMaxNesting = 8;
+
+QString _mavlinkTypeName(mavlink_message_type_t type)
+{
+    switch (type) {
+    case MAVLINK_TYPE_UINT8_T:  return QStringLiteral("uint8_t");
+    case MAVLINK_TYPE_INT8_T:   return QStringLiteral("int8_t");
+    case MAVLINK_TYPE_UINT16_T: return QStringLiteral("uint16_t");
+    case MAVLINK_TYPE_INT16_T:  return QStringLiteral("int16_t");
+    case MAVLINK_TYPE_UINT32_T: return QStringLiteral("uint32_t");
+    case MAVLINK_TYPE_INT32_T:  return QStringLiteral("int32_t");
+    case MAVLINK_TYPE_UINT64_T: return QStringLiteral("uint64_t");
+    case MAVLINK_TYPE_INT64_T:  return QStringLiteral("int64_t");
+    case MAVLINK_TYPE_FLOAT:    return QStringLiteral("float");
+    case MAVLINK_TYPE_DOUBLE:   return QStringLiteral("double");
+    default:                    return QStringLiteral("char");
+    }
+}
+
+constexpr int _tlogTimestampSize = 8;
+constexpr int _mavlinkV1HeaderSize = 6;
+constexpr int _mavlinkV2HeaderSize = 10;
+
+} // namespace
+
+bool LogAnalysisIndex::open(const QString& fileName, QString& errorMessage)
+{
+    errorMessage.clear();
+
+    _file.setFileName(fileName);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        errorMessage = QStringLiteral("Unable to open %1: %2").arg(fileName, _file.errorString());
+        return false;
+    }
+
+    _size = _file.size();
+    _data = _file.map(0, _size);
+    if (!_data) {
+        // Compressed resources and some file systems can't be mapped
+        qCDebug(LogAnalysisIndexLog) << "Unable to map" << fileName << _file.errorString() << "- reading instead";
+        _buffer = _file.readAll();
+        _data = reinterpret_cast<const uchar*>(_buffer.constData());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool success;
+    if ((_size >= _ulogHeaderSize) && (memcmp(_data, _ulogMagic, sizeof(_ulogMagic)) == 0)) {
+        _logType = LogTypeULog;
+        success = _indexULog(errorMessage);
+    } else {
+        _logType = LogTypeTLog;
+        success = _indexTLog(errorMessage);
+    }
+    if (!success) {
+        _logType = LogTypeUnknown;
+        return false;
+    }
+
+    _finishIndex();
+
+    qCDebug(LogAnalysisIndexLog) << "Indexed" << fileName << "bytes:" << _size << "messages:" << _messages.count() << "msecs:" << timer.elapsed();
+    return true;
+}
+
+int LogAnalysisIndex::_addMessage(const QString& name)
+{
+    Message_t message;
+    message.name = name;
+    _messages.append(message);
+    _messageIndices[name] = _messages.count() - 1;
+    return _messages.count() - 1;
+}
+
+bool LogAnalysisIndex::_indexTLog(QString& errorMessage)
+{
+    // Each record is a big endian usecs timestamp followed by the MAVLink frame as it came off the link
+    QHash<quint64, int> sourceMessages;     ///< (msgid, sysid, compid) to message index
+    qint64 pos = 0;
+    qint64 skippedBytes = 0;
+
+    while (pos + _tlogTimestampSize + _mavlinkV1HeaderSize + MAVLINK_NUM_CHECKSUM_BYTES <= _size) {
+        const uchar* record = _data + pos;
+        const uchar* frame = record + _tlogTimestampSize;
+        const qint64 available = _size - pos - _tlogTimestampSize;
+
+        int headerSize;
+        uint32_t msgId;
+        uint8_t sysId;
+        uint8_t compId;
+        qsizetype frameSize;
+        if (frame[0] == MAVLINK_STX) {
+            headerSize = _mavlinkV2HeaderSize;
+            if (available < headerSize) {
+                break;
+            }
+            sysId = frame[5];
+            compId = frame[6];
+            msgId = frame[7] | (frame[8] << 8) | (frame[9] << 16);
+            frameSize = headerSize + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES + ((frame[2] & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+        } else if (frame[0] == MAVLINK_STX_MAVLINK1) {
+            headerSize = _mavlinkV1HeaderSize;
+            sysId = frame[3];
+            compId = frame[4];
+            msgId = frame[5];
+            frameSize = headerSize + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+        } else {
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+        if (frameSize > available) {
+            // Partial frame at the end of a log which wasn't closed cleanly, or garbage
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+
+        const uint8_t payloadLength = frame[1];
+        const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(msgId);
+        const mavlink_message_info_t* msgInfo = mavlink_get_message_info_by_id(msgId);
+        if (!entry || !msgInfo) {
+            // Unknown to this dialect so the crc can't be checked. Skip it if the next record looks like it starts
+            // where this one says it ends.
+            const qint64 next = pos + _tlogTimestampSize + frameSize;
+            const bool nextFrame = (next == _size) || ((next + _tlogTimestampSize < _size) &&
+                                                       ((_data[next + _tlogTimestampSize] == MAVLINK_STX) || (_data[next + _tlogTimestampSize] == MAVLINK_STX_MAVLINK1)));
+            if (nextFrame) {
+                pos = next;
+            } else {
+                pos++;
+                skippedBytes++;
+            }
+            continue;
+        }
+
+        uint16_t crc = crc_calculate(frame + 1, static_cast<uint16_t>(headerSize - 1 + payloadLength));
+        crc_accumulate(entry->crc_extra, &crc);
+        const uchar* crcBytes = frame + headerSize + payloadLength;
+        if (crc != (crcBytes[0] | (crcBytes[1] << 8))) {
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+
+        const quint64 sourceKey = (static_cast<quint64>(msgId) << 16) | (sysId << 8) | compId;
+        int messageIndex = sourceMessages.value(sourceKey, -1);
+        if (messageIndex == -1) {
+            messageIndex = _addMessage(QStringLiteral("%1 (%2:%3)").arg(msgInfo->name).arg(sysId).arg(compId));
+            sourceMessages[sourceKey] = messageIndex;
+
+            Message_t& message = _messages[messageIndex];
+            for (unsigned int i = 0; i < msgInfo->num_fields; i++) {
+                const mavlink_field_info_t& fieldInfo = msgInfo->fields[i];
+                int size = 0;
+                const ReadFn readFn = _readFn(_mavlinkTypeName(fieldInfo.type), size);
+                if (!readFn) {
+                    continue;
+                }
+                if (fieldInfo.array_length == 0) {
+                    message.fields.append({ QString::fromLatin1(fieldInfo.name), readFn, static_cast<quint16>(fieldInfo.wire_offset), static_cast<quint8>(size) });
+                } else {
+                    for (unsigned int j = 0; j < fieldInfo.array_length; j++) {
+                        message.fields.append({ QStringLiteral("%1[%2]").arg(fieldInfo.name).arg(j), readFn, static_cast<quint16>(fieldInfo.wire_offset + (j * size)), static_cast<quint8>(size) });
+                    }
+                }
+            }
+        }
+
+        Message_t& message = _messages[messageIndex];
+        message.timestamps.append(static_cast<qint64>(qFromBigEndian<quint64>(record)));
+        message.offsets.append(pos + _tlogTimestampSize + headerSize);
+        message.lengths.append(payloadLength);
+
+        pos += _tlogTimestampSize + frameSize;
+    }
+
+    if (skippedBytes) {
+        qCDebug(LogAnalysisIndexLog) << "Skipped bytes which were not valid MAVLink:" << skippedBytes;
+    }
+    if (_messages.isEmpty()) {
+        errorMessage = QStringLiteral("No MAVLink messages found in log");
+        return false;
+    }
+    return true;
+}
+
+bool LogAnalysisIndex::_indexULog(QString& errorMessage)
+{
+    QHash<QString, ULogFormat_t> formats;
+    QHash<quint16, int> subscriptions;      ///< ULog msg_id to message index
+    QHash<int, int> timestampOffsets;       ///< Message index to offset of its timestamp field
+    qint64 pos = _ulogHeaderSize;
+
+    while (pos + _ulogMessageHeaderSize <= _size) {
+        const quint16 msgSize = qFromLittleEndian<quint16>(_data + pos);
+        const char msgType = static_cast<char>(_data[pos + 2]);
+        const qint64 payloadPos = pos + _ulogMessageHeaderSize;
+        if (payloadPos + msgSize > _size) {
+            qCDebug(LogAnalysisIndexLog) << "ULog truncated at" << pos;
+            break;
+        }
+        const uchar* payload = _data + payloadPos;
+
+        switch (msgType) {
+        case 'F': {
+            // "name:type field;type field;..."
+            const QString format = QString::fromLatin1(reinterpret_cast<const char*>(payload), msgSize);
+            const qsizetype colon = format.indexOf(':');
+            if (colon > 0) {
+                ULogFormat_t ulogFormat;
+                const QStringList fieldDefs = format.mid(colon + 1).split(';', Qt::SkipEmptyParts);
+                for (const QString& fieldDef: fieldDefs) {
+                    const qsizetype space = fieldDef.indexOf(' ');
+                    if (space > 0) {
+                        ulogFormat.fields.append({ fieldDef.left(space), fieldDef.mid(space + 1) });
+                    }
+                }
+                formats[format.left(colon)] = ulogFormat;
+            }
+            break;
+        }
+        case 'A': {
+            if (msgSize < 3) {
+                break;
+            }
+            const quint8 multiId = payload[0];
+            const quint16 msgId = qFromLittleEndian<quint16>(payload + 1);
+            const QString formatName = QString::fromLatin1(reinterpret_cast<const char*>(payload + 3), msgSize - 3);
+            QList<Field_t> fields;
+            if (_flattenULogFormat(formats, formatName, QString(), 0, 0, fields) < 0) {
+                qCDebug(LogAnalysisIndexLog) << "Unable to resolve ULog format" << formatName;
+                break;
+            }
+            const auto timestampField = std::find_if(fields.cbegin(), fields.cend(), [](const Field_t& field) {
+                return field.name == QStringLiteral("timestamp") && field.size == sizeof(quint64);
+            });
+            if (timestampField == fields.cend()) {
+                qCDebug(LogAnalysisIndexLog) << "ULog format without timestamp" << formatName;
+                break;
+            }
+            const QString name = multiId ? QStringLiteral("%1_%2").arg(formatName).arg(multiId) : formatName;
+            if (_messageIndices.contains(name)) {
+                // Resubscribed under a new msg_id, keep appending to the same series
+                subscriptions[msgId] = _messageIndices[name];
+                break;
+            }
+            const int messageIndex = _addMessage(name);
+            timestampOffsets[messageIndex] = timestampField->offset;
+            _messages[messageIndex].fields = fields;
+            subscriptions[msgId] = messageIndex;
+            break;
+        }
+        case 'D': {
+            if (msgSize < 2) {
+                break;
+            }
+            const int messageIndex = subscriptions.value(qFromLittleEndian<quint16>(payload), -1);
+            if (messageIndex == -1) {
+                break;
+            }
+            const quint16 dataSize = msgSize - 2;
+            const int timestampOffset = timestampOffsets[messageIndex];
+            if (timestampOffset + static_cast<int>(sizeof(quint64)) > dataSize) {
+                break;
+            }
+            Message_t& message = _messages[messageIndex];
+            message.timestamps.append(static_cast<qint64>(qFromLittleEndian<quint64>(payload + 2 + timestampOffset)));
+            message.offsets.append(payloadPos + 2);
+            message.lengths.append(dataSize);
+            break;
+        }
+        default:
+            // Definitions and logged strings which aren't charted
+            break;
+        }
+
+        pos = payloadPos + msgSize;
+    }
+
+    if (_messages.isEmpty()) {
+        errorMessage = QStringLiteral("No logged topics found in ULog");
+        return false;
+    }
+    return true;
+}
+
+int LogAnalysisIndex::_flattenULogFormat(const QHash<QString, ULogFormat_t>& formats, const QString& formatName, const QString& prefix, int offset, int depth, QList<Field_t>& fields) const
+{
+    const auto format = formats.constFind(formatName);
+    if ((format == formats.cend()) || (depth > _ulogMaxNesting)) {
+        return -1;
+    }
+
+    const int startOffset = offset;
+    for (const QPair<QString, QString>& fieldDef: format->fields) {
+        QString type = fieldDef.first;
+        int arrayLength = 0;
+        const qsizetype bracket = type.indexOf('[');
+        if (bracket > 0) {
+            arrayLength = type.mid(bracket + 1, type.length() - bracket - 2).toInt();
+            type = type.left(bracket);
+        }
+
+        const bool padding = fieldDef.second.startsWith(QStringLiteral("_padding"));
+        const int elements = arrayLength ? arrayLength : 1;
+        for (int i = 0; i < elements; i++) {
+            const QString name = prefix + (arrayLength ? QStringLiteral("%1[%2]").arg(fieldDef.second).arg(i) : fieldDef.second);
+            int size = 0;
+            const ReadFn readFn = _readFn(type, size);
+            if (size == 0) {
+                // Nested type
+                QList<Field_t> nestedFields;
+                size = _flattenULogFormat(formats, type, name + '.', offset, depth + 1, nestedFields);
+                if (size < 0) {
+                    return -1;
+                }
+                if (!padding) {
+                    fields.append(nestedFields);
+                }
+            } else if (readFn && !padding) {
+                fields.append({ name, readFn, static_cast<quint16>(offset), static_cast<quint8>(size) });
+            }
+            offset += size;
+        }
+    }
+    return offset - startOffset;
+}
+
+LogAnalysisIndex::ReadFn LogAnalysisIndex::_readFn(const QString& type, int& size)
+{
+    // char is sized but has no read function since text is not charted
+    static const QHash<QString, QPair<ReadFn, int>> rgTypes = {
+        { QStringLiteral("int8_t"),     { _read<qint8>,   1 } },
+        { QStringLiteral("uint8_t"),    { _read<quint8>,  1 } },
+        { QStringLiteral("bool"),       { _read<quint8>,  1 } },
+        { QStringLiteral("char"),       { nullptr,        1 } },
+        { QStringLiteral("int16_t"),    { _read<qint16>,  2 } },
+        { QStringLiteral("uint16_t"),   { _read<quint16>, 2 } },
+        { QStringLiteral("int32_t"),    { _read<qint32>,  4 } },
+        { QStringLiteral("uint32_t"),   { _read<quint32>, 4 } },
+        { QStringLiteral("int64_t"),    { _read<qint64>,  8 } },
+        { QStringLiteral("uint64_t"),   { _read<quint64>, 8 } },
+        { QStringLiteral("float"),      { _read<float>,   4 } },
+        { QStringLiteral("double"),     { _read<double>,  8 } },
+    };
+
+    const auto it = rgTypes.constFind(type);
+    if (it == rgTypes.cend()) {
+        size = 0;
+        return nullptr;
+    }
+    size = it->second;
+    return it->first;
+}
+
+void LogAnalysisIndex::_finishIndex(void)
+{
+    bool first = true;
+    for (Message_t& message: _messages) {
+        message.columns.resize(message.fields.count());
+
+        // Timestamps from a source are almost always in order, but a reboot or a clock jump mid log can break that
+        if (!std::is_sorted(message.timestamps.cbegin(), message.timestamps.cend())) {
+            qCDebug(LogAnalysisIndexLog) << "Sorting out of order samples" << message.name;
+            QList<qsizetype> order(message.timestamps.count());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&message](qsizetype a, qsizetype b) {
+                return message.timestamps[a] < message.timestamps[b];
+            });
+            QList<qint64> timestamps(order.count());
+            QList<qint64> offsets(order.count());
+            QList<quint16> lengths(order.count());
+            for (qsizetype i = 0; i < order.count(); i++) {
+                timestamps[i] = message.timestamps[order[i]];
+                offsets[i] = message.offsets[order[i]];
+                lengths[i] = message.lengths[order[i]];
+            }
+            message.timestamps.swap(timestamps);
+            message.offsets.swap(offsets);
+            message.lengths.swap(lengths);
+        }
+
+        if (!message.timestamps.isEmpty()) {
+            if (first) {
+                _startUSecs = message.timestamps.constFirst();
+                _endUSecs = message.timestamps.constLast();
+                first = false;
+            } else {
+                _startUSecs = qMin(_startUSecs, message.timestamps.constFirst());
+                _endUSecs = qMax(_endUSecs, message.timestamps.constLast());
+            }
+        }
+    }
+}
+
+int LogAnalysisIndex::fieldIndex(int messageIndex, const QString& name) const
+{
+    const QList<Field_t>& fields = _messages[messageIndex].fields;
+    for (int i = 0; i < fields.count(); i++) {
+        if (fields[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const LogAnalysisIndex::Column_t& LogAnalysisIndex::_column(int messageIndex, int fieldIndex)
+{
+    Message_t& message = _messages[messageIndex];
+    Column_t& column = message.columns[fieldIndex];
+    const qsizetype count = message.timestamps.count();
+    if (column.values.count() == count) {
+        return column;
+    }
+
+    const Field_t& field = message.fields[fieldIndex];
+    column.values.resize(count);
+    for (qsizetype i = 0; i < count; i++) {
+        // Trailing zeros truncated off a MAVLink 2 payload decode as zero
+        column.values[i] = (field.offset + field.size <= message.lengths[i]) ? field.readFn(_data + message.offsets[i] + field.offset) : 0;
+    }
+
+    column.blocks.resize((count + _blockSize - 1) / _blockSize);
+    for (qsizetype block = 0; block < column.blocks.count(); block++) {
+        Block_t& summary = column.blocks[block];
+        summary = { qQNaN(), qQNaN(), 0, 0, 0, -1, -1 };
+        const qsizetype last = qMin(count, (block + 1) * _blockSize);
+        for (qsizetype i = block * _blockSize; i < last; i++) {
+            const double value = column.values[i];
+            if (qIsNaN(value)) {
+                continue;
+            }
+            if ((summary.minSample == -1) || (value < summary.min)) {
+                summary.min = value;
+                summary.minSample = i;
+            }
+            if ((summary.maxSample == -1) || (value > summary.max)) {
+                summary.max = value;
+                summary.maxSample = i;
+            }
+            summary.sum += value;
+            summary.sumSquares += value * value;
+            summary.count++;
+        }
+    }
+
+    qCDebug(LogAnalysisIndexLog) << "Built column" << message.name << field.name << "samples:" << count;
+    return column;
+}
+
+LogAnalysisIndex::Block_t LogAnalysisIndex::_summary(const Column_t& column, qsizetype first, qsizetype last) const
+{
+    Block_t summary = { qQNaN(), qQNaN(), 0, 0, 0, -1, -1 };
+
+    const auto addSample = [&summary, &column](qsizetype i) {
+        const double value = column.values[i];
+        if (qIsNaN(value)) {
+            return;
+        }
+        if ((summary.minSample == -1) || (value < summary.min)) {
+            summary.min = value;
+            summary.minSample = i;
+        }
+        if ((summary.maxSample == -1) || (value > summary.max)) {
+            summary.max = value;
+            summary.maxSample = i;
+        }
+        summary.sum += value;
+        summary.sumSquares += value * value;
+        summary.count++;
+    };
+
+    // Partial blocks at either end are scanned, whole blocks in between come from their summaries
+    qsizetype i = first;
+    while ((i < last) && (i % _blockSize)) {
+        addSample(i++);
+    }
+    while (i + _blockSize <= last) {
+        const Block_t& block = column.blocks[i / _blockSize];
+        if (block.count) {
+            if ((summary.minSample == -1) || (block.min < summary.min)) {
+                summary.min = block.min;
+                summary.minSample = block.minSample;
+            }
+            if ((summary.maxSample == -1) || (block.max > summary.max)) {
+                summary.max = block.max;
+                summary.maxSample = block.maxSample;
+            }
+            summary.sum += block.sum;
+            summary.sumSquares += block.sumSquares;
+            summary.count += block.count;
+        }
+        i += _blockSize;
+    }
+    while (i < last) {
+        addSample(i++);
+    }
+
+    return summary;
+}
+
+double LogAnalysisIndex::value(int messageIndex, int fieldIndex, qsizetype sample)
+{
+    return _column(messageIndex, fieldIndex).values[sample];
+}
+
+QPair<qsizetype, qsizetype> LogAnalysisIndex::range(int messageIndex, qint64 startUSecs, qint64 endUSecs) const
+{
+    const QList<qint64>& timestamps = _messages[messageIndex].timestamps;
+    const auto first = std::lower_bound(timestamps.cbegin(), timestamps.cend(), startUSecs);
+    const auto last = std::upper_bound(first, timestamps.cend(), endUSecs);
+    return { first - timestamps.cbegin(), last - timestamps.cbegin() };
+}
+
+void LogAnalysisIndex::points(int messageIndex, int fieldIndex, qint64 startUSecs, qint64 endUSecs, int pixelWidth, QList<QPointF>& points)
+{
+    points.clear();
+    if ((endUSecs <= startUSecs) || (pixelWidth <= 0)) {
+        return;
+    }
+
+    const Column_t& column = _column(messageIndex, fieldIndex);
+    const QList<qint64>& timestamps = _messages[messageIndex].timestamps;
+    const QPair<qsizetype, qsizetype> samples = range(messageIndex, startUSecs, endUSecs);
+    const qsizetype first = qMax<qsizetype>(0, samples.first - 1);
+    const qsizetype last = qMin(timestamps.count(), samples.second + 1);
+
+    const auto addPoint = [&points, &column, &timestamps](qsizetype i) {
+        if (!qIsNaN(column.values[i])) {
+            points.append(QPointF(static_cast<qreal>(timestamps[i]), column.values[i]));
+        }
+    };
+
+    if ((last - first) <= (2 * pixelWidth)) {
+        points.reserve(last - first);
+        for (qsizetype i = first; i < last; i++) {
+            addPoint(i);
+        }
+        return;
+    }
+
+    points.reserve((2 * pixelWidth) + 2);
+    if (first < samples.first) {
+        addPoint(first);
+    }
+    qsizetype columnFirst = samples.first;
+    const double usecsPerPixel = static_cast<double>(endUSecs - startUSecs) / pixelWidth;
+    for (int pixel = 0; (pixel < pixelWidth) && (columnFirst < samples.second); pixel++) {
+        const qint64 columnEndUSecs = (pixel == pixelWidth - 1) ? endUSecs : startUSecs + static_cast<qint64>((pixel + 1) * usecsPerPixel);
+        const qsizetype columnLast = std::upper_bound(timestamps.cbegin() + columnFirst, timestamps.cbegin() + samples.second, columnEndUSecs) - timestamps.cbegin();
+        if (columnLast > columnFirst) {
+            const Block_t summary = _summary(column, columnFirst, columnLast);
+            if (summary.count) {
+                addPoint(qMin(summary.minSample, summary.maxSample));
+                if (summary.minSample != summary.maxSample) {
+                    addPoint(qMax(summary.minSample, summary.maxSample));
+                }
+            }
+        }
+        columnFirst = columnLast;
+    }
+    if (last > samples.second) {
+        addPoint(last - 1);
+    }
+}
+
+LogAnalysisIndex::Statistics_t LogAnalysisIndex::statistics(int messageIndex, int fieldIndex, qint64 startUSecs, qint64 endUSecs)
+{
+    Statistics_t statistics;
+
+    const Column_t& column = _column(messageIndex, fieldIndex);
+    const QPair<qsizetype, qsizetype> samples = range(messageIndex, startUSecs, endUSecs);
+    const Block_t summary = _summary(column, samples.first, samples.second);
+    if (summary.count == 0) {
+        return statistics;
+    }
+
+    statistics.count = summary.count;
+    statistics.min = summary.min;
+    statistics.max = summary.max;
+    statistics.mean = summary.sum / summary.count;
+    statistics.stdDev = std::sqrt(qMax(0.0, (summary.sumSquares / summary.count) - (statistics.mean * statistics.mean)));
+    return statistics;
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QPair>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QtNumeric>
+
+Q_DECLARE_LOGGING_CATEGORY(LogAnalysisIndexLog)
+
+/// Offline index over a telemetry log (.tlog) or a PX4 ULog. The file is memory mapped and walked once. That pass
+/// records where each message is and its timestamp, grouped by message type, without decoding any fields.
+/// The first time a field is queried, its values are decoded from the mapping into a column. Per block summaries are
+/// built at the same time, so range queries, downsampled series and statistics over any time range cost about the
+/// number of points returned, not the number of samples covered.
+/// Times are in usecs: since the epoch for a tlog, since boot for a ULog.
+/// Not thread-safe: open on any thread, then query from one thread at a time.
+class LogAnalysisIndex
+{
+public:
+    enum LogType_t {
+        LogTypeUnknown,
+        LogTypeTLog,
+        LogTypeULog,
+    };
+
+    struct Statistics_t {
+        qsizetype   count   = 0;            ///< Samples in the range, not counting NaN
+        double      min     = qQNaN();
+        double      max     = qQNaN();
+        double      mean    = qQNaN();
+        double      stdDev  = qQNaN();
+    };
+
+    LogAnalysisIndex(void) = default;
+
+    /// Maps and indexes the log. The file type is detected from its contents.
+    ///     @return false if failed, errorMessage set
+    bool open(const QString& fileName, QString& errorMessage);
+
+    LogType_t   logType         (void) const { return _logType; }
+    qint64      bytesIndexed    (void) const { return _size; }
+    qint64      startUSecs      (void) const { return _startUSecs; }
+    qint64      endUSecs        (void) const { return _endUSecs; }
+
+    /// Messages are a message type from a single source: "ATTITUDE (1:1)" for sysid 1 compid 1 in a tlog,
+    /// "sensor_accel" or "sensor_accel_1" for multi id 0 and 1 in a ULog
+    int         messageCount    (void) const { return _messages.count(); }
+    QString     messageName     (int messageIndex) const { return _messages[messageIndex].name; }
+    int         messageIndex    (const QString& name) const { return _messageIndices.value(name, -1); }
+    qsizetype   sampleCount     (int messageIndex) const { return _messages[messageIndex].timestamps.count(); }
+
+    /// Array fields are split into one field per element: "voltages[0]". Nested ULog types are flattened: "esc[0].esc_rpm".
+    int         fieldCount      (int messageIndex) const { return _messages[messageIndex].fields.count(); }
+    QString     fieldName       (int messageIndex, int fieldIndex) const { return _messages[messageIndex].fields[fieldIndex].name; }
+    int         fieldIndex      (int messageIndex, const QString& name) const;
+
+    qint64      timestamp       (int messageIndex, qsizetype sample) const { return _messages[messageIndex].timestamps[sample]; }
+    double      value           (int messageIndex, int fieldIndex, qsizetype sample);
+
+    /// @return Samples of the message in [startUSecs, endUSecs] as first and one past last sample index
+    QPair<qsizetype, qsizetype> range(int messageIndex, qint64 startUSecs, qint64 endUSecs) const;
+
+    /// Series for a chart of pixelWidth over [startUSecs, endUSecs], x in usecs. Every sample is returned if there are
+    /// few enough, otherwise the min and max of each pixel column in time order. The samples either side of the range
+    /// are included so the line reaches the edges of the chart.
+    void points(int messageIndex, int fieldIndex, qint64 startUSecs, qint64 endUSecs, int pixelWidth, QList<QPointF>& points);
+
+    Statistics_t statistics(int messageIndex, int fieldIndex, qint64 startUSecs, qint64 endUSecs);
+
+private:
+    typedef double (*ReadFn)(const uchar* data);
+
+    struct Field_t {
+        QString     name;
+        ReadFn      readFn;
+        quint16     offset;                 ///< From the start of the payload
+        quint8      size;
+    };
+
+    struct Block_t {
+        double      min;
+        double      max;
+        double      sum;
+        double      sumSquares;
+        qsizetype   count;
+        qsizetype   minSample;              ///< -1 if the block is all NaN
+        qsizetype   maxSample;
+    };
+
+    struct Column_t {
+        QList<double>   values;
+        QList<Block_t>  blocks;             ///< Summary of every _blockSize values
+    };
+
+    struct Message_t {
+        QString         name;
+        QList<Field_t>  fields;
+        QList<qint64>   timestamps;
+        QList<qint64>   offsets;            ///< Payload offsets in the file
+        QList<quint16>  lengths;            ///< Payload lengths, MAVLink 2 drops trailing zeros
+        QList<Column_t> columns;            ///< Indexed by field, empty until the field is first used
+    };
+
+    struct ULogFormat_t {
+        QList<QPair<QString, QString>> fields;  ///< Type, name
+    };
+
+    bool            _indexTLog          (QString& errorMessage);
+    bool            _indexULog          (QString& errorMessage);
+    int             _addMessage         (const QString& name);
+    int             _flattenULogFormat  (const QHash<QString, ULogFormat_t>& formats, const QString& formatName, const QString& prefix, int offset, int depth, QList<Field_t>& fields) const;
+    void            _finishIndex        (void);
+    const Column_t& _column             (int messageIndex, int fieldIndex);
+    Block_t         _summary            (const Column_t& column, qsizetype first, qsizetype last) const;
+
+    static ReadFn   _readFn             (const QString& type, int& size);
+
+    LogType_t           _logType        = LogTypeUnknown;
+    QFile               _file;
+    QByteArray          _buffer;                    ///< Holds the log when it can't be mapped
+    const uchar*        _data           = nullptr;
+    qint64              _size           = 0;
+    qint64              _startUSecs     = 0;
+    qint64              _endUSecs       = 0;
+    QList<Message_t>    _messages;
+    QHash<QString, int> _messageIndices;
+
+    static constexpr qsizetype _blockSize = 256;
+};
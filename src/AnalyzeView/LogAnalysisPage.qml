@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import QtCharts
+
+import QGroundControl
+import QGroundControl.Palette
+import QGroundControl.Controls
+import QGroundControl.ScreenTools
+import QGroundControl.Controllers
+
+AnalyzePage {
+    id:                 logAnalysisPage
+    pageComponent:      pageComponent
+    pageDescription:    qsTr("Plot any field of a telemetry log (.tlog) or ULog (.ulg) after the flight. Drag the range slider to zoom in on part of the log.")
+    allowPopout:        true
+
+    property real _margin: ScreenTools.defaultFontPixelWidth
+
+    LogAnalysisController {
+        id: logAnalysisController
+    }
+
+    Component {
+        id: pageComponent
+
+        ColumnLayout {
+            width:      availableWidth
+            height:     availableHeight
+            spacing:    _margin
+
+            property string _messageName:   messageCombo.currentIndex >= 0 ? messageCombo.currentText : ""
+            property string _fieldName:     fieldCombo.currentIndex >= 0 ? fieldCombo.currentText : ""
+            property var    _statistics:    ({})
+
+            function updateChart() {
+                var startSecs = rangeSlider.first.value
+                var endSecs = rangeSlider.second.value
+                axisX.min = startSecs
+                axisX.max = endSecs
+                if (!logAnalysisController.updateSeries(lineSeries, _messageName, _fieldName, startSecs, endSecs, Math.round(chart.plotArea.width))) {
+                    lineSeries.clear()
+                    _statistics = {}
+                    return
+                }
+                _statistics = logAnalysisController.statistics(_messageName, _fieldName, startSecs, endSecs)
+                if (_statistics.count > 0) {
+                    // Keep a flat line off the edges of the plot
+                    var pad = Math.max((_statistics.max - _statistics.min) * 0.05, 0.5)
+                    axisY.min = _statistics.min - pad
+                    axisY.max = _statistics.max + pad
+                }
+            }
+
+            Connections {
+                target: logAnalysisController
+                function onLogFileChanged() {
+                    rangeSlider.setValues(0, logAnalysisController.durationSecs)
+                    messageCombo.currentIndex = logAnalysisController.messageNames.length ? 0 : -1
+                }
+            }
+
+            RowLayout {
+                spacing: _margin
+
+                QGCButton {
+                    text:       qsTr("Open Log")
+                    enabled:    !logAnalysisController.busy
+                    onClicked:  openLogFile.openForLoad()
+
+                    QGCFileDialog {
+                        id:             openLogFile
+                        title:          qsTr("Select log file")
+                        nameFilters:    [qsTr("Telemetry log (*.tlog)"), qsTr("ULog file (*.ulg)"), qsTr("All Files (*)")]
+                        onAcceptedForLoad: (file) => {
+                            close()
+                            logAnalysisController.openLog(file)
+                        }
+                    }
+                }
+
+                QGCLabel {
+                    Layout.fillWidth:   true
+                    elide:              Text.ElideLeft
+                    text:               logAnalysisController.busy ? qsTr("Indexing...") :
+                                            (logAnalysisController.errorMessage !== "" ? logAnalysisController.errorMessage : logAnalysisController.logFile)
+                }
+            }
+
+            RowLayout {
+                spacing: _margin
+
+                QGCLabel { text: qsTr("Message") }
+                QGCComboBox {
+                    id:                     messageCombo
+                    Layout.preferredWidth:  ScreenTools.defaultFontPixelWidth * 30
+                    model:                  logAnalysisController.messageNames
+                    onCurrentIndexChanged:  fieldCombo.model = currentIndex >= 0 ? logAnalysisController.fieldNames(currentText) : []
+                }
+
+                QGCLabel { text: qsTr("Field") }
+                QGCComboBox {
+                    id:                     fieldCombo
+                    Layout.preferredWidth:  ScreenTools.defaultFontPixelWidth * 30
+                    onCurrentIndexChanged:  updateChart()
+                    onModelChanged:         updateChart()
+                }
+            }
+
+            ChartView {
+                id:                 chart
+                Layout.fillWidth:   true
+                Layout.fillHeight:  true
+                theme:              ChartView.ChartThemeDark
+                antialiasing:       true
+                animationOptions:   ChartView.NoAnimation
+                legend.visible:     false
+                backgroundColor:    qgcPal.window
+                backgroundRoundness: 0
+
+                onPlotAreaChanged: updateChart()
+
+                ValueAxis {
+                    id:                     axisX
+                    labelFormat:            "%.1f"
+                    titleText:              qsTr("sec")
+                    labelsFont.family:      ScreenTools.fixedFontFamily
+                    labelsFont.pointSize:   ScreenTools.smallFontPointSize
+                    labelsColor:            qgcPal.text
+                    titleBrush:             qgcPal.text
+                }
+
+                ValueAxis {
+                    id:                     axisY
+                    labelsFont.family:      ScreenTools.fixedFontFamily
+                    labelsFont.pointSize:   ScreenTools.smallFontPointSize
+                    labelsColor:            qgcPal.text
+                }
+
+                LineSeries {
+                    id:         lineSeries
+                    axisX:      axisX
+                    axisY:      axisY
+                    useOpenGL:  true
+                    color:      qgcPal.colorGreen
+                    width:      1
+                }
+            }
+
+            RangeSlider {
+                id:                 rangeSlider
+                Layout.fillWidth:   true
+                from:               0
+                to:                 Math.max(logAnalysisController.durationSecs, 1)
+                enabled:            logAnalysisController.logFile !== ""
+                first.onMoved:      updateChart()
+                second.onMoved:     updateChart()
+            }
+
+            QGCLabel {
+                visible:    _statistics.count > 0
+                text:       qsTr("Count: %1  Min: %2  Max: %3  Mean: %4  Std Dev: %5").arg(_statistics.count)
+                                .arg(Number(_statistics.min).toPrecision(6)).arg(Number(_statistics.max).toPrecision(6))
+                                .arg(Number(_statistics.mean).toPrecision(6)).arg(Number(_statistics.stdDev).toPrecision(6))
+            }
+        }
+    }
+}
@@ -20,8 +20,8 @@
 
 #define kTimeOutMilliseconds 500
 #define kGUIRateMilliseconds 17
-#define kTableBins           512
-#define kChunkSize           (kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)
+#define kMaxWindowBins       (0xFFFFFFFF / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)
+#define kStateSaveBins       1024
 
 QGC_LOGGING_CATEGORY(LogDownloadControllerLog, "qgc.analyzeview.logdownloadcontroller")
 
@@ -56,6 +56,16 @@ void
 LogDownloadController::_setActiveVehicle(Vehicle* vehicle)
 {
     if(_vehicle) {
+        //-- Keep the partial log and its resume state around so the download can continue on reconnect
+        if(_downloadData) {
+            _timer.stop();
+            _downloadData->saveState();
+            qCDebug(LogDownloadControllerLog) << "Download interrupted, resume state saved" << _downloadData->bins_received << "of" << _downloadData->numBins() << "bins";
+            delete _downloadData;
+            _downloadData = nullptr;
+        }
+        _setListing(false);
+        _setDownloading(false);
         _logEntriesModel.clearAndDeleteContents();
         disconnect(_vehicle, &Vehicle::logEntry, this, &LogDownloadController::_logEntry);
         disconnect(_vehicle, &Vehicle::logData,  this, &LogDownloadController::_logData);
@@ -250,52 +260,57 @@ LogDownloadController::_logData(uint32_t ofs, uint16_t id, uint8_t count, const
     }
 
     bool result = false;
-    uint32_t timeout_time = kTimeOutMilliseconds;
     if(ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / kChunkSize;
-        if (chunk != _downloadData->current_chunk) {
-            qCWarning(LogDownloadControllerLog) << "Ignored packet for out of order chunk actual:expected" << chunk << _downloadData->current_chunk;
+        const uint32_t bin = ofs / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+        if (bin >= _downloadData->numBins()) {
+            qCWarning(LogDownloadControllerLog) << "Out of range bin received";
             return;
         }
-        const uint16_t bin = (ofs - chunk*kChunkSize) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qCWarning(LogDownloadControllerLog) << "Out of range bin received";
-        } else
-            _downloadData->chunk_table.setBit(bin);
-        if (_downloadData->file.pos() != ofs) {
-            // Seek to correct position
-            if (!_downloadData->file.seek(ofs)) {
-                qCWarning(LogDownloadControllerLog) << "Error while seeking log file offset";
-                return;
+        //-- Reset timer, the vehicle is still streaming
+        _timer.start(kTimeOutMilliseconds);
+        _retries = 0;
+        if (_downloadData->bin_table.testBit(bin)) {
+            //-- Already have it from an earlier window, nothing to write
+            _downloadData->duplicate_bins++;
+            result = true;
+        } else {
+            if (_downloadData->file.pos() != ofs) {
+                // Seek to correct position
+                if (!_downloadData->file.seek(ofs)) {
+                    qCWarning(LogDownloadControllerLog) << "Error while seeking log file offset";
+                    return;
+                }
             }
-        }
 
-        //-- Write chunk to file
-        if(_downloadData->file.write((const char*)data, count)) {
-            _downloadData->written += count;
-            _downloadData->rate_bytes += count;
-            _updateDataRate();
-            result = true;
-            //-- reset retries
-            _retries = 0;
-            //-- Reset timer
-            _timer.start(timeout_time);
+            //-- Write bin to file
+            if(_downloadData->file.write((const char*)data, count)) {
+                _downloadData->setBin(bin);
+                _downloadData->written += count;
+                _downloadData->rate_bytes += count;
+                _updateDataRate();
+                result = true;
+                if (_downloadData->unsaved_bins >= kStateSaveBins) {
+                    _downloadData->file.flush();
+                    _downloadData->saveState();
+                }
+            } else {
+                qCWarning(LogDownloadControllerLog) << "Error while writing log file chunk";
+            }
+        }
+        if (result) {
             //-- Do we have it all?
-            if(_logComplete()) {
+            if(_downloadData->complete()) {
                 _downloadData->entry->setStatus(tr("Downloaded"));
+                _logDownloadMetrics();
+                _downloadData->file.close();
+                _downloadData->removeState();
                 //-- Check for more
                 _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk*kChunkSize,
-                                _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if (bin < _downloadData->chunk_table.size() - 1 && _downloadData->chunk_table.at(bin+1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
-                _findMissingData();
+            } else if (bin + 1 >= _downloadData->request_end_bin) {
+                // The vehicle reached the end of the requested window. Move straight on to the next
+                // gap instead of waiting for the timeout.
+                _requestNextWindow();
             }
-        } else {
-            qCWarning(LogDownloadControllerLog) << "Error while writing log file chunk";
         }
     } else {
         qCWarning(LogDownloadControllerLog) << "Received log offset greater than expected";
@@ -305,46 +320,72 @@ LogDownloadController::_logData(uint32_t ofs, uint16_t id, uint8_t count, const
     }
 }
 
-
 //----------------------------------------------------------------------------------------
-bool
-LogDownloadController::_chunkComplete() const
+void
+LogDownloadController::_logDownloadMetrics()
 {
-    return _downloadData->chunkEquals(true);
+    qCDebug(LogDownloadControllerLog) << "Log download complete"
+                                      << "id:" << _downloadData->ID
+                                      << "bytes:" << _downloadData->entry->size()
+                                      << "elapsed(ms):" << _downloadData->total_elapsed.elapsed()
+                                      << "rate(B/s):" << _downloadData->throughput()
+                                      << "requests:" << _downloadData->requests
+                                      << "duplicateBins:" << _downloadData->duplicate_bins
+                                      << "resumedBins:" << _downloadData->resumed_bins;
 }
 
 //----------------------------------------------------------------------------------------
-bool
-LogDownloadController::_logComplete() const
+void
+LogDownloadController::_receivedAllData()
 {
-    return _chunkComplete() && (_downloadData->current_chunk+1) == _downloadData->numChunks();
+    _timer.stop();
+    //-- Anything queued up for download?
+    while(_prepareLogDownload()) {
+        if (!_downloadData->complete()) {
+            _downloadData->total_elapsed.start();
+            _requestNextWindow();
+            return;
+        }
+        //-- Resumed from a state file which already had everything
+        _downloadData->entry->setStatus(tr("Downloaded"));
+        _downloadData->file.close();
+        _downloadData->removeState();
+    }
+    _resetSelection();
+    _setDownloading(false);
 }
 
 //----------------------------------------------------------------------------------------
+/// Requests the next run of missing bins. A fresh download is a single window covering the whole
+/// log, so the vehicle streams continuously instead of stopping for a round trip every chunk. Bins
+/// lost along the way show up as gaps which are requested once the stream reaches the window end.
 void
-LogDownloadController::_receivedAllData()
+LogDownloadController::_requestNextWindow()
 {
-    _timer.stop();
-    //-- Anything queued up for download?
-    if(_prepareLogDownload()) {
-        //-- Request Log
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-        _timer.start(kTimeOutMilliseconds);
-    } else {
-        _resetSelection();
-        _setDownloading(false);
+    uint32_t start = 0;
+    uint32_t end = 0;
+    if (!_downloadData->findGap(_downloadData->request_end_bin, start, end) && !_downloadData->findGap(0, start, end)) {
+        return;
     }
+    end = qMin(end, start + static_cast<uint32_t>(kMaxWindowBins));
+
+    _downloadData->request_start_bin = start;
+    _downloadData->request_end_bin = end;
+    _downloadData->requests++;
+
+    const uint32_t pos = start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const uint32_t len = (end - start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    _requestLogData(_downloadData->ID, pos, len, _retries);
+    _timer.start(kTimeOutMilliseconds);
 }
 
 //----------------------------------------------------------------------------------------
 void
 LogDownloadController::_findMissingData()
 {
-    if (_logComplete()) {
+    if (_downloadData->complete()) {
          _receivedAllData();
          return;
-    } else if (_chunkComplete()) {
-        _downloadData->advanceChunk();
     }
 
     _retries++;
@@ -362,23 +403,11 @@ LogDownloadController::_findMissingData()
 
     _updateDataRate();
 
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
-    for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
-            break;
-        }
-    }
-
-    for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
-            break;
-        }
-    }
-
-    const uint32_t pos = _downloadData->current_chunk*kChunkSize + start*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
-                   len = (end - start)*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-    _requestLogData(_downloadData->ID, pos, len, _retries);
+    //-- The vehicle stopped streaming. Save progress and restart from the first gap.
+    _downloadData->file.flush();
+    _downloadData->saveState();
+    _downloadData->request_end_bin = 0;
+    _requestNextWindow();
 }
 
 //----------------------------------------------------------------------------------------
@@ -531,28 +560,42 @@ LogDownloadController::_prepareLogDownload()
         _downloadData->filename += ".bin";
     }
     _downloadData->file.setFileName(_downloadPath + _downloadData->filename);
-    //-- Append a number to the end if the filename already exists
-    if (_downloadData->file.exists()){
-        uint num_dups = 0;
-        QStringList filename_spl = _downloadData->filename.split('.');
-        do {
-            num_dups +=1;
-            _downloadData->file.setFileName(filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
-        } while( _downloadData->file.exists());
-    }
-    //-- Create file
-    if (!_downloadData->file.open(QIODevice::WriteOnly)) {
-        qCWarning(LogDownloadControllerLog) << "Failed to create log file:" <<  _downloadData->filename;
-    } else {
-        //-- Preallocate file
-        if(!_downloadData->file.resize(entry->size())) {
-            qCWarning(LogDownloadControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
+    //-- Pick up an interrupted download of this same log where it left off
+    bool resume = false;
+    if (_downloadData->file.exists() && _downloadData->file.size() == entry->size()) {
+        resume = _downloadData->loadState();
+    }
+    if (resume) {
+        qCDebug(LogDownloadControllerLog) << "Resuming log download" << _downloadData->filename << _downloadData->bins_received << "of" << _downloadData->numBins() << "bins";
+        if (!_downloadData->file.open(QIODevice::ReadWrite)) {
+            qCWarning(LogDownloadControllerLog) << "Failed to open log file for resume:" <<  _downloadData->filename;
         } else {
-            _downloadData->current_chunk = 0;
-            _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
             _downloadData->elapsed.start();
             result = true;
         }
+    } else {
+        //-- Append a number to the end if the filename already exists
+        if (_downloadData->file.exists()){
+            uint num_dups = 0;
+            QStringList filename_spl = _downloadData->filename.split('.');
+            do {
+                num_dups +=1;
+                _downloadData->file.setFileName(_downloadPath + filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
+            } while( _downloadData->file.exists());
+        }
+        //-- Create file
+        if (!_downloadData->file.open(QIODevice::WriteOnly)) {
+            qCWarning(LogDownloadControllerLog) << "Failed to create log file:" <<  _downloadData->filename;
+        } else {
+            //-- Preallocate file
+            if(!_downloadData->file.resize(entry->size())) {
+                qCWarning(LogDownloadControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
+            } else {
+                _downloadData->bin_table = QBitArray(_downloadData->numBins(), false);
+                _downloadData->elapsed.start();
+                result = true;
+            }
+        }
     }
     if(!result) {
         if (_downloadData->file.exists()) {
@@ -617,6 +660,7 @@ LogDownloadController::cancel(void)
         if (_downloadData->file.exists()) {
             _downloadData->file.remove();
         }
+        _downloadData->removeState();
         delete _downloadData;
         _downloadData = 0;
     }
@@ -13,46 +13,143 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QtMath>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
 
-#define kTableBins 512
-#define kChunkSize (kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)
+static constexpr const char* kStateVersionKey   = "version";
+static constexpr const char* kStateIdKey        = "id";
+static constexpr const char* kStateSizeKey      = "size";
+static constexpr const char* kStateTimeKey      = "timeUTC";
+static constexpr const char* kStateBinsKey      = "bins";
+static constexpr int         kStateVersion      = 1;
 
 QGC_LOGGING_CATEGORY(LogEntryLog, "qgc.analyzeview.logentry")
 
 //-----------------------------------------------------------------------------
 LogDownloadData::LogDownloadData(QGCLogEntry* entry_)
-    : ID(entry_->id())
+    : bins_received(0)
+    , request_start_bin(0)
+    , request_end_bin(0)
+    , unsaved_bins(0)
+    , ID(entry_->id())
     , entry(entry_)
     , written(0)
     , rate_bytes(0)
     , rate_avg(0)
+    , requests(0)
+    , duplicate_bins(0)
+    , resumed_bins(0)
 {
 
 }
 
-void LogDownloadData::advanceChunk()
+// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the file
+uint32_t LogDownloadData::numBins() const
 {
-       current_chunk++;
-       chunk_table = QBitArray(chunkBins(), false);
+    return qCeil(entry->size() / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
 }
 
-// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
-uint32_t LogDownloadData::chunkBins() const
+bool LogDownloadData::setBin(uint32_t bin)
 {
-    return qMin(qCeil((entry->size() - current_chunk*kChunkSize)/static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)),
-                kTableBins);
+    if (bin_table.testBit(bin)) {
+        duplicate_bins++;
+        return false;
+    }
+    bin_table.setBit(bin);
+    bins_received++;
+    unsaved_bins++;
+    return true;
 }
 
-// The number of kChunkSize chunks in the file
-uint32_t LogDownloadData::numChunks() const
+bool LogDownloadData::findGap(uint32_t fromBin, uint32_t& startBin, uint32_t& endBin) const
 {
-    return qCeil(entry->size() / static_cast<qreal>(kChunkSize));
+    const uint32_t size = static_cast<uint32_t>(bin_table.size());
+
+    for (startBin = fromBin; startBin < size; startBin++) {
+        if (!bin_table.testBit(startBin)) {
+            break;
+        }
+    }
+    if (startBin >= size) {
+        return false;
+    }
+    for (endBin = startBin; endBin < size; endBin++) {
+        if (bin_table.testBit(endBin)) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool LogDownloadData::saveState()
+{
+    QJsonObject json;
+    json[kStateVersionKey]  = kStateVersion;
+    json[kStateIdKey]       = static_cast<qint64>(ID);
+    json[kStateSizeKey]     = static_cast<qint64>(entry->size());
+    json[kStateTimeKey]     = entry->time().toSecsSinceEpoch();
+    json[kStateBinsKey]     = QString::fromLatin1(QByteArray(bin_table.bits(), (bin_table.size() + 7) / 8).toBase64());
+
+    QSaveFile stateFile(stateFileName());
+    if (!stateFile.open(QIODevice::WriteOnly)) {
+        qCWarning(LogEntryLog) << "Unable to open resume state file" << stateFile.fileName() << stateFile.errorString();
+        return false;
+    }
+    stateFile.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    if (!stateFile.commit()) {
+        qCWarning(LogEntryLog) << "Unable to write resume state file" << stateFile.fileName() << stateFile.errorString();
+        return false;
+    }
+    unsaved_bins = 0;
+    return true;
+}
+
+// Loads the bin table from a previous interrupted download of the same log. Only succeeds if the
+// state file matches this log entry exactly.
+bool LogDownloadData::loadState()
+{
+    QFile stateFile(stateFileName());
+    if (!stateFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject json = QJsonDocument::fromJson(stateFile.readAll()).object();
+    if (json[kStateVersionKey].toInt() != kStateVersion ||
+            json[kStateIdKey].toInteger() != ID ||
+            json[kStateSizeKey].toInteger() != entry->size() ||
+            json[kStateTimeKey].toInteger() != entry->time().toSecsSinceEpoch()) {
+        qCDebug(LogEntryLog) << "Resume state does not match log entry" << stateFile.fileName();
+        return false;
+    }
+
+    const QByteArray bits = QByteArray::fromBase64(json[kStateBinsKey].toString().toLatin1());
+    const uint32_t binCount = numBins();
+    if (static_cast<uint32_t>(bits.size()) != (binCount + 7) / 8) {
+        qCWarning(LogEntryLog) << "Resume state bin table size mismatch" << stateFile.fileName();
+        return false;
+    }
+
+    bin_table = QBitArray::fromBits(bits.constData(), binCount);
+    bins_received = bin_table.count(true);
+    resumed_bins = bins_received;
+    written = qMin(bins_received * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, entry->size());
+    unsaved_bins = 0;
+    return true;
+}
+
+void LogDownloadData::removeState() const
+{
+    QFile::remove(stateFileName());
 }
 
-// True if all bins in the chunk have been set to val
-bool LogDownloadData::chunkEquals(const bool val) const
+qreal LogDownloadData::throughput() const
 {
-    return chunk_table == QBitArray(chunk_table.size(), val);
+    const qint64 msecs = total_elapsed.isValid() ? total_elapsed.elapsed() : 0;
+    if (msecs <= 0) {
+        return 0;
+    }
+    return (written - (resumed_bins * static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN))) / (msecs / 1000.0);
 }
 
 //----------------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QString>
 #include <QtCore/QBitArray>
+#include <QtCore/QFile>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
@@ -71,8 +72,11 @@ private:
 struct LogDownloadData {
     LogDownloadData(QGCLogEntry* entry);
 
-    QBitArray     chunk_table;
-    uint32_t      current_chunk;
+    QBitArray     bin_table;            ///< One bit per MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bin over the whole log
+    uint32_t      bins_received;        ///< Number of bits set in bin_table
+    uint32_t      request_start_bin;    ///< First bin of the outstanding LOG_REQUEST_DATA window
+    uint32_t      request_end_bin;      ///< One past the last bin of the outstanding window
+    uint32_t      unsaved_bins;         ///< Bins received since the resume state was last written
     QFile         file;
     QString       filename;
     uint          ID;
@@ -82,8 +86,29 @@ struct LogDownloadData {
     qreal         rate_avg;
     QElapsedTimer elapsed;
 
-    void advanceChunk();
-    uint32_t chunkBins() const;
-    uint32_t numChunks() const;
-    bool chunkEquals(const bool val) const;
+    // Throughput metrics for the whole transfer
+    QElapsedTimer total_elapsed;
+    uint32_t      requests;             ///< Number of LOG_REQUEST_DATA messages sent
+    uint32_t      duplicate_bins;       ///< Bins which arrived more than once
+    uint32_t      resumed_bins;         ///< Bins restored from a previous interrupted download
+
+    uint32_t numBins() const;
+    bool complete() const { return bins_received == numBins(); }
+
+    /// Marks the bin as received
+    ///     @return false: bin was already received
+    bool setBin(uint32_t bin);
+
+    /// Finds the first run of missing bins at or after fromBin
+    ///     @return false: no missing bins
+    bool findGap(uint32_t fromBin, uint32_t& startBin, uint32_t& endBin) const;
+
+    /// Resume state is kept next to the partial log so an interrupted download continues where it left off
+    QString stateFileName() const { return file.fileName() + QStringLiteral(".part"); }
+    bool saveState();
+    bool loadState();
+    void removeState() const;
+
+    /// Average throughput in bytes/second since the transfer started
+    qreal throughput() const;
 };
@@ -58,6 +58,16 @@ MAVLinkChartController::setRangeXIndex(quint32 t)
     updateXRange();
 }
 
+//-----------------------------------------------------------------------------
+void
+MAVLinkChartController::setPlotWidth(int width)
+{
+    if(_plotWidth != width) {
+        _plotWidth = width;
+        emit plotWidthChanged();
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 MAVLinkChartController::updateXRange()
@@ -48,6 +48,7 @@ public:
 
     Q_PROPERTY(quint32      rangeYIndex         READ rangeYIndex            WRITE setRangeYIndex    NOTIFY rangeYIndexChanged)
     Q_PROPERTY(quint32      rangeXIndex         READ rangeXIndex            WRITE setRangeXIndex    NOTIFY rangeXIndexChanged)
+    Q_PROPERTY(int          plotWidth           READ plotWidth              WRITE setPlotWidth      NOTIFY plotWidthChanged)     ///< Pixels, series are decimated to this
 
     Q_INVOKABLE void        addSeries           (QGCMAVLinkMessageField* field, QAbstractSeries* series);
     Q_INVOKABLE void        delSeries           (QGCMAVLinkMessageField* field);
@@ -62,9 +63,11 @@ public:
     quint32                 rangeXIndex         () const{ return _rangeXIndex; }
     quint32                 rangeYIndex         () const{ return _rangeYIndex; }
     int                     chartIndex          () const{ return _index; }
+    int                     plotWidth           () const{ return _plotWidth; }
 
     void                    setRangeXIndex      (quint32 t);
     void                    setRangeYIndex      (quint32 r);
+    void                    setPlotWidth        (int width);
     void                    updateXRange        ();
     void                    updateYRange        ();
 
@@ -76,6 +79,7 @@ signals:
     void rangeYMaxChanged   ();
     void rangeYIndexChanged ();
     void rangeXIndexChanged ();
+    void plotWidthChanged   ();
 
 private slots:
     void _refreshSeries     ();
@@ -89,6 +93,7 @@ private:
     qreal               _rangeYMax           = 1;
     quint32             _rangeXIndex         = 0;                    ///< 5 Seconds
     quint32             _rangeYIndex         = 0;                    ///< Auto Range
+    int                 _plotWidth           = 0;                    ///< Not known yet, no decimation
     QVariantList        _chartFields;
     MAVLinkInspectorController* _controller  = nullptr;
 };
@@ -14,6 +14,7 @@
 #include "Vehicle.h"
 #include "MAVLinkProtocol.h"
 #include "QGCLoggingCategory.h"
+#include "QGCSignalCoalescer.h"
 
 #include <QtGui/QGuiApplication>
 #include <QtGui/QClipboard>
@@ -21,8 +22,11 @@
 QGC_LOGGING_CATEGORY(MAVLinkConsoleControllerLog, "qgc.analyzeview.mavlinkconsolecontroller")
 
 MAVLinkConsoleController::MAVLinkConsoleController()
-    : QStringListModel()
+    : QAbstractListModel()
 {
+    _lines.resize(_max_num_lines);
+    _linesRichText.resize(_max_num_lines);
+
     auto *manager = qgcApp()->toolbox()->multiVehicleManager();
     connect(manager, &MultiVehicleManager::activeVehicleChanged, this, &MAVLinkConsoleController::_setActiveVehicle);
     _setActiveVehicle(manager->activeVehicle());
@@ -86,54 +90,260 @@ MAVLinkConsoleController::_setActiveVehicle(Vehicle* vehicle)
     _vehicle = vehicle;
 
     if (_vehicle) {
-        _incoming_buffer.clear();
-        // Reset the model
-        setStringList(QStringList());
-        _cursorY = 0;
-        _cursorX = 0;
-        _cursor_home_pos = -1;
+        _resetConsole();
         _uas_connections << connect(_vehicle, &Vehicle::mavlinkSerialControl, this, &MAVLinkConsoleController::_receiveData);
     }
 }
 
+void
+MAVLinkConsoleController::_resetConsole()
+{
+    beginResetModel();
+    for (int i = 0; i < _max_num_lines; i++) {
+        _lines[i].clear();
+        _linesRichText[i].clear();
+    }
+    _firstLine = _endLine = 0;
+    _publishedFirstLine = _publishedEndLine = 0;
+    _dirtyFirstLine = _dirtyEndLine = -1;
+    _cursorY = 0;
+    _cursorX = 0;
+    _cursor_home_pos = -1;
+    _parseState = ParseText;
+    _controlSequenceParams.clear();
+    _pendingText.clear();
+    _decoder.resetState();
+    endResetModel();
+}
+
 void
 MAVLinkConsoleController::_receiveData(uint8_t device, uint8_t, uint16_t, uint32_t, QByteArray data)
 {
     if (device != SERIAL_CONTROL_DEV_SHELL)
         return;
 
-    // Append incoming data and parse for ANSI codes
-    _incoming_buffer.append(data);
-    while(!_incoming_buffer.isEmpty()) {
-        bool newline = false;
-        int idx = _incoming_buffer.indexOf('\n');
-        if (idx == -1) {
-            // Read the whole incoming buffer
-            idx = _incoming_buffer.size();
+    // The parser state carries over to the next chunk, so escape sequences split across chunks need no buffering
+    for (const char c: data) {
+        switch (_parseState) {
+        case ParseText:
+            if (c == '\x1B') {
+                _flushText();
+                _parseState = ParseEscape;
+            } else if (c == '\n') {
+                _flushText();
+                _newLine();
+            } else if (c == '\r') {
+                _flushText();
+                _cursorX = 0;
+            } else {
+                _pendingText.append(c);
+            }
+            break;
+        case ParseEscape:
+            if (c == '[') {
+                _controlSequenceParams.clear();
+                _parseState = ParseControlSequence;
+            } else {
+                // Two byte escapes are not used by the shell
+                _parseState = ParseText;
+            }
+            break;
+        case ParseControlSequence:
+            if ((c >= 0x40) && (c <= 0x7E)) {
+                _controlSequence(c);
+                _parseState = ParseText;
+            } else if (_controlSequenceParams.size() < _max_control_sequence_length) {
+                _controlSequenceParams.append(c);
+            } else {
+                qCDebug(MAVLinkConsoleControllerLog) << "Dropping unterminated control sequence" << _controlSequenceParams;
+                _parseState = ParseText;
+            }
+            break;
+        }
+    }
+    _flushText();
+
+    static const int publishKey = QGCSignalCoalescer::newKey();
+    QGCSignalCoalescer::instance()->post(this, publishKey, [this]() { _publishChanges(); });
+}
+
+void
+MAVLinkConsoleController::_flushText()
+{
+    if (_pendingText.isEmpty()) {
+        return;
+    }
+    const QString text = _decoder.decode(_pendingText);
+    _pendingText.clear();
+    if (text.isEmpty()) {
+        return;
+    }
+
+    _cursorY = qMax(_cursorY, _firstLine);
+    _ensureLine(_cursorY);
+
+    // Text overwrites what is under the cursor, the same as a terminal
+    QString& line = _line(_cursorY);
+    if (line.size() < _cursorX) {
+        line.append(QString(_cursorX - line.size(), QLatin1Char(' ')));
+    }
+    line.replace(_cursorX, text.size(), text);
+    _cursorX += text.size();
+    if (line.size() > _max_line_length) {
+        line.truncate(_max_line_length);
+        _cursorX = _max_line_length;
+    }
+    _markDirty(_cursorY);
+}
+
+void
+MAVLinkConsoleController::_controlSequence(char command)
+{
+    switch (command) {
+    case 'H':
+        if (_cursor_home_pos == -1) {
+            // Assign new home position if home is unset
+            _cursor_home_pos = _cursorY;
         } else {
-            newline = true;
+            // Rewind write cursor position to home
+            _cursorY = _cursor_home_pos;
+            _cursorX = 0;
+        }
+        break;
+    case 'K':
+        // Erase the current line to the end
+        if ((_cursorY >= _firstLine) && (_cursorY < _endLine)) {
+            QString& line = _line(_cursorY);
+            if (_cursorX < line.size()) {
+                line.truncate(_cursorX);
+                _markDirty(_cursorY);
+            }
         }
+        break;
+    case 'J':
+        if ((_controlSequenceParams == "2") && (_cursor_home_pos != -1)) {
+            _eraseFromHome();
+        }
+        break;
+    default:
+        // Colors and cursor movement are not shown
+        break;
+    }
+}
 
-        QByteArray fragment = _incoming_buffer.mid(0, idx);
-        if (_processANSItext(fragment)) {
-            writeLine(_cursorY, fragment);
-            if (newline) {
-                _cursorY++;
-                _cursorX = 0;
-                // ensure line exists
-                int rc = rowCount();
-                if (_cursorY >= rc) {
-                    insertRows(rc, 1 + _cursorY - rc);
-                }
+void
+MAVLinkConsoleController::_newLine()
+{
+    _cursorY = qMax(_cursorY, _firstLine) + 1;
+    _cursorX = 0;
+    _ensureLine(_cursorY);
+}
+
+void
+MAVLinkConsoleController::_ensureLine(qint64 line)
+{
+    while (_endLine <= line) {
+        if ((_endLine - _firstLine) == _max_num_lines) {
+            // Full, the oldest line makes room
+            _firstLine++;
+            if ((_cursor_home_pos != -1) && (_cursor_home_pos < _firstLine)) {
+                _cursor_home_pos = -1;
             }
-            _incoming_buffer.remove(0, idx + (newline ? 1 : 0));
-        } else {
-            // ANSI processing failed, need more data
-            return;
         }
+        _line(_endLine).clear();
+        _endLine++;
     }
 }
 
+void
+MAVLinkConsoleController::_markDirty(qint64 line)
+{
+    if (_dirtyFirstLine == -1) {
+        _dirtyFirstLine = line;
+        _dirtyEndLine = line + 1;
+    } else {
+        _dirtyFirstLine = qMin(_dirtyFirstLine, line);
+        _dirtyEndLine = qMax(_dirtyEndLine, line + 1);
+    }
+}
+
+void
+MAVLinkConsoleController::_eraseFromHome()
+{
+    // Erase everything and rewind to home
+    for (qint64 line = qMax(_cursor_home_pos, _firstLine); line < _endLine; line++) {
+        if (!_line(line).isEmpty()) {
+            _line(line).clear();
+            _markDirty(line);
+        }
+    }
+}
+
+void
+MAVLinkConsoleController::_publishChanges()
+{
+    // Lines which dropped out of the ring since the last publish
+    const qint64 removeEndLine = qMin(_firstLine, _publishedEndLine);
+    if (removeEndLine > _publishedFirstLine) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(removeEndLine - _publishedFirstLine - 1));
+        _publishedFirstLine = removeEndLine;
+        endRemoveRows();
+    }
+    if (_publishedEndLine < _firstLine) {
+        // Everything published was dropped, the view is empty
+        _publishedFirstLine = _publishedEndLine = _firstLine;
+    }
+
+    // New lines
+    const qint64 insertFirstLine = _publishedEndLine;
+    if (_endLine > _publishedEndLine) {
+        const int firstRow = static_cast<int>(_publishedEndLine - _publishedFirstLine);
+        beginInsertRows(QModelIndex(), firstRow, firstRow + static_cast<int>(_endLine - _publishedEndLine) - 1);
+        for (qint64 line = _publishedEndLine; line < _endLine; line++) {
+            _linesRichText[static_cast<int>(line % _max_num_lines)] = transformLineForRichText(_line(line));
+        }
+        _publishedEndLine = _endLine;
+        endInsertRows();
+    }
+
+    // Changed lines, new lines are included since the view only listens for data changes
+    if (insertFirstLine < _endLine) {
+        _markDirty(insertFirstLine);
+        _markDirty(_endLine - 1);
+    }
+    const qint64 changedFirstLine = qMax(_dirtyFirstLine, _publishedFirstLine);
+    const qint64 changedEndLine = qMin(_dirtyEndLine, _publishedEndLine);
+    if ((_dirtyFirstLine != -1) && (changedFirstLine < changedEndLine)) {
+        for (qint64 line = changedFirstLine; line < qMin(changedEndLine, insertFirstLine); line++) {
+            _linesRichText[static_cast<int>(line % _max_num_lines)] = transformLineForRichText(_line(line));
+        }
+        emit dataChanged(index(static_cast<int>(changedFirstLine - _publishedFirstLine)),
+                         index(static_cast<int>(changedEndLine - _publishedFirstLine - 1)),
+                         { Qt::DisplayRole, Qt::EditRole });
+    }
+    _dirtyFirstLine = _dirtyEndLine = -1;
+}
+
+int
+MAVLinkConsoleController::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(_publishedEndLine - _publishedFirstLine);
+}
+
+QVariant
+MAVLinkConsoleController::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (index.row() >= rowCount()) || ((role != Qt::DisplayRole) && (role != Qt::EditRole))) {
+        return QVariant();
+    }
+    const qint64 line = _publishedFirstLine + index.row();
+    if (line < _firstLine) {
+        // Dropped from the ring, the view hears about it at the next publish
+        return QString();
+    }
+    return _lines[static_cast<int>(line % _max_num_lines)];
+}
+
 void
 MAVLinkConsoleController::_sendSerialData(QByteArray data, bool close)
 {
@@ -175,70 +385,6 @@ MAVLinkConsoleController::_sendSerialData(QByteArray data, bool close)
     }
 }
 
-bool
-MAVLinkConsoleController::_processANSItext(QByteArray &line)
-{
-    // Iterate over the incoming buffer to parse off known ANSI control codes
-    for (int i = 0; i < line.size(); i++) {
-        if (line.at(i) == '\x1B') {
-            // For ANSI codes we expect at least 3 incoming chars
-            if (i < line.size() - 2 && line.at(i+1) == '[') {
-                // Parse ANSI code
-                switch(line.at(i+2)) {
-                    default:
-                        continue;
-                    case 'H':
-                        if (_cursor_home_pos == -1) {
-                            // Assign new home position if home is unset
-                            _cursor_home_pos = _cursorY;
-                        } else {
-                            // Rewind write cursor position to home
-                            _cursorY = _cursor_home_pos;
-                            _cursorX = 0;
-                        }
-                        break;
-                    case 'K':
-                        // Erase the current line to the end
-                        if (_cursorY < rowCount()) {
-                            auto idx = index(_cursorY);
-                            QString updated = data(idx, Qt::DisplayRole).toString();
-                            int eraseIdx = _cursorX + i;
-                            if (eraseIdx < updated.length()) {
-                                setData(idx, updated.remove(eraseIdx, updated.length()));
-                            }
-                        }
-                        break;
-                    case '2':
-                        // Check for sufficient buffer size
-                        if ( i >= line.size() - 3)
-                            return false;
-
-                        if (line.at(i+3) == 'J' && _cursor_home_pos != -1) {
-                            // Erase everything and rewind to home
-                            bool blocked = blockSignals(true);
-                            for (int j = _cursor_home_pos; j < rowCount(); j++)
-                                setData(index(j), "");
-                            blockSignals(blocked);
-                            QVector<int> roles({Qt::DisplayRole, Qt::EditRole});
-                            emit dataChanged(index(_cursorY), index(rowCount()), roles);
-                        }
-                        // Even if we didn't understand this ANSI code, remove the 4th char
-                        line.remove(i+3,1);
-                        break;
-                }
-                // Remove the parsed ANSI code and decrement the bufferpos
-                line.remove(i, 3);
-                i--;
-            } else {
-                // We can reasonably expect a control code was fragemented
-                // Stop parsing here and wait for it to come in
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
 QString
 MAVLinkConsoleController::transformLineForRichText(const QString& line) const
 {
@@ -256,40 +402,19 @@ MAVLinkConsoleController::transformLineForRichText(const QString& line) const
 QString
 MAVLinkConsoleController::getText() const
 {
+    // Rich text is cached per line when it is published, so this is only a join
     QString ret;
-    if (rowCount() > 0) {
-        ret = transformLineForRichText(data(index(0), Qt::DisplayRole).toString());
-    }
-    for (int i = 1; i < rowCount(); ++i) {
-        ret += "<br>" + transformLineForRichText(data(index(i), Qt::DisplayRole).toString());
+    const qint64 firstLine = qMax(_publishedFirstLine, _firstLine);
+    for (qint64 line = firstLine; line < _publishedEndLine; line++) {
+        if (line != firstLine) {
+            ret += "<br>";
+        }
+        ret += _linesRichText[static_cast<int>(line % _max_num_lines)];
     }
 
     return ret;
 }
 
-void
-MAVLinkConsoleController::writeLine(int line, const QByteArray &text)
-{
-    auto rc = rowCount();
-    if (line >= rc) {
-        insertRows(rc, 1 + line - rc);
-    }
-    if (rowCount() > _max_num_lines) {
-        int count = rowCount() - _max_num_lines;
-        removeRows(0, count);
-        line -= count;
-        _cursorY -= count;
-        _cursor_home_pos -= count;
-        if (_cursor_home_pos < 0)
-            _cursor_home_pos = -1;
-    }
-    auto idx = index(line);
-    QString updated = data(idx, Qt::DisplayRole).toString();
-    updated.replace(_cursorX, text.size(), text);
-    setData(idx, updated);
-    _cursorX += text.size();
-}
-
 void MAVLinkConsoleController::CommandHistory::append(const QString& command)
 {
     if (command.length() > 0) {
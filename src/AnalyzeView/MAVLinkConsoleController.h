@@ -9,10 +9,11 @@
 
 #pragma once
 
+#include <QtCore/QAbstractListModel>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QStringDecoder>
 #include <QtCore/QMetaObject>
-#include <QtCore/QStringListModel>
 #include <QtQmlIntegration/QtQmlIntegration>
 #include <QtCore/QLoggingCategory>
 
@@ -22,12 +23,16 @@ Q_DECLARE_LOGGING_CATEGORY(MAVLinkConsoleControllerLog)
 
 class Vehicle;
 
-/// Controller for MavlinkConsole.qml.
-class MAVLinkConsoleController : public QStringListModel
+/// Controller for MavlinkConsole.qml. The console output is a list model of lines backed by a fixed size ring, the
+/// oldest lines are dropped once it is full. Incoming shell data is parsed a byte at a time, with the parser state
+/// carried across SERIAL_CONTROL chunks, so a chunk is never rescanned. Changes to the lines are collected and
+/// published to the view once per frame.
+class MAVLinkConsoleController : public QAbstractListModel
 {
     Q_OBJECT
     QML_ELEMENT
     Q_MOC_INCLUDE("Vehicle.h")
+    friend class MAVLinkConsoleControllerTest;
 
 public:
     MAVLinkConsoleController();
@@ -47,14 +52,31 @@ public:
 
     Q_PROPERTY(QString text                     READ getText                    CONSTANT)
 
+    // QAbstractListModel overrides
+    int         rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant    data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
 private slots:
     void _setActiveVehicle  (Vehicle* vehicle);
     void _receiveData(uint8_t device, uint8_t flags, uint16_t timeout, uint32_t baudrate, QByteArray data);
 
 private:
-    bool _processANSItext(QByteArray &line);
+    enum ParseState_t {
+        ParseText,
+        ParseEscape,            ///< After ESC
+        ParseControlSequence,   ///< After ESC [, collecting parameters up to the final byte
+    };
+
+    void _resetConsole          (void);
+    void _flushText             (void);
+    void _controlSequence       (char command);
+    void _newLine               (void);
+    void _ensureLine            (qint64 line);
+    void _markDirty             (qint64 line);
+    void _eraseFromHome         (void);
+    void _publishChanges        (void);
+    QString& _line              (qint64 line) { return _lines[static_cast<int>(line % _max_num_lines)]; }
     void _sendSerialData(QByteArray, bool close = false);
-    void writeLine(int line, const QByteArray &text);
 
     QString transformLineForRichText(const QString& line) const;
 
@@ -73,11 +95,26 @@ private:
     };
 
     static constexpr int _max_num_lines = 500; ///< history size (affects CPU load)
-
-    int           _cursor_home_pos{-1};
-    int           _cursorY{0};
+    static constexpr int _max_line_length = 4096;
+    static constexpr int _max_control_sequence_length = 16;
+
+    // Lines are numbered from the start of the session, line n is at _lines[n % _max_num_lines]
+    QList<QString> _lines;
+    QList<QString> _linesRichText;              ///< Updated for the published lines when they are published
+    qint64        _firstLine{0};
+    qint64        _endLine{0};                  ///< One past the last line
+    qint64        _publishedFirstLine{0};       ///< Lines the view knows about, changed only by _publishChanges
+    qint64        _publishedEndLine{0};
+    qint64        _dirtyFirstLine{-1};          ///< Lines changed since the last publish, -1 for none
+    qint64        _dirtyEndLine{-1};
+
+    qint64        _cursor_home_pos{-1};
+    qint64        _cursorY{0};
     int           _cursorX{0};
-    QByteArray    _incoming_buffer;
+    ParseState_t  _parseState{ParseText};
+    QByteArray    _controlSequenceParams;
+    QByteArray    _pendingText;                 ///< Printable bytes not yet written to the current line
+    QStringDecoder _decoder{QStringDecoder::Utf8};  ///< Keeps multi byte characters split across chunks
     Vehicle*      _vehicle{nullptr};
     QList<QMetaObject::Connection> _uas_connections;
     CommandHistory _history;
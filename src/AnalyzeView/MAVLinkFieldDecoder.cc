@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkFieldDecoder.h"
+
+#include <QtCore/QDateTime>
+
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+// Fields are not aligned on the wire, so everything is read through memcpy
+template<typename T>
+T _read(const uint8_t* data, int index)
+{
+    T v;
+    memcpy(&v, data + (index * sizeof(T)), sizeof(T));
+    return v;
+}
+
+template<typename T>
+qreal _value(const uint8_t* data)
+{
+    return static_cast<qreal>(_read<T>(data, 0));
+}
+
+qreal _noValue(const uint8_t*)
+{
+    return 0;
+}
+
+template<typename T>
+QString _number(T v)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return QString::number(static_cast<double>(v));
+    } else {
+        return QString::number(v);
+    }
+}
+
+template<typename T>
+QString _format(const uint8_t* data, uint16_t arrayLength)
+{
+    if (arrayLength == 0) {
+        return _number(_read<T>(data, 0));
+    }
+    QString string;
+    string.reserve(arrayLength * 6);
+    for (int i = 0; i < arrayLength; i++) {
+        if (i != 0) {
+            string += QStringLiteral(", ");
+        }
+        string += _number(_read<T>(data, i));
+    }
+    return string;
+}
+
+QString _formatChar(const uint8_t* data, uint16_t arrayLength)
+{
+    const char* chars = reinterpret_cast<const char*>(data);
+    if (arrayLength == 0) {
+        return QString(QChar::fromLatin1(chars[0]));
+    }
+    // Text fields which fill the whole array are not null terminated
+    return QString::fromLatin1(chars, static_cast<qsizetype>(qstrnlen(chars, arrayLength)));
+}
+
+QString _formatUnknown(const uint8_t*, uint16_t)
+{
+    return QStringLiteral("?");
+}
+
+// SYSTEM_TIME is shown as a time of day rather than a raw number
+QString _formatBootTime(const uint8_t* data, uint16_t)
+{
+    const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(_read<uint32_t>(data, 0)), Qt::UTC, 0);
+    return d.toString("HH:mm:ss");
+}
+
+QString _formatUnixTime(const uint8_t* data, uint16_t)
+{
+    const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(_read<uint64_t>(data, 0) / 1000), Qt::UTC, 0);
+    return d.toString("yyyy MM dd HH:mm:ss");
+}
+
+struct TypeInfo_t {
+    const char*                     name;
+    MAVLinkFieldDecoder::ValueFn    valueFn;
+    MAVLinkFieldDecoder::FormatFn   formatFn;
+};
+
+template<typename T>
+constexpr TypeInfo_t _typeInfo(const char* name)
+{
+    return { name, _value<T>, _format<T> };
+}
+
+} // namespace
+
+MAVLinkFieldDecoder::MAVLinkFieldDecoder(const mavlink_field_info_t& fieldInfo, uint32_t msgId)
+    : _offset       (static_cast<uint16_t>(fieldInfo.wire_offset))
+    , _arrayLength  (static_cast<uint16_t>(fieldInfo.array_length))
+    , _numeric      (true)
+{
+    TypeInfo_t typeInfo = { "?", _noValue, _formatUnknown };
+    switch (fieldInfo.type) {
+    case MAVLINK_TYPE_CHAR:
+        typeInfo = { "char", _noValue, _formatChar };
+        _numeric = false;
+        break;
+    case MAVLINK_TYPE_UINT8_T:  typeInfo = _typeInfo<uint8_t>   ("uint8_t");    break;
+    case MAVLINK_TYPE_INT8_T:   typeInfo = _typeInfo<int8_t>    ("int8_t");     break;
+    case MAVLINK_TYPE_UINT16_T: typeInfo = _typeInfo<uint16_t>  ("uint16_t");   break;
+    case MAVLINK_TYPE_INT16_T:  typeInfo = _typeInfo<int16_t>   ("int16_t");    break;
+    case MAVLINK_TYPE_UINT32_T: typeInfo = _typeInfo<uint32_t>  ("uint32_t");   break;
+    case MAVLINK_TYPE_INT32_T:  typeInfo = _typeInfo<int32_t>   ("int32_t");    break;
+    case MAVLINK_TYPE_FLOAT:    typeInfo = _typeInfo<float>     ("float");      break;
+    case MAVLINK_TYPE_DOUBLE:   typeInfo = _typeInfo<double>    ("double");     break;
+    case MAVLINK_TYPE_UINT64_T: typeInfo = _typeInfo<uint64_t>  ("uint64_t");   break;
+    case MAVLINK_TYPE_INT64_T:  typeInfo = _typeInfo<int64_t>   ("int64_t");    break;
+    default:
+        _numeric = false;
+        break;
+    }
+
+    if (msgId == MAVLINK_MSG_ID_SYSTEM_TIME && _arrayLength == 0) {
+        if (fieldInfo.type == MAVLINK_TYPE_UINT32_T) {
+            typeInfo.formatFn = _formatBootTime;
+        } else if (fieldInfo.type == MAVLINK_TYPE_UINT64_T) {
+            typeInfo.formatFn = _formatUnixTime;
+        }
+    }
+
+    _typeName   = typeInfo.name;
+    _valueFn    = typeInfo.valueFn;
+    _formatFn   = typeInfo.formatFn;
+}
@@ -0,0 +1,49 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QString>
+
+#include "MAVLinkLib.h"
+
+/// Decodes a single field from a MAVLink message payload. The field layout (type, wire offset and array length) comes
+/// from the mavlink_message_info_t tables the MAVLink generator emits for every message in the XML. A decoder is bound
+/// to one of those entries once, which picks the template instantiation for the field type. After that, reading a
+/// value is one indirect call and a memcpy, with no per message type switch.
+/// Numeric reads never allocate. Strings are only built by format(), which is meant for display refresh.
+class MAVLinkFieldDecoder
+{
+public:
+    MAVLinkFieldDecoder(const mavlink_field_info_t& fieldInfo, uint32_t msgId);
+
+    /// @param payload Payload of the message, at least MAVLINK_MAX_PAYLOAD_LEN bytes with the truncated tail zeroed
+    /// @return Value of the field, or of its first element for an array. 0 for char fields.
+    qreal value(const uint8_t* payload) const { return _valueFn(payload + _offset); }
+
+    /// @return Display string for the field: the value, array elements separated by ", ", or the text of a char array
+    QString format(const uint8_t* payload) const { return _formatFn(payload + _offset, _arrayLength); }
+
+    /// @return false: field is text and can't be charted
+    bool numeric(void) const { return _numeric; }
+
+    /// @return C type name of the field, "?" for an unknown type
+    const char* typeName(void) const { return _typeName; }
+
+    typedef qreal   (*ValueFn)  (const uint8_t* data);
+    typedef QString (*FormatFn) (const uint8_t* data, uint16_t arrayLength);
+
+private:
+    ValueFn     _valueFn;
+    FormatFn    _formatFn;
+    const char* _typeName;
+    uint16_t    _offset;
+    uint16_t    _arrayLength;
+    bool        _numeric;
+};
@@ -32,11 +32,15 @@ MAVLinkInspectorController::MAVLinkInspectorController()
     connect(mavlinkProtocol, &MAVLinkProtocol::messageReceived, this, &MAVLinkInspectorController::_receiveMessage);
     connect(&_updateFrequencyTimer, &QTimer::timeout, this, &MAVLinkInspectorController::_refreshFrequency);
     _updateFrequencyTimer.start(1000);
+    connect(&_refreshMessagesTimer, &QTimer::timeout, this, &MAVLinkInspectorController::_refreshMessages);
+    _refreshMessagesTimer.start(_refreshMessagesMSecs);
     _timeScaleSt.append(new TimeScale_st(this, tr("5 Sec"),   5 * 1000));
     _timeScaleSt.append(new TimeScale_st(this, tr("10 Sec"), 10 * 1000));
     _timeScaleSt.append(new TimeScale_st(this, tr("30 Sec"), 30 * 1000));
     _timeScaleSt.append(new TimeScale_st(this, tr("60 Sec"), 60 * 1000));
     emit timeScalesChanged();
+    const uint32_t maxTimeScale = _timeScaleSt.last()->timeScale;
+    _timeSeriesStore.setRetention(maxTimeScale, (maxTimeScale / 1000) * _maxChartSampleRateHz);
     _rangeSt.append(new Range_st(this, tr("Auto"),    0));
     _rangeSt.append(new Range_st(this, tr("10,000"),  10000));
     _rangeSt.append(new Range_st(this, tr("1,000"),   1000));
@@ -130,6 +134,23 @@ MAVLinkInspectorController::_refreshFrequency()
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+MAVLinkInspectorController::_refreshMessages()
+{
+    for(int i = 0; i < _systems.count(); i++) {
+        QGCMAVLinkSystem* v = qobject_cast<QGCMAVLinkSystem*>(_systems.get(i));
+        if(v) {
+            for(int j = 0; j < v->messages()->count(); j++) {
+                QGCMAVLinkMessage* m = qobject_cast<QGCMAVLinkMessage*>(v->messages()->get(j));
+                if(m) {
+                    m->refresh();
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 MAVLinkInspectorController::_vehicleAdded(Vehicle* vehicle)
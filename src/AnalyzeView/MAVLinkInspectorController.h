@@ -21,6 +21,7 @@
 
 #include "MAVLinkLib.h"
 #include "QmlObjectListModel.h"
+#include "TimeSeriesStore.h"
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkInspectorControllerLog)
 
@@ -80,6 +81,9 @@ public:
     const QList<TimeScale_st*>&     timeScaleSt         () { return _timeScaleSt; }
     const QList<Range_st*>&         rangeSt             () { return _rangeSt; }
 
+    /// Samples for all charted fields, retained for the longest time scale
+    TimeSeriesStore*                timeSeriesStore     () { return &_timeSeriesStore; }
+
 signals:
     void systemsChanged     ();
     void chartsChanged      ();
@@ -93,6 +97,7 @@ private slots:
     void _vehicleRemoved    (Vehicle* vehicle);
     void _setActiveVehicle  (Vehicle* vehicle);
     void _refreshFrequency  ();
+    void _refreshMessages   ();
 
 private:
     QGCMAVLinkSystem* _findVehicle (uint8_t id);
@@ -106,10 +111,14 @@ private:
     QStringList         _rangeList;
     QGCMAVLinkSystem*   _activeSystem           = nullptr;
     QTimer              _updateFrequencyTimer;
+    QTimer              _refreshMessagesTimer;
     QStringList         _systemNames;
     QmlObjectListModel  _systems;                           ///< List of QGCMAVLinkSystem
     QmlObjectListModel  _charts;                            ///< List of MAVLinkCharts
     QList<TimeScale_st*>_timeScaleSt;
     QList<Range_st*>    _rangeSt;
+    TimeSeriesStore     _timeSeriesStore;
 
+    static constexpr int _maxChartSampleRateHz = 200;       ///< Faster fields only keep the newest samples of the time scale
+    static constexpr int _refreshMessagesMSecs = 100;       ///< Counts and field values shown at most this often
 };
@@ -23,6 +23,8 @@
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageLog)
 
+class QGCMAVLinkMessageField;
+
 //-----------------------------------------------------------------------------
 /// MAVLink message
 class QGCMAVLinkMessage : public QObject
@@ -45,9 +47,9 @@ public:
     QGCMAVLinkMessage   (QObject* parent, mavlink_message_t* message);
     ~QGCMAVLinkMessage  ();
 
-    quint32             id              () const { return _message.msgid;  }
-    quint8              sysId           () const { return _message.sysid; }
-    quint8              compId          () const { return _message.compid; }
+    quint32             id              () const { return _msgId;  }
+    quint8              sysId           () const { return _sysId; }
+    quint8              compId          () const { return _compId; }
     QString             name            () const { return _name;  }
     qreal               actualRateHz    () const { return _actualRateHz; }
     int32_t             targetRateHz    () const { return _targetRateHz; }
@@ -60,6 +62,8 @@ public:
     void                updateFieldSelection();
     void                update          (mavlink_message_t* message);
     void                updateFreq      ();
+    /// Pushes what changed since the last refresh out to the display. Field values are only formatted here.
+    void                refresh         ();
     void                setSelected     (bool sel);
     void                setTargetRateHz (int32_t rate);
 
@@ -72,14 +76,25 @@ signals:
 
 private:
     void _updateFields(void);
+    void _updatePayload(const mavlink_message_t* message);
 
     QmlObjectListModel  _fields;
+    QList<QGCMAVLinkMessageField*> _chartedFields;  ///< Decoded for every message, everything else only on refresh
     QString             _name;
     qreal               _actualRateHz   = 0.0;
     int32_t             _targetRateHz   = 0;
     uint64_t            _count          = 1;
     uint64_t            _lastCount      = 0;
-    mavlink_message_t   _message;
+    uint64_t            _shownCount     = 0;
+    uint32_t            _msgId          = 0;
+    uint8_t             _sysId          = 0;
+    uint8_t             _compId         = 0;
+    uint8_t             _payloadLen     = 0;
+    bool                _fieldsDirty    = false;
     bool                _fieldSelected  = false;
     bool                _selected       = false;
+
+    /// Only the payload is kept. The tail past _payloadLen is zero, which is how MAVLink 2 trailing zero truncation
+    /// decodes.
+    uint8_t             _payload[MAVLINK_MAX_PAYLOAD_LEN] = {};
 };
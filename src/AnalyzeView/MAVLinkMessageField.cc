@@ -9,6 +9,7 @@
 
 #include "MAVLinkMessageField.h"
 #include "MAVLinkChartController.h"
+#include "MAVLinkInspectorController.h"
 #include "MAVLinkMessage.h"
 #include "QGC.h"
 #include "QGCLoggingCategory.h"
@@ -19,13 +20,15 @@
 QGC_LOGGING_CATEGORY(MAVLinkMessageFieldLog, "qgc.analyzeview.mavlinkmessagefield")
 
 //-----------------------------------------------------------------------------
-QGCMAVLinkMessageField::QGCMAVLinkMessageField(QGCMAVLinkMessage *parent, QString name, QString type)
+QGCMAVLinkMessageField::QGCMAVLinkMessageField(QGCMAVLinkMessage *parent, const mavlink_field_info_t& fieldInfo)
     : QObject(parent)
-    , _type(type)
-    , _name(name)
+    , _decoder(fieldInfo, parent->id())
+    , _type(QString::fromLatin1(_decoder.typeName()))
+    , _name(QString::fromLatin1(fieldInfo.name))
+    , _selectable(_decoder.numeric())
     , _msg(parent)
 {
-    qCDebug(MAVLinkMessageFieldLog) << "Field:" << name << type;
+    qCDebug(MAVLinkMessageFieldLog) << "Field:" << _name << _type;
 }
 
 //-----------------------------------------------------------------------------
@@ -35,8 +38,8 @@ QGCMAVLinkMessageField::addSeries(MAVLinkChartController* chart, QAbstractSeries
     if(!_pSeries) {
         _chart = chart;
         _pSeries = series;
+        _seriesId = _chart->controller()->timeSeriesStore()->addSeries();
         emit seriesChanged();
-        _dataIndex = 0;
         _msg->updateFieldSelection();
     }
 }
@@ -46,9 +49,11 @@ void
 QGCMAVLinkMessageField::delSeries()
 {
     if(_pSeries) {
-        _values.clear();
+        _chart->controller()->timeSeriesStore()->removeSeries(_seriesId);
+        _seriesId = -1;
+        _points.clear();
         QLineSeries* lineSeries = static_cast<QLineSeries*>(_pSeries);
-        lineSeries->replace(_values);
+        lineSeries->clear();
         _pSeries = nullptr;
         _chart   = nullptr;
         emit seriesChanged();
@@ -85,39 +90,32 @@ QGCMAVLinkMessageField::chartIndex()
 
 //-----------------------------------------------------------------------------
 void
-QGCMAVLinkMessageField::updateValue(QString newValue, qreal v)
+QGCMAVLinkMessageField::refreshValue(const uint8_t* payload)
 {
+    const QString newValue = _decoder.format(payload);
     if(_value != newValue) {
         _value = newValue;
         emit valueChanged();
     }
+}
+
+//-----------------------------------------------------------------------------
+void
+QGCMAVLinkMessageField::appendSample(const uint8_t* payload)
+{
     if(_pSeries && _chart) {
-        int count = _values.count();
-        //-- Arbitrary limit of 1 minute of data at 50Hz for now
-        if(count < (50 * 60)) {
-            QPointF p(QGC::bootTimeMilliseconds(), v);
-            _values.append(p);
-        } else {
-            if(_dataIndex >= count) _dataIndex = 0;
-            _values[_dataIndex].setX(QGC::bootTimeMilliseconds());
-            _values[_dataIndex].setY(v);
-            _dataIndex++;
-        }
-        //-- Auto Range
+        TimeSeriesStore* store = _chart->controller()->timeSeriesStore();
+        store->append(_seriesId, static_cast<qint64>(QGC::bootTimeMilliseconds()), _decoder.value(payload));
+        //-- Auto Range, the store keeps min/max up to date as samples come and go
         if(_chart->rangeYIndex() == 0) {
-            qreal vmin  = std::numeric_limits<qreal>::max();
-            qreal vmax  = std::numeric_limits<qreal>::min();
-            for(int i = 0; i < _values.count(); i++) {
-                qreal v = _values[i].y();
-                if(vmax < v) vmax = v;
-                if(vmin > v) vmin = v;
-            }
+            const qreal vmin = store->minimum(_seriesId);
+            const qreal vmax = store->maximum(_seriesId);
             bool changed = false;
-            if(std::abs(_rangeMin - vmin) > 0.000001) {
+            if(!qIsNaN(vmin) && std::abs(_rangeMin - vmin) > 0.000001) {
                 _rangeMin = vmin;
                 changed = true;
             }
-            if(std::abs(_rangeMax - vmax) > 0.000001) {
+            if(!qIsNaN(vmax) && std::abs(_rangeMax - vmax) > 0.000001) {
                 _rangeMax = vmax;
                 changed = true;
             }
@@ -132,17 +130,18 @@ QGCMAVLinkMessageField::updateValue(QString newValue, qreal v)
 void
 QGCMAVLinkMessageField::updateSeries()
 {
-    int count = _values.count();
-    if (count > 1) {
-        QList<QPointF> s;
-        s.reserve(count);
-        int idx = _dataIndex;
-        for(int i = 0; i < count; i++, idx++) {
-            if(idx >= count) idx = 0;
-            QPointF p(_values[idx]);
-            s.append(p);
-        }
+    if(!_pSeries || !_chart) {
+        return;
+    }
+    //-- Only what is visible, at most a min/max pair per pixel column
+    _chart->controller()->timeSeriesStore()->points(
+        _seriesId,
+        _chart->rangeXMin().toMSecsSinceEpoch(),
+        _chart->rangeXMax().toMSecsSinceEpoch(),
+        _chart->plotWidth(),
+        _points);
+    if (_points.count() > 1) {
         QLineSeries* lineSeries = static_cast<QLineSeries*>(_pSeries);
-        lineSeries->replace(s);
+        lineSeries->replace(_points);
     }
 }
@@ -19,6 +19,8 @@
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "MAVLinkFieldDecoder.h"
+
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageFieldLog)
 
 class QGCMAVLinkMessage;
@@ -42,7 +44,7 @@ public:
     Q_PROPERTY(int              chartIndex  READ chartIndex CONSTANT)
     Q_PROPERTY(QAbstractSeries* series      READ series     NOTIFY seriesChanged)
 
-    QGCMAVLinkMessageField(QGCMAVLinkMessage* parent, QString name, QString type);
+    QGCMAVLinkMessageField(QGCMAVLinkMessage* parent, const mavlink_field_info_t& fieldInfo);
 
     QString         name            () { return _name;  }
     QString         label           ();
@@ -51,13 +53,15 @@ public:
     bool            selectable      () const{ return _selectable; }
     bool            selected        () { return _pSeries != nullptr; }
     QAbstractSeries*series          () { return _pSeries; }
-    QList<QPointF>* values          () { return &_values;}
     qreal           rangeMin        () const{ return _rangeMin; }
     qreal           rangeMax        () const{ return _rangeMax; }
     int             chartIndex      ();
 
     void            setSelectable   (bool sel);
-    void            updateValue     (QString newValue, qreal v);
+    /// Decodes the field into its chart series. No-op unless the field is charted.
+    void            appendSample    (const uint8_t* payload);
+    /// Formats the field for display. Only called on display refresh, not for every message.
+    void            refreshValue    (const uint8_t* payload);
 
     void            addSeries       (MAVLinkChartController* chart, QAbstractSeries* series);
     void            delSeries       ();
@@ -69,16 +73,17 @@ signals:
     void            valueChanged        ();
 
 private:
+    MAVLinkFieldDecoder _decoder;
     QString     _type;
     QString     _name;
     QString     _value;
     bool        _selectable = true;
-    int         _dataIndex  = 0;
+    int         _seriesId   = -1;       ///< Series in the inspector's TimeSeriesStore while charted
     qreal       _rangeMin   = 0;
     qreal       _rangeMax   = 0;
 
     QAbstractSeries*    _pSeries = nullptr;
     QGCMAVLinkMessage*  _msg     = nullptr;
     MAVLinkChartController*      _chart   = nullptr;
-    QList<QPointF>      _values;
+    QList<QPointF>      _points;            ///< Reused for every series update
 };
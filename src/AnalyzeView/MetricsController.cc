@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MetricsController.h"
+#include "QGCMetrics.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QUrl>
+#include <QtCore/QVariantMap>
+
+QGC_LOGGING_CATEGORY(MetricsControllerLog, "qgc.analyzeview.metricscontroller")
+
+MetricsController::MetricsController(QObject* parent)
+    : QObject(parent)
+{
+    _refreshTimer.setInterval(_refreshIntervalMSecs);
+    (void) connect(&_refreshTimer, &QTimer::timeout, this, &MetricsController::_refresh);
+    _refreshTimer.start();
+
+    _refresh();
+}
+
+QString MetricsController::formatNSecs(double nsecs)
+{
+    if (nsecs < 1e3) {
+        return QStringLiteral("%1 ns").arg(nsecs, 0, 'f', 0);
+    } else if (nsecs < 1e6) {
+        return QStringLiteral("%1 us").arg(nsecs / 1e3, 0, 'f', 1);
+    } else if (nsecs < 1e9) {
+        return QStringLiteral("%1 ms").arg(nsecs / 1e6, 0, 'f', 1);
+    }
+    return QStringLiteral("%1 s").arg(nsecs / 1e9, 0, 'f', 2);
+}
+
+void MetricsController::_refresh(void)
+{
+    const double elapsedSecs = _sinceRefresh.isValid() ? (_sinceRefresh.restart() / 1000.0) : 0;
+    if (!_sinceRefresh.isValid()) {
+        _sinceRefresh.start();
+    }
+
+    QVariantList counters;
+    QVariantList histograms;
+    QHash<QString, quint64> values;
+
+    QGCMetrics::instance()->visit([&](const QGCMetrics::Metric_t& metric) {
+        QVariantMap row;
+        row[QStringLiteral("name")]     = metric.name;
+        row[QStringLiteral("labels")]   = QGCMetrics::labelsToString(metric.labels);
+
+        if (metric.counter) {
+            // A counter which went backwards was reset, the rate starts again from the next refresh
+            const QString key = metric.name + row[QStringLiteral("labels")].toString();
+            const quint64 value = metric.counter->value();
+            const quint64 previous = _previousValues.value(key, value);
+            const double rate = ((elapsedSecs > 0) && (value >= previous)) ? ((value - previous) / elapsedSecs) : 0;
+            values.insert(key, value);
+
+            row[QStringLiteral("value")]    = QString::number(value);
+            row[QStringLiteral("rate")]     = QString::number(rate, 'f', 1);
+            counters.append(row);
+        } else {
+            const QGCMetricHistogram::Snapshot_t snapshot = metric.histogram->snapshot();
+            row[QStringLiteral("count")]    = QString::number(snapshot.count);
+            row[QStringLiteral("mean")]     = formatNSecs(snapshot.meanNSecs());
+            row[QStringLiteral("p50")]      = formatNSecs(snapshot.percentileNSecs(0.5));
+            row[QStringLiteral("p99")]      = formatNSecs(snapshot.percentileNSecs(0.99));
+            row[QStringLiteral("max")]      = formatNSecs(snapshot.maxNSecs);
+            histograms.append(row);
+        }
+    });
+
+    _previousValues = values;
+    _counters = counters;
+    _histograms = histograms;
+    emit metricsChanged();
+}
+
+bool MetricsController::save(const QString& file)
+{
+    const QUrl url(file);
+    const QString fileName = url.isLocalFile() ? url.toLocalFile() : file;
+
+    qCDebug(MetricsControllerLog) << "Saving metrics to" << fileName;
+    return QGCMetrics::instance()->writeFile(fileName);
+}
+
+void MetricsController::reset(void)
+{
+    QGCMetrics::instance()->reset();
+    _refresh();
+}
@@ -0,0 +1,65 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QVariantList>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+Q_DECLARE_LOGGING_CATEGORY(MetricsControllerLog)
+
+/// Controller for MetricsPage.qml. Snapshots the QGCMetrics registry once a second. Counters are shown with their
+/// rate over the last second, histograms with their percentiles.
+class MetricsController : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+public:
+    MetricsController(QObject* parent = nullptr);
+
+    /// Rows of name, labels, value and rate
+    Q_PROPERTY(QVariantList counters    READ counters   NOTIFY metricsChanged)
+
+    /// Rows of name, labels, count, mean, p50, p99 and max
+    Q_PROPERTY(QVariantList histograms  READ histograms NOTIFY metricsChanged)
+
+    /// Writes the metrics as JSON if the file ends in .json, otherwise in the Prometheus text format
+    ///     @return false: Write failed
+    Q_INVOKABLE bool save(const QString& file);
+
+    /// Zeroes every metric
+    Q_INVOKABLE void reset(void);
+
+    QVariantList counters   (void) const { return _counters; }
+    QVariantList histograms (void) const { return _histograms; }
+
+    static QString formatNSecs(double nsecs);
+
+signals:
+    void metricsChanged(void);
+
+private slots:
+    void _refresh(void);
+
+private:
+    QTimer                  _refreshTimer;
+    QElapsedTimer           _sinceRefresh;
+    QHash<QString, quint64> _previousValues;    ///< Counter values at the last refresh, by name and labels
+    QVariantList            _counters;
+    QVariantList            _histograms;
+
+    static constexpr int _refreshIntervalMSecs = 1000;
+};
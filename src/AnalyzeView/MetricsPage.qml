@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Dialogs
+import QtQuick.Layouts
+
+import QGroundControl
+import QGroundControl.Palette
+import QGroundControl.Controls
+import QGroundControl.ScreenTools
+import QGroundControl.Controllers
+
+AnalyzePage {
+    id:                 metricsPage
+    pageComponent:      pageComponent
+    pageDescription:    qsTr("Live performance counters and latencies for the links, vehicle message handling, map tile cache and terrain queries. Save exports the metrics as JSON or Prometheus text.")
+    allowPopout:        true
+
+    property real _margin: ScreenTools.defaultFontPixelWidth
+
+    MetricsController {
+        id: metricsController
+    }
+
+    Component {
+        id: pageComponent
+
+        ColumnLayout {
+            width:      availableWidth
+            height:     availableHeight
+            spacing:    _margin
+
+            RowLayout {
+                spacing: _margin
+
+                QGCButton {
+                    text:       qsTr("Save")
+                    onClicked: {
+                        fileDialog.title = qsTr("Save Metrics")
+                        fileDialog.openForSave()
+                    }
+                }
+
+                QGCButton {
+                    text:       qsTr("Reset")
+                    onClicked:  metricsController.reset()
+                }
+
+                QGCFileDialog {
+                    id:             fileDialog
+                    nameFilters:    [ qsTr("Prometheus text (*.prom)"), qsTr("JSON (*.json)") ]
+                    defaultSuffix:  "prom"
+
+                    onAcceptedForSave: (file) => {
+                        close()
+                        if (!metricsController.save(file)) {
+                            mainWindow.showMessageDialog(qsTr("Save Metrics"), qsTr("Unable to write %1").arg(file))
+                        }
+                    }
+                }
+            }
+
+            QGCFlickable {
+                Layout.fillWidth:   true
+                Layout.fillHeight:  true
+                contentWidth:       metricsColumn.width
+                contentHeight:      metricsColumn.height
+
+                ColumnLayout {
+                    id:         metricsColumn
+                    spacing:    _margin
+
+                    GridLayout {
+                        rows:           metricsController.counters.length + 1
+                        flow:           GridLayout.TopToBottom
+                        columnSpacing:  ScreenTools.defaultFontPixelWidth * 2
+                        rowSpacing:     0
+
+                        QGCLabel { text: qsTr("Counter"); font.bold: true }
+                        Repeater {
+                            model: metricsController.counters
+                            QGCLabel { text: modelData.name }
+                        }
+
+                        QGCLabel { text: qsTr("Labels"); font.bold: true }
+                        Repeater {
+                            model: metricsController.counters
+                            QGCLabel { text: modelData.labels }
+                        }
+
+                        QGCLabel { text: qsTr("Total"); font.bold: true }
+                        Repeater {
+                            model: metricsController.counters
+                            QGCLabel { text: modelData.value }
+                        }
+
+                        QGCLabel { text: qsTr("Per Second"); font.bold: true }
+                        Repeater {
+                            model: metricsController.counters
+                            QGCLabel { text: modelData.rate }
+                        }
+                    }
+
+                    GridLayout {
+                        rows:           metricsController.histograms.length + 1
+                        flow:           GridLayout.TopToBottom
+                        columnSpacing:  ScreenTools.defaultFontPixelWidth * 2
+                        rowSpacing:     0
+
+                        QGCLabel { text: qsTr("Latency"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.name }
+                        }
+
+                        QGCLabel { text: qsTr("Labels"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.labels }
+                        }
+
+                        QGCLabel { text: qsTr("Count"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.count }
+                        }
+
+                        QGCLabel { text: qsTr("Mean"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.mean }
+                        }
+
+                        QGCLabel { text: qsTr("p50"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.p50 }
+                        }
+
+                        QGCLabel { text: qsTr("p99"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.p99 }
+                        }
+
+                        QGCLabel { text: qsTr("Max"); font.bold: true }
+                        Repeater {
+                            model: metricsController.histograms
+                            QGCLabel { text: modelData.max }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
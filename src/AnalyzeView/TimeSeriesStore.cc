@@ -0,0 +1,264 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TimeSeriesStore.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QtNumeric>
+
+QGC_LOGGING_CATEGORY(TimeSeriesStoreLog, "qgc.analyzeview.timeseriesstore")
+
+void TimeSeriesStore::SequenceDeque::reset(int capacity)
+{
+    _items.resize(capacity);
+    _head = 0;
+    _size = 0;
+}
+
+void TimeSeriesStore::SequenceDeque::pushBack(quint64 sequence)
+{
+    _items[(_head + _size) % _items.count()] = sequence;
+    _size++;
+}
+
+void TimeSeriesStore::SequenceDeque::popFront()
+{
+    _head = (_head + 1) % _items.count();
+    _size--;
+}
+
+TimeSeriesStore::TimeSeriesStore(qint64 retentionMSecs, int maxSamples)
+    : _retentionMSecs(retentionMSecs)
+    , _maxSamples(qMax(2, maxSamples))
+{
+
+}
+
+void TimeSeriesStore::setRetention(qint64 retentionMSecs, int maxSamples)
+{
+    _retentionMSecs = retentionMSecs;
+    maxSamples = qMax(2, maxSamples);
+    if (maxSamples == _maxSamples) {
+        return;
+    }
+    _maxSamples = maxSamples;
+
+    for (int seriesId = 0; seriesId < _series.count(); seriesId++) {
+        Series_t &series = _series[seriesId];
+        if (!series.used) {
+            continue;
+        }
+
+        const int keep = qMin(series.count, _maxSamples);
+        QList<qint64> times;
+        QList<double> values;
+        times.reserve(keep);
+        values.reserve(keep);
+        for (int i = series.count - keep; i < series.count; i++) {
+            const int index = _index(series, i);
+            times.append(series.times[index]);
+            values.append(series.values[index]);
+        }
+
+        _resetSeries(series);
+        for (int i = 0; i < keep; i++) {
+            append(seriesId, times[i], values[i]);
+        }
+    }
+
+    qCDebug(TimeSeriesStoreLog) << "Retention msecs:" << _retentionMSecs << "max samples:" << _maxSamples;
+}
+
+void TimeSeriesStore::_resetSeries(Series_t &series) const
+{
+    series.times.resize(_maxSamples);
+    series.values.resize(_maxSamples);
+    series.firstSequence = 0;
+    series.count = 0;
+    series.minDeque.reset(_maxSamples);
+    series.maxDeque.reset(_maxSamples);
+}
+
+int TimeSeriesStore::addSeries()
+{
+    int seriesId = 0;
+    while ((seriesId < _series.count()) && _series[seriesId].used) {
+        seriesId++;
+    }
+    if (seriesId == _series.count()) {
+        _series.append(Series_t());
+    }
+
+    Series_t &series = _series[seriesId];
+    series.used = true;
+    _resetSeries(series);
+
+    return seriesId;
+}
+
+void TimeSeriesStore::removeSeries(int seriesId)
+{
+    Q_ASSERT(_series[seriesId].used);
+
+    // Give the memory back, a chart can hold a lot of samples
+    _series[seriesId] = Series_t();
+    while (!_series.isEmpty() && !_series.constLast().used) {
+        _series.removeLast();
+    }
+}
+
+void TimeSeriesStore::clear(int seriesId)
+{
+    Q_ASSERT(_series[seriesId].used);
+    _resetSeries(_series[seriesId]);
+}
+
+void TimeSeriesStore::_dropOldest(Series_t &series)
+{
+    series.firstSequence++;
+    series.count--;
+
+    if (!series.minDeque.isEmpty() && (series.minDeque.front() < series.firstSequence)) {
+        series.minDeque.popFront();
+    }
+    if (!series.maxDeque.isEmpty() && (series.maxDeque.front() < series.firstSequence)) {
+        series.maxDeque.popFront();
+    }
+}
+
+void TimeSeriesStore::append(int seriesId, qint64 timeMSecs, double value)
+{
+    Series_t &series = _series[seriesId];
+    Q_ASSERT(series.used);
+
+    const int capacity = series.times.count();
+    if (series.count == capacity) {
+        _dropOldest(series);
+    }
+
+    const quint64 sequence = series.firstSequence + series.count;
+    const int index = static_cast<int>(sequence % capacity);
+    series.times[index] = timeMSecs;
+    series.values[index] = value;
+    series.count++;
+
+    // A new value makes every older value which is not smaller (or larger) irrelevant for the minimum (or maximum)
+    // as long as it is retained, so each deque stays sorted and its front is the answer
+    if (!qIsNaN(value)) {
+        while (!series.minDeque.isEmpty() && (series.values[series.minDeque.back() % capacity] >= value)) {
+            series.minDeque.popBack();
+        }
+        series.minDeque.pushBack(sequence);
+
+        while (!series.maxDeque.isEmpty() && (series.values[series.maxDeque.back() % capacity] <= value)) {
+            series.maxDeque.popBack();
+        }
+        series.maxDeque.pushBack(sequence);
+    }
+
+    while ((series.count > 1) && (series.times[_index(series, 0)] < (timeMSecs - _retentionMSecs))) {
+        _dropOldest(series);
+    }
+}
+
+int TimeSeriesStore::count(int seriesId) const
+{
+    return _series[seriesId].count;
+}
+
+double TimeSeriesStore::minimum(int seriesId) const
+{
+    const Series_t &series = _series[seriesId];
+    return series.minDeque.isEmpty() ? qQNaN() : series.values[series.minDeque.front() % series.values.count()];
+}
+
+double TimeSeriesStore::maximum(int seriesId) const
+{
+    const Series_t &series = _series[seriesId];
+    return series.maxDeque.isEmpty() ? qQNaN() : series.values[series.maxDeque.front() % series.values.count()];
+}
+
+int TimeSeriesStore::_lowerBound(const Series_t &series, qint64 timeMSecs)
+{
+    int low = 0;
+    int high = series.count;
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (series.times[_index(series, middle)] < timeMSecs) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void TimeSeriesStore::points(int seriesId, qint64 startMSecs, qint64 endMSecs, int pixelWidth, QList<QPointF> &points) const
+{
+    points.clear();
+
+    const Series_t &series = _series[seriesId];
+    // One sample before the range so the line runs in from the left edge
+    const int begin = qMax(0, _lowerBound(series, startMSecs) - 1);
+    const int end = _lowerBound(series, endMSecs + 1);
+    const int sampleCount = end - begin;
+    if (sampleCount <= 0) {
+        return;
+    }
+
+    if ((pixelWidth <= 0) || (sampleCount <= (2 * pixelWidth)) || (endMSecs <= startMSecs)) {
+        points.reserve(sampleCount);
+        for (int i = begin; i < end; i++) {
+            const int index = _index(series, i);
+            points.append(QPointF(series.times[index], series.values[index]));
+        }
+        return;
+    }
+
+    points.reserve((2 * pixelWidth) + 1);
+    const double columnsPerMSec = static_cast<double>(pixelWidth) / (endMSecs - startMSecs);
+
+    int column = -1;
+    // Logical sample indices, which unlike ring indices are in time order
+    int minSample = -1;
+    int maxSample = -1;
+    const auto appendSample = [&](int sample) {
+        const int index = _index(series, sample);
+        points.append(QPointF(series.times[index], series.values[index]));
+    };
+    const auto flushColumn = [&]() {
+        if (column < 0) {
+            return;
+        }
+        // Keep the two samples in time order so the line does not double back
+        appendSample(qMin(minSample, maxSample));
+        if (minSample != maxSample) {
+            appendSample(qMax(minSample, maxSample));
+        }
+    };
+
+    for (int i = begin; i < end; i++) {
+        const int index = _index(series, i);
+        const int sampleColumn = qBound(0, static_cast<int>((series.times[index] - startMSecs) * columnsPerMSec), pixelWidth - 1);
+        if (sampleColumn != column) {
+            flushColumn();
+            column = sampleColumn;
+            minSample = maxSample = i;
+        } else {
+            const double value = series.values[index];
+            if (value < series.values[_index(series, minSample)]) {
+                minSample = i;
+            }
+            if (value > series.values[_index(series, maxSample)]) {
+                maxSample = i;
+            }
+        }
+    }
+    flushColumn();
+}
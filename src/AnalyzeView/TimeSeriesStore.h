@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QPointF>
+
+Q_DECLARE_LOGGING_CATEGORY(TimeSeriesStoreLog)
+
+/// Sample storage for the MAVLink Inspector charts. Every series is a ring buffer with its timestamps and values in
+/// separate arrays. Samples are dropped once they are older than the retention time or the series is full.
+/// The min/max over the retained samples is maintained incrementally with monotonic deques, so auto range costs
+/// O(1) amortized per sample instead of a scan of the whole series.
+/// Not thread-safe.
+class TimeSeriesStore
+{
+public:
+    /// @param retentionMSecs Samples older than this, relative to the newest sample, are dropped.
+    /// @param maxSamples Maximum number of samples kept per series.
+    explicit TimeSeriesStore(qint64 retentionMSecs = 60 * 1000, int maxSamples = 60 * 200);
+
+    /// Changes the retention. Existing series keep their newest samples which fit.
+    void setRetention(qint64 retentionMSecs, int maxSamples);
+
+    qint64 retentionMSecs() const { return _retentionMSecs; }
+    int maxSamples() const { return _maxSamples; }
+
+    /// @return Id of a new empty series
+    int addSeries();
+
+    void removeSeries(int seriesId);
+
+    /// Removes all samples from the series
+    void clear(int seriesId);
+
+    /// Adds a sample. Timestamps are expected to be non-decreasing.
+    void append(int seriesId, qint64 timeMSecs, double value);
+
+    int count(int seriesId) const;
+
+    /// @return Smallest retained value, NaN if the series is empty
+    double minimum(int seriesId) const;
+
+    /// @return Largest retained value, NaN if the series is empty
+    double maximum(int seriesId) const;
+
+    /// Replaces the contents of points with the samples from startMSecs to endMSecs. If there are more samples than
+    /// two per pixel column the samples in each column are reduced to their min and max, which draws the same line.
+    ///     @param pixelWidth Width of the plot area, 0 for no decimation
+    void points(int seriesId, qint64 startMSecs, qint64 endMSecs, int pixelWidth, QList<QPointF> &points) const;
+
+private:
+    /// Fixed capacity double ended queue of sample sequence numbers
+    class SequenceDeque
+    {
+    public:
+        void reset(int capacity);
+        bool isEmpty() const { return _size == 0; }
+        quint64 front() const { return _items[_head]; }
+        quint64 back() const { return _items[(_head + _size - 1) % _items.count()]; }
+        void pushBack(quint64 sequence);
+        void popFront();
+        void popBack() { _size--; }
+
+    private:
+        QList<quint64> _items;
+        int _head = 0;
+        int _size = 0;
+    };
+
+    struct Series_t {
+        bool used = false;
+        QList<qint64> times;
+        QList<double> values;
+        quint64 firstSequence = 0;     ///< Sequence number of the oldest retained sample
+        int count = 0;
+        SequenceDeque minDeque;        ///< Increasing values, front is the minimum
+        SequenceDeque maxDeque;        ///< Decreasing values, front is the maximum
+    };
+
+    void _resetSeries(Series_t &series) const;
+    static void _dropOldest(Series_t &series);
+    static int _lowerBound(const Series_t &series, qint64 timeMSecs);
+    static int _index(const Series_t &series, int logicalIndex) { return static_cast<int>((series.firstSequence + logicalIndex) % series.times.count()); }
+
+    qint64 _retentionMSecs;
+    int _maxSamples;
+    QList<Series_t> _series;    ///< Indexed by series id, removed entries are reused
+};
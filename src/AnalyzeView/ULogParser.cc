@@ -11,7 +11,10 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QSet>
 #include <QtCore/QString>
+#include <QtCore/QtEndian>
 
 #include <ulog_cpp/data_container.hpp>
 #include <ulog_cpp/reader.hpp>
@@ -20,16 +23,88 @@ using namespace ulog_cpp;
 
 QGC_LOGGING_CATEGORY(ULogParserLog, "qgc.analyzeview.ulogparser")
 
-namespace ULogParser {
+namespace {
 
-bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+constexpr qint64 kReadChunkSize = 1024 * 1024;
+
+/// Splits a ULog byte stream into messages and only passes data for the camera_capture topic on to the parser.
+/// Every other message type is passed through, they are small and few compared to logged data. Skipped data
+/// messages are never copied or decoded, only their header is read.
+class CameraCaptureFilter
 {
-    errorMessage.clear();
+public:
+    CameraCaptureFilter(Reader &reader)
+        : _reader(reader)
+    {
 
-    std::shared_ptr<DataContainer> data = std::make_shared<DataContainer>(DataContainer::StorageConfig::FullLog);
-    Reader parser(data);
-    parser.readChunk(reinterpret_cast<const uint8_t*>(log.constData()), log.size());
+    }
+
+    void append(const char *data, qsizetype size)
+    {
+        (void) _pending.append(data, size);
+
+        const char *pending = _pending.constData();
+        qsizetype pos = 0;
+        if (!_headerDone) {
+            if (_pending.size() < kFileHeaderSize) {
+                return;
+            }
+            (void) _filtered.append(pending, kFileHeaderSize);
+            pos = kFileHeaderSize;
+            _headerDone = true;
+        }
+
+        while ((pos + kMessageHeaderSize) <= _pending.size()) {
+            const quint16 msgSize = qFromLittleEndian<quint16>(pending + pos);
+            const char msgType = pending[pos + 2];
+            const qsizetype messageSize = kMessageHeaderSize + msgSize;
+            if ((pos + messageSize) > _pending.size()) {
+                break;
+            }
 
+            const char *payload = pending + pos + kMessageHeaderSize;
+            bool pass = true;
+            if ((msgType == 'A') && (msgSize > 3)) {
+                // uint8_t multi_id, uint16_t msg_id, char message_name[]
+                if (QByteArrayView(payload + 3, msgSize - 3).compare(kTopic) == 0) {
+                    (void) _msgIds.insert(qFromLittleEndian<quint16>(payload + 1));
+                }
+            } else if ((msgType == 'D') && (msgSize >= 2)) {
+                pass = _msgIds.contains(qFromLittleEndian<quint16>(payload));
+            }
+
+            if (pass) {
+                (void) _filtered.append(pending + pos, messageSize);
+            } else {
+                _skippedBytes += messageSize;
+            }
+            pos += messageSize;
+        }
+
+        (void) _pending.remove(0, pos);
+        if (!_filtered.isEmpty()) {
+            _reader.readChunk(reinterpret_cast<const uint8_t*>(_filtered.constData()), static_cast<int>(_filtered.size()));
+            _filtered.clear();
+        }
+    }
+
+    qint64 skippedBytes() const { return _skippedBytes; }
+
+private:
+    Reader          &_reader;
+    QByteArray      _pending;           ///< Partial message carried over to the next chunk
+    QByteArray      _filtered;
+    QSet<quint16>   _msgIds;            ///< Subscriptions to camera_capture
+    bool            _headerDone = false;
+    qint64          _skippedBytes = 0;
+
+    static constexpr qsizetype kFileHeaderSize = 16;
+    static constexpr qsizetype kMessageHeaderSize = 3;
+    static constexpr char kTopic[] = "camera_capture";
+};
+
+bool getTags(const DataContainer *data, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+{
     if (!data->parsingErrors().empty()) {
         for (const std::string &parsing_error : data->parsingErrors()) {
             (void) errorMessage.append(parsing_error);
@@ -80,4 +155,51 @@ bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::cameraFeedbackPac
     return true;
 }
 
+} // namespace
+
+namespace ULogParser {
+
+bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+{
+    errorMessage.clear();
+
+    std::shared_ptr<DataContainer> data = std::make_shared<DataContainer>(DataContainer::StorageConfig::FullLog);
+    Reader parser(data);
+    CameraCaptureFilter filter(parser);
+    filter.append(log.constData(), log.size());
+
+    return getTags(data.get(), cameraFeedback, errorMessage);
+}
+
+bool getTagsFromLogFile(const QString &logFile, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+{
+    errorMessage.clear();
+
+    QFile file(logFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = QStringLiteral("Could not open ULog: %1").arg(file.errorString());
+        return false;
+    }
+
+    std::shared_ptr<DataContainer> data = std::make_shared<DataContainer>(DataContainer::StorageConfig::FullLog);
+    Reader parser(data);
+    CameraCaptureFilter filter(parser);
+
+    QByteArray chunk(kReadChunkSize, Qt::Uninitialized);
+    qint64 bytesRead;
+    while ((bytesRead = file.read(chunk.data(), chunk.size())) > 0) {
+        filter.append(chunk.constData(), bytesRead);
+        if (data->hadFatalError()) {
+            break;
+        }
+    }
+    if (bytesRead < 0) {
+        errorMessage = QStringLiteral("Could not read ULog: %1").arg(file.errorString());
+        return false;
+    }
+
+    qCDebug(ULogParserLog) << "Read" << file.size() << "bytes, skipped" << filter.skippedBytes();
+    return getTags(data.get(), cameraFeedback, errorMessage);
+}
+
 } // namespace ULogParser
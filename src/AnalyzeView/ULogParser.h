@@ -21,6 +21,11 @@ Q_DECLARE_LOGGING_CATEGORY(ULogParserLog)
 
 namespace ULogParser {
     /// Get GeoTags from a ULog
-    ///     @return true if failed, errorMessage set
+    ///     @return false if failed, errorMessage set
     bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage);
+
+    /// Get GeoTags from a ULog file without loading the whole log. The file is read in chunks and data for topics
+    /// other than camera_capture is skipped before it reaches the parser, so memory use does not grow with the log.
+    ///     @return false if failed, errorMessage set
+    bool getTagsFromLogFile(const QString &logFile, QList<GeoTagWorker::cameraFeedbackPacket> &cameraFeedback, QString &errorMessage);
 } // namespace ULogParser
@@ -42,6 +42,12 @@ AnalyzePage {
 
     QGCPalette { id:qgcPal; colorGroupEnabled: true }
 
+    // Vibration values are only needed while the page is shown
+    FactGroupSubscription {
+        factGroup:  _activeVehicle.vibration
+        active:     vibrationPage.visible
+    }
+
     Component {
         id: pageComponent
 
@@ -11,6 +11,7 @@
 #include "LinkManager.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMetrics.h"
 #include "MAVLinkSigning.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
@@ -28,6 +29,16 @@ LinkInterface::LinkInterface(SharedLinkConfigurationPtr &config, QObject *parent
     , _config(config)
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+
+    // Created up front since writes come from any thread
+    QGCMetrics *const metrics = QGCMetrics::instance();
+    const QGCMetrics::Labels labels = { { QStringLiteral("link"), _config ? _config->name() : QString() } };
+    _metrics.bytesReceived = metrics->counter(QStringLiteral("qgc_link_received_bytes"), QStringLiteral("Bytes received on the link"), labels);
+    _metrics.messagesReceived = metrics->counter(QStringLiteral("qgc_link_received_messages"), QStringLiteral("MAVLink messages parsed from the link"), labels);
+    _metrics.messagesLost = metrics->counter(QStringLiteral("qgc_link_lost_messages"), QStringLiteral("MAVLink messages missing from the sequence numbers"), labels);
+    _metrics.bytesSent = metrics->counter(QStringLiteral("qgc_link_sent_bytes"), QStringLiteral("Bytes written to the link"), labels);
+    _metrics.receiveTime = metrics->histogram(QStringLiteral("qgc_link_receive_seconds"), QStringLiteral("Time to parse and dispatch a chunk of received bytes"), labels);
+    _metrics.writeTime = metrics->histogram(QStringLiteral("qgc_link_write_seconds"), QStringLiteral("Time to write a chunk of bytes to the link"), labels);
 }
 
 LinkInterface::~LinkInterface()
@@ -112,7 +123,11 @@ void LinkInterface::_freeMavlinkChannel()
 void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
 {
     const QByteArray data(bytes, length);
-    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
+    (void) QMetaObject::invokeMethod(this, [this, data]() {
+        QGCMetricHistogram::Scope scope(_metrics.writeTime);
+        _writeBytes(data);
+        _metrics.bytesSent->add(static_cast<quint64>(data.size()));
+    }, Qt::AutoConnection);
 }
 
 void LinkInterface::removeVehicleReference()
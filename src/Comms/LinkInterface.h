@@ -15,6 +15,8 @@
 #include "LinkConfiguration.h"
 
 class LinkManager;
+class QGCMetricCounter;
+class QGCMetricHistogram;
 
 Q_DECLARE_LOGGING_CATEGORY(LinkInterfaceLog)
 
@@ -46,6 +48,17 @@ public:
     bool initMavlinkSigning();
     void setSigningSignatureFailure(bool failure);
 
+    /// Performance metrics for the link, labelled with the link name so they carry over a reconnect
+    struct Metrics_t {
+        QGCMetricCounter    *bytesReceived = nullptr;
+        QGCMetricCounter    *messagesReceived = nullptr;
+        QGCMetricCounter    *messagesLost = nullptr;
+        QGCMetricCounter    *bytesSent = nullptr;
+        QGCMetricHistogram  *receiveTime = nullptr;   ///< Parsing and dispatching one receiveBytes chunk
+        QGCMetricHistogram  *writeTime = nullptr;     ///< One _writeBytes call
+    };
+    const Metrics_t &metrics() const { return _metrics; }
+
 signals:
     void bytesReceived(LinkInterface *link, const QByteArray &data);
     void bytesSent(LinkInterface *link, const QByteArray &data);
@@ -79,6 +92,7 @@ private:
     bool _decodedFirstMavlinkPacket = false;
     int _vehicleReferenceCount = 0;
     bool _signingSignatureFailure = false;
+    Metrics_t _metrics;
 };
 
 typedef std::shared_ptr<LinkInterface> SharedLinkInterfacePtr;
@@ -13,6 +13,7 @@
 #include "MultiVehicleManager.h"
 #include "SettingsManager.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMetrics.h"
 
 #include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
@@ -196,6 +197,11 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
         return;
     }
 
+    // Declared after linkPtr so the time is recorded while the link is still held
+    const LinkInterface::Metrics_t& metrics = link->metrics();
+    QGCMetricHistogram::Scope metricScope(metrics.receiveTime);
+    metrics.bytesReceived->add(static_cast<quint64>(b.size()));
+
     uint8_t mavlinkChannel = link->mavlinkChannel();
 
     for (int position = 0; position < b.size(); position++) {
@@ -218,6 +224,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
             uint8_t expectedSeq = lastSeq + 1;
             // Increase receive counter
             totalReceiveCounter[mavlinkChannel]++;
+            metrics.messagesReceived->add();
             // Determine what the next expected sequence number is, accounting for
             // never having seen a message for this system/component pair.
             if(firstMessage[_message.sysid][_message.compid]) {
@@ -239,6 +246,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
                 }
                 // Log how many were lost
                 totalLossCounter[mavlinkChannel] += static_cast<uint64_t>(lostMessages);
+                metrics.messagesLost->add(static_cast<quint64>(lostMessages));
             }
 
             // And update the last sequence number for this system/component pair
@@ -1093,6 +1093,7 @@ void MockLink::_handleCommandLong(const mavlink_message_t& msg)
     bool noAck = false;
     mavlink_command_long_t request;
     uint8_t commandResult = MAV_RESULT_UNSUPPORTED;
+    uint8_t ackCompId = _vehicleComponentId;
 
     mavlink_msg_command_long_decode(&msg, &request);
 
@@ -1140,12 +1141,14 @@ void MockLink::_handleCommandLong(const mavlink_message_t& msg)
         commandResult = MAV_RESULT_ACCEPTED;
         break;
     case MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED:
-        // Test command which always returns MAV_RESULT_ACCEPTED
+        // Test command which always returns MAV_RESULT_ACCEPTED. Acked by the targeted component to simulate cameras, gimbals...
         commandResult = MAV_RESULT_ACCEPTED;
+        ackCompId = request.target_component;
         break;
     case MAV_CMD_MOCKLINK_ALWAYS_RESULT_FAILED:
-        // Test command which always returns MAV_RESULT_FAILED
+        // Test command which always returns MAV_RESULT_FAILED. Acked by the targeted component to simulate cameras, gimbals...
         commandResult = MAV_RESULT_FAILED;
+        ackCompId = request.target_component;
         break;
     case MAV_CMD_MOCKLINK_SECOND_ATTEMPT_RESULT_ACCEPTED:
         // Test command which does not respond to first request and returns MAV_RESULT_ACCEPTED on second attempt
@@ -1180,7 +1183,7 @@ void MockLink::_handleCommandLong(const mavlink_message_t& msg)
 
     mavlink_message_t commandAck;
     mavlink_msg_command_ack_pack_chan(_vehicleSystemId,
-                                      _vehicleComponentId,
+                                      ackCompId,
                                       mavlinkChannel(),
                                       &commandAck,
                                       request.command,
@@ -1667,7 +1670,7 @@ void MockLink::_handleLogRequestData(const mavlink_message_t& msg)
 
     // This will trigger _logDownloadWorker to send data
     _logDownloadCurrentOffset = request.ofs;
-    if (request.ofs + request.count > _logDownloadFileSize) {
+    if (request.count > _logDownloadFileSize - request.ofs) {
         request.count = _logDownloadFileSize - request.ofs;
     }
     _logDownloadBytesRemaining = request.count;
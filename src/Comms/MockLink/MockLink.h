@@ -151,9 +151,21 @@ public:
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
     void resetMissionItemHandler(void) { _missionItemHandler.reset(); }
 
+    /// Enables reporting a plan identifier (opaque_id) in MISSION_COUNT and MISSION_ACK
+    void setMissionItemSendOpaqueId(bool sendOpaqueId) { _missionItemHandler.setSendOpaqueId(sendOpaqueId); }
+
+    /// Drops every dropInterval'th MISSION_ITEM_INT sent during a read, 0 to drop none. Cleared by resetMissionItemHandler.
+    void setMissionItemReadDropInterval(int dropInterval) { _missionItemHandler.setReadDropInterval(dropInterval); }
+
+    /// @return Number of MISSION_REQUEST_INT messages received since the last resetMissionItemHandler
+    int missionItemRequestCount(void) const { return _missionItemHandler.missionRequestCount(); }
+
     /// Returns the filename for the simulated log file. Only available after a download is requested.
     QString logDownloadFile(void) { return _logDownloadFilename; }
 
+    /// Sets the size of the simulated log file. Must be called before the log list is requested.
+    void setLogDownloadFileSize(uint32_t size) { _logDownloadFileSize = size; }
+
     Q_INVOKABLE void setCommLost                    (bool commLost)   { _commLost = commLost; }
     Q_INVOKABLE void simulateConnectionRemoved      (void);
     static MockLink* startPX4MockLink               (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
@@ -312,7 +324,7 @@ private:
     int _currentParamRequestListParamIndex;     // Current parameter index for param request list workflow
 
     static const uint16_t _logDownloadLogId = 0;        ///< Id of siumulated log file
-    static const uint32_t _logDownloadFileSize = 1000;  ///< Size of simulated log file
+    uint32_t _logDownloadFileSize = 1000;               ///< Size of simulated log file
 
     QString     _logDownloadFilename;       ///< Filename for log download which is in progress
     uint32_t    _logDownloadCurrentOffset;  ///< Current offset we are sending from
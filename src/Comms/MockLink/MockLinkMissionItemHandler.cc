@@ -13,7 +13,9 @@
 #include "MAVLinkProtocol.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDebug>
+#include <QtCore/QtEndian>
 
 QGC_LOGGING_CATEGORY(MockLinkMissionItemHandlerLog, "MockLinkMissionItemHandlerLog")
 
@@ -26,6 +28,10 @@ MockLinkMissionItemHandler::MockLinkMissionItemHandler(MockLink* mockLink, MAVLi
     , _failReadRequestListFirstResponse     (true)
     , _failReadRequest1FirstResponse        (true)
     , _failWriteMissionCountFirstResponse   (true)
+    , _sendOpaqueId                         (false)
+    , _missionRequestCount                  (0)
+    , _readDropInterval                     (0)
+    , _readResponseCount                    (0)
 {
     Q_ASSERT(mockLink);
 }
@@ -166,7 +172,7 @@ void MockLinkMissionItemHandler::_handleMissionRequestList(const mavlink_message
             msg.compid,                 // Target is original sender
             itemCount,                  // Number of mission items
             _requestType,
-            0
+            _opaqueId(_requestType)
         );
         _mockLink->respondWithMavlinkMessage(responseMsg);
     }
@@ -182,6 +188,8 @@ void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t&
     
     Q_ASSERT(request.target_system == _mockLink->vehicleId());
 
+    _missionRequestCount++;
+
     if (_failureMode == FailReadRequest0NoResponse && request.seq == 0) {
         qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequest not responding due to failure mode FailReadRequest0NoResponse";
     } else if (_failureMode == FailReadRequest1NoResponse && request.seq == 1) {
@@ -241,7 +249,13 @@ void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t&
                                                    missionItemInt.param1, missionItemInt.param2, missionItemInt.param3, missionItemInt.param4,
                                                    missionItemInt.x, missionItemInt.y, missionItemInt.z,
                                                    _requestType);
-            _mockLink->respondWithMavlinkMessage(responseMsg);
+
+            const int readDropInterval = _readDropInterval;
+            if (readDropInterval > 0 && (++_readResponseCount % readDropInterval) == 0) {
+                qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequest dropping response due to read drop interval, seq:" << request.seq;
+            } else {
+                _mockLink->respondWithMavlinkMessage(responseMsg);
+            }
         }
     }
 }
@@ -344,7 +358,7 @@ void MockLinkMissionItemHandler::_sendAck(MAV_MISSION_RESULT ackType)
         _mavlinkProtocol->getComponentId(),
         ackType,
         _requestType,
-        0
+        _opaqueId(_requestType)
     );
     _mockLink->respondWithMavlinkMessage(message);
 }
@@ -362,6 +376,15 @@ void MockLinkMissionItemHandler::_handleMissionItem(const mavlink_message_t& msg
     mavlink_msg_mission_item_int_decode(&msg, &missionItemInt);
     missionType = static_cast<MAV_MISSION_TYPE>(missionItemInt.mission_type);
     seq = missionItemInt.seq;
+
+    if (seq < _writeSequenceIndex) {
+        // Duplicate of an item which has already been stored, for example one sent ahead of our request
+        qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionItem ignoring duplicate item seq:expected" << seq << _writeSequenceIndex;
+        if (_writeSequenceIndex < _writeSequenceCount) {
+            _startMissionItemResponseTimer();
+        }
+        return;
+    }
     
     switch (missionType) {
     case MAV_MISSION_TYPE_MISSION:
@@ -399,6 +422,40 @@ void MockLinkMissionItemHandler::_handleMissionItem(const mavlink_message_t& msg
     }
 }
 
+uint32_t MockLinkMissionItemHandler::_opaqueId(MAV_MISSION_TYPE missionType) const
+{
+    if (!_sendOpaqueId) {
+        return 0;
+    }
+
+    const MissionItemList_t* items = nullptr;
+    switch (missionType) {
+    case MAV_MISSION_TYPE_MISSION:
+        items = &_missionItems;
+        break;
+    case MAV_MISSION_TYPE_FENCE:
+        items = &_fenceItems;
+        break;
+    case MAV_MISSION_TYPE_RALLY:
+        items = &_rallyItems;
+        break;
+    default:
+        return 0;
+    }
+
+    // Only the fields which make up the plan, the target ids of the upload which stored an item do not
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (mavlink_mission_item_int_t item: *items) {
+        item.target_system = 0;
+        item.target_component = 0;
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(&item), sizeof(item)));
+    }
+    const uint32_t opaqueId = qFromLittleEndian<uint32_t>(hash.result().constData());
+
+    // 0 means no plan identifier support
+    return opaqueId == 0 ? 1 : opaqueId;
+}
+
 void MockLinkMissionItemHandler::_missionItemResponseTimeout(void)
 {
     qWarning() << "Timeout waiting for next MISSION_ITEM_INT";
@@ -17,6 +17,8 @@
 #include <QtCore/QTimer>
 #include <QtCore/QLoggingCategory>
 
+#include <atomic>
+
 class MockLink;
 class MAVLinkProtocol;
 
@@ -76,10 +78,21 @@ public:
     void sendUnexpectedMissionRequest(void);
     
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
-    void reset(void) { _missionItems.clear(); }
+    void reset(void) { _missionItems.clear(); _missionRequestCount = 0; _readDropInterval = 0; _readResponseCount = 0; }
 
     void setSendHomePositionOnEmptyList(bool sendHomePositionOnEmptyList) { _sendHomePositionOnEmptyList = sendHomePositionOnEmptyList; }
 
+    /// Enables reporting a plan identifier in MISSION_COUNT and MISSION_ACK. The identifier is derived from the plan
+    /// contents so the same plan always reports the same identifier.
+    void setSendOpaqueId(bool sendOpaqueId) { _sendOpaqueId = sendOpaqueId; }
+
+    /// Simulates a lossy link by dropping every dropInterval'th MISSION_ITEM_INT sent in response to a
+    /// MISSION_REQUEST_INT, 0 to drop none
+    void setReadDropInterval(int dropInterval) { _readDropInterval = dropInterval; }
+
+    /// @return Number of MISSION_REQUEST_INT messages received since the last reset
+    int missionRequestCount(void) const { return _missionRequestCount; }
+
 private slots:
     void _missionItemResponseTimeout(void);
 
@@ -92,6 +105,7 @@ private:
     void _requestNextMissionItem        (int sequenceNumber);
     void _sendAck                       (MAV_MISSION_RESULT ackType);
     void _startMissionItemResponseTimer (void);
+    uint32_t _opaqueId                  (MAV_MISSION_TYPE missionType) const;
 
 private:
     MockLink* _mockLink;
@@ -114,5 +128,9 @@ private:
     bool                _failReadRequestListFirstResponse;
     bool                _failReadRequest1FirstResponse;
     bool                _failWriteMissionCountFirstResponse;
+    std::atomic<bool>   _sendOpaqueId;          ///< Set from the test thread
+    std::atomic<int>    _missionRequestCount;   ///< Read from the test thread
+    std::atomic<int>    _readDropInterval;      ///< Set from the test thread
+    int                 _readResponseCount;     ///< MISSION_ITEM_INT responses, including dropped ones
 };
 
@@ -9,9 +9,18 @@
 
 
 #include "FactGroup.h"
+#include "QGCLoggingCategory.h"
+#include "QGCSignalCoalescer.h"
 
 #include <QtQml/QQmlEngine>
 
+QGC_LOGGING_CATEGORY(FactGroupLog, "FactGroupLog")
+
+namespace {
+    // Timer and live updates of a group share one slot, so a group publishes at most once per drain
+    const int publishKey = QGCSignalCoalescer::newKey();
+}
+
 FactGroup::FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject* parent, bool ignoreCamelCase)
     : QObject(parent)
     , _updateRateMSecs(updateRateMsecs)
@@ -40,7 +49,7 @@ void FactGroup::_loadFromJsonArray(const QJsonArray jsonArray)
 void FactGroup::_setupTimer()
 {
     if (_updateRateMSecs > 0) {
-        connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_updateAllValues);
+        connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_publishValues);
         _updateTimer.setSingleShot(false);
         _updateTimer.setInterval(_updateRateMSecs);
         _updateTimer.start();
@@ -123,7 +132,7 @@ void FactGroup::_addFact(Fact* fact, const QString& name)
         return;
     }
 
-    fact->setSendValueChangedSignals(_updateRateMSecs == 0);
+    fact->setSendValueChangedSignals(_updateRateMSecs == 0 && !_publishingSuspended);
     if (_nameToFactMetaDataMap.contains(name)) {
         fact->setMetaData(_nameToFactMetaDataMap[name], true /* setDefaultFromMetaData */);
     }
@@ -163,8 +172,88 @@ void FactGroup::setLiveUpdates(bool liveUpdates)
     } else {
         _updateTimer.start();
     }
+
+    // Facts keep deferring their valueChanged signals. With live updates the deferred signals are sent once per event
+    // loop pass instead of once per timer tick, so a burst of high rate messages still only updates the ui once.
     for(Fact* fact: _nameToFactMap) {
-        fact->setSendValueChangedSignals(liveUpdates);
+        if (liveUpdates) {
+            connect(fact, &Fact::rawValueChanged, this, &FactGroup::_scheduleLiveUpdate, Qt::UniqueConnection);
+        } else {
+            disconnect(fact, &Fact::rawValueChanged, this, &FactGroup::_scheduleLiveUpdate);
+        }
+    }
+}
+
+void FactGroup::_publishValues(void)
+{
+    if (_publishingSuspended) {
+        return;
+    }
+
+    // When the coalescer is frame paced, timer updates from all groups are batched into the next frame instead of
+    // each group updating the ui whenever its own timer fires
+    if (QGCSignalCoalescer::instance()->framePaced()) {
+        _scheduleLiveUpdate();
+    } else {
+        _updateAllValues();
+    }
+}
+
+void FactGroup::_scheduleLiveUpdate(void)
+{
+    if (!_publishingSuspended) {
+        QGCSignalCoalescer::instance()->post(this, publishKey, [this]() { _updateAllValues(); });
+    }
+}
+
+void FactGroup::setSubscriberActive(QObject* subscriber, bool active)
+{
+    if (!subscriber) {
+        return;
+    }
+
+    if (!_subscribers.contains(subscriber)) {
+        connect(subscriber, &QObject::destroyed, this, &FactGroup::removeSubscriber);
+    }
+    _subscribers[subscriber] = active;
+
+    _updatePublishingSuspended();
+}
+
+void FactGroup::removeSubscriber(QObject* subscriber)
+{
+    if (_subscribers.remove(subscriber)) {
+        disconnect(subscriber, &QObject::destroyed, this, &FactGroup::removeSubscriber);
+        _updatePublishingSuspended();
+    }
+}
+
+void FactGroup::_updatePublishingSuspended(void)
+{
+    bool suspended = !_subscribers.isEmpty();
+    for (bool active: _subscribers) {
+        if (active) {
+            suspended = false;
+            break;
+        }
+    }
+
+    if (suspended == _publishingSuspended) {
+        return;
+    }
+    _publishingSuspended = suspended;
+    qCDebug(FactGroupLog) << "Publishing suspended:" << suspended << this;
+
+    if (_updateRateMSecs == 0) {
+        // Immediate update facts defer their signals while suspended
+        for (Fact* fact: _nameToFactMap) {
+            fact->setSendValueChangedSignals(!suspended);
+        }
+    }
+
+    if (!suspended) {
+        // Catch up on whatever changed while suspended
+        _updateAllValues();
     }
 }
 
@@ -10,13 +10,17 @@
 #pragma once
 
 #include <QtCore/QStringList>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QTimer>
 #include <QtCore/QJsonArray>
+#include <QtCore/QLoggingCategory>
 
 #include "Fact.h"
 #include "MAVLinkLib.h"
 
+Q_DECLARE_LOGGING_CATEGORY(FactGroupLog)
+
 class Vehicle;
 
 /// Used to group Facts together into an object hierarachy.
@@ -46,6 +50,15 @@ public:
     /// Turning on live updates will allow value changes to flow through as they are received.
     Q_INVOKABLE void setLiveUpdates(bool liveUpdates);
 
+    /// Registers subscriber as a user of the values in this group. A group without subscribers always publishes value
+    /// changes. Once it has subscribers it only publishes while at least one of them is active, which allows ui which
+    /// is not visible to stop the updates it would otherwise cause. The subscriber is removed when it is destroyed.
+    Q_INVOKABLE void setSubscriberActive(QObject* subscriber, bool active);
+    Q_INVOKABLE void removeSubscriber   (QObject* subscriber);
+
+    /// @return true: value changes are held back until an active subscriber shows up
+    bool publishingSuspended(void) const { return _publishingSuspended; }
+
     QStringList factNames           (void) const { return _factNames; }
     QStringList factGroupNames      (void) const { return _nameToFactGroupMap.keys(); }
     bool        telemetryAvailable  (void) const { return _telemetryAvailable; }
@@ -76,10 +89,15 @@ protected:
     QStringList                     _factNames;
 
 private:
-    void    _setupTimer (void);
-    QString _camelCase  (const QString& text);
-
-    bool    _ignoreCamelCase    = false;
-    QTimer  _updateTimer;
-    bool    _telemetryAvailable = false;
+    void    _setupTimer                 (void);
+    QString _camelCase                  (const QString& text);
+    void    _publishValues              (void);
+    void    _scheduleLiveUpdate         (void);
+    void    _updatePublishingSuspended  (void);
+
+    bool                    _ignoreCamelCase        = false;
+    QTimer                  _updateTimer;
+    bool                    _telemetryAvailable     = false;
+    bool                    _publishingSuspended    = false;
+    QHash<QObject*, bool>   _subscribers;                       ///< Subscriber -> active
 };
@@ -0,0 +1,55 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactGroupSubscription.h"
+#include "FactGroup.h"
+
+FactGroupSubscription::FactGroupSubscription(QObject* parent)
+    : QObject(parent)
+{
+
+}
+
+FactGroupSubscription::~FactGroupSubscription()
+{
+    if (_factGroup) {
+        _factGroup->removeSubscriber(this);
+    }
+}
+
+void FactGroupSubscription::setFactGroup(FactGroup* factGroup)
+{
+    if (factGroup == _factGroup) {
+        return;
+    }
+
+    if (_factGroup) {
+        _factGroup->removeSubscriber(this);
+    }
+    _factGroup = factGroup;
+    if (_factGroup) {
+        _factGroup->setSubscriberActive(this, _active);
+    }
+
+    emit factGroupChanged();
+}
+
+void FactGroupSubscription::setActive(bool active)
+{
+    if (active == _active) {
+        return;
+    }
+
+    _active = active;
+    if (_factGroup) {
+        _factGroup->setSubscriberActive(this, _active);
+    }
+
+    emit activeChanged();
+}
@@ -0,0 +1,44 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+class FactGroup;
+
+/// Subscribes a piece of ui to a FactGroup. Bind active to the visibility of the ui so the group can stop publishing
+/// value changes while nothing which uses it is shown. Switching factGroup, for example when the active vehicle
+/// changes, moves the subscription over to the new group.
+class FactGroupSubscription : public QObject
+{
+    Q_OBJECT
+
+public:
+    FactGroupSubscription(QObject* parent = nullptr);
+    ~FactGroupSubscription();
+
+    Q_PROPERTY(FactGroup*   factGroup   READ factGroup  WRITE setFactGroup  NOTIFY factGroupChanged)
+    Q_PROPERTY(bool         active      READ active     WRITE setActive     NOTIFY activeChanged)
+
+    FactGroup*  factGroup   (void) { return _factGroup; }
+    bool        active      (void) const { return _active; }
+
+    void setFactGroup   (FactGroup* factGroup);
+    void setActive      (bool active);
+
+signals:
+    void factGroupChanged   (void);
+    void activeChanged      (void);
+
+private:
+    QPointer<FactGroup> _factGroup;
+    bool                _active = true;
+};
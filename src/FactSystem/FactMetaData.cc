@@ -14,6 +14,9 @@
 #include <MAVLinkLib.h>
 
 #include <QtCore/QtMath>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 
 // Built in translations for all Facts
 const FactMetaData::BuiltInTranslation_s FactMetaData::_rgBuiltInTranslations[] = {
@@ -160,6 +163,90 @@ const FactMetaData& FactMetaData::operator=(const FactMetaData& other)
     return *this;
 }
 
+QDataStream& operator<<(QDataStream& stream, const FactMetaData& metaData)
+{
+    stream << static_cast<qint32>(metaData._type)
+           << static_cast<qint32>(metaData._decimalPlaces)
+           << metaData._rawDefaultValue
+           << metaData._defaultValueAvailable
+           << metaData._bitmaskStrings
+           << metaData._bitmaskValues
+           << metaData._enumStrings
+           << metaData._enumValues
+           << metaData._category
+           << metaData._group
+           << metaData._longDescription
+           << metaData._rawMax
+           << metaData._rawMin
+           << metaData._name
+           << metaData._shortDescription
+           << metaData._rawUnits
+           << metaData._vehicleRebootRequired
+           << metaData._qgcRebootRequired
+           << metaData._rawIncrement
+           << metaData._hasControl
+           << metaData._readOnly
+           << metaData._writeOnly
+           << metaData._volatile;
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, FactMetaData& metaData)
+{
+    qint32          type;
+    qint32          decimalPlaces;
+    QStringList     bitmaskStrings;
+    QVariantList    bitmaskValues;
+    QStringList     enumStrings;
+    QVariantList    enumValues;
+
+    stream >> type
+           >> decimalPlaces
+           >> metaData._rawDefaultValue
+           >> metaData._defaultValueAvailable
+           >> bitmaskStrings
+           >> bitmaskValues
+           >> enumStrings
+           >> enumValues
+           >> metaData._category
+           >> metaData._group
+           >> metaData._longDescription
+           >> metaData._rawMax
+           >> metaData._rawMin
+           >> metaData._name
+           >> metaData._shortDescription
+           >> metaData._rawUnits
+           >> metaData._vehicleRebootRequired
+           >> metaData._qgcRebootRequired
+           >> metaData._rawIncrement
+           >> metaData._hasControl
+           >> metaData._readOnly
+           >> metaData._writeOnly
+           >> metaData._volatile;
+
+    metaData._type          = static_cast<FactMetaData::ValueType_t>(type);
+    metaData._decimalPlaces = decimalPlaces;
+
+    // The meta data loaders set units before any enum or bitmask values, so translators are picked the same way here
+    metaData._enumStrings.clear();
+    metaData._enumValues.clear();
+    metaData._bitmaskStrings.clear();
+    metaData._bitmaskValues.clear();
+    metaData._cookedUnits       = metaData._rawUnits;
+    metaData._rawTranslator     = FactMetaData::_defaultTranslator;
+    metaData._cookedTranslator  = FactMetaData::_defaultTranslator;
+    if (!metaData._rawUnits.isEmpty()) {
+        metaData.setBuiltInTranslator();
+    }
+
+    metaData._enumStrings       = enumStrings;
+    metaData._enumValues        = enumValues;
+    metaData._bitmaskStrings    = bitmaskStrings;
+    metaData._bitmaskValues     = bitmaskValues;
+
+    return stream;
+}
+
 const QString FactMetaData::defaultCategory()
 {
     return QString(kDefaultCategory);
@@ -1380,7 +1467,64 @@ void FactMetaData::_loadJsonDefines(const QJsonObject& jsonDefinesObject, QMap<Q
     }
 }
 
+namespace {
+
+/// Prototype meta data for each json file which has been loaded through createMapFromJsonFile
+struct JsonFileMetaDataCache {
+    ~JsonFileMetaDataCache()
+    {
+        for (const FactMetaData::NameToMetaDataMap_t& prototypeMap: prototypeMaps) {
+            qDeleteAll(prototypeMap);
+        }
+    }
+
+    QMutex                                              mutex;
+    QHash<QString, FactMetaData::NameToMetaDataMap_t>   prototypeMaps;
+};
+
+Q_GLOBAL_STATIC(JsonFileMetaDataCache, _jsonFileMetaDataCache)
+
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent)
+{
+    NameToMetaDataMap_t prototypeMap;
+    {
+        JsonFileMetaDataCache* cache = _jsonFileMetaDataCache();
+        QMutexLocker lock(&cache->mutex);
+
+        auto it = cache->prototypeMaps.constFind(jsonFilename);
+        if (it == cache->prototypeMaps.constEnd()) {
+            it = cache->prototypeMaps.insert(jsonFilename, _parseJsonFile(jsonFilename, nullptr /* metaDataParent */));
+        }
+        prototypeMap = *it;
+    }
+
+    QMap<QString, FactMetaData*> metaDataMap;
+    for (auto it = prototypeMap.constBegin(); it != prototypeMap.constEnd(); ++it) {
+        FactMetaData* metaData = new FactMetaData(*it.value(), metaDataParent);
+        if (!metaData->_rawUnits.isEmpty()) {
+            // Translators for app settings units depend on the settings at the time the meta data is created
+            metaData->setRawUnits(metaData->_rawUnits);
+        }
+        metaDataMap[it.key()] = metaData;
+    }
+
+    return metaDataMap;
+}
+
+void FactMetaData::clearJsonFileCache(void)
+{
+    JsonFileMetaDataCache* cache = _jsonFileMetaDataCache();
+    QMutexLocker lock(&cache->mutex);
+
+    for (const NameToMetaDataMap_t& prototypeMap: cache->prototypeMaps) {
+        qDeleteAll(prototypeMap);
+    }
+    cache->prototypeMaps.clear();
+}
+
+QMap<QString, FactMetaData*> FactMetaData::_parseJsonFile(const QString& jsonFilename, QObject* metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
 
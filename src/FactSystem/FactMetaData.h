@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QDataStream>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QVariant>
@@ -57,13 +58,25 @@ public:
 
     typedef QMap<QString, QString> DefineMap_t;
 
+    /// Creates a new set of meta data from the specified json file. The file is only parsed the first time it is used. After that
+    /// new meta data is copied from a shared set of prototypes which is never modified. Strings and lists in the copies are
+    /// implicitly shared with the prototypes, so a hundred complex items cost little more than one.
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent);
+
+    /// Drops the prototypes used by createMapFromJsonFile. Their strings are translated when the json is parsed, so this
+    /// must be called whenever the language changes. Existing meta data is not affected.
+    static void clearJsonFileCache(void);
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray jsonArray, DefineMap_t& defineMap, QObject* metaDataParent);
 
     static FactMetaData* createFromJsonObject(const QJsonObject& json, QMap<QString, QString>& defineMap, QObject* metaDataParent);
 
     const FactMetaData& operator=(const FactMetaData& other);
 
+    /// Binary serialization used by the parameter meta data cache. Translators are not written, they are restored
+    /// from the raw units on read.
+    friend QDataStream& operator<<(QDataStream& stream, const FactMetaData& metaData);
+    friend QDataStream& operator>>(QDataStream& stream, FactMetaData& metaData);
+
     /// Converts from meters to the user specified horizontal distance unit
     static QVariant metersToAppSettingsHorizontalDistanceUnits(const QVariant& meters);
 
@@ -311,6 +324,7 @@ private:
     static const AppSettingsTranslation_s* _findAppSettingsUnitsTranslation(const QString& rawUnits, UnitTypes type);
 
     static void _loadJsonDefines(const QJsonObject& jsonDefinesObject, QMap<QString, QString>& defineMap);
+    static QMap<QString, FactMetaData*> _parseJsonFile(const QString& jsonFilename, QObject* metaDataParent);
 
     ValueType_t     _type;                  // must be first for correct constructor init
     int             _decimalPlaces;
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataCacheLog, "ParameterMetaDataCacheLog")
+
+ParameterMetaDataCache::ParameterMetaDataCache(const QString& path, int maxNumFiles)
+    : _blobCache(path, maxNumFiles, _magic, _version)
+{
+
+}
+
+ParameterMetaDataCache& ParameterMetaDataCache::defaultInstance()
+{
+    static ParameterMetaDataCache instance(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCParameterMetaDataCache"), 20);
+    return instance;
+}
+
+bool ParameterMetaDataCache::_readMetaDataFile(const QString& metaDataFile, QByteArray& fileContents)
+{
+    QFile file(metaDataFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to open meta data file" << metaDataFile << file.errorString();
+        return false;
+    }
+    fileContents = file.readAll();
+    return true;
+}
+
+QString ParameterMetaDataCache::_fileTag(const QString& formatTag, quint32 formatVersion, const QByteArray& fileContents)
+{
+    const QByteArray hash = QCryptographicHash::hash(fileContents, QCryptographicHash::Sha1).toHex();
+    return QStringLiteral("%1_v%2_%3").arg(formatTag).arg(formatVersion).arg(QString::fromLatin1(hash));
+}
+
+/// Must be called with _mutex held
+QByteArray ParameterMetaDataCache::_cachedMetaData(const QString& fileTag)
+{
+    QByteArray binaryMetaData = _memoryCache.value(fileTag);
+    if (!binaryMetaData.isEmpty()) {
+        qCDebug(ParameterMetaDataCacheLog) << "Memory cache hit" << fileTag;
+        return binaryMetaData;
+    }
+
+    if (_blobCache.load(fileTag, binaryMetaData)) {
+        qCDebug(ParameterMetaDataCacheLog) << "Disk cache hit" << fileTag;
+        _memoryCache[fileTag] = binaryMetaData;
+    }
+
+    return binaryMetaData;
+}
+
+QByteArray ParameterMetaDataCache::metaData(const QString& metaDataFile, const QString& formatTag, quint32 formatVersion, const Parser& parser, bool* parsed)
+{
+    if (parsed) {
+        *parsed = false;
+    }
+
+    QByteArray fileContents;
+    if (!_readMetaDataFile(metaDataFile, fileContents)) {
+        return QByteArray();
+    }
+
+    const QString fileTag = _fileTag(formatTag, formatVersion, fileContents);
+
+    // Held across the parse so concurrent loads of the same file never both parse it
+    QMutexLocker locker(&_mutex);
+
+    QByteArray binaryMetaData = _cachedMetaData(fileTag);
+    if (!binaryMetaData.isEmpty()) {
+        return binaryMetaData;
+    }
+
+    QElapsedTimer parseTimer;
+    parseTimer.start();
+
+    QDataStream stream(&binaryMetaData, QIODevice::WriteOnly);
+    stream.setVersion(streamVersion);
+    const bool success = parser(fileContents, stream);
+    if (parsed) {
+        *parsed = true;
+    }
+    if (!success || stream.status() != QDataStream::Ok) {
+        qCWarning(ParameterMetaDataCacheLog) << "Parse failed, not caching" << metaDataFile;
+        return QByteArray();
+    }
+
+    qCDebug(ParameterMetaDataCacheLog) << "Parsed" << metaDataFile << "msecs:" << parseTimer.elapsed() << "bytes:" << binaryMetaData.size();
+
+    _memoryCache[fileTag] = binaryMetaData;
+    if (_blobCache.save(fileTag, binaryMetaData)) {
+        qCDebug(ParameterMetaDataCacheLog) << "Saved meta data to cache" << fileTag << "bytes:" << binaryMetaData.size();
+    }
+
+    return binaryMetaData;
+}
+
+bool ParameterMetaDataCache::preload(const QString& metaDataFile, const QString& formatTag, quint32 formatVersion, const Parser& parser)
+{
+    bool parsed = false;
+    const bool loaded = !metaData(metaDataFile, formatTag, formatVersion, parser, &parsed).isEmpty();
+    qCDebug(ParameterMetaDataCacheLog) << "Preloaded" << metaDataFile << "loaded:" << loaded << "parsed:" << parsed;
+    return loaded;
+}
+
+void ParameterMetaDataCache::clearMemoryCache()
+{
+    QMutexLocker locker(&_mutex);
+    _memoryCache.clear();
+}
@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <functional>
+
+#include "ComponentInformationBlobCache.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterMetaDataCacheLog)
+
+/// Memory and disk cache of parsed parameter meta data. A firmware plugin parses its meta data file once and writes
+/// the result to a compact binary blob. From then on every load, in this session or a later one, reads that blob
+/// instead of parsing the original file. Entries are keyed by a hash of the file contents so an updated meta data
+/// file never hits a stale entry.
+/// Thread-safe: cached meta data is preloaded from a background thread while vehicles may already be loading it.
+class ParameterMetaDataCache
+{
+public:
+    /// Parses the contents of a meta data file and writes the result to stream
+    ///     @return false: file could not be parsed, nothing is cached
+    typedef std::function<bool(const QByteArray& fileContents, QDataStream& stream)> Parser;
+
+    /// Stream version used for the binary meta data, readers must set it as well
+    static constexpr QDataStream::Version streamVersion = QDataStream::Qt_6_0;
+
+    ParameterMetaDataCache(const QString& path, int maxNumFiles);
+
+    static ParameterMetaDataCache& defaultInstance();
+
+    /// Returns the binary meta data for the specified file. The parser is only called if the meta data is in neither
+    /// the memory nor the disk cache.
+    ///     @param formatTag Identifies the binary format, for example the firmware type
+    ///     @param formatVersion Must be bumped whenever the binary format written by parser changes
+    ///     @param parsed Returned: true: parser was called, false: returned from cache
+    /// @return Binary meta data, empty if the file could not be read or parsed
+    QByteArray metaData(const QString& metaDataFile, const QString& formatTag, quint32 formatVersion, const Parser& parser, bool* parsed = nullptr);
+
+    /// Makes sure the binary meta data for the specified file is in memory ahead of its first load. A disk cache entry
+    /// is read if there is one, otherwise the file is parsed and the result written to the disk cache.
+    /// @return true: binary meta data is now in memory
+    bool preload(const QString& metaDataFile, const QString& formatTag, quint32 formatVersion, const Parser& parser);
+
+    /// Drops the in-memory copies, the disk cache is left as is
+    void clearMemoryCache();
+
+private:
+    static bool _readMetaDataFile(const QString& metaDataFile, QByteArray& fileContents);
+    static QString _fileTag(const QString& formatTag, quint32 formatVersion, const QByteArray& fileContents);
+    QByteArray _cachedMetaData(const QString& fileTag);
+
+    static constexpr quint32 _magic     = 0x51504d44;   ///< "QPMD"
+    static constexpr quint32 _version   = 1;
+
+    QMutex                          _mutex;
+    ComponentInformationBlobCache   _blobCache;
+    QHash<QString, QByteArray>      _memoryCache;       ///< File tag to binary meta data
+};
@@ -34,6 +34,7 @@
 #include <DeviceInfo.h>
 
 #include <QtNetwork/QTcpSocket>
+#include <QtCore/QDir>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QRegularExpressionMatch>
 
@@ -601,6 +602,36 @@ QString APMFirmwarePlugin::missionCommandOverrides(QGCMAVLink::VehicleClass_t ve
     }
 }
 
+QStringList APMFirmwarePlugin::_parameterMetaDataPreloadFiles(void) const
+{
+    // Newest meta data file for each vehicle, which is what a vehicle running current firmware loads
+    static const QRegularExpression regex(QStringLiteral("^APMParameterFactMetaData\\.(\\w+)\\.(\\d+)\\.(\\d+)\\.xml$"));
+
+    const QDir                      resourceDir(QStringLiteral(":/FirmwarePlugin/APM"));
+    QHash<QString, QPair<int, int>> newestVersions;
+    QHash<QString, QString>         newestFiles;
+
+    for (const QString& fileName: resourceDir.entryList({ QStringLiteral("APMParameterFactMetaData.*.xml") }, QDir::Files)) {
+        const QRegularExpressionMatch match = regex.match(fileName);
+        if (!match.hasMatch()) {
+            continue;
+        }
+        const QString           vehicleName = match.captured(1);
+        const QPair<int, int>   version(match.captured(2).toInt(), match.captured(3).toInt());
+        if (!newestVersions.contains(vehicleName) || newestVersions[vehicleName] < version) {
+            newestVersions[vehicleName] = version;
+            newestFiles[vehicleName] = resourceDir.filePath(fileName);
+        }
+    }
+
+    return newestFiles.values();
+}
+
+FirmwarePlugin::ParameterMetaDataPreloader APMFirmwarePlugin::_parameterMetaDataPreloader(void) const
+{
+    return &APMParameterMetaData::preloadCachedMetaData;
+}
+
 QObject* APMFirmwarePlugin::_loadParameterMetaData(const QString& metaDataFile)
 {
     Q_UNUSED(metaDataFile);
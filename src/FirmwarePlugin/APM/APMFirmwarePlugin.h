@@ -72,8 +72,12 @@ public:
     virtual void        initializeStreamRates           (Vehicle* vehicle);
     void                initializeVehicle               (Vehicle* vehicle) override;
     bool                sendHomePositionToVehicle       (void) override;
+    int                 missionItemReadWindow           (void) const override { return 8; }
+    int                 missionItemWriteLookahead       (void) const override { return 2; }
     QString             missionCommandOverrides         (QGCMAVLink::VehicleClass_t vehicleClass) const override;
     QString             _internalParameterMetaDataFile  (const Vehicle* vehicle) const override;
+    QStringList         _parameterMetaDataPreloadFiles  (void) const override;
+    ParameterMetaDataPreloader _parameterMetaDataPreloader(void) const override;
     FactMetaData*       _getMetaDataForFact             (QObject* parameterMetaData, const QString& name, FactMetaData::ValueType_t type, MAV_TYPE vehicleType) override;
     void                _getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion) override;
     QObject*            _loadParameterMetaData          (const QString& metaDataFile) override;
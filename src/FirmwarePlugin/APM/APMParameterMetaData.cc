@@ -9,9 +9,9 @@
 
 
 #include "APMParameterMetaData.h"
+#include "ParameterMetaDataCache.h"
 #include "QGCLoggingCategory.h"
 
-#include <QtCore/QFile>
 #include <QtCore/QStack>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QRegularExpressionMatch>
@@ -25,6 +25,42 @@ APMParameterMetaData::APMParameterMetaData(void)
 
 }
 
+QDataStream& operator<<(QDataStream& stream, const APMFactMetaDataRaw& rawMetaData)
+{
+    stream << rawMetaData.name
+           << rawMetaData.category
+           << rawMetaData.group
+           << rawMetaData.shortDescription
+           << rawMetaData.longDescription
+           << rawMetaData.min
+           << rawMetaData.max
+           << rawMetaData.incrementSize
+           << rawMetaData.units
+           << rawMetaData.rebootRequired
+           << rawMetaData.readOnly
+           << rawMetaData.values
+           << rawMetaData.bitmask;
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, APMFactMetaDataRaw& rawMetaData)
+{
+    stream >> rawMetaData.name
+           >> rawMetaData.category
+           >> rawMetaData.group
+           >> rawMetaData.shortDescription
+           >> rawMetaData.longDescription
+           >> rawMetaData.min
+           >> rawMetaData.max
+           >> rawMetaData.incrementSize
+           >> rawMetaData.units
+           >> rawMetaData.rebootRequired
+           >> rawMetaData.readOnly
+           >> rawMetaData.values
+           >> rawMetaData.bitmask;
+    return stream;
+}
+
 /// Converts a string to a typed QVariant
 ///     @param string String to convert
 ///     @param type Type for Fact which dictates the QVariant type as well
@@ -140,19 +176,37 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
-    QString currentCategory;
-
     qCDebug(APMParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
-    QFile xmlFile(metaDataFile);
-    Q_ASSERT(xmlFile.exists());
+    // The XML is only parsed the first time a file is seen, after that the parsed map comes from the cache. A badly
+    // formed file leaves whatever was read up to the error, which is cached as well since it depends on the file only.
+    bool parsed = false;
+    const QByteArray binaryMetaData = ParameterMetaDataCache::defaultInstance().metaData(metaDataFile, QStringLiteral("APM"), _binaryMetaDataVersion,
+        [this](const QByteArray& fileContents, QDataStream& stream) { return _writeParsedMetaData(fileContents, stream); }, &parsed);
+
+    if (!parsed && !binaryMetaData.isEmpty()) {
+        QDataStream stream(binaryMetaData);
+        stream.setVersion(ParameterMetaDataCache::streamVersion);
+        stream >> _vehicleTypeToParametersMap;
+        if (stream.status() != QDataStream::Ok) {
+            qCWarning(APMParameterMetaDataLog) << "Cached parameter meta data corrupt:" << metaDataFile;
+            _vehicleTypeToParametersMap.clear();
+        }
+    }
+}
+
+bool APMParameterMetaData::_writeParsedMetaData(const QByteArray& fileContents, QDataStream& stream)
+{
+    _parseParameterFactMetaData(fileContents);
+    stream << _vehicleTypeToParametersMap;
+    return true;
+}
 
-    bool success = xmlFile.open(QIODevice::ReadOnly);
-    Q_UNUSED(success);
-    Q_ASSERT(success);
+void APMParameterMetaData::_parseParameterFactMetaData(const QByteArray& fileContents)
+{
+    QString currentCategory;
 
-    QXmlStreamReader xml(xmlFile.readAll());
-    xmlFile.close();
+    QXmlStreamReader xml(fileContents);
     if (xml.hasError()) {
         qCWarning(APMParameterMetaDataLog) << "Badly formed XML, reading failed: " << xml.errorString();
         return;
@@ -160,7 +214,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
 
     bool                badMetaData = true;
     QStack<int>         xmlState;
-    APMFactMetaDataRaw* rawMetaData = nullptr;
+    APMFactMetaDataRaw* rawMetaData = nullptr;  // Points into _vehicleTypeToParametersMap, only valid while reading a single param
 
     xmlState.push(XmlStateNone);
 
@@ -250,14 +304,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                           << "group: " << group;
 
                 Q_ASSERT(!rawMetaData);
-                if (_vehicleTypeToParametersMap[currentCategory].contains(name)) {
+                ParameterNametoFactMetaDataMap& parameterMap = _vehicleTypeToParametersMap[currentCategory];
+                if (parameterMap.contains(name)) {
                     qCDebug(APMParameterMetaDataLog) << "Duplicate parameter found:" << name;
-                    rawMetaData = _vehicleTypeToParametersMap[currentCategory][name];
                 } else {
-                    rawMetaData = new APMFactMetaDataRaw(this);
-                    _vehicleTypeToParametersMap[currentCategory][name] = rawMetaData;
                     groupMembers[group] << name;
                 }
+                rawMetaData = &parameterMap[name];
                 qCDebug(APMParameterMetaDataVerboseLog) << "inserting metadata for field" << name;
                 rawMetaData->name = name;
                 if (!category.isEmpty()) {
@@ -310,7 +363,7 @@ void APMParameterMetaData::correctGroupMemberships(ParameterNametoFactMetaDataMa
     foreach(const QString& groupName, groupMembers.keys()) {
             if (groupMembers[groupName].count() == 1) {
                 foreach(const QString& parameter, groupMembers.value(groupName)) {
-                    parameterToFactMetaDataMap[parameter]->group = FactMetaData::defaultGroup();
+                    parameterToFactMetaDataMap[parameter].group = FactMetaData::defaultGroup();
                 }
             }
         }
@@ -429,16 +482,18 @@ bool APMParameterMetaData::parseParameterAttributes(QXmlStreamReader& xml, APMFa
 
 FactMetaData* APMParameterMetaData::getMetaDataForFact(const QString& name, MAV_TYPE vehicleType, FactMetaData::ValueType_t type)
 {
-    bool                keepTrying      = true;
-    QString             mavTypeString   = mavTypeToString(vehicleType);
-    APMFactMetaDataRaw* rawMetaData     = nullptr;
+    bool                        keepTrying      = true;
+    QString                     mavTypeString   = mavTypeToString(vehicleType);
+    const APMFactMetaDataRaw*   rawMetaData     = nullptr;
 
     // check if we have metadata for fact, use generic otherwise
     while (keepTrying) {
-        if (_vehicleTypeToParametersMap[mavTypeString].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap[mavTypeString][name];
-        } else if (_vehicleTypeToParametersMap["libraries"].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap["libraries"][name];
+        const auto vehicleIt = _vehicleTypeToParametersMap.constFind(mavTypeString);
+        const auto librariesIt = _vehicleTypeToParametersMap.constFind(QStringLiteral("libraries"));
+        if (vehicleIt != _vehicleTypeToParametersMap.constEnd() && vehicleIt->contains(name)) {
+            rawMetaData = &(*vehicleIt->constFind(name));
+        } else if (librariesIt != _vehicleTypeToParametersMap.constEnd() && librariesIt->contains(name)) {
+            rawMetaData = &(*librariesIt->constFind(name));
         }
         if (!rawMetaData && mavTypeString == "Rover") {
             // Hack city: Older versions of Rover have different name
@@ -623,6 +678,14 @@ FactMetaData* APMParameterMetaData::getMetaDataForFact(const QString& name, MAV_
     return metaData;
 }
 
+void APMParameterMetaData::preloadCachedMetaData(const QString& metaDataFile)
+{
+    // A miss is parsed into a throwaway instance which lives and dies on the calling thread
+    APMParameterMetaData metaData;
+    (void) ParameterMetaDataCache::defaultInstance().preload(metaDataFile, QStringLiteral("APM"), _binaryMetaDataVersion,
+        [&metaData](const QByteArray& fileContents, QDataStream& stream) { return metaData._writeParsedMetaData(fileContents, stream); });
+}
+
 void APMParameterMetaData::getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion)
 {
     static const QRegularExpression regex(".*\\.(\\d)\\.(\\d)\\.xml$");
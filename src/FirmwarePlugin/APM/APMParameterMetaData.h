@@ -11,6 +11,7 @@
 #pragma once
 
 #include <QtCore/QObject>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QXmlStreamReader>
 #include <QtCore/QLoggingCategory>
@@ -21,14 +22,10 @@
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataLog)
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataVerboseLog)
 
-class APMFactMetaDataRaw : public QObject
+/// Parameter meta data as read from the meta data file, converted to FactMetaData once the parameter type is known
+class APMFactMetaDataRaw
 {
-    Q_OBJECT
 public:
-    APMFactMetaDataRaw(QObject *parent = nullptr)
-        : QObject(parent), rebootRequired(false)
-    { }
-
     QString name;
     QString category;
     QString group;
@@ -38,16 +35,18 @@ public:
     QString max;
     QString incrementSize;
     QString units;
-    bool    rebootRequired;
-    bool    readOnly;
+    bool    rebootRequired  = false;
+    bool    readOnly        = false;
     QList<QPair<QString, QString> > values;
     QList<QPair<QString, QString> > bitmask;
 };
 
+QDataStream& operator<<(QDataStream& stream, const APMFactMetaDataRaw& rawMetaData);
+QDataStream& operator>>(QDataStream& stream, APMFactMetaDataRaw& rawMetaData);
 
 /// Collection of Parameter Facts for PX4 AutoPilot
 
-typedef QMap<QString, APMFactMetaDataRaw*> ParameterNametoFactMetaDataMap;
+typedef QHash<QString, APMFactMetaDataRaw> ParameterNametoFactMetaDataMap;
 
 class APMParameterMetaData : public QObject
 {
@@ -61,6 +60,10 @@ public:
 
     static void getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion);
 
+    /// Reads the cached binary meta data of the file into memory, parsing the file if it has no cache entry yet. Only
+    /// the raw meta data is built, no FactMetaData, so it is safe to call from any thread.
+    static void preloadCachedMetaData(const QString& metaDataFile);
+
 private:
     enum {
         XmlStateNone,
@@ -74,6 +77,8 @@ private:
         XmlStateDone
     };    
 
+    void _parseParameterFactMetaData(const QByteArray& fileContents);
+    bool _writeParsedMetaData(const QByteArray& fileContents, QDataStream& stream);   ///< ParameterMetaDataCache::Parser
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
     bool skipXMLBlock(QXmlStreamReader& xml, const QString& blockName);
     bool parseParameterAttributes(QXmlStreamReader& xml, APMFactMetaDataRaw *rawMetaData);
@@ -83,7 +88,8 @@ private:
 
     bool                                            _parameterMetaDataLoaded        = false;    ///< true: parameter meta data already loaded
     // FIXME: metadata is vehicle type specific now
-    QMap<QString, ParameterNametoFactMetaDataMap>   _vehicleTypeToParametersMap;                ///< Maps from a vehicle type to paramametertoFactMeta map>
+    QHash<QString, ParameterNametoFactMetaDataMap>  _vehicleTypeToParametersMap;                ///< Maps from a vehicle type to paramametertoFactMeta map>
 
-    static constexpr const char* kInvalidConverstion = "Internal Error: No support for string parameters";
+    static constexpr const char*    kInvalidConverstion     = "Internal Error: No support for string parameters";
+    static constexpr quint32        _binaryMetaDataVersion  = 1;    ///< Bump whenever APMFactMetaDataRaw or its serialization changes
 };
@@ -68,6 +68,10 @@ public:
     ///     value:  remapParamNameMinorVersionRemapMap_t entry
     typedef QMap<int, remapParamNameMinorVersionRemapMap_t> remapParamNameMajorVersionMap_t;
 
+    /// Makes sure the meta data of the specified file is in the parameter meta data cache. Runs on a thread pool
+    /// thread, so it must be a free or static function which touches nothing owned by the gui thread.
+    typedef void (*ParameterMetaDataPreloader)(const QString& metaDataFile);
+
     /// @return The AutoPilotPlugin associated with this firmware plugin. Must be overridden.
     virtual AutoPilotPlugin* autopilotPlugin(Vehicle* vehicle);
 
@@ -240,6 +244,15 @@ public:
     ///     false: Do not send first item to vehicle, sequence numbers must be adjusted
     virtual bool sendHomePositionToVehicle(void);
 
+    /// Number of MISSION_REQUEST_INT messages which may be outstanding at once while reading a plan from the vehicle.
+    /// Firmware which answers each request regardless of the read sequence state can return more than one so the
+    /// download is pipelined instead of taking a full round trip per item.
+    virtual int missionItemReadWindow(void) const { return 1; }
+
+    /// Number of MISSION_ITEM_INT messages to send ahead of the vehicle's MISSION_REQUEST_INT while writing a plan.
+    /// Only firmware which accepts an in-sequence item arriving before it has requested it should return non-zero.
+    virtual int missionItemWriteLookahead(void) const { return 0; }
+
     /// Returns the parameter set version info pulled from inside the meta data file. -1 if not found.
     /// Note: The implementation for this must not vary by vehicle type.
     /// Important: Only CompInfoParam code should use this method
@@ -249,6 +262,15 @@ public:
     /// Important: Only CompInfoParam code should use this method
     virtual QString _internalParameterMetaDataFile(const Vehicle* /*vehicle*/) const { return QString(); }
 
+    /// Returns the internal parameter meta data files which are parsed or read from the cache in the background at
+    /// startup, so the first vehicle to connect does not wait on either.
+    /// Important: Only FirmwarePluginManager should use this method
+    virtual QStringList _parameterMetaDataPreloadFiles(void) const { return QStringList(); }
+
+    /// Returns the function which preloads the files from _parameterMetaDataPreloadFiles, nullptr for none.
+    /// Important: Only FirmwarePluginManager should use this method
+    virtual ParameterMetaDataPreloader _parameterMetaDataPreloader(void) const { return nullptr; }
+
     /// Loads the specified parameter meta data file.
     /// @return Opaque parameter meta data information which must be stored with Vehicle. Vehicle is responsible to
     ///         call deleteParameterMetaData when no longer needed.
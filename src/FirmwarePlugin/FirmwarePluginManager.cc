@@ -14,6 +14,14 @@
 #include "FirmwarePluginManager.h"
 #include "FirmwarePlugin.h"
 #include "FirmwarePluginFactory.h"
+#include "QGCApplication.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThreadPool>
+
+QGC_LOGGING_CATEGORY(FirmwarePluginManagerLog, "FirmwarePluginManagerLog")
 
 FirmwarePluginManager::FirmwarePluginManager(QGCApplication* app, QGCToolbox* toolbox)
     : QGCTool(app, toolbox)
@@ -24,9 +32,57 @@ FirmwarePluginManager::FirmwarePluginManager(QGCApplication* app, QGCToolbox* to
 
 FirmwarePluginManager::~FirmwarePluginManager()
 {
+    // The preload writes to the meta data cache, which must not be torn down under it
+    _preloadFuture.waitForFinished();
     delete _genericFirmwarePlugin;
 }
 
+void FirmwarePluginManager::setToolbox(QGCToolbox* toolbox)
+{
+    QGCTool::setToolbox(toolbox);
+
+    // Unit tests load meta data as needed to keep test runs independent of each other
+    if (!qgcApp()->runningUnitTests()) {
+        _preloadParameterMetaData();
+    }
+}
+
+/// Loads the internal parameter meta data files into ParameterMetaDataCache on a background thread ahead of any vehicle
+/// connecting. A file with a disk cache entry is only read, anything else is parsed and written to the disk cache
+/// there, so the first vehicle never parses on the gui thread. The preloaders are static functions, the plugins
+/// themselves are never used off the gui thread.
+void FirmwarePluginManager::_preloadParameterMetaData(void)
+{
+    QMap<QString, FirmwarePlugin::ParameterMetaDataPreloader> preloadFiles;
+
+    for (FirmwarePluginFactory* factory: FirmwarePluginFactoryRegister::instance()->pluginFactories()) {
+        for (QGCMAVLink::FirmwareClass_t firmwareClass: factory->supportedFirmwareClasses()) {
+            for (QGCMAVLink::VehicleClass_t vehicleClass: factory->supportedVehicleClasses()) {
+                FirmwarePlugin* plugin = factory->firmwarePluginForAutopilot(QGCMAVLink::firmwareClassToAutopilot(firmwareClass), QGCMAVLink::vehicleClassToMavType(vehicleClass));
+                FirmwarePlugin::ParameterMetaDataPreloader preloader = plugin ? plugin->_parameterMetaDataPreloader() : nullptr;
+                if (preloader) {
+                    for (const QString& metaDataFile: plugin->_parameterMetaDataPreloadFiles()) {
+                        preloadFiles[metaDataFile] = preloader;
+                    }
+                }
+            }
+        }
+    }
+
+    if (preloadFiles.isEmpty()) {
+        return;
+    }
+
+    _preloadFuture = QtConcurrent::run(QThreadPool::globalInstance(), [preloadFiles]() {
+        QElapsedTimer preloadTimer;
+        preloadTimer.start();
+        for (auto it = preloadFiles.constBegin(); it != preloadFiles.constEnd(); ++it) {
+            it.value()(it.key());
+        }
+        qCDebug(FirmwarePluginManagerLog) << "Parameter meta data preloaded, files:" << preloadFiles.count() << "msecs:" << preloadTimer.elapsed();
+    });
+}
+
 QList<QGCMAVLink::FirmwareClass_t> FirmwarePluginManager::supportedFirmwareClasses(void)
 {
     if (_supportedFirmwareClasses.isEmpty()) {
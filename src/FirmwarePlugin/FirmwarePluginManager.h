@@ -14,6 +14,11 @@
 #include "QGCMAVLink.h"
 #include "QGCToolbox.h"
 
+#include <QtCore/QFuture>
+#include <QtCore/QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(FirmwarePluginManagerLog)
+
 
 class QGCApplication;
 class FirmwarePlugin;
@@ -41,9 +46,14 @@ public:
     /// @return Singleton FirmwarePlugin instance for the specified MAV_AUTOPILOT.
     FirmwarePlugin* firmwarePluginForAutopilot(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType);
 
+    // Overrides from QGCTool
+    void setToolbox(QGCToolbox* toolbox) final;
+
 private:
     FirmwarePluginFactory* _findPluginFactory(QGCMAVLink::FirmwareClass_t firmwareClass);
+    void _preloadParameterMetaData(void);
 
     FirmwarePlugin*                     _genericFirmwarePlugin;
     QList<QGCMAVLink::FirmwareClass_t>  _supportedFirmwareClasses;
+    QFuture<void>                       _preloadFuture;
 };
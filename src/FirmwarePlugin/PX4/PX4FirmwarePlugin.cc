@@ -332,6 +332,11 @@ QString PX4FirmwarePlugin::missionCommandOverrides(QGCMAVLink::VehicleClass_t ve
     }
 }
 
+FirmwarePlugin::ParameterMetaDataPreloader PX4FirmwarePlugin::_parameterMetaDataPreloader(void) const
+{
+    return &PX4ParameterMetaData::preloadCachedMetaData;
+}
+
 QObject* PX4FirmwarePlugin::_loadParameterMetaData(const QString& metaDataFile)
 {
     PX4ParameterMetaData* metaData = new PX4ParameterMetaData;
@@ -12,6 +12,7 @@
 ///     @author Don Gagne <don@thegagnes.com>
 
 #include "PX4ParameterMetaData.h"
+#include "ParameterMetaDataCache.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QFile>
@@ -87,20 +88,54 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
 
     qCDebug(PX4ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
-    QFile xmlFile(metaDataFile);
-
-    if (!xmlFile.exists()) {
+    if (!QFile::exists(metaDataFile)) {
         qWarning() << "Internal error: metaDataFile mission" << metaDataFile;
         return;
     }
-    
-    if (!xmlFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Internal error: Unable to open parameter file:" << metaDataFile << xmlFile.errorString();
-        return;
+
+    // The XML is only parsed the first time a file is seen, after that the meta data comes from the cache. A badly
+    // formed file leaves whatever was read up to the error, which is cached as well since it depends on the file only.
+    bool parsed = false;
+    const QByteArray binaryMetaData = ParameterMetaDataCache::defaultInstance().metaData(metaDataFile, QStringLiteral("PX4"), _binaryMetaDataVersion,
+        [this](const QByteArray& fileContents, QDataStream& stream) { return _writeParsedMetaData(fileContents, stream); }, &parsed);
+
+    if (!parsed && !binaryMetaData.isEmpty()) {
+        QDataStream stream(binaryMetaData);
+        stream.setVersion(ParameterMetaDataCache::streamVersion);
+        quint32 count = 0;
+        stream >> count;
+        _mapParameterName2FactMetaData.reserve(count);
+        for (quint32 i=0; i<count && stream.status() == QDataStream::Ok; i++) {
+            QString name;
+            FactMetaData* metaData = new FactMetaData(this);
+            stream >> name >> *metaData;
+            _mapParameterName2FactMetaData[name] = metaData;
+        }
+        if (stream.status() != QDataStream::Ok) {
+            qCWarning(PX4ParameterMetaDataLog) << "Cached parameter meta data corrupt:" << metaDataFile;
+            qDeleteAll(_mapParameterName2FactMetaData);
+            _mapParameterName2FactMetaData.clear();
+        }
     }
-    
-    QXmlStreamReader xml(xmlFile.readAll());
-    xmlFile.close();
+
+#ifdef GENERATE_PARAMETER_JSON
+    _generateParameterJson();
+#endif
+}
+
+bool PX4ParameterMetaData::_writeParsedMetaData(const QByteArray& fileContents, QDataStream& stream)
+{
+    _parseParameterFactMetaData(fileContents);
+    stream << static_cast<quint32>(_mapParameterName2FactMetaData.count());
+    for (auto it = _mapParameterName2FactMetaData.constBegin(); it != _mapParameterName2FactMetaData.constEnd(); ++it) {
+        stream << it.key() << *it.value();
+    }
+    return true;
+}
+
+void PX4ParameterMetaData::_parseParameterFactMetaData(const QByteArray& fileContents)
+{
+    QXmlStreamReader xml(fileContents);
     if (xml.hasError()) {
         qWarning() << "Badly formed XML" << xml.errorString();
         return;
@@ -139,7 +174,7 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 }
                 if (intVersion <= 2) {
                     // We can't read these old files
-                    qDebug() << "Parameter version stamp too old, skipping load. Found:" << intVersion << "Want: 3 File:" << metaDataFile;
+                    qDebug() << "Parameter version stamp too old, skipping load. Found:" << intVersion << "Want: 3";
                     return;
                 }
                 
@@ -151,7 +186,7 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "group") {
                 if (xmlState != XmlStateFoundVersion) {
                     // We didn't get a version stamp, assume older version we can't read
-                    qDebug() << "Parameter version stamp not found, skipping load" << metaDataFile;
+                    qDebug() << "Parameter version stamp not found, skipping load";
                     return;
                 }
                 xmlState = XmlStateFoundGroup;
@@ -397,10 +432,6 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         }
         xml.readNext();
     }
-
-#ifdef GENERATE_PARAMETER_JSON
-    _generateParameterJson();
-#endif
 }
 
 #ifdef GENERATE_PARAMETER_JSON
@@ -500,6 +531,13 @@ FactMetaData* PX4ParameterMetaData::getMetaDataForFact(const QString& name, MAV_
     return _mapParameterName2FactMetaData[name];
 }
 
+void PX4ParameterMetaData::preloadCachedMetaData(const QString& metaDataFile)
+{
+    PX4ParameterMetaData metaData;
+    (void) ParameterMetaDataCache::defaultInstance().preload(metaDataFile, QStringLiteral("PX4"), _binaryMetaDataVersion,
+        [&metaData](const QByteArray& fileContents, QDataStream& stream) { return metaData._writeParsedMetaData(fileContents, stream); });
+}
+
 void PX4ParameterMetaData::getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion)
 {
     QFile xmlFile(metaDataFile);
@@ -13,6 +13,7 @@
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QLoggingCategory>
 
@@ -36,6 +37,11 @@ public:
 
     static void getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion);
 
+    /// Reads the cached binary meta data of the file into memory, parsing the file if it has no cache entry yet. Safe to
+    /// call from any thread: the FactMetaData of a parse belong to a throwaway instance on the calling thread and only
+    /// read the units settings.
+    static void preloadCachedMetaData(const QString& metaDataFile);
+
 private:
     enum {
         XmlStateNone,
@@ -46,6 +52,8 @@ private:
         XmlStateDone
     };
 
+    void _parseParameterFactMetaData(const QByteArray& fileContents);
+    bool _writeParsedMetaData(const QByteArray& fileContents, QDataStream& stream);   ///< ParameterMetaDataCache::Parser
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
     static void _outputFileWarning(const QString& metaDataFile, const QString& error1, const QString& error2);
 
@@ -54,8 +62,9 @@ private:
 #endif
 
     bool                                _parameterMetaDataLoaded        = false;    ///< true: parameter meta data already loaded
-    FactMetaData::NameToMetaDataMap_t   _mapParameterName2FactMetaData;             ///< Maps from a parameter name to FactMetaData
+    QHash<QString, FactMetaData*>       _mapParameterName2FactMetaData;             ///< Maps from a parameter name to FactMetaData
 
-    static constexpr const char* kInvalidConverstion = "Internal Error: No support for string parameters";
+    static constexpr const char*    kInvalidConverstion     = "Internal Error: No support for string parameters";
+    static constexpr quint32        _binaryMetaDataVersion  = 1;    ///< Bump whenever the FactMetaData serialization changes
 
 };
@@ -268,6 +268,7 @@ FlightMap {
             onPointAdded: (coordinate) =>       trajectoryPolyline.addCoordinate(coordinate)
             onUpdateLastPoint: (coordinate) =>  trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate)
             onPointsCleared:                    trajectoryPolyline.path = []
+            onPointsSimplified:                 trajectoryPolyline.path = _activeVehicle.trajectoryPoints.list()
         }
     }
 
@@ -300,7 +301,7 @@ FlightMap {
             altitude:       object.altitude
             callsign:       object.callsign
             heading:        object.heading
-            alert:          object.alert
+            alert:          object.alert || object.conflictLevel > 0
             map:            _root
             size:           pipMode ? ScreenTools.defaultFontPixelHeight : ScreenTools.defaultFontPixelHeight * 2.5
             z:              QGroundControl.zOrderVehicles
@@ -9,6 +9,7 @@
 
 #include "LandingComplexItem.h"
 #include "QGCApplication.h"
+#include "QGCSignalCoalescer.h"
 #include "JsonHelper.h"
 #include "MissionController.h"
 #include "SimpleMissionItem.h"
@@ -28,8 +29,7 @@ LandingComplexItem::LandingComplexItem(PlanMasterController* masterController, b
     _isIncomplete = false;
 
     // The following is used to compress multiple recalc calls in a row to into a single call.
-    connect(this, &LandingComplexItem::_updateFlightPathSegmentsSignal, this, &LandingComplexItem::_updateFlightPathSegmentsDontCallDirectly,   Qt::QueuedConnection);
-    qgcApp()->addCompressedSignal(QMetaMethod::fromSignal(&LandingComplexItem::_updateFlightPathSegmentsSignal));
+    QGCSignalCoalescer::connect(this, &LandingComplexItem::_updateFlightPathSegmentsSignal, this, &LandingComplexItem::_updateFlightPathSegmentsDontCallDirectly);
 }
 
 void LandingComplexItem::_init(void)
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PlanCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QStandardPaths>
+
+QGC_LOGGING_CATEGORY(PlanCacheLog, "PlanCacheLog")
+
+PlanCache::PlanCache(const QString& path, int maxNumPlans)
+    : _blobCache(path, maxNumPlans, _magic, _version)
+{
+
+}
+
+PlanCache& PlanCache::defaultInstance()
+{
+    static PlanCache instance(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCPlanCache"), 100);
+    return instance;
+}
+
+QString PlanCache::fileTag(int vehicleId, MAV_AUTOPILOT firmwareType, MAV_MISSION_TYPE planType, uint32_t opaqueId, int count)
+{
+    if (opaqueId == 0) {
+        return QString();
+    }
+    return QStringLiteral("plan_%1_%2_%3_%4_%5").arg(firmwareType).arg(vehicleId).arg(planType).arg(opaqueId, 8, 16, QLatin1Char('0')).arg(count);
+}
+
+bool PlanCache::load(const QString& fileTag, QList<mavlink_mission_item_int_t>& items)
+{
+    items.clear();
+    if (fileTag.isEmpty()) {
+        return false;
+    }
+
+    QByteArray payload;
+    if (!_blobCache.load(fileTag, payload)) {
+        return false;
+    }
+    if ((payload.size() % sizeof(mavlink_mission_item_int_t)) != 0) {
+        qCWarning(PlanCacheLog) << "Cached plan payload corrupt" << fileTag;
+        return false;
+    }
+
+    items.resize(payload.size() / sizeof(mavlink_mission_item_int_t));
+    memcpy(items.data(), payload.constData(), payload.size());
+    qCDebug(PlanCacheLog) << "Loaded cached plan" << fileTag << "count:" << items.count();
+    return true;
+}
+
+void PlanCache::save(const QString& fileTag, const QList<mavlink_mission_item_int_t>& items)
+{
+    if (fileTag.isEmpty() || items.isEmpty()) {
+        return;
+    }
+
+    const QByteArray payload(reinterpret_cast<const char*>(items.constData()), items.count() * sizeof(mavlink_mission_item_int_t));
+    if (_blobCache.save(fileTag, payload)) {
+        qCDebug(PlanCacheLog) << "Saved plan to cache" << fileTag << "count:" << items.count();
+    }
+}
@@ -0,0 +1,47 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+#include "ComponentInformationBlobCache.h"
+#include "MAVLinkLib.h"
+
+Q_DECLARE_LOGGING_CATEGORY(PlanCacheLog)
+
+/// Local store of the last plans seen on each vehicle. Entries are keyed by the opaque_id the vehicle reports in
+/// MISSION_COUNT and MISSION_ACK, which changes whenever the plan on the vehicle changes. Items are stored exactly
+/// as they go over the wire so a cache hit goes through the same conversion as a download.
+class PlanCache
+{
+public:
+    PlanCache(const QString& path, int maxNumPlans);
+
+    static PlanCache& defaultInstance();
+
+    /// Returns the cache key for a plan. An opaque_id of 0 means the vehicle does not support plan identifiers
+    /// in which case an empty tag is returned and nothing is cached.
+    static QString fileTag(int vehicleId, MAV_AUTOPILOT firmwareType, MAV_MISSION_TYPE planType, uint32_t opaqueId, int count);
+
+    /// Loads a plan from the cache
+    ///     @return false: not in the cache or the entry is corrupt
+    bool load(const QString& fileTag, QList<mavlink_mission_item_int_t>& items);
+
+    /// Stores a plan in the cache. Existing entries are left as is since the tag identifies the content.
+    void save(const QString& fileTag, const QList<mavlink_mission_item_int_t>& items);
+
+private:
+    static constexpr quint32 _magic     = 0x51504c43;   ///< "QPLC"
+    static constexpr quint32 _version   = 2;
+
+    ComponentInformationBlobCache _blobCache;
+};
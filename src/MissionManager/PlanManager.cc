@@ -13,7 +13,11 @@
 #include "MAVLinkProtocol.h"
 #include "QGCApplication.h"
 #include "MissionCommandTree.h"
+#include "PlanCache.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMetrics.h"
+
+#include <algorithm>
 
 QGC_LOGGING_CATEGORY(PlanManagerLog, "PlanManagerLog")
 
@@ -28,6 +32,9 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
     , _resumeMission            (false)
     , _lastMissionRequest       (-1)
     , _missionItemCountToRead   (-1)
+    , _readWindow               (1)
+    , _writeLookahead           (0)
+    , _writeLookaheadSeq        (-1)
     , _currentMissionIndex      (-1)
     , _lastCurrentIndex         (-1)
 {
@@ -35,6 +42,10 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
     _ackTimeoutTimer->setSingleShot(true);
 
     connect(_ackTimeoutTimer, &QTimer::timeout, this, &PlanManager::_ackTimeout);
+
+    const QGCMetrics::Labels labels = { { QStringLiteral("plan"), _planTypeString() } };
+    _readLostMetric     = QGCMetrics::instance()->counter(QStringLiteral("qgc_plan_read_lost_items"), QStringLiteral("Mission item requests presumed lost because a later request was answered first"), labels);
+    _readTimeoutMetric  = QGCMetrics::instance()->counter(QStringLiteral("qgc_plan_read_timeouts"), QStringLiteral("Mission item reads where the vehicle stopped answering until the ack timeout"), labels);
 }
 
 PlanManager::~PlanManager()
@@ -55,6 +66,9 @@ void PlanManager::_writeMissionItemsWorker(void)
     for (int i=0; i<_writeMissionItems.count(); i++) {
         _itemIndicesToWrite << i;
     }
+    _buildWriteMissionItemsInt();
+    _writeLookahead = _vehicle->firmwarePlugin()->missionItemWriteLookahead();
+    _writeLookaheadSeq = -1;
 
     _retryCount = 0;
     _setTransactionInProgress(TransactionWrite);
@@ -196,6 +210,7 @@ void PlanManager::_ackTimeout(void)
             _finishTransaction(false);
         } else {
             _retryCount++;
+            _readTimeoutMetric->add();
             qCDebug(PlanManagerLog) << tr("Retrying %1 MISSION_REQUEST retry Count").arg(_planTypeString()) << _retryCount;
             _requestNextMissionItem();
         }
@@ -334,19 +349,27 @@ void PlanManager::_handleMissionCount(const mavlink_message_t& message)
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 count:").arg(_planTypeString()) << missionCount.count;
 
     _retryCount = 0;
+    _readPlanCacheTag = PlanCache::fileTag(_vehicle->id(), _vehicle->firmwareType(), _planType, missionCount.opaque_id, missionCount.count);
 
     if (missionCount.count == 0) {
         _readTransactionComplete();
+    } else if (_loadFromPlanCache()) {
+        // Same plan as last time we saw this vehicle, no need to download it again
+        _readTransactionComplete();
     } else {
         // Prime read list
         for (int i=0; i<missionCount.count; i++) {
             _itemIndicesToRead << i;
         }
         _missionItemCountToRead = missionCount.count;
+        _readWindow = qMax(1, _vehicle->firmwarePlugin()->missionItemReadWindow());
+        _readRequestsInFlight.clear();
         _requestNextMissionItem();
     }
 }
 
+/// Keeps up to _readWindow MISSION_REQUEST_INT messages outstanding, always asking for the lowest items which are
+/// neither received nor in flight. With a window of one this is the classic request/response sequence.
 void PlanManager::_requestNextMissionItem(void)
 {
     if (_itemIndicesToRead.count() == 0) {
@@ -354,7 +377,25 @@ void PlanManager::_requestNextMissionItem(void)
         return;
     }
 
-    qCDebug(PlanManagerLog) << QStringLiteral("_requestNextMissionItem %1 sequenceNumber:retry").arg(_planTypeString()) << _itemIndicesToRead[0] << _retryCount;
+    if (_retryCount != 0) {
+        // The vehicle stopped answering, whatever was still outstanding is lost
+        _readRequestsInFlight.clear();
+    }
+
+    // _itemIndicesToRead is kept in ascending order
+    for (int i=0; i<_itemIndicesToRead.count() && _readRequestsInFlight.count() < _readWindow; i++) {
+        const int seq = _itemIndicesToRead[i];
+        if (!_readRequestsInFlight.contains(seq)) {
+            _readRequestsInFlight.append(seq);
+            _sendMissionRequest(seq);
+        }
+    }
+    _startAckTimeout(AckMissionItem);
+}
+
+void PlanManager::_sendMissionRequest(int seq)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_requestNextMissionItem %1 sequenceNumber:retry").arg(_planTypeString()) << seq << _retryCount;
 
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
@@ -366,45 +407,55 @@ void PlanManager::_requestNextMissionItem(void)
                                                   &message,
                                                   _vehicle->id(),
                                                   MAV_COMP_ID_AUTOPILOT1,
-                                                  _itemIndicesToRead[0],
+                                                  seq,
                                                   _planType);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
     }
-    _startAckTimeout(AckMissionItem);
 }
 
-void PlanManager::_handleMissionItem(const mavlink_message_t& message)
+/// Converts a MISSION_ITEM_INT as sent by the vehicle into the internal representation
+MissionItem* PlanManager::_createMissionItem(const mavlink_mission_item_int_t& missionItem)
 {
-    MAV_CMD          command;
-    MAV_FRAME        frame;
-    MAV_MISSION_TYPE missionType;
-    double           param1;
-    double           param2;
-    double           param3;
-    double           param4;
-    double           param5;
-    double           param6;
-    double           param7;
-    bool             autoContinue;
-    bool             isCurrentItem;
-    int              seq;
+    MAV_FRAME frame = (MAV_FRAME)missionItem.frame;
+
+    // We don't support editing ALT_INT frames so change on the way in.
+    if (frame == MAV_FRAME_GLOBAL_INT) {
+        frame = MAV_FRAME_GLOBAL;
+    } else if (frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+        frame = MAV_FRAME_GLOBAL_RELATIVE_ALT;
+    }
+
+    MissionItem* item = new MissionItem(missionItem.seq,
+                                        (MAV_CMD)missionItem.command,
+                                        frame,
+                                        missionItem.param1,
+                                        missionItem.param2,
+                                        missionItem.param3,
+                                        missionItem.param4,
+                                        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.x : (double)missionItem.x * 1e-7,
+                                        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.y : (double)missionItem.y * 1e-7,
+                                        (double)missionItem.z,
+                                        missionItem.autocontinue,
+                                        missionItem.current,
+                                        this);
+
+    if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
+        // Home is in position 0
+        item->setParam1((int)item->param1() + 1);
+    }
 
+    return item;
+}
+
+void PlanManager::_handleMissionItem(const mavlink_message_t& message)
+{
     mavlink_mission_item_int_t missionItem;
     mavlink_msg_mission_item_int_decode(&message, &missionItem);
 
-    command =       (MAV_CMD)missionItem.command;
-    frame =         (MAV_FRAME)missionItem.frame;
-    missionType =   (MAV_MISSION_TYPE)missionItem.mission_type;
-    param1 =        missionItem.param1;
-    param2 =        missionItem.param2;
-    param3 =        missionItem.param3;
-    param4 =        missionItem.param4;
-    param5 =        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.x : (double)missionItem.x * 1e-7;
-    param6 =        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.y : (double)missionItem.y * 1e-7;
-    param7 =        (double)missionItem.z;
-    autoContinue =  missionItem.autocontinue;
-    isCurrentItem = missionItem.current;
-    seq =           missionItem.seq;
+    const MAV_CMD           command =       (MAV_CMD)missionItem.command;
+    const MAV_MISSION_TYPE  missionType =   (MAV_MISSION_TYPE)missionItem.mission_type;
+    const bool              isCurrentItem = missionItem.current;
+    const int               seq =           missionItem.seq;
 
     // Check the mission_type field. It can happen that we receive a late duplicate message for a
     // different mission_type request.
@@ -413,13 +464,6 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
        return;
     }
 
-    // We don't support editing ALT_INT frames so change on the way in.
-    if (frame == MAV_FRAME_GLOBAL_INT) {
-        frame = MAV_FRAME_GLOBAL;
-    } else if (frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-        frame = MAV_FRAME_GLOBAL_RELATIVE_ALT;
-    }
-
     bool ardupilotHomePositionUpdate = false;
     if (!_checkForExpectedAck(AckMissionItem)) {
         if (_vehicle->apmFirmware() && seq ==  0 && _planType == MAV_MISSION_TYPE_MISSION) {
@@ -433,34 +477,35 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 seq:command:current:ardupilotHomePositionUpdate").arg(_planTypeString()) << seq << command << isCurrentItem << ardupilotHomePositionUpdate;
 
     if (ardupilotHomePositionUpdate) {
-        QGeoCoordinate newHomePosition(param5, param6, param7);
+        const double scale = missionItem.frame == MAV_FRAME_MISSION ? 1.0 : 1e-7;
+        QGeoCoordinate newHomePosition(missionItem.x * scale, missionItem.y * scale, missionItem.z);
         _vehicle->_setHomePosition(newHomePosition);
         return;
     }
     
+    // The vehicle answers requests in order, so anything requested before this item and still unanswered was lost.
+    // Those requests leave the window and go out again.
+    const qsizetype inFlightIndex = _readRequestsInFlight.indexOf(seq);
+    if (inFlightIndex >= 0) {
+        if (inFlightIndex > 0) {
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 requests presumed lost:").arg(_planTypeString()) << _readRequestsInFlight.mid(0, inFlightIndex);
+            _readLostMetric->add(inFlightIndex);
+        }
+        _readRequestsInFlight.remove(0, inFlightIndex + 1);
+    }
+
     if (_itemIndicesToRead.contains(seq)) {
         _itemIndicesToRead.removeOne(seq);
 
-        MissionItem* item = new MissionItem(seq,
-                                            command,
-                                            frame,
-                                            param1,
-                                            param2,
-                                            param3,
-                                            param4,
-                                            param5,
-                                            param6,
-                                            param7,
-                                            autoContinue,
-                                            isCurrentItem,
-                                            this);
-
-        if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
-            // Home is in position 0
-            item->setParam1((int)item->param1() + 1);
-        }
+        MissionItem* item = _createMissionItem(missionItem);
 
-        _missionItems.append(item);
+        // With more than one request outstanding items can arrive out of order after a retry
+        auto insertPos = std::upper_bound(_missionItems.begin(), _missionItems.end(), seq, [](int seq, const MissionItem* missionItem) {
+            return seq < missionItem->sequenceNumber();
+        });
+        const qsizetype insertIndex = std::distance(_missionItems.begin(), insertPos);
+        _missionItems.insert(insertIndex, item);
+        _readMissionItemsInt.insert(insertIndex, missionItem);
     } else {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 mission item received item index which was not requested, disregrarding:").arg(_planTypeString()) << seq;
         // We have to put the ack timeout back since it was removed above
@@ -468,10 +513,11 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
         return;
     }
 
-    emit progressPctChanged((double)seq / (double)_missionItemCountToRead);
+    emit progressPctChanged((double)(_missionItemCountToRead - _itemIndicesToRead.count()) / (double)_missionItemCountToRead);
     
     _retryCount = 0;
     if (_itemIndicesToRead.count() == 0) {
+        PlanCache::defaultInstance().save(_readPlanCacheTag, _readMissionItemsInt);
         _readTransactionComplete();
     } else {
         _requestNextMissionItem();
@@ -481,9 +527,26 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
 void PlanManager::_clearMissionItems(void)
 {
     _itemIndicesToRead.clear();
+    _readMissionItemsInt.clear();
     _clearAndDeleteMissionItems();
 }
 
+/// Fills _missionItems from the local plan cache if the vehicle reported an identifier we have seen before
+///     @return true: Plan was loaded from the cache
+bool PlanManager::_loadFromPlanCache(void)
+{
+    QList<mavlink_mission_item_int_t> cachedItems;
+    if (!PlanCache::defaultInstance().load(_readPlanCacheTag, cachedItems)) {
+        return false;
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_loadFromPlanCache %1 skipping download, using cached plan").arg(_planTypeString()) << _readPlanCacheTag;
+    for (const mavlink_mission_item_int_t& cachedItem: cachedItems) {
+        _missionItems.append(_createMissionItem(cachedItem));
+    }
+    return true;
+}
+
 void PlanManager::_handleMissionRequest(const mavlink_message_t& message)
 {
     MAV_MISSION_TYPE    missionRequestMissionType;
@@ -516,41 +579,80 @@ void PlanManager::_handleMissionRequest(const mavlink_message_t& message)
     emit progressPctChanged((double)missionRequestSeq / (double)_writeMissionItems.count());
 
     _lastMissionRequest = missionRequestSeq;
+    bool alreadySent = false;
     if (!_itemIndicesToWrite.contains(missionRequestSeq)) {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequence number requested which has already been sent, sending again:").arg(_planTypeString()) << missionRequestSeq;
+        // Anything sent ahead of a re-requested item was dropped by the vehicle, so the look ahead restarts from here
+        _writeLookaheadSeq = missionRequestSeq;
     } else {
         _itemIndicesToWrite.removeOne(missionRequestSeq);
+        // First request for an item which went out ahead of the request is already on its way
+        alreadySent = missionRequestSeq <= _writeLookaheadSeq;
     }
-    
-    MissionItem* item = _writeMissionItems[missionRequestSeq];
-    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << missionRequestSeq << item->command();
+
+    if (alreadySent) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber already sent ahead of request").arg(_planTypeString()) << missionRequestSeq;
+    } else {
+        _sendMissionItem(missionRequestSeq);
+    }
+
+    // Send the next items ahead of their requests so the vehicle does not wait a round trip for each one
+    const int lookaheadEnd = qMin(missionRequestSeq + _writeLookahead, _writeMissionItemsInt.count() - 1);
+    for (int seq=qMax(missionRequestSeq, _writeLookaheadSeq) + 1; seq<=lookaheadEnd; seq++) {
+        _sendMissionItem(seq);
+    }
+    _writeLookaheadSeq = qMax(_writeLookaheadSeq, lookaheadEnd);
+
+    _startAckTimeout(AckMissionRequest);
+}
+
+void PlanManager::_sendMissionItem(int seq)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << seq << _writeMissionItemsInt[seq].command;
 
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
-        mavlink_message_t       messageOut;
-
-        mavlink_msg_mission_item_int_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
-                                               qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
-                                               sharedLink->mavlinkChannel(),
-                                               &messageOut,
-                                               _vehicle->id(),
-                                               MAV_COMP_ID_AUTOPILOT1,
-                                               missionRequestSeq,
-                                               item->frame(),
-                                               item->command(),
-                                               missionRequestSeq == 0,
-                                               item->autoContinue(),
-                                               item->param1(),
-                                               item->param2(),
-                                               item->param3(),
-                                               item->param4(),
-                                               item->frame() == MAV_FRAME_MISSION ? item->param5() : item->param5() * 1e7,
-                                               item->frame() == MAV_FRAME_MISSION ? item->param6() : item->param6() * 1e7,
-                                               item->param7(),
-                                               _planType);
+        mavlink_message_t messageOut;
+
+        // The payload is built once per write and reused for re-requests. It is still encoded per send so the
+        // message gets a fresh sequence number and signature.
+        mavlink_msg_mission_item_int_encode_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
+                                                 qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
+                                                 sharedLink->mavlinkChannel(),
+                                                 &messageOut,
+                                                 &_writeMissionItemsInt[seq]);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), messageOut);
     }
-    _startAckTimeout(AckMissionRequest);
+}
+
+/// Generates the MISSION_ITEM_INT payloads for the whole write list in one pass
+void PlanManager::_buildWriteMissionItemsInt(void)
+{
+    _writeMissionItemsInt.clear();
+    _writeMissionItemsInt.reserve(_writeMissionItems.count());
+
+    for (int seq=0; seq<_writeMissionItems.count(); seq++) {
+        const MissionItem* item = _writeMissionItems[seq];
+        mavlink_mission_item_int_t missionItemInt;
+
+        memset(&missionItemInt, 0, sizeof(missionItemInt));
+        missionItemInt.target_system    = _vehicle->id();
+        missionItemInt.target_component = MAV_COMP_ID_AUTOPILOT1;
+        missionItemInt.seq              = seq;
+        missionItemInt.frame            = item->frame();
+        missionItemInt.command          = item->command();
+        missionItemInt.current          = seq == 0;
+        missionItemInt.autocontinue     = item->autoContinue();
+        missionItemInt.param1           = item->param1();
+        missionItemInt.param2           = item->param2();
+        missionItemInt.param3           = item->param3();
+        missionItemInt.param4           = item->param4();
+        missionItemInt.x                = item->frame() == MAV_FRAME_MISSION ? item->param5() : item->param5() * 1e7;
+        missionItemInt.y                = item->frame() == MAV_FRAME_MISSION ? item->param6() : item->param6() * 1e7;
+        missionItemInt.z                = item->param7();
+        missionItemInt.mission_type     = _planType;
+        _writeMissionItemsInt.append(missionItemInt);
+    }
 }
 
 void PlanManager::_handleMissionAck(const mavlink_message_t& message)
@@ -608,6 +710,9 @@ void PlanManager::_handleMissionAck(const mavlink_message_t& message)
         if (missionAck.type == MAV_MISSION_ACCEPTED) {
             if (_itemIndicesToWrite.count() == 0) {
                 qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck write sequence complete %1").arg(_planTypeString());
+                // Remember what we wrote so the next connect can skip downloading it again
+                PlanCache::defaultInstance().save(PlanCache::fileTag(_vehicle->id(), _vehicle->firmwareType(), _planType, missionAck.opaque_id, _writeMissionItemsInt.count()),
+                                                  _writeMissionItemsInt);
                 _finishTransaction(true);
             } else {
                 // FIXME: Protocol error
@@ -809,6 +914,7 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
 
     _itemIndicesToRead.clear();
     _itemIndicesToWrite.clear();
+    _writeMissionItemsInt.clear();
 
     // First thing we do is clear the transaction. This way inProgesss is off when we signal transaction complete.
     TransactionType_t currentTransactionType = _transactionInProgress;
@@ -18,6 +18,7 @@
 
 class Vehicle;
 class MissionCommandTree;
+class QGCMetricCounter;
 
 Q_DECLARE_LOGGING_CATEGORY(PlanManagerLog)
 
@@ -115,6 +116,11 @@ protected:
     void _handleMissionRequest(const mavlink_message_t& message);
     void _handleMissionAck(const mavlink_message_t& message);
     void _requestNextMissionItem(void);
+    MissionItem* _createMissionItem(const mavlink_mission_item_int_t& missionItem);
+    bool _loadFromPlanCache(void);
+    void _sendMissionRequest(int seq);
+    void _sendMissionItem(int seq);
+    void _buildWriteMissionItemsInt(void);
     void _clearMissionItems(void);
     void _sendError(ErrorCode_t errorCode, const QString& errorMsg);
     QString _ackTypeToString(AckType_t ackType);
@@ -146,12 +152,22 @@ protected:
     QList<int>          _itemIndicesToRead;     ///< List of mission items which still need to be requested from vehicle
     int                 _lastMissionRequest;    ///< Index of item last requested by MISSION_REQUEST
     int                 _missionItemCountToRead;///< Count of all mission items to read
+    int                 _readWindow;            ///< Maximum number of outstanding MISSION_REQUEST_INT during read
+    QList<int>          _readRequestsInFlight;  ///< Outstanding MISSION_REQUEST_INT sequence numbers, in the order sent
+    int                 _writeLookahead;        ///< Number of items sent ahead of the vehicle's requests during write
+    int                 _writeLookaheadSeq;     ///< Highest sequence number sent so far during write, -1 for none
 
     QList<MissionItem*> _missionItems;          ///< Set of mission items on vehicle
     QList<MissionItem*> _writeMissionItems;     ///< Set of mission items currently being written to vehicle
+    QList<mavlink_mission_item_int_t> _writeMissionItemsInt; ///< Payloads for _writeMissionItems, generated once per write
+    QList<mavlink_mission_item_int_t> _readMissionItemsInt;  ///< Payloads for _missionItems as received during read
+    QString             _readPlanCacheTag;      ///< PlanCache key for the plan being read, empty if vehicle has no plan identifier
     int                 _currentMissionIndex;
     int                 _lastCurrentIndex;
 
+    QGCMetricCounter*   _readLostMetric =       nullptr;
+    QGCMetricCounter*   _readTimeoutMetric =    nullptr;
+
 private:
     void _setTransactionInProgress(TransactionType_t type);
 };
@@ -11,6 +11,7 @@
 #include "JsonHelper.h"
 #include "MissionController.h"
 #include "QGCApplication.h"
+#include "QGCSignalCoalescer.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
 #include "PlanMasterController.h"
@@ -103,8 +104,7 @@ StructureScanComplexItem::StructureScanComplexItem(PlanMasterController* masterC
     connect(_missionController,                     &MissionController::plannedHomePositionChanged, this, &StructureScanComplexItem::_updateFlightPathSegmentsSignal);
 
     // The follow is used to compress multiple recalc calls in a row to into a single call.
-    connect(this, &StructureScanComplexItem::_updateFlightPathSegmentsSignal, this, &StructureScanComplexItem::_updateFlightPathSegmentsDontCallDirectly,   Qt::QueuedConnection);
-    qgcApp()->addCompressedSignal(QMetaMethod::fromSignal(&StructureScanComplexItem::_updateFlightPathSegmentsSignal));
+    QGCSignalCoalescer::connect(this, &StructureScanComplexItem::_updateFlightPathSegmentsSignal, this, &StructureScanComplexItem::_updateFlightPathSegmentsDontCallDirectly);
 
     _recalcLayerInfo();
 
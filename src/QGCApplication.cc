@@ -17,6 +17,7 @@
  */
 
 #include <QtCore/QFile>
+#include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
 #include <QtGui/QFontDatabase>
 #include <QtGui/QIcon>
@@ -37,6 +38,9 @@
 #include "QGCPalette.h"
 #include "QGCMapPalette.h"
 #include "QGCLoggingCategory.h"
+#include "QGCStartupProfiler.h"
+#include "QGCMetrics.h"
+#include "QGCSignalCoalescer.h"
 #include "ParameterEditorController.h"
 #include "ESP8266ComponentController.h"
 #include "ScreenToolsController.h"
@@ -50,6 +54,7 @@
 #include "Vehicle.h"
 #include "JoystickConfigController.h"
 #include "JoystickManager.h"
+#include "MAVLinkLogManager.h"
 #include "QmlObjectListModel.h"
 #include "QGCGeoBoundingCube.h"
 #include "MissionManager.h"
@@ -57,6 +62,7 @@
 #include "FlightPathSegment.h"
 #include "PlanMasterController.h"
 #include "VideoManager.h"
+#include "LogAnalysisController.h"
 #include "LogDownloadController.h"
 #if !defined(QGC_DISABLE_MAVLINK_INSPECTOR)
 #include "MAVLinkInspectorController.h"
@@ -75,11 +81,13 @@
 #include "VisualMissionItem.h"
 #include "EditPositionDialogController.h"
 #include "FactGroup.h"
+#include "FactGroupSubscription.h"
 #include "FactPanelController.h"
 #include "FactValueSliderListModel.h"
 #include "ShapeFileHelper.h"
 #include "QGCFileDownload.h"
 #include "MAVLinkConsoleController.h"
+#include "MetricsController.h"
 #include "MAVLinkChartController.h"
 #include "GeoTagController.h"
 #include "LogReplayLink.h"
@@ -152,6 +160,10 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     bool fClearCache = false;           // Clear parameter/airframe caches
     bool logging = false;               // Turn on logging
     QString loggingOptions;
+    bool startupTrace = false;          // Write startup trace
+    QString startupTraceFile;
+    bool metricsExport = false;         // Write metrics periodically
+    QString metricsFile;
 
     CmdLineOpt_t rgCmdLineOptions[] = {
         { "--clear-settings",   &fClearSettingsOptions, nullptr },
@@ -159,11 +171,27 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
         { "--logging",          &logging,               &loggingOptions },
         { "--fake-mobile",      &_fakeMobile,           nullptr },
         { "--log-output",       &_logOutput,            nullptr },
+        { "--startup-trace",    &startupTrace,          &startupTraceFile },
+        { "--metrics-file",     &metricsExport,         &metricsFile },
         // Add additional command line option flags here
     };
 
     ParseCmdLineOptions(argc, argv, rgCmdLineOptions, sizeof(rgCmdLineOptions)/sizeof(rgCmdLineOptions[0]), false);
 
+    if (startupTrace) {
+        if (startupTraceFile.isEmpty()) {
+            startupTraceFile = QDir::temp().filePath(QStringLiteral("QGCStartupTrace.json"));
+        }
+        QGCStartupProfiler::instance()->setTraceFile(startupTraceFile);
+    }
+
+    if (metricsExport) {
+        if (metricsFile.isEmpty()) {
+            metricsFile = QDir::temp().filePath(QStringLiteral("QGCMetrics.prom"));
+        }
+        QGCMetrics::instance()->setExportFile(metricsFile);
+    }
+
     // Set up timer for delayed missing fact display
     _missingParamsDelayedDisplayTimer.setSingleShot(true);
     _missingParamsDelayedDisplayTimer.setInterval(_missingParamsDelayedDisplayTimerTimeout);
@@ -244,8 +272,11 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     // We need to set language as early as possible prior to loading on JSON files.
     setLanguage();
 
-    _toolbox = new QGCToolbox(this);
-    _toolbox->setChildToolboxes();
+    {
+        QGCStartupProfiler::Scope profilerScope(QStringLiteral("QGCToolbox"), "toolbox");
+        _toolbox = new QGCToolbox(this);
+        _toolbox->setChildToolboxes();
+    }
 
 #ifndef DAILY_BUILD
     _checkForNewVersion();
@@ -293,6 +324,8 @@ void QGCApplication::setLanguage()
             qCWarning(LocalizationLog) << "Error loading json localization for" << _locale.name();
         }
     }
+    // Json meta data parsed from here on must pick up the new translations
+    FactMetaData::clearJsonFileCache();
     if(_qmlAppEngine) {
         _qmlAppEngine->retranslate();
     }
@@ -311,6 +344,7 @@ void QGCApplication::init()
     qmlRegisterType<Fact>               ("QGroundControl.FactSystem", 1, 0, "Fact");
     qmlRegisterType<FactMetaData>       ("QGroundControl.FactSystem", 1, 0, "FactMetaData");
     qmlRegisterType<FactPanelController>("QGroundControl.FactSystem", 1, 0, "FactPanelController");
+    qmlRegisterType<FactGroupSubscription>("QGroundControl.FactSystem", 1, 0, "FactGroupSubscription");
 
     qmlRegisterUncreatableType<FactGroup>               ("QGroundControl.FactSystem",   1, 0, "FactGroup",                  "Reference only");
     qmlRegisterUncreatableType<FactValueSliderListModel>("QGroundControl.FactControls", 1, 0, "FactValueSliderListModel",   "Reference only");
@@ -348,6 +382,7 @@ void QGCApplication::init()
     qmlRegisterUncreatableType<Autotune>              ("QGroundControl.Vehicle",   1, 0, "Autotune",               "Reference only");
     qmlRegisterUncreatableType<RemoteIDManager>       ("QGroundControl.Vehicle",   1, 0, "RemoteIDManager",        "Reference only");
     qmlRegisterUncreatableType<TrajectoryPoints>      ("QGroundControl.FlightMap", 1, 0, "TrajectoryPoints",       "Reference only");
+    qmlRegisterUncreatableType<MAVLinkLogManager>     ("QGroundControl.MAVLinkLogManager", 1, 0, "MAVLinkLogManager", "Reference only");
     qmlRegisterUncreatableType<VehicleObjectAvoidance>("QGroundControl.Vehicle",   1, 0, "VehicleObjectAvoidance", "Reference only");
 
 
@@ -371,8 +406,10 @@ void QGCApplication::init()
     qmlRegisterType<MAVLinkInspectorController>       ("QGroundControl.Controllers", 1, 0, "MAVLinkInspectorController");
 #endif
     qmlRegisterType<GeoTagController>        ("QGroundControl.Controllers", 1, 0, "GeoTagController");
+    qmlRegisterType<LogAnalysisController>   ("QGroundControl.Controllers", 1, 0, "LogAnalysisController");
     qmlRegisterType<LogDownloadController>   ("QGroundControl.Controllers", 1, 0, "LogDownloadController");
     qmlRegisterType<MAVLinkConsoleController>("QGroundControl.Controllers", 1, 0, "MAVLinkConsoleController");
+    qmlRegisterType<MetricsController>       ("QGroundControl.Controllers", 1, 0, "MetricsController");
 
 
     qmlRegisterUncreatableType<AutoPilotPlugin>("QGroundControl.AutoPilotPlugin", 1, 0, "AutoPilotPlugin", "Reference only");
@@ -402,6 +439,7 @@ void QGCApplication::init()
         _initForNormalAppBoot();
     } else {
         AudioOutput::instance()->setMuted(true);
+        QGCStartupProfiler::instance()->finish();
     }
 }
 
@@ -413,12 +451,22 @@ void QGCApplication::_initForNormalAppBoot()
 #endif
 
     QQuickStyle::setStyle("Basic");
-    _qmlAppEngine = _toolbox->corePlugin()->createQmlApplicationEngine(this);
+    {
+        QGCStartupProfiler::Scope profilerScope(QStringLiteral("createQmlApplicationEngine"), "qml");
+        _qmlAppEngine = _toolbox->corePlugin()->createQmlApplicationEngine(this);
+    }
     QObject::connect(_qmlAppEngine, &QQmlApplicationEngine::objectCreationFailed, this, QCoreApplication::quit, Qt::QueuedConnection);
-    _toolbox->corePlugin()->createRootWindow(_qmlAppEngine);
+    QObject::connect(_qmlAppEngine, &QQmlApplicationEngine::objectCreated, this, [](QObject* object, const QUrl& url) {
+        QGCStartupProfiler::instance()->addInstantEvent(QStringLiteral("Created %1").arg(url.toString()), object ? "qml" : "qml failed");
+    });
+    {
+        QGCStartupProfiler::Scope profilerScope(QStringLiteral("createRootWindow"), "qml");
+        _toolbox->corePlugin()->createRootWindow(_qmlAppEngine);
+    }
 
     AudioOutput::instance()->init(_toolbox->settingsManager()->appSettings()->audioMuted());
     FollowMe::instance()->init();
+    QGCMetrics::instance()->start(this);
 
     // Image provider for Optical Flow
     _qmlAppEngine->addImageProvider(qgcImageProviderId, new QGCImageProvider());
@@ -427,6 +475,13 @@ void QGCApplication::_initForNormalAppBoot()
     if (rootWindow) {
         rootWindow->scheduleRenderJob(new FinishVideoInitialization(_toolbox->videoManager()),
                 QQuickWindow::BeforeSynchronizingStage);
+
+        // frameSwapped comes from the render thread, the context object queues the call over to the gui thread
+        (void) connect(rootWindow, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped, Qt::SingleShotConnection);
+
+        Fact* frameSyncedTelemetry = _toolbox->settingsManager()->appSettings()->frameSyncedTelemetry();
+        (void) connect(frameSyncedTelemetry, &Fact::rawValueChanged, this, &QGCApplication::_frameSyncedTelemetryChanged);
+        _frameSyncedTelemetryChanged();
     }
 
     // Safe to show popup error messages now that main window is created
@@ -466,8 +521,10 @@ void QGCApplication::_initForNormalAppBoot()
     // Load known link configurations
     _toolbox->linkManager()->loadLinkConfigurationList();
 
-    // Probe for joysticks
-    _toolbox->joystickManager()->init();
+    // Probing for joysticks can be slow, so it waits for the first frame
+    if (!rootWindow) {
+        _toolbox->joystickManager()->init();
+    }
 
     if (_settingsUpgraded) {
         showAppMessage(QString(tr("The format for %1 saved settings has been modified. "
@@ -478,6 +535,37 @@ void QGCApplication::_initForNormalAppBoot()
     _toolbox->linkManager()->startAutoConnectedLinks();
 }
 
+void QGCApplication::_firstFrameSwapped(void)
+{
+    QGCStartupProfiler::instance()->addInstantEvent(QStringLiteral("First frame"), "frame");
+    QGCStartupProfiler::instance()->finish();
+
+    // Probe for joysticks
+    _toolbox->joystickManager()->init();
+}
+
+void QGCApplication::_frameSyncedTelemetryChanged(void)
+{
+    QQuickWindow* rootWindow = mainRootWindow();
+    QGCSignalCoalescer* coalescer = QGCSignalCoalescer::instance();
+
+    // afterAnimating is the gui thread side of a frame, emitted right before the scene graph is synchronized. With
+    // the threaded render loop beforeSynchronizing comes from the render thread while the gui thread is blocked, so
+    // bindings could not be updated from there.
+    if (_toolbox->settingsManager()->appSettings()->frameSyncedTelemetry()->rawValue().toBool()) {
+        (void) connect(rootWindow, &QQuickWindow::afterAnimating, coalescer, &QGCSignalCoalescer::drain, Qt::UniqueConnection);
+        QPointer<QQuickWindow> window = rootWindow;
+        coalescer->setFrameRequester([window]() {
+            if (window) {
+                window->update();
+            }
+        });
+    } else {
+        (void) disconnect(rootWindow, &QQuickWindow::afterAnimating, coalescer, &QGCSignalCoalescer::drain);
+        coalescer->setFrameRequester(nullptr);
+    }
+}
+
 void QGCApplication::deleteAllSettingsNextBoot(void)
 {
     QSettings settings;
@@ -754,102 +842,6 @@ QString QGCApplication::cachedAirframeMetaDataFile(void)
     return airframeDir.filePath(QStringLiteral("PX4AirframeFactMetaData.xml"));
 }
 
-/// Returns a signal index that is can be compared to QMetaCallEvent.signalId
-int QGCApplication::CompressedSignalList::_signalIndex(const QMetaMethod & method)
-{
-    if (method.methodType() != QMetaMethod::Signal) {
-        qCWarning(QGCApplicationLog) << "Internal error: QGCApplication::CompressedSignalList::_signalIndex not a signal" << method.methodType();
-        return -1;
-    }
-
-    int index = -1;
-    const QMetaObject* metaObject = method.enclosingMetaObject();
-    for (int i=0; i<=method.methodIndex(); i++) {
-        if (metaObject->method(i).methodType() != QMetaMethod::Signal) {
-            continue;
-        }
-        index++;
-    }
-    return index;
-}
-
-void QGCApplication::CompressedSignalList::add(const QMetaMethod & method)
-{
-    const QMetaObject*  metaObject  = method.enclosingMetaObject();
-    int                 signalIndex = _signalIndex(method);
-
-    if (signalIndex != -1 && !contains(metaObject, signalIndex)) {
-        _signalMap[method.enclosingMetaObject()].insert(signalIndex);
-    }
-}
-
-void QGCApplication::CompressedSignalList::remove(const QMetaMethod & method)
-{
-    const int signalIndex = _signalIndex(method);
-    const QMetaObject*  metaObject  = method.enclosingMetaObject();
-
-    if (signalIndex != -1 && _signalMap.contains(metaObject) && _signalMap[metaObject].contains(signalIndex)) {
-        _signalMap[metaObject].remove(signalIndex);
-        if (_signalMap[metaObject].count() == 0) {
-            _signalMap.remove(metaObject);
-        }
-    }
-}
-
-bool QGCApplication::CompressedSignalList::contains(const QMetaObject* metaObject, int signalIndex)
-{
-    return _signalMap.contains(metaObject) && _signalMap[metaObject].contains(signalIndex);
-}
-
-void QGCApplication::addCompressedSignal(const QMetaMethod & method)
-{
-    _compressedSignals.add(method);
-}
-
-void QGCApplication::removeCompressedSignal(const QMetaMethod & method)
-{
-    _compressedSignals.remove(method);
-}
-
-bool QGCApplication::compressEvent(QEvent*event, QObject* receiver, QPostEventList* postedEvents)
-{
-    if (event->type() != QEvent::MetaCall) {
-        return QApplication::compressEvent(event, receiver, postedEvents);
-    }
-
-    const QMetaCallEvent* mce = static_cast<QMetaCallEvent*>(event);
-    if (!mce->sender() || !_compressedSignals.contains(mce->sender()->metaObject(), mce->signalId())) {
-        return QApplication::compressEvent(event, receiver, postedEvents);
-    }
-
-    for (QPostEventList::iterator it = postedEvents->begin(); it != postedEvents->end(); ++it) {
-        QPostEvent &cur = *it;
-        if (cur.receiver != receiver || cur.event == 0 || cur.event->type() != event->type()) {
-            continue;
-        }
-        const QMetaCallEvent *cur_mce = static_cast<QMetaCallEvent*>(cur.event);
-        if (cur_mce->sender() != mce->sender() || cur_mce->signalId() != mce->signalId() || cur_mce->id() != mce->id()) {
-            continue;
-        }
-        /* Keep The Newest Call */
-        // We can't merely qSwap the existing posted event with the new one, since QEvent
-        // keeps track of whether it has been posted. Deletion of a formerly posted event
-        // takes the posted event list mutex and does a useless search of the posted event
-        // list upon deletion. We thus clear the QEvent::posted flag before deletion.
-        struct EventHelper : private QEvent {
-            static void clearPostedFlag(QEvent * ev) {
-                (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
-            }
-        };
-        EventHelper::clearPostedFlag(cur.event);
-        delete cur.event;
-        cur.event = event;
-        return true;
-    }
-
-    return false;
-}
-
 bool QGCApplication::event(QEvent *e)
 {
     if (e->type() == QEvent::Quit) {
@@ -19,10 +19,6 @@
 #include <QtCore/QMetaObject>
 #include <QtCore/QTranslator>
 
-// These private headers are require to implement the signal compress support below
-#include <QtCore/private/qthread_p.h>
-#include <QtCore/private/qobject_p.h>
-
 // Work around circular header includes
 class QQmlApplicationEngine;
 class QGCToolbox;
@@ -92,11 +88,6 @@ public:
     QString         bigSizeToString(quint64 size);
     QString         bigSizeMBToString(quint64 size_MB);
 
-    /// Registers the signal such that only the last duplicate signal added is left in the queue.
-    void addCompressedSignal(const QMetaMethod & method);
-
-    void removeCompressedSignal(const QMetaMethod & method);
-
     bool event(QEvent *e) override;
 
     static QString cachedParameterMetaDataFile(void);
@@ -157,6 +148,8 @@ private slots:
     void _qgcCurrentStableVersionDownloadComplete   (QString remoteFile, QString localFile, QString errorMsg);
     bool _parseVersionText                          (const QString& versionString, int& majorVersion, int& minorVersion, int& buildVersion);
     void _showDelayedAppMessages                    (void);
+    void _firstFrameSwapped                         (void);
+    void _frameSyncedTelemetryChanged               (void);
 
 private:
     /// @brief Initialize the application for normal application boot. Or in other words we are not going to run unit tests.
@@ -166,9 +159,6 @@ private:
     void _checkForNewVersion();
     bool _checkTelemetrySavePath(bool useMessageBox);
 
-    // Overrides from QApplication
-    bool compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents) override;
-
     bool                        _runningUnitTests;                                  ///< true: running unit tests, false: normal app
     static const int            _missingParamsDelayedDisplayTimerTimeout = 1000;    ///< Timeout to wait for next missing fact to come in before display
     QTimer                      _missingParamsDelayedDisplayTimer;                  ///< Timer use to delay missing fact display
@@ -192,24 +182,6 @@ private:
 
     QList<QPair<QString /* title */, QString /* message */>> _delayedAppMessages;
 
-    class CompressedSignalList {
-        Q_DISABLE_COPY(CompressedSignalList)
-
-    public:
-        CompressedSignalList() {}
-
-        void add        (const QMetaMethod & method);
-        void remove     (const QMetaMethod & method);
-        bool contains   (const QMetaObject * metaObject, int signalIndex);
-
-    private:
-        static int _signalIndex(const QMetaMethod & method);
-
-        QMap<const QMetaObject*, QSet<int> > _signalMap;
-    };
-
-    CompressedSignalList _compressedSignals;
-
     const QString _settingsVersionKey = QStringLiteral("SettingsVersion"); ///< Settings key which hold settings version
     const QString _deleteAllSettingsKey = QStringLiteral("DeleteAllSettingsNextBoot"); ///< If this settings key is set on boot, all settings will be deleted
 
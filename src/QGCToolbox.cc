@@ -23,6 +23,7 @@
 #include "QGCCorePlugin.h"
 #include "SettingsManager.h"
 #include "QGCApplication.h"
+#include "QGCStartupProfiler.h"
 #ifndef QGC_AIRLINK_DISABLED
 #include "AirLinkManager.h"
 #endif
@@ -35,61 +36,90 @@
 #include "UTMSPManager.h"
 #endif
 
+template<class T>
+T* QGCToolbox::_createTool(void)
+{
+    QGCStartupProfiler::Scope profilerScope(QString::fromLatin1(T::staticMetaObject.className()), "construct");
+    return new T(_app, this);
+}
+
+void QGCToolbox::_setToolbox(QGCTool* tool)
+{
+    QGCStartupProfiler::Scope profilerScope(QString::fromLatin1(tool->metaObject()->className()), "setToolbox");
+    tool->setToolbox(this);
+}
+
 QGCToolbox::QGCToolbox(QGCApplication* app)
     : QObject(app)
+    , _app(app)
 {
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager        = new SettingsManager           (app, this);
+    _settingsManager        = _createTool<SettingsManager>          ();
 
     //-- Scan and load plugins
     _scanAndLoadPlugins(app);
-    _firmwarePluginManager  = new FirmwarePluginManager     (app, this);
+    _firmwarePluginManager  = _createTool<FirmwarePluginManager>    ();
 #ifndef NO_SERIAL_LINK
-    _gpsManager             = new GPSManager                (app, this);
-#endif
-    _joystickManager        = new JoystickManager           (app, this);
-    _linkManager            = new LinkManager               (app, this);
-    _mavlinkProtocol        = new MAVLinkProtocol           (app, this);
-    _missionCommandTree     = new MissionCommandTree        (app, this);
-    _multiVehicleManager    = new MultiVehicleManager       (app, this);
-    _qgcPositionManager     = new QGCPositionManager        (app, this);
-    _videoManager           = new VideoManager              (app, this);
-
-    _mavlinkLogManager      = new MAVLinkLogManager         (app, this);
-#ifndef QGC_AIRLINK_DISABLED
-    _airlinkManager         = new AirLinkManager            (app, this);
+    _gpsManager             = _createTool<GPSManager>               ();
 #endif
+    _joystickManager        = _createTool<JoystickManager>          ();
+    _linkManager            = _createTool<LinkManager>              ();
+    _mavlinkProtocol        = _createTool<MAVLinkProtocol>          ();
+    _missionCommandTree     = _createTool<MissionCommandTree>       ();
+    _multiVehicleManager    = _createTool<MultiVehicleManager>      ();
+    _qgcPositionManager     = _createTool<QGCPositionManager>       ();
+    _videoManager           = _createTool<VideoManager>             ();
 #ifdef QGC_UTM_ADAPTER
-    _utmspManager            = new UTMSPManager               (app, this);
+    _utmspManager           = _createTool<UTMSPManager>             ();
 #endif
 }
 
 void QGCToolbox::setChildToolboxes(void)
 {
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager->setToolbox(this);
+    _setToolbox(_settingsManager);
 
-    _corePlugin->setToolbox(this);
-    _firmwarePluginManager->setToolbox(this);
+    _setToolbox(_corePlugin);
+    _setToolbox(_firmwarePluginManager);
 #ifndef NO_SERIAL_LINK
-    _gpsManager->setToolbox(this);
-#endif
-    _joystickManager->setToolbox(this);
-    _linkManager->setToolbox(this);
-    _mavlinkProtocol->setToolbox(this);
-    _missionCommandTree->setToolbox(this);
-    _multiVehicleManager->setToolbox(this);
-    _qgcPositionManager->setToolbox(this);
-    _videoManager->setToolbox(this);
-    _mavlinkLogManager->setToolbox(this);
-#ifndef QGC_AIRLINK_DISABLED
-    _airlinkManager->setToolbox(this);
+    _setToolbox(_gpsManager);
 #endif
+    _setToolbox(_joystickManager);
+    _setToolbox(_linkManager);
+    _setToolbox(_mavlinkProtocol);
+    _setToolbox(_missionCommandTree);
+    _setToolbox(_multiVehicleManager);
+    _setToolbox(_qgcPositionManager);
+    _setToolbox(_videoManager);
 #ifdef QGC_UTM_ADAPTER
-    _utmspManager->setToolbox(this);
+    _setToolbox(_utmspManager);
 #endif
+
+    // MAVLinkLogManager starts logging from its activeVehicleChanged handler. The active vehicle is set after a delay
+    // once the vehicle is added, so creating it on vehicleAdded is early enough to not miss the first vehicle.
+    (void) connect(_multiVehicleManager, &MultiVehicleManager::vehicleAdded, this, [this]() { (void) mavlinkLogManager(); }, Qt::SingleShotConnection);
+}
+
+MAVLinkLogManager* QGCToolbox::mavlinkLogManager()
+{
+    if (!_mavlinkLogManager) {
+        _mavlinkLogManager = _createTool<MAVLinkLogManager>();
+        _setToolbox(_mavlinkLogManager);
+    }
+    return _mavlinkLogManager;
 }
 
+#ifndef QGC_AIRLINK_DISABLED
+AirLinkManager* QGCToolbox::airlinkManager()
+{
+    if (!_airlinkManager) {
+        _airlinkManager = _createTool<AirLinkManager>();
+        _setToolbox(_airlinkManager);
+    }
+    return _airlinkManager;
+}
+#endif
+
 void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
 {
 #if defined (QGC_CUSTOM_BUILD)
@@ -100,7 +130,7 @@ void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
     }
 #endif
     //-- No plugins found, use default instance
-    _corePlugin = new QGCCorePlugin(app, this);
+    _corePlugin = _createTool<QGCCorePlugin>();
 }
 
 QGCTool::QGCTool(QGCApplication* app, QGCToolbox* toolbox)
@@ -48,14 +48,14 @@ public:
     MultiVehicleManager*        multiVehicleManager     () { return _multiVehicleManager; }
     QGCPositionManager*         qgcPositionManager      () { return _qgcPositionManager; }
     VideoManager*               videoManager            () { return _videoManager; }
-    MAVLinkLogManager*          mavlinkLogManager       () { return _mavlinkLogManager; }
+    MAVLinkLogManager*          mavlinkLogManager       ();
     QGCCorePlugin*              corePlugin              () { return _corePlugin; }
     SettingsManager*            settingsManager         () { return _settingsManager; }
 #ifndef NO_SERIAL_LINK
     GPSManager*                 gpsManager              () { return _gpsManager; }
 #endif
 #ifndef QGC_AIRLINK_DISABLED
-    AirLinkManager*              airlinkManager          () { return _airlinkManager; }
+    AirLinkManager*              airlinkManager          ();
 #endif
 #ifdef QGC_UTM_ADAPTER
     UTMSPManager*                utmspManager             () { return _utmspManager; }
@@ -65,6 +65,14 @@ private:
     void setChildToolboxes(void);
     void _scanAndLoadPlugins(QGCApplication *app);
 
+    /// Constructs the tool, the constructor time is recorded by the startup profiler
+    template<class T> T* _createTool(void);
+
+    /// Calls setToolbox on the tool, the call time is recorded by the startup profiler
+    void _setToolbox(QGCTool* tool);
+
+    QGCApplication*             _app                    = nullptr;
+
     FirmwarePluginManager*      _firmwarePluginManager  = nullptr;
 #ifndef NO_SERIAL_LINK
     GPSManager*                 _gpsManager             = nullptr;
@@ -86,6 +94,10 @@ private:
 #ifdef QGC_UTM_ADAPTER
     UTMSPManager*                _utmspManager            = nullptr;
 #endif
+    // Tools which are not needed to show the first frame are only created on first access:
+    //  MAVLinkLogManager - Created at the latest when the first vehicle is added since it starts logging on connect
+    //  AirLinkManager
+
     friend class QGCApplication;
 };
 
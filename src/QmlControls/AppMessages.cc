@@ -14,11 +14,13 @@
 
 #include "AppMessages.h"
 #include "QGCApplication.h"
+#include "QGCSignalCoalescer.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
 
-#include <QtCore/QStringListModel>
 #include <QtConcurrent/QtConcurrent>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
 Q_GLOBAL_STATIC(AppLogModel, debug_model)
@@ -41,6 +43,62 @@ static void msgHandler(QtMsgType type, const QMessageLogContext &context, const
     if( type == QtFatalMsg ) abort();
 }
 
+AppLogFileWriter::AppLogFileWriter(qint64 maxFileBytes, int maxFiles)
+    : QObject()
+    , _maxFileBytes(maxFileBytes)
+    , _maxFiles(maxFiles)
+{
+
+}
+
+bool AppLogFileWriter::open(const QString& fileName)
+{
+    _file.setFileName(fileName);
+
+    // The log of the previous session is kept as the first rotated file
+    if (QFile::exists(fileName)) {
+        _rotate();
+    }
+    _bytesWritten = 0;
+    return _file.open(QIODevice::WriteOnly | QIODevice::Text);
+}
+
+void AppLogFileWriter::write(const QStringList& lines)
+{
+    if (!_file.isOpen()) {
+        return;
+    }
+    for (const QString& line: lines) {
+        const QByteArray bytes = line.toUtf8();
+        _bytesWritten += _file.write(bytes);
+        _bytesWritten += _file.write("\n", 1);
+    }
+    // Flushed once per batch so the file is up to date when the app crashes
+    (void) _file.flush();
+
+    if (_bytesWritten >= _maxFileBytes) {
+        _file.close();
+        _rotate();
+        _bytesWritten = 0;
+        (void) _file.open(QIODevice::WriteOnly | QIODevice::Text);
+    }
+}
+
+QString AppLogFileWriter::_rotatedFileName(int index) const
+{
+    const QFileInfo fileInfo(_file.fileName());
+    return fileInfo.absoluteDir().absoluteFilePath(QStringLiteral("%1.%2.%3").arg(fileInfo.completeBaseName()).arg(index).arg(fileInfo.suffix()));
+}
+
+void AppLogFileWriter::_rotate()
+{
+    (void) QFile::remove(_rotatedFileName(_maxFiles - 1));
+    for (int i = _maxFiles - 2; i >= 1; i--) {
+        (void) QFile::rename(_rotatedFileName(i), _rotatedFileName(i + 1));
+    }
+    (void) QFile::rename(_file.fileName(), _rotatedFileName(1));
+}
+
 void AppMessages::installHandler()
 {
     old_handler = qInstallMessageHandler(msgHandler);
@@ -54,27 +112,49 @@ AppLogModel *AppMessages::getModel()
     return debug_model;
 }
 
-AppLogModel::AppLogModel() : QStringListModel()
+AppLogModel::AppLogModel() : QAbstractListModel()
 {
-#ifdef __mobile__
-    Qt::ConnectionType contype = Qt::QueuedConnection;
-#else
-    Qt::ConnectionType contype = Qt::AutoConnection;
-#endif
-    connect(this, &AppLogModel::emitLog, this, &AppLogModel::threadsafeLog, contype);
+    _lines.resize(_maxLines);
+
+    _logFileThread.setObjectName(QStringLiteral("AppLogFile"));
+    _logFileWriter = new AppLogFileWriter();
+    _logFileWriter->moveToThread(&_logFileThread);
+}
+
+AppLogModel::~AppLogModel()
+{
+    if (_logFileThread.isRunning()) {
+        _logFileThread.quit();
+        _logFileThread.wait();
+
+        // Whatever was still queued goes straight to the file, the writer thread is done with it
+        QStringList lines;
+        QString line;
+        while (_queue.pop(line)) {
+            lines.append(line);
+        }
+        _logFileWriter->write(lines);
+    }
+    delete _logFileWriter;
 }
 
 void AppLogModel::writeMessages(const QString dest_file)
 {
-    const QString writebuffer(stringList().join('\n').append('\n'));
+    QStringList lines;
+    lines.reserve(_lineCount);
+    for (int row = 0; row < _lineCount; row++) {
+        lines.append(_line(row));
+    }
 
-    QFuture<void> future = QtConcurrent::run([dest_file, writebuffer] {
+    QFuture<void> future = QtConcurrent::run([dest_file, lines] {
         emit debug_model->writeStarted();
         bool success = false;
         QFile file(dest_file);
         if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
             QTextStream out(&file);
-            out << writebuffer;
+            for (const QString& line: lines) {
+                out << line << '\n';
+            }
             success = out.status() == QTextStream::Ok;
         } else {
             qWarning() << "AppLogModel::writeMessages write failed:" << file.errorString();
@@ -85,34 +165,126 @@ void AppLogModel::writeMessages(const QString dest_file)
 
 void AppLogModel::log(const QString message)
 {
-    emit debug_model->emitLog(message);
+    debug_model->_log(message);
+}
+
+void AppLogModel::_log(const QString& message)
+{
+    if (_queuedCount.fetch_add(1, std::memory_order_relaxed) >= _maxQueuedLines) {
+        _queuedCount.fetch_sub(1, std::memory_order_relaxed);
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    _queue.push(message);
+    _postDrain();
 }
 
-void AppLogModel::threadsafeLog(const QString message)
+void AppLogModel::_postDrain()
 {
-    const int line = rowCount();
-    insertRows(line, 1);
-    setData(index(line), message, Qt::DisplayRole);
+    // Only the first line after a drain schedules the next one. post() takes the coalescer's lock, once per drain
+    // rather than once per line. Any wake of the gui thread locks its event queue, so this is the cheapest there is.
+    if (!_drainPending.exchange(true, std::memory_order_acq_rel)) {
+        static const int drainKey = QGCSignalCoalescer::newKey();
+        QGCSignalCoalescer::instance()->post(this, drainKey, [this]() { _drain(); });
+    }
+}
 
-    if (qgcApp() && qgcApp()->logOutput() && _logFile.fileName().isEmpty()) {
-        qDebug() << _logFile.fileName().isEmpty() << qgcApp()->logOutput();
-        QGCToolbox* toolbox = qgcApp()->toolbox();
-        // Be careful of toolbox not being open yet
-        if (toolbox) {
-            QString saveDirPath = qgcApp()->toolbox()->settingsManager()->appSettings()->crashSavePath();
-            QDir saveDir(saveDirPath);
-            QString saveFilePath = saveDir.absoluteFilePath(QStringLiteral("QGCConsole.log"));
+void AppLogModel::_drain()
+{
+    _drainPending.store(false, std::memory_order_release);
 
-            _logFile.setFileName(saveFilePath);
-            if (!_logFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-                qgcApp()->showAppMessage(tr("Open console log output file failed %1 : %2").arg(_logFile.fileName()).arg(_logFile.errorString()));
-            }
+    QStringList lines;
+    QString line;
+    while (_queue.pop(line)) {
+        lines.append(line);
+    }
+    _queuedCount.fetch_sub(lines.count(), std::memory_order_relaxed);
+
+    // A line counted but not yet linked into the queue is missed by the pops above, and its producer may have seen
+    // _drainPending still set
+    if (_queuedCount.load(std::memory_order_acquire) > 0) {
+        _postDrain();
+    }
+
+    const int droppedCount = _droppedCount.exchange(0, std::memory_order_relaxed);
+    if (droppedCount > 0) {
+        lines.append(tr("%1 log messages dropped").arg(droppedCount));
+    }
+    if (lines.isEmpty()) {
+        return;
+    }
+
+    _openLogFile();
+    if (_logFileThread.isRunning()) {
+        (void) QMetaObject::invokeMethod(_logFileWriter, [writer = _logFileWriter, lines]() { writer->write(lines); }, Qt::QueuedConnection);
+    }
+
+    // Only the newest lines fit when more arrived than the ring holds
+    if (lines.count() >= _maxLines) {
+        beginResetModel();
+        for (int i = 0; i < _maxLines; i++) {
+            _lines[i] = lines[lines.count() - _maxLines + i];
+        }
+        _firstLine = 0;
+        _lineCount = _maxLines;
+        endResetModel();
+        return;
+    }
+
+    const int overflow = _lineCount + lines.count() - _maxLines;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        for (int row = 0; row < overflow; row++) {
+            _lines[(_firstLine + row) % _maxLines].clear();
         }
+        _firstLine = (_firstLine + overflow) % _maxLines;
+        _lineCount -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), _lineCount, _lineCount + lines.count() - 1);
+    for (const QString& newLine: lines) {
+        _lines[(_firstLine + _lineCount) % _maxLines] = newLine;
+        _lineCount++;
+    }
+    endInsertRows();
+}
+
+void AppLogModel::_openLogFile()
+{
+    if (_logFileChecked || !qgcApp() || !qgcApp()->logOutput()) {
+        return;
+    }
+
+    QGCToolbox* toolbox = qgcApp()->toolbox();
+    // Be careful of toolbox not being open yet
+    if (!toolbox) {
+        return;
     }
+    _logFileChecked = true;
 
-    if (_logFile.isOpen()) {
-        QTextStream out(&_logFile);
-        out << message << "\n";
-        _logFile.flush();
+    QString saveDirPath = toolbox->settingsManager()->appSettings()->crashSavePath();
+    QDir saveDir(saveDirPath);
+    QString saveFilePath = saveDir.absoluteFilePath(QStringLiteral("QGCConsole.log"));
+
+    _logFileThread.start(QThread::LowPriority);
+    (void) QMetaObject::invokeMethod(_logFileWriter, [writer = _logFileWriter, saveFilePath]() {
+        if (!writer->open(saveFilePath)) {
+            const QString error = QObject::tr("Open console log output file failed %1").arg(saveFilePath);
+            (void) QMetaObject::invokeMethod(qgcApp(), [error]() { qgcApp()->showAppMessage(error); }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+}
+
+int AppLogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _lineCount;
+}
+
+QVariant AppLogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (index.row() >= _lineCount) || ((role != Qt::DisplayRole) && (role != Qt::EditRole))) {
+        return QVariant();
     }
+    return _line(index.row());
 }
@@ -10,34 +10,89 @@
 
 #pragma once
 
-#include <QtCore/QStringListModel>
+#include <QtCore/QAbstractListModel>
 #include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QThread>
+
+#include <atomic>
+
+#include "QGCMPSCQueue.h"
+
+/// Writes the console log file. Lives on its own thread, the file is rotated once it reaches maxFileBytes so at most
+/// maxFiles files are kept.
+class AppLogFileWriter : public QObject
+{
+public:
+    AppLogFileWriter(qint64 maxFileBytes = 10 * 1024 * 1024, int maxFiles = 5);
+
+    bool open   (const QString& fileName);
+    void write  (const QStringList& lines);
+
+private:
+    QString _rotatedFileName(int index) const;
+    void    _rotate         ();
+
+    QFile           _file;
+    qint64          _bytesWritten = 0;
+    const qint64    _maxFileBytes;
+    const int       _maxFiles;
+};
 
 // Hackish way to force only this translation unit to have public ctor access
 #ifndef _LOG_CTOR_ACCESS_
 #define _LOG_CTOR_ACCESS_ private
 #endif
 
-class AppLogModel : public QStringListModel
+/// Model for the application message console. log() may be called from any thread, including the message handler:
+/// it pushes onto a lock-free queue and at most one drain is pending at a time. Only the first line after each drain
+/// takes a lock, to post that drain. The queue is drained once per frame on the gui thread into a fixed size ring, the
+/// oldest lines are dropped once it is full. Drained lines are also handed to a background thread which writes the
+/// rotating console log file.
+class AppLogModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
+    ~AppLogModel();
+
     Q_INVOKABLE void writeMessages(const QString dest_file);
     static void log(const QString message);
 
+    // QAbstractListModel overrides
+    int         rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant    data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
 signals:
-    void emitLog(const QString message);
     void writeStarted();
     void writeFinished(bool success);
 
-private slots:
-    void threadsafeLog(const QString message);
-
 private:
-    QFile _logFile;
+    void _log               (const QString& message);
+    void _postDrain         ();
+    void _drain             ();
+    void _openLogFile       ();
+    const QString& _line    (int row) const { return _lines[(_firstLine + row) % _maxLines]; }
+
+    QGCMPSCQueue<QString>   _queue;
+    std::atomic<int>        _queuedCount{0};
+    std::atomic<int>        _droppedCount{0};       ///< Lines dropped because the queue was full
+    std::atomic<bool>       _drainPending{false};
+
+    QList<QString>          _lines;                 ///< Ring of _maxLines
+    int                     _firstLine = 0;
+    int                     _lineCount = 0;
+
+    bool                    _logFileChecked = false;
+    QThread                 _logFileThread;
+    AppLogFileWriter*       _logFileWriter = nullptr;
+
+    static constexpr int _maxLines = 10000;
+    static constexpr int _maxQueuedLines = 20000;   ///< Bounds the queue if the gui thread stalls
 
 _LOG_CTOR_ACCESS_:
     AppLogModel();
+
+    friend class AppLogModelTest;
 };
 
 
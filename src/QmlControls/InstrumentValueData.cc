@@ -111,6 +111,17 @@ void InstrumentValueData::_setFactWorker(void)
         _fact = factGroup->getFact(nonEmptyFactName);
     }
 
+    // Instrument values do not know whether they are visible, so they keep the group they show publishing
+    if (factGroup != _subscribedFactGroup) {
+        if (_subscribedFactGroup) {
+            _subscribedFactGroup->removeSubscriber(this);
+        }
+        _subscribedFactGroup = factGroup;
+        if (_subscribedFactGroup) {
+            _subscribedFactGroup->setSubscriberActive(this, true);
+        }
+    }
+
     if (_fact) {
         _factName = nonEmptyFactName;
         connect(_fact, &Fact::rawValueChanged, this, &InstrumentValueData::_updateRanges);
@@ -13,8 +13,10 @@
 #include "FactValueGrid.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 
 class Vehicle;
+class FactGroup;
 class QmlObjectListModel;
 
 class InstrumentValueData : public QObject
@@ -117,6 +119,7 @@ private:
     Vehicle*                _activeVehicle =        nullptr;
     QmlObjectListModel*     _rowModel =             nullptr;
     Fact*                   _fact =                 nullptr;
+    QPointer<FactGroup>     _subscribedFactGroup;
     QString                 _factName;
     QString                 _factGroupName;
     QString                 _text;
@@ -48,6 +48,13 @@ ChartView {
         }
     }
 
+    Binding {
+        target:     chartController
+        property:   "plotWidth"
+        value:      Math.round(chartView.plotArea.width)
+        when:       chartController !== null
+    }
+
     DateTimeAxis {
         id:                         axisX
         min:                        chartController ? chartController.rangeXMin : new Date()
@@ -80,7 +80,6 @@ void QGroundControlQmlGlobal::setToolbox(QGCToolbox* toolbox)
     _qgcPositionManager     = toolbox->qgcPositionManager();
     _missionCommandTree     = toolbox->missionCommandTree();
     _videoManager           = toolbox->videoManager();
-    _mavlinkLogManager      = toolbox->mavlinkLogManager();
     _corePlugin             = toolbox->corePlugin();
     _firmwarePluginManager  = toolbox->firmwarePluginManager();
     _settingsManager        = toolbox->settingsManager();
@@ -88,14 +87,26 @@ void QGroundControlQmlGlobal::setToolbox(QGCToolbox* toolbox)
     _gpsRtkFactGroup        = toolbox->gpsManager()->gpsRtkFactGroup();
 #endif
     _globalPalette          = new QGCPalette(this);
-#ifndef QGC_AIRLINK_DISABLED
-    _airlinkManager         = toolbox->airlinkManager();
-#endif
 #ifdef QGC_UTM_ADAPTER
     _utmspManager            = toolbox->utmspManager();
 #endif
 }
 
+MAVLinkLogManager* QGroundControlQmlGlobal::mavlinkLogManager()
+{
+    // Created on first use by the toolbox
+    return _toolbox->mavlinkLogManager();
+}
+
+AirLinkManager* QGroundControlQmlGlobal::airlinkManager()
+{
+#ifndef QGC_AIRLINK_DISABLED
+    return _toolbox->airlinkManager();
+#else
+    return nullptr;
+#endif
+}
+
 void QGroundControlQmlGlobal::saveGlobalSetting (const QString& key, const QString& value)
 {
     QSettings settings;
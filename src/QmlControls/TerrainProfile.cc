@@ -13,7 +13,7 @@
 #include "FlightPathSegment.h"
 #include "ComplexMissionItem.h"
 #include "QGCLoggingCategory.h"
-#include "QGCApplication.h"
+#include "QGCSignalCoalescer.h"
 
 #include <QtQuick/QSGFlatColorMaterial>
 
@@ -28,8 +28,7 @@ TerrainProfile::TerrainProfile(QQuickItem* parent)
     connect(this, &TerrainProfile::visibleWidthChanged, this, &QQuickItem::update);
 
     // This collapse multiple _updateSignals in a row to a single update
-    connect(this, &TerrainProfile::_updateSignal, this, &QQuickItem::update, Qt::QueuedConnection);
-    qgcApp()->addCompressedSignal(QMetaMethod::fromSignal(&TerrainProfile::_updateSignal));
+    QGCSignalCoalescer::connect(this, &TerrainProfile::_updateSignal, this, &QQuickItem::update);
 }
 
 void TerrainProfile::componentComplete(void)
@@ -48,7 +47,7 @@ void TerrainProfile::setMissionController(MissionController* missionController)
         connect(_missionController, &MissionController::visualItemsChanged,         this, &TerrainProfile::_newVisualItems);
 
         connect(this,               &TerrainProfile::visibleWidthChanged,           this, &TerrainProfile::_updateSignal, Qt::QueuedConnection);
-        connect(_missionController, &MissionController::recalcTerrainProfile,       this, &TerrainProfile::_updateSignal, Qt::QueuedConnection);
+        QGCSignalCoalescer::connect(_missionController, &MissionController::recalcTerrainProfile, this, &TerrainProfile::_updateSignal);
     }
 }
 
@@ -21,10 +21,12 @@
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMetrics.h"
 
 #include <QtCore/QDateTime>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
+#include <QtCore/QMetaEnum>
 #include <QtCore/QSettings>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
@@ -36,6 +38,8 @@ QGC_LOGGING_CATEGORY(QGCTileCacheWorkerLog, "qgc.qtlocationplugin.qgctilecachewo
 
 QGCCacheWorker::QGCCacheWorker(QObject* parent)
     : QThread(parent)
+    , _tileHits(QGCMetrics::instance()->counter(QStringLiteral("qgc_tile_cache_hits"), QStringLiteral("Tile fetches found in the cache database")))
+    , _tileMisses(QGCMetrics::instance()->counter(QStringLiteral("qgc_tile_cache_misses"), QStringLiteral("Tile fetches not in the cache database")))
 {
     // qCDebug(QGCTileCacheWorkerLog) << Q_FUNC_INFO << this;
 }
@@ -132,6 +136,14 @@ QGCCacheWorker::run()
 
 void QGCCacheWorker::_runTask(QGCMapTask *task)
 {
+    QGCMetricHistogram *metric = _taskMetrics.value(task->type());
+    if (!metric) {
+        const QString taskName = QString::fromLatin1(QMetaEnum::fromType<QGCMapTask::TaskType>().valueToKey(task->type()));
+        metric = QGCMetrics::instance()->histogram(QStringLiteral("qgc_tile_cache_task_seconds"), QStringLiteral("Time to run a tile cache database task"), { { QStringLiteral("task"), taskName } });
+        _taskMetrics.insert(task->type(), metric);
+    }
+    QGCMetricHistogram::Scope metricScope(metric);
+
     switch (task->type()) {
     case QGCMapTask::taskInit:
         break;
@@ -303,9 +315,11 @@ QGCCacheWorker::_getTile(QGCMapTask* mtask)
             QGCCacheTile* tile = new QGCCacheTile(task->hash(), arrray, format, type);
             task->setTileFetched(tile);
             found = true;
+            _tileHits->add();
         }
     }
     if(!found) {
+        _tileMisses->add();
         qCDebug(QGCTileCacheWorkerLog) << "_getTile() (NOT in DB) HASH:" << task->hash();
         task->setError("Tile not in cache database");
     }
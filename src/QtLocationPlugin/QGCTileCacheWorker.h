@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QMutex>
 #include <QtCore/QQueue>
@@ -29,6 +30,8 @@ Q_DECLARE_LOGGING_CATEGORY(QGCTileCacheWorkerLog)
 
 class QGCMapTask;
 class QGCCachedTileSet;
+class QGCMetricCounter;
+class QGCMetricHistogram;
 class QSqlDatabase;
 
 class QGCCacheWorker : public QThread
@@ -94,6 +97,9 @@ private:
     int _updateTimeout = kShortTimeout;
     std::atomic_bool _failed = false;
     std::atomic_bool _valid = false;
+    QHash<int, QGCMetricHistogram*> _taskMetrics;     ///< Task time by task type, only used on the worker thread
+    QGCMetricCounter *_tileHits = nullptr;
+    QGCMetricCounter *_tileMisses = nullptr;
 
     static QByteArray _bingNoTileImage;
     static constexpr const char *kSession = "QGeoTileWorkerSession";
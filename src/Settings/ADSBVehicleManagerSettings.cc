@@ -19,3 +19,9 @@ DECLARE_SETTINGGROUP(ADSBVehicleManager, "ADSBVehicleManager")
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerConnectEnabled)
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerHostAddress)
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerPort)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbMaxDisplayDistance)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbMaxDisplayAltitudeDifference)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictDetectionEnabled)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictHorizontalSeparation)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictVerticalSeparation)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictLookahead)
@@ -21,4 +21,10 @@ public:
     DEFINE_SETTINGFACT(adsbServerConnectEnabled)
     DEFINE_SETTINGFACT(adsbServerHostAddress)
     DEFINE_SETTINGFACT(adsbServerPort)
+    DEFINE_SETTINGFACT(adsbMaxDisplayDistance)
+    DEFINE_SETTINGFACT(adsbMaxDisplayAltitudeDifference)
+    DEFINE_SETTINGFACT(adsbConflictDetectionEnabled)
+    DEFINE_SETTINGFACT(adsbConflictHorizontalSeparation)
+    DEFINE_SETTINGFACT(adsbConflictVerticalSeparation)
+    DEFINE_SETTINGFACT(adsbConflictLookahead)
 };
@@ -16,6 +16,7 @@
 #include "QGCMapUrlEngine.h"
 #include "ElevationMapProvider.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMetrics.h"
 
 #include <QtLocation/private/qgeotilespec_p.h>
 #include <QtNetwork/QNetworkAccessManager>
@@ -34,6 +35,10 @@ TerrainTileManager *TerrainTileManager::instance()
 TerrainTileManager::TerrainTileManager(QObject *parent)
     : QObject(parent)
     , _networkManager(new QNetworkAccessManager(this))
+    , _lookupMetric(QGCMetrics::instance()->histogram(QStringLiteral("qgc_terrain_lookup_seconds"), QStringLiteral("Time to look up the altitudes for a terrain query in the tile cache")))
+    , _tileHitMetric(QGCMetrics::instance()->counter(QStringLiteral("qgc_terrain_tile_hits"), QStringLiteral("Terrain coordinates found in a cached tile")))
+    , _tileMissMetric(QGCMetrics::instance()->counter(QStringLiteral("qgc_terrain_tile_misses"), QStringLiteral("Terrain lookups which needed a tile which is not cached")))
+    , _queuedQueryMetric(QGCMetrics::instance()->counter(QStringLiteral("qgc_terrain_queued_queries"), QStringLiteral("Terrain queries queued behind a tile download")))
 {
     // qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << this;
 
@@ -63,6 +68,7 @@ void TerrainTileManager::addCoordinateQuery(TerrainQueryInterface *terrainQueryI
     QList<double> altitudes;
     if (!getAltitudesForCoordinates(coordinates, altitudes, error)) {
         qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << "queue count" << _requestQueue.count();
+        _queuedQueryMetric->add();
         const QueuedRequestInfo_t queuedRequestInfo = {
             terrainQueryInterface,
             TerrainQuery::QueryMode::QueryModeCoordinates,
@@ -126,6 +132,7 @@ void TerrainTileManager::addPathQuery(TerrainQueryInterface *terrainQueryInterfa
     QList<double> altitudes;
     if (!getAltitudesForCoordinates(coordinates, altitudes, error)) {
         qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << "queue count" << _requestQueue.count();
+        _queuedQueryMetric->add();
         const QueuedRequestInfo_t queuedRequestInfo = {
             terrainQueryInterface,
             TerrainQuery::QueryMode::QueryModePath,
@@ -152,6 +159,8 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
 {
     error = false;
 
+    QGCMetricHistogram::Scope metricScope(_lookupMetric);
+
     static const QString kMapType = CopernicusElevationProvider::kProviderKey;
     const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(kMapType);
     for (const QGeoCoordinate &coordinate: coordinates) {
@@ -165,6 +174,7 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
 
         TerrainTile* const tile = _getCachedTile(tileHash);
         if (tile) {
+            _tileHitMetric->add();
             const double elevation = tile->elevation(coordinate);
             if (qIsNaN(elevation)) {
                 error = true;
@@ -174,6 +184,7 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
             }
             altitudes.push_back(elevation);
         } else if (_state != TerrainQuery::State::Downloading) {
+            _tileMissMetric->add();
             QGeoTileSpec spec;
             spec.setX(provider->long2tileX(coordinate.longitude(), 1));
             spec.setY(provider->lat2tileY(coordinate.latitude(), 1));
@@ -186,6 +197,7 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
             // TODO: Batch Downloading?
             return false;
         } else {
+            _tileMissMetric->add();
             return false;
         }
     }
@@ -19,6 +19,8 @@
 
 class TerrainTile;
 class QNetworkAccessManager;
+class QGCMetricCounter;
+class QGCMetricHistogram;
 
 Q_DECLARE_LOGGING_CATEGORY(TerrainTileManagerLog)
 
@@ -66,4 +68,9 @@ private:
     QHash<QString, TerrainTile*> _tiles;
 
     QNetworkAccessManager *_networkManager = nullptr;
+
+    QGCMetricHistogram *_lookupMetric = nullptr;
+    QGCMetricCounter *_tileHitMetric = nullptr;
+    QGCMetricCounter *_tileMissMetric = nullptr;
+    QGCMetricCounter *_queuedQueryMetric = nullptr;
 };
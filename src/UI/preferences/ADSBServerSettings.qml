@@ -53,4 +53,61 @@ SettingsPage {
             visible:            fact.visible
         }
     }
+
+    SettingsGroupLayout {
+        Layout.fillWidth:   true
+        heading:            qsTr("Traffic Display")
+        visible:            _adsbSettings.adsbMaxDisplayDistance.visible || _adsbSettings.adsbMaxDisplayAltitudeDifference.visible
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              fact.shortDescription
+            fact:               _adsbSettings.adsbMaxDisplayDistance
+            visible:            fact.visible
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              fact.shortDescription
+            fact:               _adsbSettings.adsbMaxDisplayAltitudeDifference
+            visible:            fact.visible
+        }
+    }
+
+    SettingsGroupLayout {
+        Layout.fillWidth:   true
+        heading:            qsTr("Conflict Alerts")
+        visible:            _adsbSettings.adsbConflictDetectionEnabled.visible
+
+        FactCheckBoxSlider {
+            Layout.fillWidth:   true
+            text:               fact.shortDescription
+            fact:               _adsbSettings.adsbConflictDetectionEnabled
+            visible:            fact.visible
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              fact.shortDescription
+            fact:               _adsbSettings.adsbConflictHorizontalSeparation
+            visible:            fact.visible
+            enabled:            _adsbSettings.adsbConflictDetectionEnabled.rawValue
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              fact.shortDescription
+            fact:               _adsbSettings.adsbConflictVerticalSeparation
+            visible:            fact.visible
+            enabled:            _adsbSettings.adsbConflictDetectionEnabled.rawValue
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              fact.shortDescription
+            fact:               _adsbSettings.adsbConflictLookahead
+            visible:            fact.visible
+            enabled:            _adsbSettings.adsbConflictDetectionEnabled.rawValue
+        }
+    }
 }
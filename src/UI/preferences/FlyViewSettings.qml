@@ -77,6 +77,14 @@ SettingsPage {
             property Fact _keepMapCenteredOnVehicle: _flyViewSettings.keepMapCenteredOnVehicle
         }
 
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Maximum Flight Path Points")
+            fact:               _maxTrajectoryPoints
+            visible:            fact.visible
+            property Fact _maxTrajectoryPoints: _flyViewSettings.maxTrajectoryPoints
+        }
+
         FactCheckBoxSlider {
             Layout.fillWidth:   true
             text:               qsTr("Show Telemetry Log Replay Status Bar")
@@ -162,6 +162,14 @@ SettingsPage {
             visible:            fact.visible
             property Fact _saveCsvTelemetry: _appSettings.saveCsvTelemetry
         }
+
+        FactCheckBoxSlider {
+            Layout.fillWidth:   true
+            text:               qsTr("Update telemetry values once per display frame")
+            fact:               _frameSyncedTelemetry
+            visible:            fact.visible
+            property Fact _frameSyncedTelemetry: _appSettings.frameSyncedTelemetry
+        }
     }
 
     SettingsGroupLayout {
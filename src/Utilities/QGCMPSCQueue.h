@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/// Unbounded multi producer, single consumer queue (Vyukov's intrusive list). A push is a single atomic exchange, so
+/// producers never block each other or the consumer, which makes it safe to push from a message handler on any thread.
+/// The consumer only ever touches the tail. A pop which lands on a push midway through linking its node reports
+/// empty, the item shows up on the next pop.
+/// Thread-safe: push from any thread, pop from one thread at a time.
+template<typename T>
+class QGCMPSCQueue
+{
+public:
+    QGCMPSCQueue(void)
+        : _head(&_stub)
+        , _tail(&_stub)
+    {
+
+    }
+
+    ~QGCMPSCQueue()
+    {
+        T value;
+        while (pop(value)) {}
+    }
+
+    QGCMPSCQueue(const QGCMPSCQueue&) = delete;
+    QGCMPSCQueue& operator=(const QGCMPSCQueue&) = delete;
+
+    void push(T value)
+    {
+        _push(new Node(std::move(value)));
+    }
+
+    /// Consumer only
+    ///     @return false: Queue is empty
+    bool pop(T& value)
+    {
+        Node* tail = _tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+
+        // The stub marks an empty queue, step over it
+        if (tail == &_stub) {
+            if (!next) {
+                return false;
+            }
+            _tail = tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            _tail = next;
+            value = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+
+        // tail is the last node, unless a push has swapped the head but not linked its node yet
+        if (tail != _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        // The last node can only be taken once something is behind it
+        _stub.next.store(nullptr, std::memory_order_relaxed);
+        _push(&_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            _tail = next;
+            value = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Node {
+        Node(void) = default;
+        explicit Node(T v) : value(std::move(v)) { }
+
+        T                   value{};
+        std::atomic<Node*>  next{nullptr};
+    };
+
+    void _push(Node* node)
+    {
+        Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    Node                _stub;
+    std::atomic<Node*>  _head;      ///< Producers: last node pushed
+    Node*               _tail;      ///< Consumer: next node to pop
+};
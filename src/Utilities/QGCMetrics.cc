@@ -0,0 +1,330 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCMetrics.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+#include <QtCore/QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(QGCMetricsLog, "qgc.utilities.qgcmetrics")
+
+int QGCMetricHistogram::bucketIndex(quint64 nsecs)
+{
+    if (nsecs < static_cast<quint64>(_subBucketCount)) {
+        return static_cast<int>(nsecs);
+    }
+
+    // The top bits below the leading one pick the sub bucket within the power of two
+    const int exponent = 63 - qCountLeadingZeroBits(nsecs);
+    if (exponent >= _maxValueBits) {
+        return _bucketCount - 1;
+    }
+    const int subBucket = static_cast<int>(nsecs >> (exponent - _subBucketBits)) & (_subBucketCount - 1);
+    return ((exponent - _subBucketBits + 1) * _subBucketCount) + subBucket;
+}
+
+quint64 QGCMetricHistogram::bucketMaxNSecs(int index)
+{
+    if (index < _subBucketCount) {
+        return static_cast<quint64>(index);
+    }
+
+    const int shift = (index / _subBucketCount) - 1;
+    const quint64 first = static_cast<quint64>(_subBucketCount + (index % _subBucketCount)) << shift;
+    return first + (Q_UINT64_C(1) << shift) - 1;
+}
+
+void QGCMetricHistogram::record(qint64 nsecs)
+{
+    const quint64 value = static_cast<quint64>(qMax(nsecs, Q_INT64_C(0)));
+
+    _buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    _sumNSecs.fetch_add(value, std::memory_order_relaxed);
+
+    quint64 max = _maxNSecs.load(std::memory_order_relaxed);
+    while ((value > max) && !_maxNSecs.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+QGCMetricHistogram::Snapshot_t QGCMetricHistogram::snapshot(void) const
+{
+    Snapshot_t snapshot;
+
+    // The count is taken from the buckets so the percentiles always add up
+    snapshot.buckets.resize(_bucketCount);
+    for (int i = 0; i < _bucketCount; i++) {
+        snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sumNSecs = _sumNSecs.load(std::memory_order_relaxed);
+    snapshot.maxNSecs = _maxNSecs.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+void QGCMetricHistogram::reset(void)
+{
+    for (std::atomic<quint64>& bucket: _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _sumNSecs.store(0, std::memory_order_relaxed);
+    _maxNSecs.store(0, std::memory_order_relaxed);
+}
+
+quint64 QGCMetricHistogram::Snapshot_t::percentileNSecs(double percentile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    const quint64 rank = qBound(Q_UINT64_C(1), static_cast<quint64>(std::ceil(percentile * count)), count);
+    quint64 seen = 0;
+    for (int i = 0; i < buckets.count(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // The last bucket also holds everything too large to track, only the max is known for those
+            return (i == (buckets.count() - 1)) ? maxNSecs : qMin(bucketMaxNSecs(i), maxNSecs);
+        }
+    }
+
+    return maxNSecs;
+}
+
+QGCMetrics* QGCMetrics::instance(void)
+{
+    static QGCMetrics metrics;
+    return &metrics;
+}
+
+QString QGCMetrics::labelsToString(const Labels& labels)
+{
+    QStringList pairs;
+    for (const QPair<QString, QString>& label: labels) {
+        QString value = label.second;
+        value.replace(QLatin1Char('\\'), QStringLiteral("\\\\"));
+        value.replace(QLatin1Char('"'), QStringLiteral("\\\""));
+        value.replace(QLatin1Char('\n'), QStringLiteral("\\n"));
+        pairs.append(label.first + QStringLiteral("=\"") + value + QLatin1Char('"'));
+    }
+    return pairs.join(QLatin1Char(','));
+}
+
+QGCMetrics::Metric_t* QGCMetrics::_metric(MetricType_t type, const QString& name, const QString& help, const Labels& labels)
+{
+    QMutexLocker locker(&_mutex);
+
+    const QString labelString = labelsToString(labels);
+    const auto it = std::lower_bound(_metrics.begin(), _metrics.end(), qMakePair(name, labelString),
+        [](const std::unique_ptr<Metric_t>& metric, const QPair<QString, QString>& key) {
+            return qMakePair(metric->name, labelsToString(metric->labels)) < key;
+        });
+    if ((it != _metrics.end()) && ((*it)->name == name) && ((*it)->labels == labels)) {
+        if ((*it)->type != type) {
+            qCWarning(QGCMetricsLog) << "Metric registered with a different type" << name << labelString;
+            return nullptr;
+        }
+        return it->get();
+    }
+
+    qCDebug(QGCMetricsLog) << "Registered" << name << labelString;
+
+    std::unique_ptr<Metric_t> metric = std::make_unique<Metric_t>();
+    metric->type = type;
+    metric->name = name;
+    metric->help = help;
+    metric->labels = labels;
+    if (type == MetricTypeCounter) {
+        metric->counter = std::make_unique<QGCMetricCounter>();
+    } else {
+        metric->histogram = std::make_unique<QGCMetricHistogram>();
+    }
+
+    return _metrics.insert(it, std::move(metric))->get();
+}
+
+QGCMetricCounter* QGCMetrics::counter(const QString& name, const QString& help, const Labels& labels)
+{
+    Metric_t* const metric = _metric(MetricTypeCounter, name, help, labels);
+    if (!metric) {
+        // Hand back something usable so a clash between two callers never crashes either
+        static QGCMetricCounter unregistered;
+        return &unregistered;
+    }
+    return metric->counter.get();
+}
+
+QGCMetricHistogram* QGCMetrics::histogram(const QString& name, const QString& help, const Labels& labels)
+{
+    Metric_t* const metric = _metric(MetricTypeHistogram, name, help, labels);
+    if (!metric) {
+        static QGCMetricHistogram unregistered;
+        return &unregistered;
+    }
+    return metric->histogram.get();
+}
+
+void QGCMetrics::reset(void)
+{
+    visit([](const Metric_t& metric) {
+        if (metric.counter) {
+            metric.counter->reset();
+        } else {
+            metric.histogram->reset();
+        }
+    });
+}
+
+QByteArray QGCMetrics::toJson(void) const
+{
+    QJsonArray counters;
+    QJsonArray histograms;
+
+    visit([&counters, &histograms](const Metric_t& metric) {
+        QJsonObject labels;
+        for (const QPair<QString, QString>& label: metric.labels) {
+            labels[label.first] = label.second;
+        }
+
+        QJsonObject jsonMetric;
+        jsonMetric[QStringLiteral("name")]      = metric.name;
+        jsonMetric[QStringLiteral("labels")]    = labels;
+        if (metric.counter) {
+            jsonMetric[QStringLiteral("value")] = static_cast<qint64>(metric.counter->value());
+            counters.append(jsonMetric);
+        } else {
+            const QGCMetricHistogram::Snapshot_t snapshot = metric.histogram->snapshot();
+            jsonMetric[QStringLiteral("count")]     = static_cast<qint64>(snapshot.count);
+            jsonMetric[QStringLiteral("sumNSecs")]  = static_cast<qint64>(snapshot.sumNSecs);
+            jsonMetric[QStringLiteral("maxNSecs")]  = static_cast<qint64>(snapshot.maxNSecs);
+            jsonMetric[QStringLiteral("meanNSecs")] = snapshot.meanNSecs();
+            QJsonObject jsonPercentiles;
+            for (const double percentile: percentiles) {
+                jsonPercentiles[QString::number(percentile)] = static_cast<qint64>(snapshot.percentileNSecs(percentile));
+            }
+            jsonMetric[QStringLiteral("percentilesNSecs")] = jsonPercentiles;
+            histograms.append(jsonMetric);
+        }
+    });
+
+    QJsonObject json;
+    json[QStringLiteral("timestamp")]   = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    json[QStringLiteral("counters")]    = counters;
+    json[QStringLiteral("histograms")]  = histograms;
+
+    return QJsonDocument(json).toJson(QJsonDocument::Indented);
+}
+
+QByteArray QGCMetrics::toPrometheus(void) const
+{
+    QString text;
+    QString family;
+
+    visit([&text, &family](const Metric_t& metric) {
+        const QString labels = labelsToString(metric.labels);
+        const QString name = metric.counter ? (metric.name + QStringLiteral("_total")) : metric.name;
+
+        // Metrics are sorted by name so each family is together, HELP and TYPE only come once per family. Names and
+        // labels are appended rather than going through arg() since a label value could hold a %.
+        if (name != family) {
+            family = name;
+            text += QStringLiteral("# HELP ") + name + QLatin1Char(' ') + metric.help + QLatin1Char('\n');
+            text += QStringLiteral("# TYPE ") + name + (metric.counter ? QStringLiteral(" counter\n") : QStringLiteral(" summary\n"));
+        }
+
+        const QString bracedLabels = labels.isEmpty() ? QString() : (QLatin1Char('{') + labels + QLatin1Char('}'));
+        if (metric.counter) {
+            text += name + bracedLabels + QLatin1Char(' ') + QString::number(metric.counter->value()) + QLatin1Char('\n');
+            return;
+        }
+
+        // Summaries are in seconds
+        const QGCMetricHistogram::Snapshot_t snapshot = metric.histogram->snapshot();
+        const QString labelPrefix = labels.isEmpty() ? QString() : (labels + QLatin1Char(','));
+        for (const double percentile: percentiles) {
+            text += name + QLatin1Char('{') + labelPrefix + QStringLiteral("quantile=\"") + QString::number(percentile) + QStringLiteral("\"} ")
+                  + QString::number(snapshot.percentileNSecs(percentile) / 1e9, 'g', 9) + QLatin1Char('\n');
+        }
+        text += name + QStringLiteral("_sum") + bracedLabels + QLatin1Char(' ') + QString::number(snapshot.sumNSecs / 1e9, 'g', 12) + QLatin1Char('\n');
+        text += name + QStringLiteral("_count") + bracedLabels + QLatin1Char(' ') + QString::number(snapshot.count) + QLatin1Char('\n');
+    });
+
+    return text.toUtf8();
+}
+
+bool QGCMetrics::writeFile(const QString& fileName) const
+{
+    // Written to the side and renamed so a soak test reading the file never sees half of it
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(QGCMetricsLog) << "Unable to write metrics" << fileName << file.errorString();
+        return false;
+    }
+    (void) file.write(fileName.endsWith(QStringLiteral(".json"), Qt::CaseInsensitive) ? toJson() : toPrometheus());
+    if (!file.commit()) {
+        qCWarning(QGCMetricsLog) << "Unable to write metrics" << fileName << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void QGCMetrics::setExportFile(const QString& fileName)
+{
+    QMutexLocker locker(&_mutex);
+    _exportFile = fileName;
+}
+
+void QGCMetrics::start(QObject* parent)
+{
+    QGCMetricHistogram* const eventLoopLag = histogram(
+        QStringLiteral("qgc_gui_event_loop_lag_seconds"),
+        QStringLiteral("How late a gui thread timer fires, which grows with the work queued ahead of it"));
+
+    QString exportFile;
+    {
+        QMutexLocker locker(&_mutex);
+        exportFile = _exportFile;
+    }
+
+    QTimer* const timer = new QTimer(parent);
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(_probeIntervalMSecs);
+
+    QElapsedTimer sinceProbe;
+    QElapsedTimer sinceExport;
+    sinceProbe.start();
+    sinceExport.start();
+    (void) QObject::connect(timer, &QTimer::timeout, timer, [this, eventLoopLag, exportFile, sinceProbe, sinceExport]() mutable {
+        eventLoopLag->record(sinceProbe.nsecsElapsed() - (_probeIntervalMSecs * Q_INT64_C(1000000)));
+        sinceProbe.restart();
+
+        if (!exportFile.isEmpty() && sinceExport.hasExpired(_exportIntervalMSecs)) {
+            sinceExport.restart();
+            (void) writeFile(exportFile);
+        }
+    });
+    timer->start();
+
+    if (!exportFile.isEmpty()) {
+        qCDebug(QGCMetricsLog) << "Writing metrics to" << exportFile;
+        (void) QObject::connect(parent, &QObject::destroyed, [this, exportFile]() {
+            (void) writeFile(exportFile);
+        });
+    }
+}
@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCMetricsLog)
+
+class QObject;
+
+/// Monotonic count of events. Incrementing is a single relaxed atomic add.
+/// Thread-safe.
+class QGCMetricCounter
+{
+public:
+    void    add     (quint64 count = 1) { _value.fetch_add(count, std::memory_order_relaxed); }
+    quint64 value   (void) const { return _value.load(std::memory_order_relaxed); }
+    void    reset   (void) { _value.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> _value{0};
+};
+
+/// Latency histogram in nsecs with log-linear buckets, in the style of an HDR histogram: each power of two is split
+/// into _subBucketCount buckets, so any percentile is within 12.5% of the real value whatever its size. Values from
+/// 1 nsec to about 18 minutes are tracked. Recording is a few relaxed atomic adds, percentiles are worked out when
+/// the histogram is read.
+/// Thread-safe. A read while values are being recorded may be off by the values in flight.
+class QGCMetricHistogram
+{
+public:
+    struct Snapshot_t {
+        quint64         count       = 0;
+        quint64         sumNSecs    = 0;
+        quint64         maxNSecs    = 0;
+        QList<quint64>  buckets;
+
+        /// @return Value which percentile (0-1) of the values are at or below, 0 if there are no values
+        quint64 percentileNSecs(double percentile) const;
+
+        double  meanNSecs(void) const { return count ? static_cast<double>(sumNSecs) / count : 0; }
+    };
+
+    void        record      (qint64 nsecs);
+    Snapshot_t  snapshot    (void) const;
+    void        reset       (void);
+
+    /// Records the lifetime of the scope
+    class Scope
+    {
+    public:
+        explicit Scope(QGCMetricHistogram* histogram) : _histogram(histogram) { _timer.start(); }
+        ~Scope() { _histogram->record(_timer.nsecsElapsed()); }
+
+    private:
+        QGCMetricHistogram* _histogram;
+        QElapsedTimer       _timer;
+    };
+
+    static int      bucketIndex     (quint64 nsecs);
+    static quint64  bucketMaxNSecs  (int index);                ///< Largest value which lands in the bucket
+
+    static constexpr int _subBucketBits     = 3;
+    static constexpr int _subBucketCount    = 1 << _subBucketBits;
+    static constexpr int _maxValueBits      = 40;
+    static constexpr int _bucketCount       = (_maxValueBits - _subBucketBits + 1) * _subBucketCount;
+
+private:
+    std::atomic<quint64> _buckets[_bucketCount] = {};
+    std::atomic<quint64> _sumNSecs{0};
+    std::atomic<quint64> _maxNSecs{0};
+};
+
+/// Registry of the performance counters and latency histograms kept by each subsystem. Metrics are registered once
+/// by name and labels, the same pair always returns the same metric, and they live until exit. Hot paths keep the
+/// returned pointer so recording never touches the registry.
+/// Metrics can be exported as JSON or in the Prometheus text format. Names follow the Prometheus conventions: a
+/// qgc_<subsystem>_ prefix, counters are exported with a _total suffix and histograms as summaries in seconds.
+/// Thread-safe.
+class QGCMetrics
+{
+public:
+    typedef QList<QPair<QString, QString>> Labels;
+
+    enum MetricType_t {
+        MetricTypeCounter,
+        MetricTypeHistogram,
+    };
+
+    struct Metric_t {
+        MetricType_t                            type;
+        QString                                 name;
+        QString                                 help;
+        Labels                                  labels;
+        std::unique_ptr<QGCMetricCounter>       counter;
+        std::unique_ptr<QGCMetricHistogram>     histogram;
+    };
+
+    static QGCMetrics* instance(void);
+
+    QGCMetricCounter*   counter     (const QString& name, const QString& help, const Labels& labels = Labels());
+    QGCMetricHistogram* histogram   (const QString& name, const QString& help, const Labels& labels = Labels());
+
+    /// Calls visitor for every metric, sorted by name then labels. The registry is locked during the calls.
+    template<typename Visitor>
+    void visit(Visitor visitor) const
+    {
+        QMutexLocker locker(&_mutex);
+        for (const std::unique_ptr<Metric_t>& metric: _metrics) {
+            visitor(*metric);
+        }
+    }
+
+    QByteArray toJson       (void) const;
+    QByteArray toPrometheus (void) const;
+
+    /// Zeroes every metric, for measuring from a known point
+    void reset(void);
+
+    /// Starts sampling the gui event loop lag and, if an export file is set, writing the metrics to it periodically
+    /// and when parent is destroyed. Call on the gui thread.
+    void start(QObject* parent);
+
+    /// Metrics are written as JSON if the file name ends in .json, otherwise as Prometheus text
+    void setExportFile(const QString& fileName);
+
+    bool writeFile(const QString& fileName) const;
+
+    static QString labelsToString(const Labels& labels);
+
+    /// Percentiles included in the exports
+    static constexpr double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+private:
+    QGCMetrics(void) = default;
+
+    Metric_t* _metric(MetricType_t type, const QString& name, const QString& help, const Labels& labels);
+
+    mutable QMutex                          _mutex;
+    std::vector<std::unique_ptr<Metric_t>>  _metrics;       ///< Sorted by name then labels
+    QString                                 _exportFile;
+
+    static constexpr int _probeIntervalMSecs = 100;
+    static constexpr int _exportIntervalMSecs = 10000;
+};
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCSignalCoalescer.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <atomic>
+
+QGC_LOGGING_CATEGORY(QGCSignalCoalescerLog, "QGCSignalCoalescerLog")
+
+QGCSignalCoalescer* QGCSignalCoalescer::instance(void)
+{
+    static QGCSignalCoalescer* coalescer = new QGCSignalCoalescer();
+    return coalescer;
+}
+
+QGCSignalCoalescer::QGCSignalCoalescer(void)
+    : _frameFallbackTimer(new QTimer(this))
+{
+    _frameFallbackTimer->setSingleShot(true);
+    _frameFallbackTimer->setInterval(_frameFallbackMSecs);
+    (void) connect(_frameFallbackTimer, &QTimer::timeout, this, &QGCSignalCoalescer::drain);
+
+    // Calls must run on the gui thread no matter which thread first asked for the instance
+    if (QCoreApplication::instance()) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+int QGCSignalCoalescer::newKey(void)
+{
+    static std::atomic<int> nextKey{0};
+    return nextKey++;
+}
+
+void QGCSignalCoalescer::post(const QObject* context, int key, std::function<void()> fn)
+{
+    const SlotKey_t slotKey(context, key);
+    bool scheduleDrain = false;
+    bool framePaced = false;
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        auto it = _pending.find(slotKey);
+        if (it != _pending.end()) {
+            // A destroyed context can have its address reused, in which case this is a new slot which needs its own
+            // entry in the call order
+            if (it->context.isNull()) {
+                _pendingOrder.removeOne(slotKey);
+                _pendingOrder.append(slotKey);
+            } else {
+                _coalescedCount++;
+            }
+            it->context = context;
+            it->fn      = std::move(fn);
+        } else {
+            _pending.insert(slotKey, Pending_t{ context, std::move(fn) });
+            _pendingOrder.append(slotKey);
+        }
+
+        if (!_drainScheduled) {
+            _drainScheduled = scheduleDrain = true;
+            framePaced = _framePaced;
+        }
+    }
+
+    if (!scheduleDrain) {
+        return;
+    }
+
+    if (framePaced) {
+        if (QThread::currentThread() == thread()) {
+            _requestFrame();
+        } else {
+            (void) QMetaObject::invokeMethod(this, &QGCSignalCoalescer::_requestFrame, Qt::QueuedConnection);
+        }
+    } else {
+        // However many calls are pending there is only ever one drain event in the queue
+        (void) QMetaObject::invokeMethod(this, &QGCSignalCoalescer::drain, Qt::QueuedConnection);
+    }
+}
+
+void QGCSignalCoalescer::_requestFrame(void)
+{
+    // Only ever modified on the gui thread, which is where this runs
+    if (!_requestFrameFn) {
+        (void) QMetaObject::invokeMethod(this, &QGCSignalCoalescer::drain, Qt::QueuedConnection);
+        return;
+    }
+
+    _requestFrameFn();
+    if (!_frameFallbackTimer->isActive()) {
+        _frameFallbackTimer->start();
+    }
+}
+
+void QGCSignalCoalescer::setFrameRequester(std::function<void()> requestFrame)
+{
+    bool drainNow = false;
+
+    {
+        QMutexLocker locker(&_mutex);
+        _framePaced = static_cast<bool>(requestFrame);
+        _requestFrameFn = std::move(requestFrame);
+        drainNow = _drainScheduled;
+    }
+
+    qCDebug(QGCSignalCoalescerLog) << "Frame paced:" << framePaced();
+
+    // Anything still waiting on a frame or an event loop pass from the previous mode
+    if (drainNow) {
+        _requestFrame();
+    }
+}
+
+bool QGCSignalCoalescer::framePaced(void) const
+{
+    QMutexLocker locker(&_mutex);
+    return _framePaced;
+}
+
+void QGCSignalCoalescer::drain(void)
+{
+    QHash<SlotKey_t, Pending_t> pending;
+    QList<SlotKey_t>            pendingOrder;
+
+    _frameFallbackTimer->stop();
+
+    {
+        QMutexLocker locker(&_mutex);
+        if (!_drainScheduled) {
+            // Frame paced drains are called for every frame, most of which have nothing to do
+            return;
+        }
+        pending.swap(_pending);
+        pendingOrder.swap(_pendingOrder);
+        _drainScheduled = false;
+    }
+
+    // Calls may post again, those land in the next drain
+    for (const SlotKey_t& slotKey: pendingOrder) {
+        const Pending_t& call = pending[slotKey];
+        if (call.context) {
+            call.fn();
+        }
+    }
+}
+
+quint64 QGCSignalCoalescer::coalescedCount(void) const
+{
+    QMutexLocker locker(&_mutex);
+    return _coalescedCount;
+}
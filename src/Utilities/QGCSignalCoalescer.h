@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+class QTimer;
+
+#include <functional>
+#include <type_traits>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCSignalCoalescerLog)
+
+/// Coalesces high rate notifications so only the latest one is delivered. Each notification is posted into a slot
+/// keyed by (context object, key). Posting to a slot which is already pending replaces the pending call, so no matter
+/// how many notifications arrive between drains only the most recent one runs. Pending calls are drained on the gui
+/// thread, once per event loop pass, with a single queued event for all of them. When frame paced they are instead
+/// drained once per rendered frame.
+/// Thread-safe: post may be called from any thread, calls always run on the gui thread.
+class QGCSignalCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static QGCSignalCoalescer* instance(void);
+
+    /// @return A new unique key to post with
+    static int newKey(void);
+
+    /// Queues fn to run at the next drain, replacing any call still pending for the same context and key. The call is
+    /// dropped if context is destroyed before the drain.
+    void post(const QObject* context, int key, std::function<void()> fn);
+
+    /// Runs all pending calls now
+    void drain(void);
+
+    /// @return Number of calls which were replaced by a newer one before they ran
+    quint64 coalescedCount(void) const;
+
+    /// Paces drains to the display. Instead of draining on the next event loop pass requestFrame is called, and the
+    /// owner of the frame calls drain while preparing it. If no frame comes within _frameFallbackMSecs, for example
+    /// because the window is minimized, pending calls are drained from the event loop anyway.
+    /// Pass an empty function to go back to event loop draining. Must be called on the gui thread.
+    void setFrameRequester(std::function<void()> requestFrame);
+
+    bool framePaced(void) const;
+
+    /// Connects signal to slot such that emissions are coalesced: the slot runs once per drain with the arguments of
+    /// the latest emission. Replaces queued connections whose slot only needs the most recent values.
+    template<typename Sender, typename SignalClass, typename... Args, typename Receiver, typename Slot>
+    static QMetaObject::Connection connect(const Sender* sender, void (SignalClass::*signal)(Args...), Receiver* receiver, Slot slot)
+    {
+        const int key = newKey();
+        return QObject::connect(sender, signal, receiver, [receiver, slot, key](Args... args) {
+            instance()->post(receiver, key, [receiver, slot, args...]() {
+                if constexpr (std::is_member_function_pointer_v<Slot>) {
+                    (receiver->*slot)(args...);
+                } else {
+                    slot(args...);
+                }
+            });
+        }, Qt::DirectConnection);
+    }
+
+private slots:
+    void _requestFrame(void);
+
+private:
+    QGCSignalCoalescer(void);
+
+    struct Pending_t {
+        QPointer<const QObject>     context;
+        std::function<void()>       fn;
+    };
+
+    typedef QPair<const QObject*, int> SlotKey_t;
+
+    mutable QMutex              _mutex;
+    QHash<SlotKey_t, Pending_t> _pending;
+    QList<SlotKey_t>            _pendingOrder;          ///< Calls run in the order they were first posted
+    bool                        _drainScheduled = false;
+    quint64                     _coalescedCount = 0;
+    std::function<void()>       _requestFrameFn;
+    bool                        _framePaced     = false;
+    QTimer*                     _frameFallbackTimer;
+
+    static constexpr int _frameFallbackMSecs = 100;
+};
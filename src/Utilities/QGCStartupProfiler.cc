@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCStartupProfiler.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+QGC_LOGGING_CATEGORY(QGCStartupProfilerLog, "QGCStartupProfilerLog")
+
+QGCStartupProfiler* QGCStartupProfiler::instance(void)
+{
+    static QGCStartupProfiler profiler;
+    return &profiler;
+}
+
+QGCStartupProfiler::QGCStartupProfiler(void)
+{
+    _timer.start();
+}
+
+void QGCStartupProfiler::setTraceFile(const QString& traceFile)
+{
+    QMutexLocker locker(&_mutex);
+    _traceFile = traceFile;
+}
+
+void QGCStartupProfiler::addEvent(const QString& name, const char* category, qint64 startNSecs, qint64 durationNSecs)
+{
+    qCDebug(QGCStartupProfilerLog) << category << name << "start(msecs):" << startNSecs / 1000000 << "duration(msecs):" << durationNSecs / 1000000.0;
+    _addEvent({ name, category, 'X', startNSecs, durationNSecs, reinterpret_cast<quintptr>(QThread::currentThreadId()) });
+}
+
+void QGCStartupProfiler::addInstantEvent(const QString& name, const char* category)
+{
+    const qint64 nsecs = elapsedNSecs();
+    qCDebug(QGCStartupProfilerLog) << category << name << "at(msecs):" << nsecs / 1000000;
+    _addEvent({ name, category, 'i', nsecs, 0, reinterpret_cast<quintptr>(QThread::currentThreadId()) });
+}
+
+void QGCStartupProfiler::_addEvent(const Event_t& event)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_finished) {
+        _events.append(event);
+    }
+}
+
+void QGCStartupProfiler::finish(void)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+
+    qCDebug(QGCStartupProfilerLog) << "Startup complete msecs:" << _timer.elapsed();
+    if (!_traceFile.isEmpty() && _writeTrace()) {
+        qCDebug(QGCStartupProfilerLog) << "Startup trace written to" << _traceFile;
+    }
+    _events.clear();
+}
+
+bool QGCStartupProfiler::finished(void) const
+{
+    QMutexLocker locker(&_mutex);
+    return _finished;
+}
+
+bool QGCStartupProfiler::_writeTrace(void) const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+    for (const Event_t& event: _events) {
+        // Trace event times are in microseconds
+        QJsonObject jsonEvent;
+        jsonEvent[QStringLiteral("name")]   = event.name;
+        jsonEvent[QStringLiteral("cat")]    = QString::fromLatin1(event.category);
+        jsonEvent[QStringLiteral("ph")]     = QString(QChar::fromLatin1(event.phase));
+        jsonEvent[QStringLiteral("ts")]     = event.startNSecs / 1000.0;
+        jsonEvent[QStringLiteral("pid")]    = pid;
+        jsonEvent[QStringLiteral("tid")]    = QString::number(event.threadId);
+        if (event.phase == 'X') {
+            jsonEvent[QStringLiteral("dur")] = event.durationNSecs / 1000.0;
+        } else {
+            jsonEvent[QStringLiteral("s")] = QStringLiteral("g");
+        }
+        traceEvents.append(jsonEvent);
+    }
+
+    QJsonObject jsonTrace;
+    jsonTrace[QStringLiteral("traceEvents")]        = traceEvents;
+    jsonTrace[QStringLiteral("displayTimeUnit")]    = QStringLiteral("ms");
+
+    QFile file(_traceFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(QGCStartupProfilerLog) << "Unable to write startup trace" << _traceFile << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(jsonTrace).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QGCStartupProfiler::Scope::Scope(const QString& name, const char* category)
+    : _name         (name)
+    , _category     (category)
+    , _startNSecs   (QGCStartupProfiler::instance()->elapsedNSecs())
+{
+
+}
+
+QGCStartupProfiler::Scope::~Scope()
+{
+    QGCStartupProfiler* profiler = QGCStartupProfiler::instance();
+    if (!profiler->finished()) {
+        profiler->addEvent(_name, _category, _startNSecs, profiler->elapsedNSecs() - _startNSecs);
+    }
+}
@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCStartupProfilerLog)
+
+/// Collects timings for the startup sequence: tool construction, setToolbox calls, QML loading and the first frame.
+/// Every event is logged to QGCStartupProfilerLog. If a trace file is set the events are also written out in the
+/// Chrome trace event format when startup finishes, which can be opened in chrome://tracing or ui.perfetto.dev.
+/// Thread-safe: startup work may run on the global thread pool.
+class QGCStartupProfiler
+{
+public:
+    static QGCStartupProfiler* instance(void);
+
+    /// Enables writing the trace to the specified file once startup is finished
+    void setTraceFile(const QString& traceFile);
+
+    /// Adds an event which started at startNSecs and lasted durationNSecs. Times are relative to elapsedNSecs().
+    void addEvent(const QString& name, const char* category, qint64 startNSecs, qint64 durationNSecs);
+
+    /// Adds a point in time event at the current time
+    void addInstantEvent(const QString& name, const char* category);
+
+    /// @return nsecs since the profiler was created, which is as early in startup as possible
+    qint64 elapsedNSecs(void) const { return _timer.nsecsElapsed(); }
+
+    /// Marks startup as complete. Writes the trace file if one was set. Events added after this are dropped.
+    void finish(void);
+
+    bool finished(void) const;
+
+    /// Records the lifetime of the scope as an event
+    class Scope
+    {
+    public:
+        Scope(const QString& name, const char* category);
+        ~Scope();
+
+    private:
+        QString     _name;
+        const char* _category;
+        qint64      _startNSecs;
+    };
+
+private:
+    QGCStartupProfiler(void);
+
+    struct Event_t {
+        QString     name;
+        const char* category;
+        char        phase;              ///< 'X' complete event, 'i' instant event
+        qint64      startNSecs;
+        qint64      durationNSecs;
+        quint64     threadId;
+    };
+
+    void _addEvent(const Event_t& event);
+    bool _writeTrace(void) const;
+
+    QElapsedTimer   _timer;
+    mutable QMutex  _mutex;
+    QList<Event_t>  _events;
+    QString         _traceFile;
+    bool            _finished = false;
+};
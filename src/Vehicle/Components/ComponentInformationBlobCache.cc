@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ComponentInformationBlobCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryFile>
+
+QGC_LOGGING_CATEGORY(ComponentInformationBlobCacheLog, "ComponentInformationBlobCacheLog")
+
+ComponentInformationBlobCache::ComponentInformationBlobCache(const QString& path, int maxNumFiles, quint32 magic, quint32 version)
+    : _path(path)
+    , _magic(magic)
+    , _version(version)
+    , _fileCache(QDir(path), maxNumFiles)
+{
+
+}
+
+bool ComponentInformationBlobCache::load(const QString& fileTag, QByteArray& blob)
+{
+    blob.clear();
+
+    const QString fileName = _fileCache.access(fileTag);
+    if (fileName.isEmpty()) {
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(ComponentInformationBlobCacheLog) << "Unable to open" << fileName << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint16 checksum = 0;
+    stream >> magic >> version >> checksum >> blob;
+
+    if (stream.status() != QDataStream::Ok || magic != _magic || version != _version) {
+        qCWarning(ComponentInformationBlobCacheLog) << "Header invalid" << fileName;
+        blob.clear();
+        return false;
+    }
+    if (blob.isEmpty() || qChecksum(blob) != checksum) {
+        qCWarning(ComponentInformationBlobCacheLog) << "Blob corrupt" << fileName;
+        blob.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ComponentInformationBlobCache::save(const QString& fileTag, const QByteArray& blob)
+{
+    // ComponentInformationCache takes ownership of the file by moving it, so it must live on the same volume
+    QTemporaryFile file(_path + QLatin1String("/XXXXXX.tmp"));
+    file.setAutoRemove(false);
+    if (!file.open()) {
+        qCWarning(ComponentInformationBlobCacheLog) << "Unable to create" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << _magic << _version << qChecksum(blob) << blob;
+    file.close();
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(ComponentInformationBlobCacheLog) << "Failed writing" << file.fileName();
+        file.remove();
+        return false;
+    }
+
+    if (_fileCache.insert(fileTag, file.fileName()).isEmpty()) {
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+#include "ComponentInformationCache.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ComponentInformationBlobCacheLog)
+
+/// Binary blobs stored in a ComponentInformationCache directory. Each file is framed with a magic number, a format
+/// version and a checksum of the blob, so a truncated or corrupt file, or one from another format version, loads as
+/// a miss.
+/// Not thread-safe.
+class ComponentInformationBlobCache
+{
+public:
+    ComponentInformationBlobCache(const QString& path, int maxNumFiles, quint32 magic, quint32 version);
+
+    /// @return false: not in the cache or the entry is invalid, blob is empty
+    bool load(const QString& fileTag, QByteArray& blob);
+
+    /// Existing entries are left as is, the tag is expected to identify the content
+    ///     @return false: blob could not be written
+    bool save(const QString& fileTag, const QByteArray& blob);
+
+private:
+    QString                     _path;
+    quint32                     _magic;
+    quint32                     _version;
+    ComponentInformationCache   _fileCache;
+};
@@ -267,7 +267,7 @@ void RequestMetaDataTypeStateMachine::_stateRequestCompInfo(StateMachine* stateM
             stateMachine->advance();
         } else {
             qCDebug(ComponentInformationManagerLog) << "Requesting component metadata" << requestMachine->typeToString();
-            vehicle->requestMessage(
+            vehicle->requestMessageCached(
                         _requestMessageResultHandler,
                         stateMachine,
                         MAV_COMP_ID_AUTOPILOT1,
@@ -301,7 +301,7 @@ void RequestMetaDataTypeStateMachine::_stateRequestCompInfoDeprecated(StateMachi
             stateMachine->advance();
         } else {
             qCDebug(ComponentInformationManagerLog) << "Requesting component information" << requestMachine->typeToString();
-            vehicle->requestMessage(
+            vehicle->requestMessageCached(
                         _requestMessageResultHandlerDeprecated,
                         stateMachine,
                         MAV_COMP_ID_AUTOPILOT1,
@@ -19,76 +19,183 @@
 #include "GeoFenceManager.h"
 #include "RallyPointManager.h"
 #include "QGCLoggingCategory.h"
+#ifndef NO_SERIAL_LINK
+    #include "SerialLink.h"
+#endif
 
 QGC_LOGGING_CATEGORY(InitialConnectStateMachineLog, "InitialConnectStateMachineLog")
 
 InitialConnectStateMachine::InitialConnectStateMachine(Vehicle* vehicle)
-    : _vehicle(vehicle)
+    : QObject   (vehicle)
+    , _vehicle  (vehicle)
 {
-    static_assert(sizeof(_rgStates)/sizeof(_rgStates[0]) == sizeof(_rgProgressWeights)/sizeof(_rgProgressWeights[0]),
-            "array size mismatch");
+    for (int i = 0; i < StageCount; i++) {
+        _rgStageStates[i]       = StageWaiting;
+        _rgStageSubProgress[i]  = 0;
+        _rgStageStartMSecs[i]   = -1;
+        _rgStageEndMSecs[i]     = -1;
+        _progressWeightTotal    += _rgStages[i].progressWeight;
+
+        // Dependencies must point backwards in the table, which also rules out cycles
+        Q_ASSERT((_rgStages[i].dependencies & ~((1u << i) - 1)) == 0);
+    }
+}
 
-    _progressWeightTotal = 0;
-    for (int i = 0; i < _cStates; ++i) {
-        _progressWeightTotal += _rgProgressWeights[i];
+void InitialConnectStateMachine::start(void)
+{
+    _active = true;
+    _connectTimer.start();
+    qCDebug(InitialConnectStateMachineLog) << "Starting initial connect, link bandwidth budget:" << _linkBandwidthBudget();
+    _startReadyStages();
+}
+
+void InitialConnectStateMachine::stageCompleted(Stage_t stage)
+{
+    if (_rgStageStates[stage] != StageRunning) {
+        qCWarning(InitialConnectStateMachineLog) << "stageCompleted: stage not running" << _rgStages[stage].name << _rgStageStates[stage];
+        return;
     }
+
+    disconnect(_rgProgressConnections[stage]);
+    _rgStageStates[stage]       = StageDone;
+    _rgStageSubProgress[stage]  = 1;
+    _rgStageEndMSecs[stage]     = _connectTimer.elapsed();
+    qCDebug(InitialConnectStateMachineLog) << "Stage complete" << _rgStages[stage].name << "msecs:" << _rgStageEndMSecs[stage] - _rgStageStartMSecs[stage];
+
+    emit progressUpdate(_progress());
+    _startReadyStages();
 }
 
-int InitialConnectStateMachine::stateCount(void) const
+void InitialConnectStateMachine::_startReadyStages(void)
 {
-    return _cStates;
+    // Stages can complete synchronously from within their stage function, which calls back in here. Rather than
+    // recursing, note that another pass is needed and let the outer call loop.
+    if (_startingStages) {
+        _restartStages = true;
+        return;
+    }
+    _startingStages = true;
+
+    do {
+        _restartStages = false;
+        for (int i = 0; i < StageCount && _active; i++) {
+            if (_rgStageStates[i] != StageWaiting || !_dependenciesDone(i)) {
+                continue;
+            }
+            const int runningCost = _runningBandwidthCost();
+            if (runningCost != 0 && runningCost + _rgStages[i].bandwidthCost > _linkBandwidthBudget()) {
+                continue;
+            }
+
+            _rgStageStates[i]       = StageRunning;
+            _rgStageStartMSecs[i]   = _connectTimer.elapsed();
+            qCDebug(InitialConnectStateMachineLog) << "Stage start" << _rgStages[i].name << "at msecs:" << _rgStageStartMSecs[i];
+            (*_rgStages[i].stageFn)(this);
+        }
+    } while (_restartStages);
+
+    _startingStages = false;
+
+    if (_active) {
+        for (int i = 0; i < StageCount; i++) {
+            if (_rgStageStates[i] != StageDone) {
+                return;
+            }
+        }
+        _connectComplete();
+    }
 }
 
-const InitialConnectStateMachine::StateFn* InitialConnectStateMachine::rgStates(void) const
+bool InitialConnectStateMachine::_dependenciesDone(int stageIndex) const
 {
-    return &_rgStates[0];
+    for (int i = 0; i < StageCount; i++) {
+        if ((_rgStages[stageIndex].dependencies & (1u << i)) && _rgStageStates[i] != StageDone) {
+            return false;
+        }
+    }
+    return true;
 }
 
-void InitialConnectStateMachine::statesCompleted(void) const
+int InitialConnectStateMachine::_runningBandwidthCost(void) const
 {
+    int cost = 0;
+    for (int i = 0; i < StageCount; i++) {
+        if (_rgStageStates[i] == StageRunning) {
+            cost += _rgStages[i].bandwidthCost;
+        }
+    }
+    return cost;
+}
 
+int InitialConnectStateMachine::_linkBandwidthBudget(void) const
+{
+#ifndef NO_SERIAL_LINK
+    SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (sharedLink && sharedLink->linkConfiguration()->type() == LinkConfiguration::TypeSerial) {
+        const SerialConfiguration* serialConfig = qobject_cast<const SerialConfiguration*>(sharedLink->linkConfiguration().get());
+        if (serialConfig && serialConfig->baud() <= _lowBandwidthMaxBaud) {
+            return _lowBandwidthBudget;
+        }
+    }
+#endif
+    return _bandwidthBudget;
 }
 
-void InitialConnectStateMachine::advance()
+void InitialConnectStateMachine::_stageProgress(Stage_t stage, float subProgress)
 {
-    StateMachine::advance();
+    if (_rgStageStates[stage] != StageRunning) {
+        return;
+    }
+    _rgStageSubProgress[stage] = qBound(0.0f, subProgress, 1.0f);
     emit progressUpdate(_progress());
 }
 
-void InitialConnectStateMachine::gotProgressUpdate(float progressValue)
+float InitialConnectStateMachine::_progress(void) const
 {
-    emit progressUpdate(_progress(progressValue));
+    float progressWeight = 0;
+    for (int i = 0; i < StageCount; i++) {
+        progressWeight += _rgStages[i].progressWeight * _rgStageSubProgress[i];
+    }
+    return progressWeight / (float)_progressWeightTotal;
 }
 
-float InitialConnectStateMachine::_progress(float subProgress)
+void InitialConnectStateMachine::_connectComplete(void)
 {
-    int progressWeight = 0;
-    for (int i = 0; i < _stateIndex && i < _cStates; ++i) {
-        progressWeight += _rgProgressWeights[i];
+    _active = false;
+
+    if (InitialConnectStateMachineLog().isDebugEnabled()) {
+        for (int i = 0; i < StageCount; i++) {
+            qCDebug(InitialConnectStateMachineLog) << "Stage timing" << _rgStages[i].name << "start:" << _rgStageStartMSecs[i] << "end:" << _rgStageEndMSecs[i];
+        }
+        qCDebug(InitialConnectStateMachineLog) << "Initial connect msecs:" << _connectTimer.elapsed();
+        qCDebug(InitialConnectStateMachineLog) << "REQUEST_MESSAGE round trips saved by merging/caching:" << _vehicle->requestMessageRoundTripsSaved();
     }
-    int currentWeight = _stateIndex < _cStates ? _rgProgressWeights[_stateIndex] : 1;
-    return (progressWeight + currentWeight * subProgress) / (float)_progressWeightTotal;
+
+    // Vehicle resets its load progress once the machine is no longer active
+    emit progressUpdate(_progress());
+
+    qCDebug(InitialConnectStateMachineLog) << "Signalling initialConnectComplete";
+    emit _vehicle->initialConnectComplete();
 }
 
-void InitialConnectStateMachine::_stateRequestAutopilotVersion(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestAutopilotVersion(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:AUTOPILOT_VERSION request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageCompleted(StageAutopilotVersion);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:AUTOPILOT_VERSION request due to link type";
-            connectMachine->advance();
+            connectMachine->stageCompleted(StageAutopilotVersion);
         } else {
             qCDebug(InitialConnectStateMachineLog) << "Sending REQUEST_MESSAGE:AUTOPILOT_VERSION";
-            vehicle->requestMessage(_autopilotVersionRequestMessageHandler,
-                                    connectMachine,
-                                    MAV_COMP_ID_AUTOPILOT1,
-                                    MAVLINK_MSG_ID_AUTOPILOT_VERSION);
+            vehicle->requestMessageCached(_autopilotVersionRequestMessageHandler,
+                                          connectMachine,
+                                          MAV_COMP_ID_AUTOPILOT1,
+                                          MAVLINK_MSG_ID_AUTOPILOT_VERSION);
         }
     }
 }
@@ -179,31 +286,30 @@ void InitialConnectStateMachine::_autopilotVersionRequestMessageHandler(void* re
         vehicle->_setCapabilities(assumedCapabilities);
     }
 
-    connectMachine->advance();
+    connectMachine->stageCompleted(StageAutopilotVersion);
 }
 
-void InitialConnectStateMachine::_stateRequestProtocolVersion(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestProtocolVersion(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageCompleted(StageProtocolVersion);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to link type";
-            connectMachine->advance();
+            connectMachine->stageCompleted(StageProtocolVersion);
         } else if (vehicle->apmFirmware()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to Ardupilot firmware";
-            connectMachine->advance();
+            connectMachine->stageCompleted(StageProtocolVersion);
         } else {
             qCDebug(InitialConnectStateMachineLog) << "Sending REQUEST_MESSAGE:PROTOCOL_VERSION";
-            vehicle->requestMessage(_protocolVersionRequestMessageHandler,
-                                    connectMachine,
-                                    MAV_COMP_ID_AUTOPILOT1,
-                                    MAVLINK_MSG_ID_PROTOCOL_VERSION);
+            vehicle->requestMessageCached(_protocolVersionRequestMessageHandler,
+                                          connectMachine,
+                                          MAV_COMP_ID_AUTOPILOT1,
+                                          MAVLINK_MSG_ID_PROTOCOL_VERSION);
         }
     }
 }
@@ -248,94 +354,76 @@ void InitialConnectStateMachine::_protocolVersionRequestMessageHandler(void* res
         vehicle->_setMaxProtoVersionFromBothSources();
     }
 
-    connectMachine->advance();
+    connectMachine->stageCompleted(StageProtocolVersion);
 }
-void InitialConnectStateMachine::_stateRequestCompInfo(StateMachine* stateMachine)
+
+void InitialConnectStateMachine::_stateRequestCompInfo(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestCompInfo";
-    connect(vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
+    connectMachine->_rgProgressConnections[StageCompInfo] = connect(vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate, connectMachine,
+            [connectMachine](float progress) { connectMachine->_stageProgress(StageCompInfo, progress); });
     vehicle->_componentInformationManager->requestAllComponentInformation(_stateRequestCompInfoComplete, connectMachine);
 }
 
-void InitialConnectStateMachine::_stateRequestStandardModes(StateMachine *stateMachine)
+void InitialConnectStateMachine::_stateRequestStandardModes(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestStandardModes";
-    connect(vehicle->_standardModes, &StandardModes::requestCompleted, connectMachine,
-            &InitialConnectStateMachine::standardModesRequestCompleted);
+    // Single shot, the stage is over after the first completion
+    connectMachine->_rgProgressConnections[StageStandardModes] = connect(vehicle->_standardModes, &StandardModes::requestCompleted, connectMachine,
+            [connectMachine]() { connectMachine->stageCompleted(StageStandardModes); });
     vehicle->_standardModes->request();
 }
 
-void InitialConnectStateMachine::standardModesRequestCompleted()
-{
-    disconnect(_vehicle->_standardModes, &StandardModes::requestCompleted, this,
-               &InitialConnectStateMachine::standardModesRequestCompleted);
-    advance();
-}
-
 void InitialConnectStateMachine::_stateRequestCompInfoComplete(void* requestAllCompleteFnData)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(requestAllCompleteFnData);
-    disconnect(connectMachine->_vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate,
-            connectMachine, &InitialConnectStateMachine::gotProgressUpdate);
+    InitialConnectStateMachine* connectMachine = static_cast<InitialConnectStateMachine*>(requestAllCompleteFnData);
 
-    connectMachine->advance();
+    connectMachine->stageCompleted(StageCompInfo);
 }
 
-void InitialConnectStateMachine::_stateRequestParameters(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestParameters(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestParameters";
-    connect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
+    connectMachine->_rgProgressConnections[StageParameters] = connect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
+            [connectMachine](float progress) { connectMachine->_stageProgress(StageParameters, progress); });
     vehicle->_parameterManager->refreshAllParameters();
 }
 
-void InitialConnectStateMachine::_stateRequestMission(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestMission(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
-
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission: Skipping first mission load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageCompleted(StageMission);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission: Skipping first mission load request due to link type";
             vehicle->_firstMissionLoadComplete();
         } else {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission";
+            connectMachine->_rgProgressConnections[StageMission] = connect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
+                    [connectMachine](double progress) { connectMachine->_stageProgress(StageMission, progress); });
             vehicle->_missionManager->loadFromVehicle();
-            connect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
-                    &InitialConnectStateMachine::gotProgressUpdate);
         }
     }
 }
 
-void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestGeoFence(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: Skipping first geofence load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageCompleted(StageGeoFence);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: Skipping first geofence load request due to link type";
@@ -343,9 +431,9 @@ void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachin
         } else {
             if (vehicle->_geoFenceManager->supported()) {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence";
+                connectMachine->_rgProgressConnections[StageGeoFence] = connect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
+                        [connectMachine](double progress) { connectMachine->_stageProgress(StageGeoFence, progress); });
                 vehicle->_geoFenceManager->loadFromVehicle();
-                connect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
-                        &InitialConnectStateMachine::gotProgressUpdate);
             } else {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: skipped due to no support";
                 vehicle->_firstGeoFenceLoadComplete();
@@ -354,27 +442,23 @@ void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachin
     }
 }
 
-void InitialConnectStateMachine::_stateRequestRallyPoints(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestRallyPoints(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: Skipping first rally point load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageCompleted(StageRallyPoints);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: Skipping first rally point load request due to link type";
             vehicle->_firstRallyPointLoadComplete();
         } else {
             if (vehicle->_rallyPointManager->supported()) {
+                connectMachine->_rgProgressConnections[StageRallyPoints] = connect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
+                        [connectMachine](double progress) { connectMachine->_stageProgress(StageRallyPoints, progress); });
                 vehicle->_rallyPointManager->loadFromVehicle();
-                connect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
-                        &InitialConnectStateMachine::gotProgressUpdate);
             } else {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: skipping due to no support";
                 vehicle->_firstRallyPointLoadComplete();
@@ -382,17 +466,3 @@ void InitialConnectStateMachine::_stateRequestRallyPoints(StateMachine* stateMac
         }
     }
 }
-
-void InitialConnectStateMachine::_stateSignalInitialConnectComplete(StateMachine* stateMachine)
-{
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
-
-    disconnect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
-    connectMachine->advance();
-    qCDebug(InitialConnectStateMachineLog) << "Signalling initialConnectComplete";
-    emit vehicle->initialConnectComplete();
-}
-
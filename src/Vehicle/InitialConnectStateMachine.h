@@ -9,81 +9,128 @@
 
 #pragma once
 
-#include "StateMachine.h"
 #include "QGCMAVLink.h"
 #include "Vehicle.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
 
 Q_DECLARE_LOGGING_CATEGORY(InitialConnectStateMachineLog)
 
 class Vehicle;
 
-class InitialConnectStateMachine : public StateMachine
+/// Runs the initial connect sequence with a vehicle. The sequence is made up of stages with dependencies between
+/// them. A stage starts as soon as all of its dependencies have completed and the link has bandwidth left for it,
+/// so stages which do not depend on each other run concurrently.
+class InitialConnectStateMachine : public QObject
 {
     Q_OBJECT
 
 public:
+    enum Stage_t {
+        StageAutopilotVersion,
+        StageProtocolVersion,
+        StageStandardModes,
+        StageCompInfo,
+        StageParameters,
+        StageMission,
+        StageGeoFence,
+        StageRallyPoints,
+        StageCount
+    };
+    Q_ENUM(Stage_t)
+
     InitialConnectStateMachine(Vehicle* vehicle);
 
-    // Overrides from StateMachine
-    int             stateCount      (void) const final;
-    const StateFn*  rgStates        (void) const final;
-    void            statesCompleted (void) const final;
+    /// Starts all stages which have no dependencies
+    void start(void);
+
+    /// @return true: connect sequence is still running
+    bool active(void) const { return _active; }
+
+    /// Marks the specified stage as complete and starts any stages which were waiting on it
+    void stageCompleted(Stage_t stage);
 
-    void advance() override;
+    /// @return msecs from start until the stage started, -1 if it has not started yet
+    qint64 stageStartMSecs(Stage_t stage) const { return _rgStageStartMSecs[stage]; }
+
+    /// @return msecs from start until the stage completed, -1 if it has not completed yet
+    qint64 stageEndMSecs(Stage_t stage) const { return _rgStageEndMSecs[stage]; }
+
+    /// @return Bit mask of the stages which must complete before the specified stage can start
+    static quint32 stageDependencies(Stage_t stage) { return _rgStages[stage].dependencies; }
 
 signals:
     void progressUpdate(float progress);
 
-private slots:
-    void gotProgressUpdate(float progressValue);
-    void standardModesRequestCompleted();
-
 private:
-    static void _stateRequestAutopilotVersion           (StateMachine* stateMachine);
-    static void _stateRequestProtocolVersion            (StateMachine* stateMachine);
-    static void _stateRequestCompInfo                   (StateMachine* stateMachine);
-    static void _stateRequestStandardModes              (StateMachine* stateMachine);
+    typedef void (*StageFn)(InitialConnectStateMachine* connectMachine);
+
+    typedef enum {
+        StageWaiting,
+        StageRunning,
+        StageDone
+    } StageState_t;
+
+    struct StageInfo_t {
+        const char* name;
+        StageFn     stageFn;
+        quint32     dependencies;       ///< Bit mask of Stage_t
+        int         progressWeight;
+        int         bandwidthCost;      ///< Relative share of the link used while the stage is running
+    };
+
+    static void _stateRequestAutopilotVersion           (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestProtocolVersion            (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestCompInfo                   (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestStandardModes              (InitialConnectStateMachine* connectMachine);
     static void _stateRequestCompInfoComplete           (void* requestAllCompleteFnData);
-    static void _stateRequestParameters                 (StateMachine* stateMachine);
-    static void _stateRequestMission                    (StateMachine* stateMachine);
-    static void _stateRequestGeoFence                   (StateMachine* stateMachine);
-    static void _stateRequestRallyPoints                (StateMachine* stateMachine);
-    static void _stateSignalInitialConnectComplete      (StateMachine* stateMachine);
+    static void _stateRequestParameters                 (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestMission                    (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestGeoFence                   (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestRallyPoints                (InitialConnectStateMachine* connectMachine);
 
     static void _autopilotVersionRequestMessageHandler  (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
     static void _protocolVersionRequestMessageHandler   (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
 
-    float _progress(float subProgress = 0.f);
-
-    Vehicle* _vehicle;
-
-    int _progressWeightTotal;
-
-    static constexpr const StateMachine::StateFn _rgStates[] = {
-        _stateRequestAutopilotVersion,
-        _stateRequestProtocolVersion,
-        _stateRequestStandardModes,
-        _stateRequestCompInfo,
-        _stateRequestParameters,
-        _stateRequestMission,
-        _stateRequestGeoFence,
-        _stateRequestRallyPoints,
-        _stateSignalInitialConnectComplete
+    void    _startReadyStages       (void);
+    bool    _dependenciesDone       (int stageIndex) const;
+    int     _runningBandwidthCost   (void) const;
+    int     _linkBandwidthBudget    (void) const;
+    void    _stageProgress          (Stage_t stage, float subProgress);
+    void    _connectComplete        (void);
+    float   _progress               (void) const;
+
+    Vehicle*                _vehicle;
+    bool                    _active                 = false;
+    bool                    _startingStages         = false;
+    bool                    _restartStages          = false;
+    int                     _progressWeightTotal    = 0;
+    QElapsedTimer           _connectTimer;
+    StageState_t            _rgStageStates      [StageCount];
+    float                   _rgStageSubProgress [StageCount];
+    qint64                  _rgStageStartMSecs  [StageCount];
+    qint64                  _rgStageEndMSecs    [StageCount];
+    QMetaObject::Connection _rgProgressConnections[StageCount];
+
+    // Budget is in the same units as StageInfo_t::bandwidthCost. A stage is always allowed to start when nothing else
+    // is running, so a budget below the cost of a single stage still makes progress.
+    static constexpr int _bandwidthBudget           = 4;    ///< Two bulk transfers at once
+    static constexpr int _lowBandwidthBudget        = 2;    ///< One bulk transfer at a time
+    static constexpr int _lowBandwidthMaxBaud       = 57600;
+    static constexpr int _lightCost                 = 1;    ///< Single request/response
+    static constexpr int _bulkCost                  = 2;    ///< Parameter, mission or FTP transfer
+
+    // Mission, fence and rally points share the mission protocol which only supports one transfer at a time
+    static constexpr const StageInfo_t _rgStages[StageCount] = {
+        { "AutopilotVersion",   _stateRequestAutopilotVersion,  0,                              1, _lightCost },
+        { "ProtocolVersion",    _stateRequestProtocolVersion,   (1u << StageAutopilotVersion),  1, _lightCost },
+        { "StandardModes",      _stateRequestStandardModes,     (1u << StageProtocolVersion),   1, _lightCost },
+        { "CompInfo",           _stateRequestCompInfo,          (1u << StageProtocolVersion),   5, _bulkCost },
+        { "Parameters",         _stateRequestParameters,        (1u << StageCompInfo),          5, _bulkCost },
+        { "Mission",            _stateRequestMission,           (1u << StageProtocolVersion),   2, _bulkCost },
+        { "GeoFence",           _stateRequestGeoFence,          (1u << StageMission),           1, _bulkCost },
+        { "RallyPoints",        _stateRequestRallyPoints,       (1u << StageGeoFence),          1, _bulkCost },
     };
-
-    static constexpr const int _rgProgressWeights[] = {
-        1, //_stateRequestCapabilities
-        1, //_stateRequestProtocolVersion
-        1, //_stateRequestStandardModes
-        5, //_stateRequestCompInfo
-        5, //_stateRequestParameters
-        2, //_stateRequestMission
-        1, //_stateRequestGeoFence
-        1, //_stateRequestRallyPoints
-        1, //_stateSignalInitialConnectComplete
-    };
-
-    static constexpr int _cStates = sizeof(_rgStates) / sizeof(_rgStates[0]);
 };
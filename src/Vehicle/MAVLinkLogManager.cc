@@ -325,7 +325,6 @@ MAVLinkLogManager::setToolbox(QGCToolbox* toolbox)
 {
     QGCTool::setToolbox(toolbox);
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
-    qmlRegisterUncreatableType<MAVLinkLogManager>("QGroundControl.MAVLinkLogManager", 1, 0, "MAVLinkLogManager", "Reference only");
     //-- Logging location
     _ulogExtension  = ".";
     _ulogExtension += qgcApp()->toolbox()->settingsManager()->appSettings()->logFileExtension;
@@ -9,12 +9,24 @@
 
 #include "TrajectoryPoints.h"
 #include "Vehicle.h"
+#include "QGCApplication.h"
+#include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QtMath>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(TrajectoryPointsLog, "TrajectoryPointsLog")
 
 TrajectoryPoints::TrajectoryPoints(Vehicle* vehicle, QObject* parent)
     : QObject       (parent)
     , _vehicle      (vehicle)
     , _lastAzimuth  (qQNaN())
 {
+    Fact* maxPointsFact = qgcApp()->toolbox()->settingsManager()->flyViewSettings()->maxTrajectoryPoints();
+    connect(maxPointsFact, &Fact::rawValueChanged, this, &TrajectoryPoints::_maxPointsSettingChanged);
+    _maxPointsSettingChanged(maxPointsFact->rawValue());
 }
 
 void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
@@ -29,28 +41,138 @@ void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
             _vehicle->updateFlightDistance(distance);
             // Vehicle has moved far enough from previous point for an update
             double newAzimuth = _lastPoint.azimuthTo(coordinate);
-            if (qIsNaN(_lastAzimuth) || qAbs(newAzimuth - _lastAzimuth) > _azimuthTolerance) {
+            double azimuthChange = qAbs(newAzimuth - _lastAzimuth);
+            if (azimuthChange > 180.0) {
+                azimuthChange = 360.0 - azimuthChange;
+            }
+            if (qIsNaN(_lastAzimuth) || azimuthChange > _azimuthTolerance) {
                 // The new position IS NOT colinear with the last segment. Append the new position to the list.
-                _lastAzimuth = _lastPoint.azimuthTo(coordinate);
+                _lastAzimuth = newAzimuth;
                 _lastPoint = coordinate;
-                _points.append(QVariant::fromValue(coordinate));
-                emit pointAdded(coordinate);
+                _appendPoint(coordinate);
             } else {
                 // The new position IS colinear with the last segment. Don't add a new point, just update
                 // the last point to be the new position.
                 _lastPoint = coordinate;
-                _points[_points.count() - 1] = QVariant::fromValue(coordinate);
+                _points.last() = coordinate;
                 emit updateLastPoint(coordinate);
             }
         }
     } else {
         // Add the very first trajectory point to the list
         _lastPoint = coordinate;
-        _points.append(QVariant::fromValue(coordinate));
-        emit pointAdded(coordinate);
+        _appendPoint(coordinate);
+    }
+}
+
+void TrajectoryPoints::_appendPoint(const QGeoCoordinate& coordinate)
+{
+    _points.append(coordinate);
+    emit pointAdded(coordinate);
+
+    if (_points.count() > _maxPoints) {
+        // Simplify well below max so this only happens once every few hundred points
+        _simplify(_maxPoints * _simplifyPercent / 100);
+    }
+}
+
+void TrajectoryPoints::_simplify(int targetCount)
+{
+    const int previousCount = _points.count();
+    simplify(_points, targetCount, _maxPoints * _exactTailPercent / 100);
+    qCDebug(TrajectoryPointsLog) << "Simplified from" << previousCount << "to" << _points.count() << "points";
+
+    emit pointsSimplified();
+}
+
+void TrajectoryPoints::simplify(QList<QGeoCoordinate>& points, int targetCount, int exactTailCount)
+{
+    targetCount = qMax(targetCount, 2);
+
+    while (points.count() > targetCount) {
+        // Candidates for removal are the points between the first point and the exact tail, each of which must have a
+        // neighbour on both sides
+        const int lastCandidate = points.count() - qMax(exactTailCount, 1) - 1;
+        if (lastCandidate < 1) {
+            break;
+        }
+
+        QList<double> areas(lastCandidate + 1);
+        for (int i = 1; i <= lastCandidate; i++) {
+            areas[i] = _triangleArea(points[i - 1], points[i], points[i + 1]);
+        }
+
+        // Areas change as neighbours are removed, so at most every other candidate is removed in a single pass and
+        // the areas are recalculated for the next pass
+        const int removeCount = qMin(points.count() - targetCount, (lastCandidate + 1) / 2);
+        QList<double> sortedAreas(areas.constBegin() + 1, areas.constEnd());
+        std::nth_element(sortedAreas.begin(), sortedAreas.begin() + removeCount - 1, sortedAreas.end());
+        const double maxRemoveArea = sortedAreas[removeCount - 1];
+
+        QList<QGeoCoordinate> simplified;
+        simplified.reserve(points.count() - removeCount);
+        simplified.append(points[0]);
+        int  removed = 0;
+        bool previousRemoved = false;
+        for (int i = 1; i < points.count(); i++) {
+            if (i <= lastCandidate && !previousRemoved && removed < removeCount && areas[i] <= maxRemoveArea) {
+                removed++;
+                previousRemoved = true;
+            } else {
+                simplified.append(points[i]);
+                previousRemoved = false;
+            }
+        }
+        points.swap(simplified);
+
+        if (removed == 0) {
+            break;
+        }
+    }
+
+    if (points.count() > targetCount) {
+        // Nothing left which can be simplified
+        points.remove(0, points.count() - targetCount);
     }
 }
 
+double TrajectoryPoints::_triangleArea(const QGeoCoordinate& a, const QGeoCoordinate& b, const QGeoCoordinate& c)
+{
+    // Flat projection around b is plenty accurate for comparing the small triangles of a flight path
+    constexpr double metersPerDegree = 111319.49;
+    const double metersPerLonDegree = qCos(qDegreesToRadians(b.latitude())) * metersPerDegree;
+
+    const double baX = (a.longitude() - b.longitude()) * metersPerLonDegree;
+    const double baY = (a.latitude() - b.latitude()) * metersPerDegree;
+    const double bcX = (c.longitude() - b.longitude()) * metersPerLonDegree;
+    const double bcY = (c.latitude() - b.latitude()) * metersPerDegree;
+
+    return qAbs((baX * bcY) - (baY * bcX)) / 2.0;
+}
+
+QVariantList TrajectoryPoints::list(void) const
+{
+    QVariantList list;
+    list.reserve(_points.count());
+    for (const QGeoCoordinate& point: _points) {
+        list.append(QVariant::fromValue(point));
+    }
+    return list;
+}
+
+void TrajectoryPoints::setMaxPoints(int maxPoints)
+{
+    _maxPoints = qMax(maxPoints, _minMaxPoints);
+    if (_points.count() > _maxPoints) {
+        _simplify(_maxPoints);
+    }
+}
+
+void TrajectoryPoints::_maxPointsSettingChanged(QVariant value)
+{
+    setMaxPoints(value.toInt());
+}
+
 void TrajectoryPoints::start(void)
 {
     clear();
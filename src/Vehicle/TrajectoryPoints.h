@@ -10,11 +10,18 @@
 #pragma once
 
 #include <QtPositioning/QGeoCoordinate>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 
+Q_DECLARE_LOGGING_CATEGORY(TrajectoryPointsLog)
+
 class Vehicle;
 
+/// Flight path of a vehicle. Positions are filtered as they arrive so a straight segment only needs two points. The
+/// path is bounded by the maxTrajectoryPoints setting, once it is full the older part of the path is simplified to make
+/// room for new points.
 class TrajectoryPoints : public QObject
 {
     Q_OBJECT
@@ -22,28 +29,52 @@ class TrajectoryPoints : public QObject
 public:
     TrajectoryPoints(Vehicle* vehicle, QObject* parent = nullptr);
 
-    Q_INVOKABLE QVariantList list(void) const { return _points; }
+    /// @return The whole path for the map. Only needed when the path is first shown or after pointsSimplified, all
+    /// other changes are signalled one point at a time.
+    Q_INVOKABLE QVariantList list(void) const;
+
+    const QList<QGeoCoordinate>& points(void) const { return _points; }
+
+    int  maxPoints      (void) const { return _maxPoints; }
+    void setMaxPoints   (int maxPoints);
 
     void start  (void);
     void stop   (void);
 
+    /// Simplifies points down to targetCount using Visvalingam-Whyatt: the points which add the least area to the path
+    /// are removed first. The first point and the last exactTailCount points are never removed. If that is not enough
+    /// to get down to targetCount the oldest points are dropped.
+    static void simplify(QList<QGeoCoordinate>& points, int targetCount, int exactTailCount);
+
 public slots:
     void clear  (void);
 
 signals:
-    void pointAdded     (QGeoCoordinate coordinate);
-    void updateLastPoint(QGeoCoordinate coordinate);
-    void pointsCleared  (void);
+    void pointAdded         (QGeoCoordinate coordinate);
+    void updateLastPoint    (QGeoCoordinate coordinate);
+    void pointsCleared      (void);
+    void pointsSimplified   (void);     ///< Older points were removed, the path must be reloaded using list()
 
 private slots:
-    void _vehicleCoordinateChanged(QGeoCoordinate coordinate);
+    void _vehicleCoordinateChanged  (QGeoCoordinate coordinate);
+    void _maxPointsSettingChanged   (QVariant value);
 
 private:
-    Vehicle*        _vehicle;
-    QVariantList    _points;
-    QGeoCoordinate  _lastPoint;
-    double          _lastAzimuth;
+    void _appendPoint   (const QGeoCoordinate& coordinate);
+    void _simplify      (int targetCount);
+
+    static double _triangleArea(const QGeoCoordinate& a, const QGeoCoordinate& b, const QGeoCoordinate& c);
+
+    Vehicle*                _vehicle;
+    QList<QGeoCoordinate>   _points;
+    QGeoCoordinate          _lastPoint;
+    double                  _lastAzimuth;
+    int                     _maxPoints = _defaultMaxPoints;
 
-    static constexpr double _distanceTolerance = 2.0;
-    static constexpr double _azimuthTolerance = 1.5;
+    static constexpr double _distanceTolerance  = 2.0;
+    static constexpr double _azimuthTolerance   = 1.5;
+    static constexpr int    _defaultMaxPoints   = 5000;
+    static constexpr int    _minMaxPoints       = 100;
+    static constexpr int    _simplifyPercent    = 75;   ///< A full path is simplified down to this percentage of max points
+    static constexpr int    _exactTailPercent   = 10;   ///< Percentage of max points at the end of the path which is never simplified
 };
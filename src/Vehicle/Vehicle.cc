@@ -20,6 +20,8 @@
 #include "GeoFenceManager.h"
 #include "ImageProtocolManager.h"
 #include "InitialConnectStateMachine.h"
+#include "QGCSignalCoalescer.h"
+#include "QGCMetrics.h"
 #include "Joystick.h"
 #include "JoystickManager.h"
 #include "LinkManager.h"
@@ -164,9 +166,8 @@ Vehicle::Vehicle(LinkInterface*             link,
     _prearmErrorTimer.setSingleShot(true);
 
     // Send MAV_CMD ack timer
-    _mavCommandResponseCheckTimer.setSingleShot(false);
-    _mavCommandResponseCheckTimer.setInterval(_mavCommandResponseCheckTimeoutMSecs);
-    _mavCommandResponseCheckTimer.start();
+    _mavCommandResponseCheckTimer.setSingleShot(true);
+    _mavCommandResponseCheckTimer.setTimerType(Qt::PreciseTimer);
     connect(&_mavCommandResponseCheckTimer, &QTimer::timeout, this, &Vehicle::_sendMavCommandResponseTimeoutCheck);
 
     // MAV_TYPE_GENERIC is used by unit test for creating a vehicle which doesn't do the connect sequence. This
@@ -378,6 +379,10 @@ Vehicle::~Vehicle()
 {
     qCDebug(VehicleLog) << "~Vehicle" << this;
 
+    for (const auto& requestMessageInfos: _requestMessageInfoMap) {
+        qDeleteAll(requestMessageInfos);
+    }
+
     delete _missionManager;
     _missionManager = nullptr;
 
@@ -485,6 +490,10 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
         }
     }
 
+    static QGCMetricHistogram* const dispatchMetric = QGCMetrics::instance()->histogram(
+        QStringLiteral("qgc_vehicle_dispatch_seconds"), QStringLiteral("Time for a vehicle to handle a message, fact groups included"));
+    QGCMetricHistogram::Scope dispatchScope(dispatchMetric);
+
     // We give the link manager first whack since it it reponsible for adding new links
     _vehicleLinkManager->mavlinkMessageReceived(link, message);
 
@@ -538,8 +547,13 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     VehicleBatteryFactGroup::handleMessageForFactGroupCreation(this, message);
 
     // Let the fact groups take a whack at the mavlink traffic
-    for (FactGroup* factGroup : factGroups()) {
-        factGroup->handleMessage(this, message);
+    {
+        static QGCMetricHistogram* const factGroupMetric = QGCMetrics::instance()->histogram(
+            QStringLiteral("qgc_vehicle_fact_group_update_seconds"), QStringLiteral("Time for all of a vehicle's fact groups to handle a message"));
+        QGCMetricHistogram::Scope factGroupScope(factGroupMetric);
+        for (FactGroup* factGroup : factGroups()) {
+            factGroup->handleMessage(this, message);
+        }
     }
 
     this->handleMessage(this, message);
@@ -750,7 +764,7 @@ void Vehicle::_handleGpsRawInt(mavlink_message_t& message)
             QGeoCoordinate newPosition(gpsRawInt.lat  / (double)1E7, gpsRawInt.lon / (double)1E7, gpsRawInt.alt  / 1000.0);
             if (newPosition != _coordinate) {
                 _coordinate = newPosition;
-                emit coordinateChanged(_coordinate);
+                _postCoordinateChanged();
             }
             if (!_altitudeMessageAvailable) {
                 _altitudeAMSLFact.setRawValue(gpsRawInt.alt / 1000.0);
@@ -780,7 +794,7 @@ void Vehicle::_handleGlobalPositionInt(mavlink_message_t& message)
     QGeoCoordinate newPosition(globalPositionInt.lat  / (double)1E7, globalPositionInt.lon / (double)1E7, globalPositionInt.alt  / 1000.0);
     if (newPosition != _coordinate) {
         _coordinate = newPosition;
-        emit coordinateChanged(_coordinate);
+        _postCoordinateChanged();
     }
 }
 
@@ -821,7 +835,7 @@ void Vehicle::_handleHighLatency(mavlink_message_t& message)
     _coordinate.setLatitude(coordinate.latitude);
     _coordinate.setLongitude(coordinate.longitude);
     _coordinate.setAltitude(coordinate.altitude);
-    emit coordinateChanged(_coordinate);
+    _postCoordinateChanged();
 
     _airSpeedFact.setRawValue((double)highLatency.airspeed / 5.0);
     _groundSpeedFact.setRawValue((double)highLatency.groundspeed / 5.0);
@@ -858,7 +872,7 @@ void Vehicle::_handleHighLatency2(mavlink_message_t& message)
     _coordinate.setLatitude(highLatency2.latitude  / (double)1E7);
     _coordinate.setLongitude(highLatency2.longitude / (double)1E7);
     _coordinate.setAltitude(highLatency2.altitude);
-    emit coordinateChanged(_coordinate);
+    _postCoordinateChanged();
 
     _airSpeedFact.setRawValue((double)highLatency2.airspeed / 5.0);
     _groundSpeedFact.setRawValue((double)highLatency2.groundspeed / 5.0);
@@ -1816,13 +1830,13 @@ void Vehicle::_gotProgressUpdate(float progressValue)
 void Vehicle::_firstMissionLoadComplete()
 {
     disconnect(_missionManager, &MissionManager::newMissionItemsAvailable, this, &Vehicle::_firstMissionLoadComplete);
-    _initialConnectStateMachine->advance();
+    _initialConnectStateMachine->stageCompleted(InitialConnectStateMachine::StageMission);
 }
 
 void Vehicle::_firstGeoFenceLoadComplete()
 {
     disconnect(_geoFenceManager, &GeoFenceManager::loadComplete, this, &Vehicle::_firstGeoFenceLoadComplete);
-    _initialConnectStateMachine->advance();
+    _initialConnectStateMachine->stageCompleted(InitialConnectStateMachine::StageGeoFence);
 }
 
 void Vehicle::_firstRallyPointLoadComplete()
@@ -1830,7 +1844,7 @@ void Vehicle::_firstRallyPointLoadComplete()
     disconnect(_rallyPointManager, &RallyPointManager::loadComplete, this, &Vehicle::_firstRallyPointLoadComplete);
     _initialPlanRequestComplete = true;
     emit initialPlanRequestCompleteChanged(true);
-    _initialConnectStateMachine->advance();
+    _initialConnectStateMachine->stageCompleted(InitialConnectStateMachine::StageRallyPoints);
 }
 
 void Vehicle::_parametersReady(bool parametersReady)
@@ -1844,7 +1858,7 @@ void Vehicle::_parametersReady(bool parametersReady)
     if (parametersReady) {
         disconnect(_parameterManager, &ParameterManager::parametersReadyChanged, this, &Vehicle::_parametersReady);
         _setupAutoDisarmSignalling();
-        _initialConnectStateMachine->advance();
+        _initialConnectStateMachine->stageCompleted(InitialConnectStateMachine::StageParameters);
     }
 
     _multirotor_speed_limits_available = _firmwarePlugin->mulirotorSpeedLimitsAvailable(this);
@@ -2442,21 +2456,54 @@ void Vehicle::sendMavCommandIntWithHandler(const MavCmdAckHandlerInfo_t* ackHand
 
 bool Vehicle::isMavCommandPending(int targetCompId, MAV_CMD command)
 {
-    bool pending = ((-1) < _findMavCommandListEntryIndex(targetCompId, command));
+    bool pending = _findMavCommandListEntry(targetCompId, command) != nullptr;
     // qDebug() << "Pending target: " << targetCompId << ", command: " << (int)command << ", pending: " << (pending ? "yes" : "no");
     return pending;
 }
 
-int Vehicle::_findMavCommandListEntryIndex(int targetCompId, MAV_CMD command)
+Vehicle::MavCommandListEntry_t* Vehicle::_findMavCommandListEntry(int targetCompId, MAV_CMD command)
 {
-    for (int i=0; i<_mavCommandList.count(); i++) {
-        const MavCommandListEntry_t& entry = _mavCommandList[i];
-        if (entry.targetCompId == targetCompId && entry.command == command) {
-            return i;
-        }
+    auto it = _mavCommandQueues.find(_mavCommandKey(targetCompId, command));
+    if (it == _mavCommandQueues.end() || it->isEmpty()) {
+        return nullptr;
+    }
+
+    return &it->first();
+}
+
+bool Vehicle::_takeMavCommandListEntry(int targetCompId, MAV_CMD command, MavCommandListEntry_t& entry)
+{
+    auto it = _mavCommandQueues.find(_mavCommandKey(targetCompId, command));
+    if (it == _mavCommandQueues.end() || it->isEmpty()) {
+        return false;
+    }
+
+    entry = it->takeFirst();
+    if (it->isEmpty()) {
+        _mavCommandQueues.erase(it);
     }
+    // If the entry had the earliest deadline the check fires early, finds nothing due and re-arms itself
+    if (_mavCommandQueues.isEmpty()) {
+        _mavCommandResponseCheckTimer.stop();
+    }
+
+    return true;
+}
+
+/// Commands which fail due to no response are not counted
+QGCMetricHistogram* Vehicle::_mavCommandLatencyMetric(MAV_CMD command)
+{
+    return QGCMetrics::instance()->histogram(
+        QStringLiteral("qgc_vehicle_command_seconds"), QStringLiteral("Time from the first send of a command to its final ack"),
+        { { QStringLiteral("command"), _toolbox->missionCommandTree()->rawName(command) } });
+}
 
-    return -1;
+void Vehicle::_recordMavCommandLatency(const MavCommandListEntry_t& entry)
+{
+    const qint64 latencyNSecs = entry.latencyTimer.nsecsElapsed();
+    _mavCommandLatencyMetric(entry.command)->record(latencyNSecs);
+
+    qCDebug(VehicleLog) << "MAV_CMD latency" << _toolbox->missionCommandTree()->rawName(entry.command) << "compId" << entry.targetCompId << latencyNSecs / 1000000 << "msecs tries" << entry.tryCount;
 }
 
 bool Vehicle::_sendMavCommandShouldRetry(MAV_CMD command)
@@ -2564,23 +2611,32 @@ void Vehicle::_sendMavCommandWorker(
     entry.rgParam7          = param7;
     entry.maxTries          = _sendMavCommandShouldRetry(command) ? _mavCommandMaxRetryCount : 1;
     entry.ackTimeoutMSecs   = sharedLink->linkConfiguration()->isHighLatency() ? _mavCommandAckTimeoutMSecsHighLatency : _mavCommandAckTimeoutMSecs;
+    entry.nextCheckMSecs    = entry.ackTimeoutMSecs;
     entry.elapsedTimer.start();
+    entry.latencyTimer.start();
 
     qCDebug(VehicleLog) << Q_FUNC_INFO << "command:param1-7" << command << param1 << param2 << param3 << param4 << param5 << param6 << param7;
 
-    _mavCommandList.append(entry);
-    _sendMavCommandFromList(_mavCommandList.count() - 1);
+    const quint32 key = _mavCommandKey(targetCompId, command);
+    QList<MavCommandListEntry_t>& queue = _mavCommandQueues[key];
+    queue.append(entry);
+    _sendMavCommandFromList(key, queue.count() - 1);
+    _scheduleMavCommandResponseCheck(entry.ackTimeoutMSecs);
 }
 
-void Vehicle::_sendMavCommandFromList(int index)
+void Vehicle::_sendMavCommandFromList(quint32 key, int index)
 {
-    MavCommandListEntry_t commandEntry = _mavCommandList[index];
+    QList<MavCommandListEntry_t>& queue = _mavCommandQueues[key];
+    MavCommandListEntry_t commandEntry = queue[index];
 
     QString rawCommandName  = _toolbox->missionCommandTree()->rawName(commandEntry.command);
 
-    if (++_mavCommandList[index].tryCount > commandEntry.maxTries) {
+    if (++queue[index].tryCount > commandEntry.maxTries) {
         qCDebug(VehicleLog) << Q_FUNC_INFO << "giving up after max retries" << rawCommandName;
-        _mavCommandList.removeAt(index);
+        queue.removeAt(index);
+        if (queue.isEmpty()) {
+            _mavCommandQueues.remove(key);
+        }
         if (commandEntry.ackHandlerInfo.resultHandler) {
             mavlink_command_ack_t ack = {};
             ack.result = MAV_RESULT_FAILED;
@@ -2594,6 +2650,9 @@ void Vehicle::_sendMavCommandFromList(int index)
         return;
     }
 
+    // The first retry waits out the full ack timeout, subsequent retries follow at the response check interval
+    queue[index].nextCheckMSecs = queue[index].tryCount > 1 ? commandEntry.elapsedTimer.elapsed() + _mavCommandResponseCheckTimeoutMSecs : commandEntry.ackTimeoutMSecs;
+
     if (commandEntry.tryCount > 1 && !px4Firmware() && commandEntry.command == MAV_CMD_START_RX_PAIR) {
         // The implementation of this command comes from the IO layer and is shared across stacks. So for other firmwares
         // we aren't really sure whether they are correct or not.
@@ -2657,17 +2716,46 @@ void Vehicle::_sendMavCommandFromList(int index)
 
 void Vehicle::_sendMavCommandResponseTimeoutCheck(void)
 {
-    if (_mavCommandList.isEmpty()) {
-        return;
+    // Only the entries whose own deadline has passed are touched, everything else keeps waiting on its own schedule.
+    // The earliest deadline left is picked up on the same walk. This is the only place all pending commands are
+    // walked, sends and acks just move the check earlier when they need to.
+    qint64 nextCheckMSecs = -1;
+    const QList<quint32> keys = _mavCommandQueues.keys();
+    for (quint32 key: keys) {
+        // Walk the queue backwards since _sendMavCommandFromList can remove entries
+        for (int i=_mavCommandQueues.value(key).count()-1; i>=0; i--) {
+            // Result handlers called from _sendMavCommandFromList may have modified the queues
+            auto it = _mavCommandQueues.constFind(key);
+            if (it == _mavCommandQueues.constEnd() || i >= it->count()) {
+                continue;
+            }
+            if (it->at(i).elapsedTimer.elapsed() >= it->at(i).nextCheckMSecs) {
+                // Try sending command again
+                _sendMavCommandFromList(key, i);
+                it = _mavCommandQueues.constFind(key);
+                if (it == _mavCommandQueues.constEnd() || i >= it->count()) {
+                    continue;
+                }
+            }
+            const MavCommandListEntry_t& commandEntry = it->at(i);
+            const qint64 remainingMSecs = commandEntry.nextCheckMSecs - commandEntry.elapsedTimer.elapsed();
+            if (nextCheckMSecs == -1 || remainingMSecs < nextCheckMSecs) {
+                nextCheckMSecs = remainingMSecs;
+            }
+        }
     }
 
-    // Walk the list backwards since _sendMavCommandFromList can remove entries
-    for (int i=_mavCommandList.count()-1; i>=0; i--) {
-        MavCommandListEntry_t& commandEntry = _mavCommandList[i];
-        if (commandEntry.elapsedTimer.elapsed() > commandEntry.ackTimeoutMSecs) {
-            // Try sending command again
-            _sendMavCommandFromList(i);
-        }
+    if (nextCheckMSecs != -1) {
+        _scheduleMavCommandResponseCheck(nextCheckMSecs);
+    }
+}
+
+void Vehicle::_scheduleMavCommandResponseCheck(qint64 remainingMSecs)
+{
+    // +1 so the deadline has actually passed when the timer fires
+    const int intervalMSecs = static_cast<int>(qMax<qint64>(0, remainingMSecs)) + 1;
+    if (!_mavCommandResponseCheckTimer.isActive() || intervalMSecs < _mavCommandResponseCheckTimer.remainingTime()) {
+        _mavCommandResponseCheckTimer.start(intervalMSecs);
     }
 }
 
@@ -2704,26 +2792,29 @@ void Vehicle::_handleCommandAck(mavlink_message_t& message)
     }
 #endif
 
-    int entryIndex = _findMavCommandListEntryIndex(message.compid, static_cast<MAV_CMD>(ack.command));
-    if (entryIndex != -1) {
+    if (_findMavCommandListEntry(message.compid, static_cast<MAV_CMD>(ack.command))) {
         if (ack.result == MAV_RESULT_IN_PROGRESS) {
             MavCommandListEntry_t commandEntry;
             if (px4Firmware() && ack.command == MAV_CMD_DO_AUTOTUNE_ENABLE) {
                 // HacK to support PX4 autotune which does not send final result ack and just sends in progress
-                commandEntry = _mavCommandList.takeAt(entryIndex);
+                _takeMavCommandListEntry(message.compid, static_cast<MAV_CMD>(ack.command), commandEntry);
             } else {
                 // Command has not completed yet, don't remove
-                MavCommandListEntry_t& commandEntryRef = _mavCommandList[entryIndex];
+                MavCommandListEntry_t& commandEntryRef = *_findMavCommandListEntry(message.compid, static_cast<MAV_CMD>(ack.command));
                 commandEntryRef.maxTries = 1;         // Vehicle responsed to command so don't retry
                 commandEntryRef.elapsedTimer.start(); // We've heard from vehicle, restart elapsed timer for no ack received timeout
+                commandEntryRef.nextCheckMSecs = commandEntryRef.ackTimeoutMSecs;
                 commandEntry = commandEntryRef;
+                _scheduleMavCommandResponseCheck(commandEntryRef.nextCheckMSecs);
             }
 
             if (commandEntry.ackHandlerInfo.progressHandler) {
                 (*commandEntry.ackHandlerInfo.progressHandler)(commandEntry.ackHandlerInfo.progressHandlerData, message.compid, ack);
             }
         } else {
-            MavCommandListEntry_t commandEntry = _mavCommandList.takeAt(entryIndex);
+            MavCommandListEntry_t commandEntry;
+            _takeMavCommandListEntry(message.compid, static_cast<MAV_CMD>(ack.command), commandEntry);
+            _recordMavCommandLatency(commandEntry);
 
             if (commandEntry.ackHandlerInfo.resultHandler) {
                 (*commandEntry.ackHandlerInfo.resultHandler)(commandEntry.ackHandlerInfo.resultHandlerData, message.compid, ack, MavCmdResultCommandResultOnly);
@@ -2760,53 +2851,132 @@ void Vehicle::_handleCommandAck(mavlink_message_t& message)
     }
 }
 
-void Vehicle::_removeRequestMessageInfo(int compId, int msgId)
+static bool _requestMessageParamsMatch(const float* rgParam1, const float* rgParam2)
 {
-    if (_requestMessageInfoMap.contains(compId) && _requestMessageInfoMap[compId].contains(msgId)) {
-        delete _requestMessageInfoMap[compId][msgId];
-        _requestMessageInfoMap[compId].remove(msgId);
-    } else {
-        qWarning() << Q_FUNC_INFO << "compId:msgId not found" << compId << msgId;
+    for (int i=0; i<5; i++) {
+        if (rgParam1[i] != rgParam2[i]) {
+            return false;
+        }
     }
+    return true;
 }
 
+void Vehicle::_completeRequestMessage(RequestMessageInfo_t* requestMessageInfo, MAV_RESULT commandResult, RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message)
+{
+    const int compId = requestMessageInfo->compId;
+    const int msgId  = requestMessageInfo->msgId;
+
+    _requestMessageInfoMap[compId].remove(msgId);
+    if (_requestMessageInfoMap[compId].isEmpty()) {
+        _requestMessageInfoMap.remove(compId);
+    }
+    _requestMessageQueueMap[compId].removeOne(requestMessageInfo);
+
+    if (failureCode == RequestMessageNoFailure) {
+        RequestMessageCacheEntry_t& cacheEntry = _requestMessageCache[_requestMessageCacheKey(compId, msgId)];
+        memcpy(cacheEntry.rgParam, requestMessageInfo->rgParam, sizeof(cacheEntry.rgParam));
+        cacheEntry.message = message;
+        cacheEntry.receivedElapsedTimer.start();
+    }
+
+    const QList<RequestMessageResultHandlerInfo_t> resultHandlers = requestMessageInfo->resultHandlers;
+    delete requestMessageInfo;
+
+    // Get the next request for this component going before the callbacks, they may well make new requests
+    _sendNextRequestMessage(compId);
+
+    for (const RequestMessageResultHandlerInfo_t& resultHandler: resultHandlers) {
+        (*resultHandler.first)(resultHandler.second, commandResult, failureCode, message);
+    }
+}
+
+void Vehicle::_sendNextRequestMessage(int compId)
+{
+    auto queueIt = _requestMessageQueueMap.find(compId);
+    if (queueIt == _requestMessageQueueMap.end()) {
+        return;
+    }
+    if (queueIt->isEmpty()) {
+        _requestMessageQueueMap.erase(queueIt);
+        return;
+    }
+
+    RequestMessageInfo_t* nextRequestMessageInfo = nullptr;
+    for (RequestMessageInfo_t* requestMessageInfo: *queueIt) {
+        if (requestMessageInfo->commandSent) {
+            if (!requestMessageInfo->commandAckReceived) {
+                // Acks for REQUEST_MESSAGE can't be told apart, so we need to wait for this one first
+                return;
+            }
+        } else if (!nextRequestMessageInfo) {
+            nextRequestMessageInfo = requestMessageInfo;
+        }
+    }
+    if (!nextRequestMessageInfo) {
+        return;
+    }
+
+    if (!vehicleLinkManager()->primaryLink().lock()) {
+        // Don't leave the rest of the queue stuck behind a command which never went out
+        qCDebug(VehicleLog) << "_sendNextRequestMessage: primary link gone!";
+        mavlink_message_t message;
+        _completeRequestMessage(nextRequestMessageInfo, MAV_RESULT_FAILED, RequestMessageFailureCommandNotAcked, message);
+        return;
+    }
+
+    nextRequestMessageInfo->commandSent = true;
+
+    Vehicle::MavCmdAckHandlerInfo_t handlerInfo = {};
+    handlerInfo.resultHandler       = _requestMessageCmdResultHandler;
+    handlerInfo.resultHandlerData   = nextRequestMessageInfo;
+
+    _sendMavCommandWorker(false,                                    // commandInt
+                          false,                                    // showError
+                          &handlerInfo,
+                          compId,
+                          MAV_CMD_REQUEST_MESSAGE,
+                          MAV_FRAME_GLOBAL,
+                          nextRequestMessageInfo->msgId,
+                          nextRequestMessageInfo->rgParam[0],
+                          nextRequestMessageInfo->rgParam[1],
+                          nextRequestMessageInfo->rgParam[2],
+                          nextRequestMessageInfo->rgParam[3],
+                          nextRequestMessageInfo->rgParam[4],
+                          0);
+}
 
 void Vehicle::_waitForMavlinkMessageMessageReceivedHandler(const mavlink_message_t& message)
 {
     if (_requestMessageInfoMap.contains(message.compid) && _requestMessageInfoMap[message.compid].contains(message.msgid)) {
-        auto pInfo              = _requestMessageInfoMap[message.compid][message.msgid];
-        auto resultHandler      = pInfo->resultHandler;
-        auto resultHandlerData  = pInfo->resultHandlerData;
+        auto pInfo = _requestMessageInfoMap[message.compid][message.msgid];
 
         qCDebug(VehicleLog) << Q_FUNC_INFO << "message received - compId:msgId" << message.compid << message.msgid;
 
-        if (!pInfo->commandAckReceived) {
+        if (!pInfo->commandSent) {
+            // Message showed up by itself while the request was still queued, no need to ask for it
+            qCDebug(VehicleLog) << Q_FUNC_INFO << "message received before request was sent.";
+            _requestMessageRoundTripsSaved += pInfo->resultHandlers.count();
+        } else if (!pInfo->commandAckReceived) {
             qCDebug(VehicleLog) << Q_FUNC_INFO << "message received before ack came back.";
-            int entryIndex = _findMavCommandListEntryIndex(message.compid, MAV_CMD_REQUEST_MESSAGE);
-            if (entryIndex != -1) {
-                _mavCommandList.takeAt(entryIndex);
+            MavCommandListEntry_t commandEntry;
+            if (_takeMavCommandListEntry(message.compid, MAV_CMD_REQUEST_MESSAGE, commandEntry)) {
+                _recordMavCommandLatency(commandEntry);
             } else {
                 qWarning() << Q_FUNC_INFO << "Removing request message command from list failed - not found in list";
             }
         }
-        _removeRequestMessageInfo(message.compid, message.msgid);
 
-        (*resultHandler)(resultHandlerData, MAV_RESULT_ACCEPTED, RequestMessageNoFailure, message);
+        _completeRequestMessage(pInfo, MAV_RESULT_ACCEPTED, RequestMessageNoFailure, message);
     } else {
         // We use any incoming message as a trigger to check timeouts on message requests
 
         for (auto& compIdEntry : _requestMessageInfoMap) {
             for (auto requestMessageInfo : compIdEntry) {    
                 if (requestMessageInfo->messageWaitElapsedTimer.isValid() && requestMessageInfo->messageWaitElapsedTimer.elapsed() > (qgcApp()->runningUnitTests() ? 50 : 1000)) {
-                    auto resultHandler      = requestMessageInfo->resultHandler;
-                    auto resultHandlerData  = requestMessageInfo->resultHandlerData;
-
                     qCDebug(VehicleLog) << Q_FUNC_INFO << "request message timed out - compId:msgId" << requestMessageInfo->compId << requestMessageInfo->msgId;
 
-                    _removeRequestMessageInfo(requestMessageInfo->compId, requestMessageInfo->msgId);
-
                     mavlink_message_t message;
-                    (*resultHandler)(resultHandlerData, MAV_RESULT_FAILED, RequestMessageFailureMessageNotReceived, message);
+                    _completeRequestMessage(requestMessageInfo, MAV_RESULT_FAILED, RequestMessageFailureMessageNotReceived, message);
 
                     return; // We only handle one timeout at a time
                 }
@@ -2818,10 +2988,7 @@ void Vehicle::_waitForMavlinkMessageMessageReceivedHandler(const mavlink_message
 void Vehicle::_requestMessageCmdResultHandler(void* resultHandlerData_, [[maybe_unused]] int compId, const mavlink_command_ack_t& ack, MavCmdResultFailureCode_t failureCode)
 {
     auto requestMessageInfo = static_cast<RequestMessageInfo_t*>(resultHandlerData_);
-    auto resultHandler      = requestMessageInfo->resultHandler;
-    auto resultHandlerData  = requestMessageInfo->resultHandlerData;
     auto vehicle            = requestMessageInfo->vehicle;
-    auto message            = requestMessageInfo->message;
 
     requestMessageInfo->commandAckReceived = true;
     if (ack.result != MAV_RESULT_ACCEPTED) {
@@ -2840,58 +3007,68 @@ void Vehicle::_requestMessageCmdResultHandler(void* resultHandlerData_, [[maybe_
             break;
         }
 
-        vehicle->_removeRequestMessageInfo(requestMessageInfo->compId, requestMessageInfo->msgId);
-
-        (*resultHandler)(resultHandlerData, static_cast<MAV_RESULT>(ack.result),  requestMessageFailureCode, message);
+        vehicle->_completeRequestMessage(requestMessageInfo, static_cast<MAV_RESULT>(ack.result), requestMessageFailureCode, message);
 
         return;
     }
 
-    if (requestMessageInfo->messageReceived) {
-        // This should never happen. The command should have already been removed from the list when the message was received
-        qWarning() << Q_FUNC_INFO << "Command result handler should now have been called if message has already been received";
-    } else {
-        // Now that the request has been acked we start the timer to wait for the message
-        requestMessageInfo->messageWaitElapsedTimer.start();
-    }
+    // Now that the request has been acked we start the timer to wait for the message. The command slot for this
+    // component is free again, so the next queued request can go out while we wait.
+    requestMessageInfo->messageWaitElapsedTimer.start();
+    vehicle->_sendNextRequestMessage(requestMessageInfo->compId);
 }
 
-void Vehicle::_requestMessageWaitForMessageResultHandler(void* resultHandlerData, bool noResponsefromVehicle, const mavlink_message_t& message)
+void Vehicle::requestMessageCached(RequestMessageResultHandler resultHandler, void* resultHandlerData, int compId, int messageId, float param1, float param2, float param3, float param4, float param5)
 {
-    RequestMessageInfo_t* pInfo = static_cast<RequestMessageInfo_t*>(resultHandlerData);
+    const float rgParam[5] = { param1, param2, param3, param4, param5 };
 
-    pInfo->messageReceived  = true;
-    if (pInfo->commandAckReceived) {
-        (*pInfo->resultHandler)(pInfo->resultHandlerData, noResponsefromVehicle ? MAV_RESULT_FAILED : MAV_RESULT_ACCEPTED, noResponsefromVehicle ? RequestMessageFailureMessageNotReceived : RequestMessageNoFailure, message);
-    } else {
-        // Result handler will be called when we get the Ack
-        pInfo->message = message;
+    auto cacheIt = _requestMessageCache.find(_requestMessageCacheKey(compId, messageId));
+    if (cacheIt != _requestMessageCache.end()) {
+        if (cacheIt->receivedElapsedTimer.elapsed() > _requestMessageCacheTimeoutMSecs) {
+            _requestMessageCache.erase(cacheIt);
+        } else if (_requestMessageParamsMatch(cacheIt->rgParam, rgParam)) {
+            qCDebug(VehicleLog) << Q_FUNC_INFO << "answered from cache - compId:msgId" << compId << messageId;
+            _requestMessageRoundTripsSaved++;
+            const mavlink_message_t message = cacheIt->message;
+            (*resultHandler)(resultHandlerData, MAV_RESULT_ACCEPTED, RequestMessageNoFailure, message);
+            return;
+        }
     }
+
+    requestMessage(resultHandler, resultHandlerData, compId, messageId, param1, param2, param3, param4, param5);
 }
 
 void Vehicle::requestMessage(RequestMessageResultHandler resultHandler, void* resultHandlerData, int compId, int messageId, float param1, float param2, float param3, float param4, float param5)
 {
+    const float rgParam[5] = { param1, param2, param3, param4, param5 };
+
+    // Piggyback on an identical request which is already waiting on the vehicle
+    RequestMessageInfo_t* pendingRequestMessageInfo = _requestMessageInfoMap.value(compId).value(messageId, nullptr);
+    if (pendingRequestMessageInfo) {
+        if (_requestMessageParamsMatch(pendingRequestMessageInfo->rgParam, rgParam)) {
+            qCDebug(VehicleLog) << Q_FUNC_INFO << "merged with pending request - compId:msgId" << compId << messageId;
+            _requestMessageRoundTripsSaved++;
+            pendingRequestMessageInfo->resultHandlers.append(RequestMessageResultHandlerInfo_t(resultHandler, resultHandlerData));
+        } else {
+            // The responses to the two requests could not be told apart
+            qCDebug(VehicleLog) << Q_FUNC_INFO << "pending request with different params - compId:msgId" << compId << messageId;
+            mavlink_message_t message;
+            (*resultHandler)(resultHandlerData, MAV_RESULT_FAILED, RequestMessageFailureDuplicateCommand, message);
+        }
+        return;
+    }
+
     auto requestMessageInfo = new RequestMessageInfo_t;
     requestMessageInfo->vehicle                 = this;
     requestMessageInfo->compId                  = compId;
     requestMessageInfo->msgId                   = messageId;
-    requestMessageInfo->resultHandler           = resultHandler;
-    requestMessageInfo->resultHandlerData       = resultHandlerData;
+    memcpy(requestMessageInfo->rgParam, rgParam, sizeof(rgParam));
+    requestMessageInfo->resultHandlers.append(RequestMessageResultHandlerInfo_t(resultHandler, resultHandlerData));
 
     _requestMessageInfoMap[compId][messageId] = requestMessageInfo;
+    _requestMessageQueueMap[compId].append(requestMessageInfo);
 
-    Vehicle::MavCmdAckHandlerInfo_t handlerInfo;
-    handlerInfo.resultHandler       = _requestMessageCmdResultHandler;
-    handlerInfo.resultHandlerData   = requestMessageInfo;
-
-    _sendMavCommandWorker(false,                                    // commandInt
-                          false,                                    // showError
-                          &handlerInfo,
-                          compId,
-                          MAV_CMD_REQUEST_MESSAGE,
-                          MAV_FRAME_GLOBAL,
-                          messageId,
-                          param1, param2, param3, param4, param5, 0);
+    _sendNextRequestMessage(compId);
 }
 
 void Vehicle::setPrearmError(const QString& prearmError)
@@ -3323,6 +3500,12 @@ void Vehicle::_handleADSBVehicle(const mavlink_message_t &message)
             vehicleInfo.availableFlags |= ADSB::HeadingAvailable;
         }
 
+        if (adsbVehicleMsg.flags & ADSB_FLAGS_VALID_VELOCITY) {
+            vehicleInfo.groundSpeed = adsbVehicleMsg.hor_velocity / 1e2;
+            vehicleInfo.verticalRate = adsbVehicleMsg.ver_velocity / 1e2;
+            vehicleInfo.availableFlags |= ADSB::VelocityAvailable;
+        }
+
         (void) QMetaObject::invokeMethod(ADSBVehicleManager::instance(), "adsbVehicleUpdate", Qt::AutoConnection, vehicleInfo);
     }
 }
@@ -3435,10 +3618,20 @@ void Vehicle::_mavlinkMessageStatus(int uasId, uint64_t totalSent, uint64_t tota
         _mavlinkReceivedCount   = totalReceived;
         _mavlinkLossCount       = totalLoss;
         _mavlinkLossPercent     = lossPercent;
-        emit mavlinkStatusChanged();
+
+        // Status comes in with every message, the ui only needs to see the latest
+        static const int mavlinkStatusChangedKey = QGCSignalCoalescer::newKey();
+        QGCSignalCoalescer::instance()->post(this, mavlinkStatusChangedKey, [this]() { emit mavlinkStatusChanged(); });
     }
 }
 
+void Vehicle::_postCoordinateChanged(void)
+{
+    // Position comes in at message rate, listeners only need the latest one
+    static const int coordinateChangedKey = QGCSignalCoalescer::newKey();
+    QGCSignalCoalescer::instance()->post(this, coordinateChangedKey, [this]() { emit coordinateChanged(_coordinate); });
+}
+
 int Vehicle::versionCompare(QString& compare) const
 {
     return _firmwarePlugin->versionCompare(this, compare);
@@ -65,6 +65,7 @@ class MAVLinkProtocol;
 class MissionManager;
 class ParameterManager;
 class QGCCameraManager;
+class QGCMetricHistogram;
 class RallyPointManager;
 class RemoteIDManager;
 class RequestMessageTest;
@@ -625,6 +626,7 @@ public:
     VehicleObjectAvoidance*         objectAvoidance     () { return _objectAvoidance; }
     Autotune*                       autotune            () const { return _autotune; }
     RemoteIDManager*                remoteIDManager     () { return _remoteIDManager; }
+    InitialConnectStateMachine*     initialConnectStateMachine() { return _initialConnectStateMachine; }
 
     /// Sends the specified MAV_CMD to the vehicle. If no Ack is received command will be retried. If a sendMavCommand is already in progress
     /// the command will be queued and sent when the previous command completes.
@@ -710,10 +712,20 @@ public:
     typedef void (*RequestMessageResultHandler)(void* resultHandlerData, MAV_RESULT commandResult, RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
 
     /// Requests the vehicle to send the specified message. Will retry a number of times.
+    /// Concurrent requests for the same message are merged into a single command, requests for different messages from the
+    /// same component are sent one after the other. The vehicle is always asked, use requestMessageCached for messages
+    /// whose contents do not change.
     ///     @param resultHandler Callback for result
     ///     @param resultHandlerData Opaque data passed back to resultHandler
     void requestMessage(RequestMessageResultHandler resultHandler, void* resultHandlerData, int compId, int messageId, float param1 = 0.0f, float param2 = 0.0f, float param3 = 0.0f, float param4 = 0.0f, float param5 = 0.0f);
 
+    /// Same as requestMessage, except that a message received in response to any request with the same params within
+    /// the last couple of seconds is handed back immediately without asking the vehicle again.
+    void requestMessageCached(RequestMessageResultHandler resultHandler, void* resultHandlerData, int compId, int messageId, float param1 = 0.0f, float param2 = 0.0f, float param3 = 0.0f, float param4 = 0.0f, float param5 = 0.0f);
+
+    /// @return Number of requestMessage calls which were answered without a round trip to the vehicle of their own
+    int requestMessageRoundTripsSaved() const { return _requestMessageRoundTripsSaved; }
+
     int firmwareMajorVersion() const { return _firmwareMajorVersion; }
     int firmwareMinorVersion() const { return _firmwareMinorVersion; }
     int firmwarePatchVersion() const { return _firmwarePatchVersion; }
@@ -943,6 +955,7 @@ private:
     void _loadJoystickSettings          ();
     void _activeVehicleChanged          (Vehicle* newActiveVehicle);
     void _captureJoystick               ();
+    void _postCoordinateChanged         (void);
     void _handlePing                    (LinkInterface* link, mavlink_message_t& message);
     void _handleHomePosition            (mavlink_message_t& message);
     void _handleHeartbeat               (mavlink_message_t& message);
@@ -1162,24 +1175,36 @@ private:
 
     // requestMessage handling
 
+    typedef QPair<RequestMessageResultHandler, void* /* resultHandlerData */> RequestMessageResultHandlerInfo_t;
+
     typedef struct RequestMessageInfo {
         Vehicle*                    vehicle             = nullptr;
         int                         compId;
         int                         msgId;
-        RequestMessageResultHandler resultHandler       = nullptr;
-        void*                       resultHandlerData   = nullptr;
+        float                       rgParam[5]          = { 0, 0, 0, 0, 0 };
+        QList<RequestMessageResultHandlerInfo_t> resultHandlers;    // Everyone waiting on this message, duplicate requests share a single command
+        bool                        commandSent         = false;    // false: Queued behind a command to the same component
         bool                        commandAckReceived  = false;    // We keep track of the ack/message being received since the order in which this will come in is random
-        bool                        messageReceived     = false;    // We only delete the allocated RequestMessageInfo_t when both happen (or the message wait times out)
         QElapsedTimer               messageWaitElapsedTimer;        // Elapsed time since we started waiting for the message to show up
-        mavlink_message_t           message;
     } RequestMessageInfo_t;
 
-    QMap<int /* compId */, QMap<int /* msgId */, RequestMessageInfo_t*>> _requestMessageInfoMap; // Map of all request message calls currently waiting on a response
+    typedef struct RequestMessageCacheEntry {
+        float                       rgParam[5];
+        QElapsedTimer               receivedElapsedTimer;
+        mavlink_message_t           message;
+    } RequestMessageCacheEntry_t;
+
+    QMap<int /* compId */, QMap<int /* msgId */, RequestMessageInfo_t*>> _requestMessageInfoMap;     // Map of all request message calls currently waiting on a response
+    QMap<int /* compId */, QList<RequestMessageInfo_t*>>                 _requestMessageQueueMap;    // Per component request order, only one REQUEST_MESSAGE command per component can be waiting on an ack
+    QHash<quint32 /* compId:msgId */, RequestMessageCacheEntry_t>        _requestMessageCache;       // Messages recently received in response to a request, only read by requestMessageCached
+    int                                                                  _requestMessageRoundTripsSaved = 0;
+    static const int                                                     _requestMessageCacheTimeoutMSecs = 2000;
 
-    void _removeRequestMessageInfo(int compId, int msgId);
+    void _sendNextRequestMessage    (int compId);
+    void _completeRequestMessage    (RequestMessageInfo_t* requestMessageInfo, MAV_RESULT commandResult, RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
 
-    static void _requestMessageCmdResultHandler             (void* resultHandlerData, int compId, const mavlink_command_ack_t& ack, MavCmdResultFailureCode_t failureCode);
-    static void _requestMessageWaitForMessageResultHandler  (void* resultHandlerData, bool noResponsefromVehicle, const mavlink_message_t& message);
+    static quint32 _requestMessageCacheKey(int compId, int msgId) { return (static_cast<quint32>(compId & 0xFF) << 24) | static_cast<quint32>(msgId & 0xFFFFFF); }
+    static void _requestMessageCmdResultHandler(void* resultHandlerData, int compId, const mavlink_command_ack_t& ack, MavCmdResultFailureCode_t failureCode);
 
     typedef struct MavCommandListEntry {
         int                     targetCompId        = MAV_COMP_ID_AUTOPILOT1;
@@ -1197,12 +1222,16 @@ private:
         MavCmdAckHandlerInfo_t  ackHandlerInfo;
         int                     maxTries            = _mavCommandMaxRetryCount;
         int                     tryCount            = 0;
-        QElapsedTimer           elapsedTimer;
+        QElapsedTimer           elapsedTimer;                   // Restarted each time we hear back from the vehicle
+        QElapsedTimer           latencyTimer;                   // Time since first send, used for latency stats
         int                     ackTimeoutMSecs     = _mavCommandAckTimeoutMSecs;
+        qint64                  nextCheckMSecs      = 0;        // elapsedTimer value at which this entry needs attention again
     } MavCommandListEntry_t;
 
-    QList<MavCommandListEntry_t>    _mavCommandList;
-    QTimer                          _mavCommandResponseCheckTimer;
+    // Pending commands are queued per (component, command) pair. Only commands which can be duplicated ever have more than
+    // one entry in a queue, acks are matched against the front of the queue.
+    QHash<quint32 /* key */, QList<MavCommandListEntry_t>>  _mavCommandQueues;
+    QTimer                                                  _mavCommandResponseCheckTimer;  // Armed at or before the earliest deadline of all pending commands
     static const int                _mavCommandMaxRetryCount                = 3;
     static const int                _mavCommandResponseCheckTimeoutMSecs    = 500;
     static const int                _mavCommandAckTimeoutMSecs              = 3000;
@@ -1213,8 +1242,13 @@ private:
             const MavCmdAckHandlerInfo_t* ackHandlerInfo,   ///> nullptr to signale no handlers
             int compId, MAV_CMD command, MAV_FRAME frame, 
             float param1, float param2, float param3, float param4, double param5, double param6, float param7);
-    void _sendMavCommandFromList(int index);
-    int  _findMavCommandListEntryIndex(int targetCompId, MAV_CMD command);
+    void _sendMavCommandFromList(quint32 key, int index);
+    MavCommandListEntry_t* _findMavCommandListEntry(int targetCompId, MAV_CMD command);
+    bool _takeMavCommandListEntry(int targetCompId, MAV_CMD command, MavCommandListEntry_t& entry);
+    void _scheduleMavCommandResponseCheck(qint64 remainingMSecs);
+    void _recordMavCommandLatency(const MavCommandListEntry_t& entry);
+    QGCMetricHistogram* _mavCommandLatencyMetric(MAV_CMD command);
+    static quint32 _mavCommandKey(int targetCompId, MAV_CMD command) { return (static_cast<quint32>(targetCompId & 0xFF) << 16) | static_cast<quint16>(command); }
     bool _sendMavCommandShouldRetry(MAV_CMD command);
     bool _commandCanBeDuplicated(MAV_CMD command);
 
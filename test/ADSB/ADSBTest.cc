@@ -2,12 +2,55 @@
 #include "ADSBVehicleManager.h"
 #include "ADSBVehicle.h"
 #include "ADSBTCPLink.h"
+#include "ADSBSpatialGrid.h"
+#include "ADSBSBSParser.h"
+#include "ADSBConflictDetector.h"
 #include "QmlObjectListModel.h"
+#include "QGCSignalCoalescer.h"
+#include "QGCApplication.h"
+#include "QGCToolbox.h"
+#include "SettingsManager.h"
+#include "ADSBVehicleManagerSettings.h"
+#include "Vehicle.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QRandomGenerator>
 #include <QtNetwork/QTcpServer>
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
 
+#include <algorithm>
+
+namespace {
+
+ADSB::VehicleInfo_t _trafficInfo(uint32_t icaoAddress, const QGeoCoordinate &location, double altitude, double heading, double groundSpeed)
+{
+    ADSB::VehicleInfo_t vehicleInfo{};
+    vehicleInfo.icaoAddress = icaoAddress;
+    vehicleInfo.location = location;
+    vehicleInfo.altitude = altitude;
+    vehicleInfo.heading = heading;
+    vehicleInfo.groundSpeed = groundSpeed;
+    vehicleInfo.verticalRate = 0;
+    vehicleInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::HeadingAvailable | ADSB::VelocityAvailable;
+    return vehicleInfo;
+}
+
+}
+
+void ADSBTest::cleanup()
+{
+    // The manager is an application singleton, don't let traffic or range settings leak into the next test
+    ADSBVehicleManager* const manager = ADSBVehicleManager::instance();
+    manager->_clearTraffic();
+    ADSBVehicleManagerSettings* const settings = qgcApp()->toolbox()->settingsManager()->adsbVehicleManagerSettings();
+    settings->adsbMaxDisplayDistance()->setRawValue(0);
+    settings->adsbMaxDisplayAltitudeDifference()->setRawValue(0);
+    QGCSignalCoalescer::instance()->drain();
+
+    UnitTest::cleanup();
+}
+
 void ADSBTest::_adsbVehicleTest()
 {
     ADSB::VehicleInfo_t vehicleInfo;
@@ -21,7 +64,6 @@ void ADSBTest::_adsbVehicleTest()
 
     ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
     QVERIFY(adsbVehicle != nullptr);
-    QVERIFY(!adsbVehicle->expired());
 
     QCOMPARE(adsbVehicle->icaoAddress(), vehicleInfo.icaoAddress);
     QCOMPARE(adsbVehicle->callsign(), vehicleInfo.callsign);
@@ -51,7 +93,7 @@ void ADSBTest::_adsbTcpLinkTest()
 
     ADSBTCPLink* const adsbLink = new ADSBTCPLink(QHostAddress::LocalHost, 30003, this);
     QVERIFY(adsbLink);
-    QSignalSpy spy(adsbLink, &ADSBTCPLink::adsbVehicleUpdate);
+    QSignalSpy spy(adsbLink, &ADSBTCPLink::adsbVehicleUpdates);
 
     bool timeout = false;
     QVERIFY(server->waitForNewConnection(1000, &timeout));
@@ -64,7 +106,16 @@ void ADSBTest::_adsbTcpLinkTest()
         (void) clientSocket->write(message);
     }
 
-    // QVERIFY(spy.wait(5000));
+    // Completes the garbage line above, then a position split across writes
+    (void) clientSocket->write("\r\nMSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,47.39");
+    (void) clientSocket->write("77,8.5456,,,0,0,0,0\r\n");
+    (void) clientSocket->flush();
+
+    QVERIFY(spy.wait(5000));
+    const QList<ADSB::VehicleInfo_t> batch = spy.first().first().value<QList<ADSB::VehicleInfo_t>>();
+    QCOMPARE(batch.count(), 1);
+    QCOMPARE(batch.first().icaoAddress, 0x4840D6u);
+    QCOMPARE(batch.first().location, QGeoCoordinate(47.3977, 8.5456));
 
     server->close();
 }
@@ -86,5 +137,386 @@ void ADSBTest::_adsbVehicleManagerTest()
     vehicleInfo.availableFlags = ADSB::LocationAvailable;
 
     manager->adsbVehicleUpdate(vehicleInfo);
-    QCOMPARE(manager->adsbVehicles()->count(), 1);
+    QCOMPARE(manager->trackedCount(), 1);
+
+    // The model is updated in a batch on the next ui tick
+    QCOMPARE(manager->adsbVehicles()->count(), 0);
+    QTRY_COMPARE(manager->adsbVehicles()->count(), 1);
+}
+
+void ADSBTest::_adsbSpatialGridTest()
+{
+    ADSBSpatialGrid grid(0.5);
+
+    const QGeoCoordinate center(47.3977, 8.5456);
+    grid.insert(1, center.atDistanceAndAzimuth(1000, 0));
+    grid.insert(2, center.atDistanceAndAzimuth(20000, 90));
+    grid.insert(3, center.atDistanceAndAzimuth(500000, 180));
+    // Neighbours across the antimeridian
+    grid.insert(4, QGeoCoordinate(0, 179.99));
+    grid.insert(5, QGeoCoordinate(0, -179.99));
+    QCOMPARE(grid.count(), 5);
+
+    QList<uint32_t> result;
+    grid.query(center, 25000, result);
+    QVERIFY(result.contains(1));
+    QVERIFY(result.contains(2));
+    QVERIFY(!result.contains(3));
+
+    // Moving an aircraft moves it to its new cell
+    grid.insert(3, center);
+    result.clear();
+    grid.query(center, 25000, result);
+    QVERIFY(result.contains(3));
+
+    result.clear();
+    grid.query(QGeoCoordinate(0, 180), 5000, result);
+    QVERIFY(result.contains(4));
+    QVERIFY(result.contains(5));
+
+    grid.remove(1);
+    result.clear();
+    grid.query(center, 25000, result);
+    QVERIFY(!result.contains(1));
+    QCOMPARE(grid.count(), 4);
+}
+
+void ADSBTest::_adsbVehicleManagerRangeTest()
+{
+    ADSBVehicleManager* const manager = ADSBVehicleManager::instance();
+    ADSBVehicleManagerSettings* const settings = qgcApp()->toolbox()->settingsManager()->adsbVehicleManagerSettings();
+
+    _connectMockLink();
+    QTRY_VERIFY(_vehicle->coordinate().isValid());
+    const QGeoCoordinate reference = _vehicle->coordinate();
+    QVERIFY(!qIsNaN(reference.altitude()));
+
+    const auto displayed = [manager]() {
+        QList<uint32_t> icaoAddresses;
+        for (int i = 0; i < manager->adsbVehicles()->count(); i++) {
+            icaoAddresses.append(qobject_cast<const ADSBVehicle*>(manager->adsbVehicles()->get(i))->icaoAddress());
+        }
+        std::sort(icaoAddresses.begin(), icaoAddresses.end());
+        return icaoAddresses;
+    };
+
+    settings->adsbMaxDisplayDistance()->setRawValue(5000);
+    settings->adsbMaxDisplayAltitudeDifference()->setRawValue(300);
+
+    constexpr uint32_t nearby = 1;
+    constexpr uint32_t distant = 2;
+    constexpr uint32_t above = 3;
+    constexpr uint32_t unknownAltitude = 4;
+    manager->adsbVehicleUpdate(_trafficInfo(nearby, reference.atDistanceAndAzimuth(1000, 0), reference.altitude() + 100, 0, 50));
+    manager->adsbVehicleUpdate(_trafficInfo(distant, reference.atDistanceAndAzimuth(10000, 0), reference.altitude(), 0, 50));
+    manager->adsbVehicleUpdate(_trafficInfo(above, reference.atDistanceAndAzimuth(1000, 90), reference.altitude() + 1000, 0, 50));
+    // The altitude band only applies to traffic which reports its altitude
+    ADSB::VehicleInfo_t vehicleInfo = _trafficInfo(unknownAltitude, reference.atDistanceAndAzimuth(2000, 180), 0, 0, 50);
+    vehicleInfo.availableFlags &= ~ADSB::AltitudeAvailable;
+    manager->adsbVehicleUpdate(vehicleInfo);
+
+    QGCSignalCoalescer::instance()->drain();
+    QCOMPARE(manager->trackedCount(), 4);
+    QCOMPARE(displayed(), QList<uint32_t>({ nearby, unknownAltitude }));
+
+    // Moving out of range drops the aircraft from the model, moving into range adds it
+    manager->adsbVehicleUpdate(_trafficInfo(nearby, reference.atDistanceAndAzimuth(20000, 0), reference.altitude(), 0, 50));
+    manager->adsbVehicleUpdate(_trafficInfo(distant, reference.atDistanceAndAzimuth(2000, 0), reference.altitude(), 0, 50));
+    QGCSignalCoalescer::instance()->drain();
+    QCOMPARE(manager->trackedCount(), 4);
+    QCOMPARE(displayed(), QList<uint32_t>({ distant, unknownAltitude }));
+
+    // Distance only
+    settings->adsbMaxDisplayAltitudeDifference()->setRawValue(0);
+    QGCSignalCoalescer::instance()->drain();
+    QCOMPARE(displayed(), QList<uint32_t>({ distant, above, unknownAltitude }));
+
+    // No limits shows all the traffic again
+    settings->adsbMaxDisplayDistance()->setRawValue(0);
+    QGCSignalCoalescer::instance()->drain();
+    QCOMPARE(displayed(), QList<uint32_t>({ nearby, distant, above, unknownAltitude }));
+}
+
+void ADSBTest::_adsbSBSParserTest()
+{
+    ADSB::VehicleInfo_t vehicleInfo{};
+    QVERIFY(ADSBSBSParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000H,,,47.3977,-8.5456,,,0,1,0,0\r\n", vehicleInfo));
+    QCOMPARE(vehicleInfo.icaoAddress, 0x4840D6u);
+    QVERIFY(vehicleInfo.availableFlags == (ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable));
+    QCOMPARE(vehicleInfo.location, QGeoCoordinate(47.3977, -8.5456));
+    QCOMPARE(vehicleInfo.altitude, 37000 * 0.3048);
+    QVERIFY(vehicleInfo.alert);
+
+    vehicleInfo = ADSB::VehicleInfo_t{};
+    QVERIFY(ADSBSBSParser::parseLine("MSG,4,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,420,275.5,,,0,,,,,0", vehicleInfo));
+    QCOMPARE(vehicleInfo.availableFlags, ADSB::HeadingAvailable);
+    QCOMPARE(vehicleInfo.heading, 275.5);
+
+    vehicleInfo = ADSB::VehicleInfo_t{};
+    QVERIFY(ADSBSBSParser::parseLine("MSG,1,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000, SWR123 ,,,,,,,,,,,", vehicleInfo));
+    QCOMPARE(vehicleInfo.availableFlags, ADSB::CallsignAvailable);
+    QCOMPARE(vehicleInfo.callsign, QStringLiteral("SWR123"));
+
+    // Unsupported, truncated and malformed lines
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,2,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,0,10,90,47.3977,8.5456,,,,,,-1", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,8,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,,,,,,,,,,0", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,47.3977", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,3,1,1,XYZ,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,47.3977,8.5456,,,0,0,0,0", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,0,0,,,0,0,0,0", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,8D4840D6202CC371C32CE0576098", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("STA,,5,179,400AE7,10103,2008/11/28,14:58:51.153,2008/11/28,14:58:51.153,RM", vehicleInfo));
+
+    // Lines split across appends and updates for the same aircraft merged into one batch entry
+    ADSBSBSParser parser;
+    parser.append("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,47.39");
+    QVERIFY(!parser.hasBatch());
+    parser.append("77,8.5456,,,0,0,0,0\nMSG,4,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,420,90,,,0,,,,,0\n");
+    parser.append("MSG,3,1,1,3C6586,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,5000,,,47.5,8.6,,,0,0,0,0\n");
+    QCOMPARE(parser.lineCount(), static_cast<quint64>(3));
+
+    const QList<ADSB::VehicleInfo_t> batch = parser.takeBatch();
+    QCOMPARE(batch.count(), 2);
+    QCOMPARE(batch[0].icaoAddress, 0x4840D6u);
+    QVERIFY(batch[0].availableFlags == (ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable | ADSB::HeadingAvailable));
+    QCOMPARE(batch[0].location, QGeoCoordinate(47.3977, 8.5456));
+    QCOMPARE(batch[0].heading, 90.);
+    QCOMPARE(batch[1].icaoAddress, 0x3C6586u);
+    QVERIFY(!parser.hasBatch());
+}
+
+void ADSBTest::_adsbSBSParserStreamTest()
+{
+    // Interleaved traffic the way dump1090 sends it, read in socket sized chunks so lines are split across appends
+    // Odd so every aircraft gets each of the message types
+    constexpr int aircraftCount = 49;
+    constexpr int lineCount = 2000;
+    constexpr qsizetype chunkSize = 1460;
+
+    QByteArray stream;
+    QHash<uint32_t, ADSB::VehicleInfo_t> expected;
+    for (int i = 0; i < lineCount; i++) {
+        const int aircraft = i % aircraftCount;
+        const uint32_t icaoAddress = 0x400000 + aircraft;
+        const QByteArray icao = QByteArray::number(icaoAddress, 16).toUpper();
+        ADSB::VehicleInfo_t &info = expected[icaoAddress];
+        info.icaoAddress = icaoAddress;
+        switch (i % 4) {
+        case 0:
+            stream += "MSG,1,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,T" + QByteArray::number(aircraft) + ",,,,,,,,,,,\r\n";
+            info.callsign = QStringLiteral("T%1").arg(aircraft);
+            break;
+        case 1:
+            stream += "MSG,4,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,420," + QByteArray::number(i % 360) + ",,,0,,,,,0\r\n";
+            info.heading = i % 360;
+            break;
+        default:
+        {
+            const QByteArray lat = QByteArray::number(47.0 + aircraft * 0.001, 'f', 5);
+            const QByteArray lon = QByteArray::number(8.0 + i * 0.0001, 'f', 5);
+            stream += "MSG,3,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,," + lat + "," + lon + ",,,0,0,0,0\r\n";
+            info.location = QGeoCoordinate(lat.toDouble(), lon.toDouble());
+            break;
+        }
+        }
+    }
+
+    ADSBSBSParser parser;
+    QHash<uint32_t, ADSB::VehicleInfo_t> received;
+    int batchedCount = 0;
+    const auto takeBatch = [&]() {
+        const QList<ADSB::VehicleInfo_t> batch = parser.takeBatch();
+        batchedCount += batch.count();
+        for (const ADSB::VehicleInfo_t &vehicleInfo : batch) {
+            ADSB::VehicleInfo_t &info = received[vehicleInfo.icaoAddress];
+            info.icaoAddress = vehicleInfo.icaoAddress;
+            ADSB::mergeVehicleInfo(info, vehicleInfo);
+        }
+    };
+    for (qsizetype offset = 0; offset < stream.size(); offset += chunkSize) {
+        parser.append(QByteArrayView(stream).sliced(offset, qMin(chunkSize, stream.size() - offset)));
+        if ((offset / chunkSize) % 8 == 0) {
+            takeBatch();
+        }
+    }
+    takeBatch();
+
+    QCOMPARE(parser.lineCount(), static_cast<quint64>(lineCount));
+    // Updates for the same aircraft within a batch are merged
+    QVERIFY(batchedCount < lineCount);
+    QCOMPARE(received.count(), aircraftCount);
+    for (const ADSB::VehicleInfo_t &info : std::as_const(expected)) {
+        const ADSB::VehicleInfo_t &actual = received.value(info.icaoAddress);
+        QVERIFY(actual.availableFlags == (ADSB::CallsignAvailable | ADSB::HeadingAvailable | ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable));
+        QCOMPARE(actual.callsign, info.callsign);
+        QCOMPARE(actual.heading, info.heading);
+        QCOMPARE(actual.location, info.location);
+        QCOMPARE(actual.altitude, 37000 * 0.3048);
+        QVERIFY(!actual.alert);
+    }
+}
+
+void ADSBTest::_adsbConflictDetectorTest()
+{
+    const QGeoCoordinate home(47.3977, 8.5456, 500);
+
+    QList<ADSBConflictDetector::Ownship_t> ownships;
+    ADSBConflictDetector::Ownship_t ownship;
+    ownship.vehicleId = 1;
+    ownship.location = home;
+    ownship.velocityNorth = 10;
+    ownships.append(ownship);
+
+    ADSBConflictDetector::Thresholds_t thresholds;
+    thresholds.horizontalSeparation = 500;
+    thresholds.verticalSeparation = 100;
+    thresholds.lookaheadSecs = 60;
+    thresholds.warningSecs = 20;
+
+    ADSBConflictDetector::Traffic_t traffic;
+    // Head on: 3 km north flying south at 40 m/s, closing at 50 m/s so CPA in 60 secs
+    traffic.append(_trafficInfo(1, home.atDistanceAndAzimuth(3000, 0), 520, 180, 40));
+    // Crossing: flying west at 50 m/s, crosses our track where we will be in 20 secs
+    traffic.append(_trafficInfo(2, home.atDistanceAndAzimuth(1000, 90).atDistanceAndAzimuth(200, 0), 480, 270, 50));
+    // Same crossing but 300 m above
+    traffic.append(_trafficInfo(3, home.atDistanceAndAzimuth(1000, 90).atDistanceAndAzimuth(200, 0), 800, 270, 50));
+    // Diverging: behind us flying away
+    traffic.append(_trafficInfo(4, home.atDistanceAndAzimuth(1000, 180), 500, 180, 50));
+    // Far away and outside the broad phase
+    traffic.append(_trafficInfo(5, home.atDistanceAndAzimuth(100000, 45), 500, 225, 50));
+    // Hovering right next to us with unknown altitude
+    ADSB::VehicleInfo_t hovering = _trafficInfo(6, home.atDistanceAndAzimuth(300, 0), 0, 0, 0);
+    hovering.availableFlags = ADSB::LocationAvailable;
+    traffic.append(hovering);
+
+    const QList<ADSBConflictDetector::Conflict_t> conflicts = ADSBConflictDetector::detect(ownships, traffic, thresholds);
+    QCOMPARE(conflicts.count(), 3);
+
+    // Warnings first, most urgent first
+    QCOMPARE(conflicts[0].icaoAddress, 6u);
+    QCOMPARE(conflicts[0].level, ADSB::ConflictWarning);
+    QCOMPARE(conflicts[0].timeToLoss, 0.);
+    QVERIFY(qIsNaN(conflicts[0].verticalCpa));
+
+    QCOMPARE(conflicts[1].icaoAddress, 2u);
+    QCOMPARE(conflicts[1].level, ADSB::ConflictWarning);
+    QVERIFY(qAbs(conflicts[1].timeToCpa - 20) < 0.5);
+    QVERIFY(conflicts[1].timeToLoss > 5);
+    QVERIFY(conflicts[1].timeToLoss < conflicts[1].timeToCpa);
+    QVERIFY(conflicts[1].horizontalCpa < 250);
+
+    QCOMPARE(conflicts[2].icaoAddress, 1u);
+    QCOMPARE(conflicts[2].level, ADSB::ConflictAdvisory);
+    QVERIFY(qAbs(conflicts[2].timeToCpa - 60) < 0.5);
+    QVERIFY(conflicts[2].horizontalCpa < 10);
+    QVERIFY(qAbs(conflicts[2].verticalCpa - 20) < 0.1);
+    QVERIFY(qAbs(conflicts[2].distance - 3000) < 10);
+
+    // A second vehicle sitting where the head on traffic is going gets its own conflict
+    ownship.vehicleId = 2;
+    ownship.location = home.atDistanceAndAzimuth(2000, 0);
+    ownship.velocityNorth = 0;
+    ownships.append(ownship);
+    const QList<ADSBConflictDetector::Conflict_t> conflicts2 = ADSBConflictDetector::detect(ownships, traffic, thresholds);
+    QVERIFY(std::any_of(conflicts2.cbegin(), conflicts2.cend(), [](const ADSBConflictDetector::Conflict_t &conflict) {
+        return (conflict.vehicleId == 2) && (conflict.icaoAddress == 1) && (conflict.level == ADSB::ConflictWarning);
+    }));
+
+    QVERIFY(ADSBConflictDetector::detect({}, traffic, thresholds).isEmpty());
+}
+
+void ADSBTest::_adsbConflictDetectorVerticalTest()
+{
+    // Hovering at 500 m, none of the traffic is vertically inside the separation at its horizontal CPA
+    const QGeoCoordinate home(47.3977, 8.5456, 500);
+    ADSBConflictDetector::Ownship_t ownship;
+    ownship.vehicleId = 1;
+    ownship.location = home;
+
+    ADSBConflictDetector::Thresholds_t thresholds;
+    thresholds.horizontalSeparation = 500;
+    thresholds.verticalSeparation = 100;
+    thresholds.lookaheadSecs = 60;
+    thresholds.warningSecs = 20;
+
+    ADSBConflictDetector::Traffic_t traffic;
+    // Already inside the horizontal separation and climbing through our level between 10 and 30 secs
+    ADSB::VehicleInfo_t climbing = _trafficInfo(11, home.atDistanceAndAzimuth(300, 90), 300, 0, 0);
+    climbing.verticalRate = 10;
+    traffic.append(climbing);
+    // Same but climbing too slowly to reach our level within the lookahead
+    ADSB::VehicleInfo_t slowClimbing = _trafficInfo(12, home.atDistanceAndAzimuth(300, 270), 300, 0, 0);
+    slowClimbing.verticalRate = 1;
+    traffic.append(slowClimbing);
+    // Head on: inside the horizontal separation from 20 to 40 secs with the CPA at 30, descending into our level from
+    // 35 secs, so 150 m clear at the CPA
+    ADSB::VehicleInfo_t descending = _trafficInfo(13, home.atDistanceAndAzimuth(1500, 0), 950, 180, 50);
+    descending.verticalRate = -10;
+    traffic.append(descending);
+    // Same but only reaching our level after it has passed
+    ADSB::VehicleInfo_t descendingLate = _trafficInfo(14, home.atDistanceAndAzimuth(1500, 180), 1100, 0, 50);
+    descendingLate.verticalRate = -10;
+    traffic.append(descendingLate);
+
+    const QList<ADSBConflictDetector::Conflict_t> conflicts = ADSBConflictDetector::detect({ ownship }, traffic, thresholds);
+    QCOMPARE(conflicts.count(), 2);
+
+    QCOMPARE(conflicts[0].icaoAddress, 11u);
+    QCOMPARE(conflicts[0].level, ADSB::ConflictWarning);
+    QVERIFY(qAbs(conflicts[0].timeToLoss - 10) < 0.5);
+    QVERIFY(conflicts[0].verticalCpa > 100);
+
+    QCOMPARE(conflicts[1].icaoAddress, 13u);
+    QCOMPARE(conflicts[1].level, ADSB::ConflictAdvisory);
+    QVERIFY(qAbs(conflicts[1].timeToLoss - 35) < 0.5);
+    QVERIFY(qAbs(conflicts[1].timeToCpa - 30) < 0.5);
+    QVERIFY(qAbs(conflicts[1].verticalCpa - 150) < 1);
+}
+
+void ADSBTest::_adsbConflictDetectorFleetTest()
+{
+    // A fleet in busy airspace: the broad phase must not change the result, and the same input gives the same output
+    const QGeoCoordinate center(47.45, 8.56, 450);
+    QRandomGenerator random(42);
+
+    QList<ADSBConflictDetector::Ownship_t> ownships;
+    for (int i = 0; i < 8; i++) {
+        ADSBConflictDetector::Ownship_t ownship;
+        ownship.vehicleId = i + 1;
+        ownship.location = center.atDistanceAndAzimuth(random.bounded(10000.0), random.bounded(360.0));
+        ownship.location.setAltitude(450 + random.bounded(120.0));
+        ownship.velocityNorth = random.bounded(30.0) - 15;
+        ownship.velocityEast = random.bounded(30.0) - 15;
+        ownships.append(ownship);
+    }
+
+    ADSBConflictDetector::Traffic_t traffic;
+    uint32_t icaoAddress = 0x100000;
+    for (int i = 0; i < 400; i++) {
+        const QGeoCoordinate location = center.atDistanceAndAzimuth(random.bounded(30000.0), random.bounded(360.0));
+        traffic.append(_trafficInfo(icaoAddress++, location, 300 + random.bounded(3000.0), random.bounded(360.0), 30 + random.bounded(100.0)));
+    }
+
+    ADSBConflictDetector::Thresholds_t thresholds;
+    const QList<ADSBConflictDetector::Conflict_t> conflicts = ADSBConflictDetector::detect(ownships, traffic, thresholds);
+    const QList<ADSBConflictDetector::Conflict_t> repeat = ADSBConflictDetector::detect(ownships, traffic, thresholds);
+    QCOMPARE(repeat.count(), conflicts.count());
+    for (qsizetype i = 0; i < conflicts.count(); i++) {
+        QCOMPARE(repeat[i].vehicleId, conflicts[i].vehicleId);
+        QCOMPARE(repeat[i].icaoAddress, conflicts[i].icaoAddress);
+        QCOMPARE(repeat[i].level, conflicts[i].level);
+    }
+
+    // Each vehicle checked alone finds the same conflicts as the whole fleet
+    int perVehicleCount = 0;
+    for (const ADSBConflictDetector::Ownship_t &ownship : std::as_const(ownships)) {
+        const QList<ADSBConflictDetector::Conflict_t> vehicleConflicts = ADSBConflictDetector::detect({ ownship }, traffic, thresholds);
+        for (const ADSBConflictDetector::Conflict_t &conflict : vehicleConflicts) {
+            QCOMPARE(conflict.vehicleId, ownship.vehicleId);
+            QVERIFY(std::any_of(conflicts.cbegin(), conflicts.cend(), [&conflict](const ADSBConflictDetector::Conflict_t &fleetConflict) {
+                return (fleetConflict.vehicleId == conflict.vehicleId) && (fleetConflict.icaoAddress == conflict.icaoAddress) && (fleetConflict.level == conflict.level);
+            }));
+        }
+        perVehicleCount += vehicleConflicts.count();
+    }
+    QCOMPARE(perVehicleCount, conflicts.count());
 }
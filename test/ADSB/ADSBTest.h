@@ -6,8 +6,18 @@ class ADSBTest : public UnitTest
 {
     Q_OBJECT
 
+protected slots:
+    void cleanup(void) final;
+
 private slots:
     void _adsbVehicleTest();
     void _adsbTcpLinkTest();
     void _adsbVehicleManagerTest();
+    void _adsbSpatialGridTest();
+    void _adsbVehicleManagerRangeTest();
+    void _adsbSBSParserTest();
+    void _adsbSBSParserStreamTest();
+    void _adsbConflictDetectorTest();
+    void _adsbConflictDetectorVerticalTest();
+    void _adsbConflictDetectorFleetTest();
 };
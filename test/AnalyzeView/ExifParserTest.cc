@@ -2,6 +2,9 @@
 #include "ExifParser.h"
 #include "GeoTagWorker.h"
 
+#include <exif.h>
+
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QTest>
 
 void ExifParserTest::_readTimeTest()
@@ -44,3 +47,213 @@ void ExifParserTest::_writeTest()
     // QVERIFY(outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
     // QCOMPARE(outputFile.write(imageBuffer), imageBuffer.size());
 }
+
+void ExifParserTest::_readSegmentTimeTest()
+{
+    QFile file(":/DSCN0010.jpg");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    qint64 segmentOffset;
+    const QByteArray segment = ExifParser::readExifSegment(file, segmentOffset);
+    QVERIFY(!segment.isEmpty());
+    QVERIFY(segment.startsWith(QByteArrayLiteral("Exif\0\0")));
+    QVERIFY(segmentOffset > 0);
+
+    // Only the headers ahead of the Exif segment and the segment itself are read
+    QCOMPARE(file.pos(), segmentOffset + segment.size());
+    QVERIFY(file.pos() < file.size());
+
+    const QDateTime tagTime(QDate(2008, 10, 22), QTime(16, 28, 39));
+    QCOMPARE(ExifParser::readTimeFromSegment(segment), tagTime.toMSecsSinceEpoch() / 1000.0);
+}
+
+void ExifParserTest::_writeFileTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString taggedFile = tempDir.filePath("tagged.jpg");
+
+    const GeoTagWorker::cameraFeedbackPacket data = _geotag(37.225, -80.425, 618.4392);
+    const ExifParser::WriteMethod writeMethod = ExifParser::writeFile(":/DSCN0010.jpg", taggedFile, data);
+    QVERIFY(writeMethod == ExifParser::WriteInPlace || writeMethod == ExifParser::WriteStreamed);
+
+    QFile source(":/DSCN0010.jpg");
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    qint64 sourceOffset;
+    const QByteArray sourceSegment = ExifParser::readExifSegment(source, sourceOffset);
+    const QByteArray sourceImage = source.readAll();
+
+    QFile tagged(taggedFile);
+    QVERIFY(tagged.open(QIODevice::ReadOnly));
+    qint64 taggedOffset;
+    const QByteArray taggedSegment = ExifParser::readExifSegment(tagged, taggedOffset);
+    const QByteArray taggedImage = tagged.readAll();
+
+    // Exif is still readable, and everything after it is untouched
+    QCOMPARE(ExifParser::readTimeFromSegment(taggedSegment), ExifParser::readTimeFromSegment(sourceSegment));
+    QCOMPARE(taggedOffset, sourceOffset);
+    QCOMPARE(taggedImage, sourceImage);
+    if (writeMethod == ExifParser::WriteInPlace) {
+        QCOMPARE(taggedSegment.size(), sourceSegment.size());
+    }
+
+    // Whole image parse of the result sees the same capture time and the new position
+    QVERIFY(tagged.seek(0));
+    const QByteArray taggedBuffer = tagged.readAll();
+    const QDateTime tagTime(QDate(2008, 10, 22), QTime(16, 28, 39));
+    QCOMPARE(ExifParser::readTime(taggedBuffer), tagTime.toMSecsSinceEpoch() / 1000.0);
+    QCOMPARE(ExifParser::readTime2(taggedBuffer), tagTime.toMSecsSinceEpoch() / 1000.0);
+    _verifyGeotag(taggedBuffer, data);
+}
+
+void ExifParserTest::_writeFileStreamedTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString plainFile = tempDir.filePath("plain.jpg");
+    const QString taggedFile = tempDir.filePath("tagged.jpg");
+
+    // No GPS tags and no spare room, the Exif segment has to grow
+    const QByteArray plain = _minimalJpeg();
+    QFile plainOutput(plainFile);
+    QVERIFY(plainOutput.open(QIODevice::WriteOnly));
+    QCOMPARE(plainOutput.write(plain), plain.size());
+    plainOutput.close();
+
+    const GeoTagWorker::cameraFeedbackPacket data = _geotag(37.225, -80.425, 618.4392);
+    QCOMPARE(ExifParser::writeFile(plainFile, taggedFile, data), ExifParser::WriteStreamed);
+
+    QFile tagged(taggedFile);
+    QVERIFY(tagged.open(QIODevice::ReadOnly));
+    qint64 taggedOffset;
+    const QByteArray taggedSegment = ExifParser::readExifSegment(tagged, taggedOffset);
+    QVERIFY(taggedSegment.size() > _minimalExifSegment().size());
+    QCOMPARE(tagged.readAll(), plain.mid(_minimalImageDataOffset()));
+
+    QVERIFY(tagged.seek(0));
+    _verifyGeotag(tagged.readAll(), data);
+}
+
+void ExifParserTest::_writeFileInPlaceTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString plainFile = tempDir.filePath("plain.jpg");
+    const QString taggedFile = tempDir.filePath("tagged.jpg");
+    const QString retaggedFile = tempDir.filePath("retagged.jpg");
+
+    const QByteArray plain = _minimalJpeg();
+    QFile plainOutput(plainFile);
+    QVERIFY(plainOutput.open(QIODevice::WriteOnly));
+    QCOMPARE(plainOutput.write(plain), plain.size());
+    plainOutput.close();
+    QCOMPARE(ExifParser::writeFile(plainFile, taggedFile, _geotag(37.225, -80.425, 618.4392)), ExifParser::WriteStreamed);
+
+    // Every GPS tag now exists with the same size as the new value, so the segment is rewritten at its size
+    const GeoTagWorker::cameraFeedbackPacket data = _geotag(-33.8568, 151.2153, 42.5);
+    QCOMPARE(ExifParser::writeFile(taggedFile, retaggedFile, data), ExifParser::WriteInPlace);
+
+    QFile tagged(taggedFile);
+    QVERIFY(tagged.open(QIODevice::ReadOnly));
+    QFile retagged(retaggedFile);
+    QVERIFY(retagged.open(QIODevice::ReadOnly));
+    QCOMPARE(retagged.size(), tagged.size());
+
+    qint64 taggedOffset;
+    const QByteArray taggedSegment = ExifParser::readExifSegment(tagged, taggedOffset);
+    qint64 retaggedOffset;
+    const QByteArray retaggedSegment = ExifParser::readExifSegment(retagged, retaggedOffset);
+    QCOMPARE(retaggedOffset, taggedOffset);
+    QCOMPARE(retaggedSegment.size(), taggedSegment.size());
+    QCOMPARE(retagged.readAll(), tagged.readAll());
+
+    QVERIFY(retagged.seek(0));
+    _verifyGeotag(retagged.readAll(), data);
+}
+
+void ExifParserTest::_writeFileSameFileTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString imageFile = tempDir.filePath("image.jpg");
+    QVERIFY(QFile::copy(":/DSCN0010.jpg", imageFile));
+    QVERIFY(QFile::setPermissions(imageFile, QFile::permissions(imageFile) | QFileDevice::WriteOwner));
+
+    // Tagging into the image directory tags the original
+    const GeoTagWorker::cameraFeedbackPacket data = _geotag(37.225, -80.425, 618.4392);
+    QVERIFY(ExifParser::writeFile(imageFile, imageFile, data) != ExifParser::WriteFailed);
+
+    QFile source(":/DSCN0010.jpg");
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    qint64 sourceOffset;
+    const QByteArray sourceSegment = ExifParser::readExifSegment(source, sourceOffset);
+
+    QFile image(imageFile);
+    QVERIFY(image.open(QIODevice::ReadOnly));
+    qint64 imageOffset;
+    const QByteArray imageSegment = ExifParser::readExifSegment(image, imageOffset);
+    QVERIFY(!imageSegment.isEmpty());
+    QCOMPARE(image.readAll(), source.readAll());
+
+    QVERIFY(image.seek(0));
+    _verifyGeotag(image.readAll(), data);
+}
+
+GeoTagWorker::cameraFeedbackPacket ExifParserTest::_geotag(double latitude, double longitude, double altitude)
+{
+    GeoTagWorker::cameraFeedbackPacket geotag{};
+    geotag.latitude = latitude;
+    geotag.longitude = longitude;
+    geotag.altitude = altitude;
+    return geotag;
+}
+
+void ExifParserTest::_verifyGeotag(const QByteArray &image, const GeoTagWorker::cameraFeedbackPacket &geotag)
+{
+    easyexif::EXIFInfo info;
+    QCOMPARE(info.parseFrom(reinterpret_cast<const unsigned char*>(image.constData()), static_cast<unsigned>(image.size())), PARSE_EXIF_SUCCESS);
+
+    // Seconds are written to 1/1000, altitude to 1/100
+    QVERIFY(qAbs(info.GeoLocation.Latitude - geotag.latitude) < 1e-6);
+    QVERIFY(qAbs(info.GeoLocation.Longitude - geotag.longitude) < 1e-6);
+    QVERIFY(qAbs(info.GeoLocation.Altitude - geotag.altitude) < 0.01);
+}
+
+QByteArray ExifParserTest::_minimalExifSegment()
+{
+    // Little endian tiff with an IFD0 holding only the orientation
+    static constexpr char segment[] = {
+        'E', 'x', 'i', 'f', '\0', '\0',
+        'I', 'I', 0x2A, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x01, 0x00,
+        0x12, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+    return QByteArray(segment, sizeof(segment));
+}
+
+QByteArray ExifParserTest::_minimalJpeg()
+{
+    const QByteArray segment = _minimalExifSegment();
+
+    QByteArray jpeg;
+    jpeg.append(static_cast<char>(0xFF)).append(static_cast<char>(0xD8));
+    jpeg.append(static_cast<char>(0xFF)).append(static_cast<char>(0xE1));
+    jpeg.append(static_cast<char>((segment.size() + 2) >> 8)).append(static_cast<char>((segment.size() + 2) & 0xFF));
+    jpeg.append(segment);
+    Q_ASSERT(jpeg.size() == _minimalImageDataOffset());
+
+    // Stand in scan data, never decoded
+    jpeg.append(static_cast<char>(0xFF)).append(static_cast<char>(0xDA)).append('\0').append(static_cast<char>(0x04)).append('\0').append('\0');
+    for (int i = 0; i < 4096; i++) {
+        jpeg.append(static_cast<char>(i % 0xFF));
+    }
+    jpeg.append(static_cast<char>(0xFF)).append(static_cast<char>(0xD9));
+
+    return jpeg;
+}
+
+qsizetype ExifParserTest::_minimalImageDataOffset()
+{
+    return 2 + 4 + _minimalExifSegment().size();
+}
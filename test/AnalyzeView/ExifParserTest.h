@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UnitTest.h"
+#include "GeoTagWorker.h"
 
 class ExifParserTest : public UnitTest
 {
@@ -12,4 +13,18 @@ public:
 private slots:
 	void _readTimeTest();
 	void _writeTest();
+	void _readSegmentTimeTest();
+	void _writeFileTest();
+	void _writeFileStreamedTest();
+	void _writeFileInPlaceTest();
+	void _writeFileSameFileTest();
+
+private:
+	static GeoTagWorker::cameraFeedbackPacket _geotag(double latitude, double longitude, double altitude);
+	static void _verifyGeotag(const QByteArray &image, const GeoTagWorker::cameraFeedbackPacket &geotag);
+
+	/// JPEG with a bare Exif segment: no GPS tags and no spare room
+	static QByteArray _minimalJpeg();
+	static QByteArray _minimalExifSegment();
+	static qsizetype _minimalImageDataOffset();
 };
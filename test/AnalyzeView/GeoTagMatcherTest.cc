@@ -0,0 +1,155 @@
+#include "GeoTagMatcherTest.h"
+#include "GeoTagMatcher.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+#include <cmath>
+
+namespace {
+
+/// Simulated flight: triggers every intervalSecs to 1.25 * intervalSecs on the log clock, images stamped by a camera
+/// clock an hour and a bit behind it with a resolution of resolutionSecs, one second for Exif
+struct Flight_t {
+    QList<double>   triggerSecs;
+    QList<double>   imageSecs;
+    QList<int>      imageTrigger;   ///< Trigger each image was really taken at
+};
+
+Flight_t _flight(int triggerCount, int firstImage, int lastImage, const QList<int>& droppedImages, const QList<int>& droppedTriggers,
+                 double intervalSecs = 2, double resolutionSecs = 1)
+{
+    QRandomGenerator random(11);
+    QList<double> allTriggerSecs;
+    double secs = 1.7e9;
+    for (int i = 0; i < triggerCount; i++) {
+        secs += intervalSecs + random.bounded(intervalSecs / 4);
+        allTriggerSecs.append(secs);
+    }
+
+    Flight_t flight;
+    QList<int> triggerIndices(triggerCount, -1);
+    for (int i = 0; i < triggerCount; i++) {
+        if (!droppedTriggers.contains(i)) {
+            triggerIndices[i] = flight.triggerSecs.count();
+            flight.triggerSecs.append(allTriggerSecs[i]);
+        }
+    }
+    for (int i = firstImage; i < lastImage; i++) {
+        if (!droppedImages.contains(i)) {
+            flight.imageSecs.append(std::floor((allTriggerSecs[i] - 3600.4) / resolutionSecs) * resolutionSecs);
+            flight.imageTrigger.append(triggerIndices[i]);
+        }
+    }
+    return flight;
+}
+
+} // namespace
+
+void GeoTagMatcherTest::_dropoutTest()
+{
+    // A frame dropped early on would throw every later image off by one when paired by index
+    const Flight_t flight = _flight(500, 0, 500, { 3, 250, 251, 252 }, { 10, 400 });
+
+    GeoTagMatcher matcher;
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(matcher.match(flight.imageSecs));
+    QVERIFY(std::fabs(matcher.offsetSecs() - 3600.9) < 0.6);
+
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(matcher.trigger(i), flight.imageTrigger[i]);
+    }
+
+    // The images from the dropped log entries, and the triggers from the dropped frames
+    QCOMPARE(matcher.unmatchedImages().count(), 2);
+    QCOMPARE(matcher.unmatchedTriggers().count(), 4);
+    QCOMPARE(matcher.matchCount(), flight.imageSecs.count() - 2);
+}
+
+void GeoTagMatcherTest::_partialFlightTest()
+{
+    // Images from the first part of the flight only, the camera card was swapped
+    Flight_t flight = _flight(600, 0, 300, { 17 }, {});
+
+    GeoTagMatcher matcher;
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(matcher.match(flight.imageSecs));
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(matcher.trigger(i), flight.imageTrigger[i]);
+    }
+
+    // And from the second card
+    flight = _flight(600, 300, 600, {}, { 450 });
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(matcher.match(flight.imageSecs));
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(matcher.trigger(i), flight.imageTrigger[i]);
+    }
+}
+
+void GeoTagMatcherTest::_incrementalTest()
+{
+    const Flight_t flight = _flight(400, 0, 400, { 100 }, {});
+
+    GeoTagMatcher matcher;
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(matcher.match(flight.imageSecs.mid(0, 200)));
+    QCOMPARE(matcher.matchCount(), 200);
+
+    const int firstImage = matcher.addImages(flight.imageSecs.mid(200));
+    QCOMPARE(firstImage, 200);
+    QCOMPARE(matcher.imageCount(), flight.imageSecs.count());
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(matcher.trigger(i), flight.imageTrigger[i]);
+    }
+    QCOMPARE(matcher.unmatchedTriggers(), QList<int>({ 100 }));
+}
+
+void GeoTagMatcherTest::_noImageTimesTest()
+{
+    const Flight_t flight = _flight(50, 0, 50, {}, {});
+
+    GeoTagMatcher matcher;
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(!matcher.match(QList<double>(50, -1.0)));
+    QVERIFY(!matcher.valid());
+    QCOMPARE(matcher.matchCount(), 0);
+    QCOMPARE(matcher.unmatchedImages().count(), 50);
+
+    // Images without a time are skipped, the rest still match
+    QList<double> imageSecs = flight.imageSecs;
+    imageSecs[5] = -1;
+    QVERIFY(matcher.match(imageSecs));
+    QCOMPARE(matcher.trigger(5), -1);
+    QCOMPARE(matcher.trigger(6), 6);
+}
+
+void GeoTagMatcherTest::_shortIntervalTest()
+{
+    // Triggers 1.2 to 1.5 seconds apart are within a second of their neighbours, the tolerance is capped so each image
+    // only reaches its own
+    Flight_t flight = _flight(300, 0, 300, { 40, 41 }, {}, 1.2);
+
+    GeoTagMatcher matcher;
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(matcher.match(flight.imageSecs));
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(matcher.trigger(i), flight.imageTrigger[i]);
+    }
+
+    // Triggers under a second apart share whole second image times, so only the order can pair them
+    flight = _flight(300, 0, 300, { 40 }, {}, 0.3);
+    matcher.setTriggers(flight.triggerSecs);
+    QVERIFY(!matcher.match(flight.imageSecs));
+    QVERIFY(!matcher.valid());
+    QCOMPARE(matcher.matchCount(), 0);
+
+    // Unless the camera stamps sub-second times
+    flight = _flight(300, 0, 300, { 40 }, { 150 }, 0.3, 0.01);
+    GeoTagMatcher subSecondMatcher(0.01);
+    subSecondMatcher.setTriggers(flight.triggerSecs);
+    QVERIFY(subSecondMatcher.match(flight.imageSecs));
+    for (int i = 0; i < flight.imageSecs.count(); i++) {
+        QCOMPARE(subSecondMatcher.trigger(i), flight.imageTrigger[i]);
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class GeoTagMatcherTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    GeoTagMatcherTest() = default;
+
+private slots:
+    void _dropoutTest();
+    void _partialFlightTest();
+    void _incrementalTest();
+    void _noImageTimesTest();
+    void _shortIntervalTest();
+};
@@ -0,0 +1,139 @@
+#include "LogAnalysisIndexTest.h"
+#include "LogAnalysisIndex.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr qint64 _tlogStartUSecs = 1700000000000000;
+
+void _appendRecord(QByteArray& log, qint64 timeUSecs, const mavlink_message_t& message)
+{
+    const quint64 timestamp = qToBigEndian<quint64>(static_cast<quint64>(timeUSecs));
+    log.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+    log.append(reinterpret_cast<const char*>(buffer), length);
+}
+
+/// ATTITUDE at 100Hz with roll counting up from 0 and SYS_STATUS at 1Hz
+QByteArray _tlog(int seconds)
+{
+    QByteArray log;
+    log.reserve(seconds * 100 * 50);
+    mavlink_message_t message;
+    for (int i = 0; i < seconds * 100; i++) {
+        const qint64 timeUSecs = _tlogStartUSecs + (i * 10000);
+        (void) mavlink_msg_attitude_pack_chan(1, 1, MAVLINK_COMM_0, &message, i * 10, static_cast<float>(i), 0.5f, -1, 0, 0, 0);
+        _appendRecord(log, timeUSecs, message);
+        if ((i % 100) == 0) {
+            (void) mavlink_msg_sys_status_pack_chan(1, 1, MAVLINK_COMM_0, &message, 0, 0, 0, 500, 12600, -1, 90, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+            _appendRecord(log, timeUSecs, message);
+        }
+    }
+    return log;
+}
+
+bool _writeFile(const QString& fileName, const QByteArray& data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+}
+
+} // namespace
+
+void LogAnalysisIndexTest::_tlogTest()
+{
+    QByteArray log = _tlog(10);
+    // Garbage in the middle of the log must only cost the records it overwrote
+    log.replace(5000, 64, QByteArray(64, '\xFD'));
+
+    QTemporaryDir tempDir;
+    const QString fileName = tempDir.filePath(QStringLiteral("test.tlog"));
+    QVERIFY(_writeFile(fileName, log));
+
+    LogAnalysisIndex index;
+    QString errorMessage;
+    QVERIFY(index.open(fileName, errorMessage));
+    QVERIFY(errorMessage.isEmpty());
+    QCOMPARE(index.logType(), LogAnalysisIndex::LogTypeTLog);
+    QCOMPARE(index.startUSecs(), _tlogStartUSecs);
+
+    const int attitude = index.messageIndex(QStringLiteral("ATTITUDE (1:1)"));
+    QVERIFY(attitude >= 0);
+    QVERIFY(index.messageIndex(QStringLiteral("SYS_STATUS (1:1)")) >= 0);
+    QVERIFY(index.sampleCount(attitude) < 1000);
+    QVERIFY(index.sampleCount(attitude) > 990);
+
+    const int roll = index.fieldIndex(attitude, QStringLiteral("roll"));
+    const int yawspeed = index.fieldIndex(attitude, QStringLiteral("yawspeed"));
+    QVERIFY(roll >= 0);
+    QVERIFY(yawspeed >= 0);
+    QCOMPARE(index.value(attitude, roll, 0), 0.);
+    // Truncated off the end of the MAVLink 2 payload
+    QCOMPARE(index.value(attitude, yawspeed, 0), 0.);
+
+    // One second from 5s, the garbage is earlier in the log
+    const qint64 startUSecs = _tlogStartUSecs + 5000000;
+    const qint64 endUSecs = startUSecs + 990000;
+    const QPair<qsizetype, qsizetype> range = index.range(attitude, startUSecs, endUSecs);
+    QCOMPARE(range.second - range.first, static_cast<qsizetype>(100));
+    QCOMPARE(index.timestamp(attitude, range.first), startUSecs);
+
+    const LogAnalysisIndex::Statistics_t statistics = index.statistics(attitude, roll, startUSecs, endUSecs);
+    QCOMPARE(statistics.count, static_cast<qsizetype>(100));
+    QCOMPARE(statistics.min, 500.);
+    QCOMPARE(statistics.max, 599.);
+    QCOMPARE(statistics.mean, 549.5);
+
+    // Whole log downsampled to 100 pixels keeps the extremes
+    QList<QPointF> points;
+    index.points(attitude, roll, index.startUSecs(), index.endUSecs(), 100, points);
+    QVERIFY(points.count() <= 200);
+    QCOMPARE(points.first().y(), 0.);
+    QCOMPARE(points.last().y(), 999.);
+    for (qsizetype i = 1; i < points.count(); i++) {
+        QVERIFY(points[i].x() > points[i - 1].x());
+    }
+
+    // Few enough samples to return all of them, plus one either side
+    index.points(attitude, roll, startUSecs, endUSecs, 1000, points);
+    QCOMPARE(points.count(), static_cast<qsizetype>(102));
+    QCOMPARE(points.first().y(), 499.);
+}
+
+void LogAnalysisIndexTest::_ulogTest()
+{
+    QTemporaryDir tempDir;
+    const QString fileName = tempDir.filePath(QStringLiteral("SampleULog.ulg"));
+    QVERIFY(QFile::copy(QStringLiteral(":/SampleULog.ulg"), fileName));
+
+    LogAnalysisIndex index;
+    QString errorMessage;
+    QVERIFY(index.open(fileName, errorMessage));
+    QCOMPARE(index.logType(), LogAnalysisIndex::LogTypeULog);
+    QVERIFY(index.endUSecs() > index.startUSecs());
+
+    const int cameraCapture = index.messageIndex(QStringLiteral("camera_capture"));
+    QVERIFY(cameraCapture >= 0);
+    QVERIFY(index.sampleCount(cameraCapture) > 0);
+    const int seq = index.fieldIndex(cameraCapture, QStringLiteral("seq"));
+    QVERIFY(seq >= 0);
+    QVERIFY(index.fieldIndex(cameraCapture, QStringLiteral("lat")) >= 0);
+
+    // Statistics over the whole log match a scan of the column
+    const qsizetype count = index.sampleCount(cameraCapture);
+    double max = index.value(cameraCapture, seq, 0);
+    for (qsizetype i = 1; i < count; i++) {
+        QVERIFY(index.timestamp(cameraCapture, i) >= index.timestamp(cameraCapture, i - 1));
+        max = qMax(max, index.value(cameraCapture, seq, i));
+    }
+    const LogAnalysisIndex::Statistics_t statistics = index.statistics(cameraCapture, seq, index.startUSecs(), index.endUSecs());
+    QCOMPARE(statistics.count, count);
+    QCOMPARE(statistics.max, max);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LogAnalysisIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    LogAnalysisIndexTest() = default;
+
+private slots:
+    void _tlogTest();
+    void _ulogTest();
+};
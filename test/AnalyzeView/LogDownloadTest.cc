@@ -22,8 +22,62 @@ LogDownloadTest::LogDownloadTest(void)
 
 void LogDownloadTest::downloadTest(void)
 {
+    _downloadMockLog(0);
+}
+
+void LogDownloadTest::downloadLargeTest(void)
+{
+    // Large enough to span many windows and state saves
+    _downloadMockLog(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN * 2000);
+}
+
+void LogDownloadTest::resumeStateTest(void)
+{
+    QGCLogEntry entry(3, QDateTime::fromSecsSinceEpoch(1700000000), MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN * 100 + 10, true);
+    const QString logFile = QDir(QDir::tempPath()).filePath("LogDownloadTest_resume.bin");
+
+    LogDownloadData saved(&entry);
+    saved.file.setFileName(logFile);
+    saved.bin_table = QBitArray(saved.numBins(), false);
+    QCOMPARE(saved.numBins(), 101u);
+    for (uint32_t bin: { 0, 1, 2, 50, 100 }) {
+        QVERIFY(saved.setBin(bin));
+    }
+    QVERIFY(!saved.setBin(50));
+    QCOMPARE(saved.duplicate_bins, 1u);
 
+    uint32_t start, end;
+    QVERIFY(saved.findGap(0, start, end));
+    QCOMPARE(start, 3u);
+    QCOMPARE(end, 50u);
+    QVERIFY(saved.findGap(51, start, end));
+    QCOMPARE(start, 51u);
+    QCOMPARE(end, 100u);
+    QVERIFY(saved.saveState());
+
+    LogDownloadData resumed(&entry);
+    resumed.file.setFileName(logFile);
+    QVERIFY(resumed.loadState());
+    QCOMPARE(resumed.bin_table, saved.bin_table);
+    QCOMPARE(resumed.bins_received, 5u);
+    QCOMPARE(resumed.resumed_bins, 5u);
+
+    // State belonging to a different log must not be picked up
+    QGCLogEntry otherEntry(3, QDateTime::fromSecsSinceEpoch(1700000000), MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN * 200, true);
+    LogDownloadData other(&otherEntry);
+    other.file.setFileName(logFile);
+    QVERIFY(!other.loadState());
+
+    saved.removeState();
+    QVERIFY(!QFile::exists(saved.stateFileName()));
+}
+
+void LogDownloadTest::_downloadMockLog(uint32_t logSize)
+{
     _connectMockLink(MAV_AUTOPILOT_PX4);
+    if (logSize) {
+        _mockLink->setLogDownloadFileSize(logSize);
+    }
 
     LogDownloadController* controller = new LogDownloadController();
 
@@ -63,6 +117,9 @@ void LogDownloadTest::downloadTest(void)
     QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
 
     QFile::remove(downloadFile);
+    QVERIFY(!QFile::exists(downloadFile + QStringLiteral(".part")));
 
     delete controller;
+    delete _multiSpyLogDownloadController;
+    _disconnectMockLink();
 }
@@ -26,8 +26,12 @@ private slots:
     //void cleanup(void) { _cleanup(); }
 
     void downloadTest(void);
+    void downloadLargeTest(void);
+    void resumeStateTest(void);
 
 private:
+    void _downloadMockLog(uint32_t logSize);
+
     // LogDownloadController signals
 
     enum {
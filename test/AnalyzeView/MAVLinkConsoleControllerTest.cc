@@ -0,0 +1,182 @@
+#include "MAVLinkConsoleControllerTest.h"
+#include "MAVLinkConsoleController.h"
+#include "MAVLinkLib.h"
+
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+void MAVLinkConsoleControllerTest::_receive(MAVLinkConsoleController& controller, const QByteArray& data)
+{
+    controller._receiveData(SERIAL_CONTROL_DEV_SHELL, 0, 0, 0, data);
+}
+
+void MAVLinkConsoleControllerTest::_publish(MAVLinkConsoleController& controller)
+{
+    controller._publishChanges();
+}
+
+QStringList MAVLinkConsoleControllerTest::_rows(const MAVLinkConsoleController& controller)
+{
+    QStringList rows;
+    for (int row = 0; row < controller.rowCount(); row++) {
+        rows.append(controller.data(controller.index(row)).toString());
+    }
+    return rows;
+}
+
+void MAVLinkConsoleControllerTest::_splitEscapeTest()
+{
+    MAVLinkConsoleController controller;
+
+    // A color sequence split in every possible place is dropped without leaving any of its bytes behind
+    _receive(controller, "\x1B");
+    _receive(controller, "[");
+    _receive(controller, "3");
+    _receive(controller, "2m");
+    _receive(controller, "ok\x1B[");
+    _receive(controller, "0mdone\n");
+
+    // Erase line split from its parameters
+    _receive(controller, "abcdef\rxy\x1B");
+    _receive(controller, "[K\n");
+
+    _publish(controller);
+    QCOMPARE(_rows(controller), QStringList({ QStringLiteral("okdone"), QStringLiteral("xy"), QString() }));
+}
+
+void MAVLinkConsoleControllerTest::_splitUtf8Test()
+{
+    MAVLinkConsoleController controller;
+
+    // U+00E9 is two bytes and U+20AC is three, split across chunks
+    _receive(controller, "caf\xC3");
+    _receive(controller, "\xA9 \xE2");
+    _receive(controller, "\x82");
+    _receive(controller, "\xAC\n");
+
+    _publish(controller);
+    QCOMPARE(_rows(controller).first(), QStringLiteral("café €"));
+}
+
+void MAVLinkConsoleControllerTest::_eraseTest()
+{
+    MAVLinkConsoleController controller;
+
+    // The first cursor home sets home to the current line
+    _receive(controller, "banner\n\x1B[H");
+    QCOMPARE(controller._cursor_home_pos, qint64(1));
+    _receive(controller, "top 1\nload 2\n");
+
+    // Erase display clears from home on, cursor home then rewinds to home
+    _receive(controller, "\x1B[2J\x1B[H");
+    QCOMPARE(controller._cursorY, qint64(1));
+    _receive(controller, "top 3\x1B[K\nload\n");
+    _publish(controller);
+    QCOMPARE(_rows(controller), QStringList({ QStringLiteral("banner"), QStringLiteral("top 3"), QStringLiteral("load"), QString() }));
+
+    // Erase line only truncates from the cursor
+    _receive(controller, "\x1B[H");
+    _receive(controller, "to\x1B[K");
+    _publish(controller);
+    QCOMPARE(_rows(controller)[1], QStringLiteral("to"));
+    QCOMPARE(_rows(controller)[2], QStringLiteral("load"));
+
+    // Erase display without a home position is ignored
+    MAVLinkConsoleController noHome;
+    _receive(noHome, "kept\n\x1B[2J");
+    _publish(noHome);
+    QCOMPARE(_rows(noHome).first(), QStringLiteral("kept"));
+}
+
+void MAVLinkConsoleControllerTest::_ringWrapTest()
+{
+    constexpr int maxLines = MAVLinkConsoleController::_max_num_lines;
+    constexpr int lineCount = maxLines + 100;
+
+    MAVLinkConsoleController controller;
+
+    // Home on line 0, which then falls out of the ring
+    _receive(controller, "\x1B[H");
+    QCOMPARE(controller._cursor_home_pos, qint64(0));
+    for (int i = 0; i < lineCount; i++) {
+        _receive(controller, QStringLiteral("line %1\n").arg(i).toUtf8());
+    }
+    QCOMPARE(controller._cursor_home_pos, qint64(-1));
+
+    _publish(controller);
+    const QStringList rows = _rows(controller);
+    QCOMPARE(rows.count(), qsizetype(maxLines));
+    // The last row is the empty line under the cursor
+    QCOMPARE(rows.first(), QStringLiteral("line %1").arg(lineCount - maxLines + 1));
+    QCOMPARE(rows[maxLines - 2], QStringLiteral("line %1").arg(lineCount - 1));
+    QVERIFY(rows.last().isEmpty());
+
+    // With home gone cursor home sets a new one rather than rewinding to a dropped line
+    const qint64 cursorY = controller._cursorY;
+    _receive(controller, "\x1B[H");
+    QCOMPARE(controller._cursor_home_pos, cursorY);
+    QCOMPARE(controller._cursorY, cursorY);
+
+    // Lines are capped
+    _receive(controller, QByteArray(MAVLinkConsoleController::_max_line_length + 100, 'x'));
+    _publish(controller);
+    QCOMPARE(_rows(controller).last().size(), qsizetype(MAVLinkConsoleController::_max_line_length));
+}
+
+void MAVLinkConsoleControllerTest::_publishTest()
+{
+    constexpr int maxLines = MAVLinkConsoleController::_max_num_lines;
+
+    MAVLinkConsoleController controller;
+    QSignalSpy insertSpy(&controller, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removeSpy(&controller, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changeSpy(&controller, &QAbstractItemModel::dataChanged);
+
+    // Nothing reaches the view until a publish
+    _receive(controller, "one\ntwo");
+    QCOMPARE(controller.rowCount(), 0);
+    _publish(controller);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(controller.rowCount(), 2);
+    QCOMPARE(_rows(controller), QStringList({ QStringLiteral("one"), QStringLiteral("two") }));
+
+    // Appending to the last line is a data change, not an insert
+    insertSpy.clear();
+    changeSpy.clear();
+    _receive(controller, " three");
+    _publish(controller);
+    QCOMPARE(insertSpy.count(), 0);
+    QCOMPARE(changeSpy.count(), 1);
+    QCOMPARE(changeSpy[0][0].toModelIndex().row(), 1);
+    QCOMPARE(changeSpy[0][1].toModelIndex().row(), 1);
+    QCOMPARE(_rows(controller)[1], QStringLiteral("two three"));
+
+    // Wrapping between publishes: rows which dropped out read as empty until the publish removes them
+    insertSpy.clear();
+    _receive(controller, "\n");
+    for (int i = 0; i < maxLines; i++) {
+        _receive(controller, QStringLiteral("%1\n").arg(i).toUtf8());
+    }
+    QCOMPARE(controller.rowCount(), 2);
+    QVERIFY(controller.data(controller.index(0)).toString().isEmpty());
+    _publish(controller);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(removeSpy[0][1].toInt(), 0);
+    QCOMPARE(removeSpy[0][2].toInt(), 1);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(controller.rowCount(), maxLines);
+
+    // The model and the text property agree with the ring after every publish
+    const QStringList rows = _rows(controller);
+    for (int row = 0; row < rows.count(); row++) {
+        QCOMPARE(rows[row], controller._line(controller._firstLine + row));
+    }
+    QCOMPARE(controller.getText().count(QStringLiteral("<br>")), qsizetype(maxLines - 1));
+
+    // A publish with no changes emits nothing
+    insertSpy.clear();
+    removeSpy.clear();
+    changeSpy.clear();
+    _publish(controller);
+    QCOMPARE(insertSpy.count() + removeSpy.count() + changeSpy.count(), 0);
+}
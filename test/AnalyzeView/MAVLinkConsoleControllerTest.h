@@ -0,0 +1,26 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkConsoleController;
+
+class MAVLinkConsoleControllerTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    MAVLinkConsoleControllerTest() = default;
+
+private slots:
+    void _splitEscapeTest();
+    void _splitUtf8Test();
+    void _eraseTest();
+    void _ringWrapTest();
+    void _publishTest();
+
+private:
+    static void _receive(MAVLinkConsoleController& controller, const QByteArray& data);
+    static void _publish(MAVLinkConsoleController& controller);
+    /// @return Every row of the model
+    static QStringList _rows(const MAVLinkConsoleController& controller);
+};
@@ -0,0 +1,109 @@
+#include "MAVLinkFieldDecoderTest.h"
+#include "MAVLinkFieldDecoder.h"
+
+#include <QtTest/QTest>
+
+#include <cstring>
+
+namespace {
+
+/// Payload the way QGCMAVLinkMessage keeps it: trailing zeros MAVLink 2 truncated off the wire are zero again
+struct Payload_t {
+    uint8_t bytes[MAVLINK_MAX_PAYLOAD_LEN] = {};
+
+    Payload_t(const mavlink_message_t& message)
+    {
+        memcpy(bytes, &message.payload64[0], message.len);
+    }
+};
+
+MAVLinkFieldDecoder _decoder(const mavlink_message_t& message, const char* fieldName)
+{
+    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&message);
+    for (unsigned int i = 0; i < msgInfo->num_fields; i++) {
+        if (strcmp(msgInfo->fields[i].name, fieldName) == 0) {
+            return MAVLinkFieldDecoder(msgInfo->fields[i], message.msgid);
+        }
+    }
+    qFatal("Unknown field %s", fieldName);
+}
+
+} // namespace
+
+void MAVLinkFieldDecoderTest::_numericTest()
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_attitude_pack_chan(1, 1, MAVLINK_COMM_0, &message, 1234, 0.5f, -0.25f, 0, 0, 0, 0);
+    const Payload_t payload(message);
+
+    const MAVLinkFieldDecoder timeBootMs = _decoder(message, "time_boot_ms");
+    QVERIFY(timeBootMs.numeric());
+    QCOMPARE(QString(timeBootMs.typeName()), QStringLiteral("uint32_t"));
+    QCOMPARE(timeBootMs.value(payload.bytes), 1234.);
+    QCOMPARE(timeBootMs.format(payload.bytes), QStringLiteral("1234"));
+
+    const MAVLinkFieldDecoder roll = _decoder(message, "roll");
+    QCOMPARE(QString(roll.typeName()), QStringLiteral("float"));
+    QCOMPARE(roll.value(payload.bytes), 0.5);
+    QCOMPARE(_decoder(message, "pitch").format(payload.bytes), QStringLiteral("-0.25"));
+
+    // Zero fields at the end of the payload are not sent with MAVLink 2
+    QVERIFY(message.len < MAVLINK_MSG_ID_ATTITUDE_LEN);
+    QCOMPARE(_decoder(message, "yawspeed").value(payload.bytes), 0.);
+}
+
+void MAVLinkFieldDecoderTest::_arrayTest()
+{
+    uint8_t prn[20] = {};
+    uint8_t snr[20] = {};
+    for (int i = 0; i < 20; i++) {
+        prn[i] = static_cast<uint8_t>(i + 1);
+        snr[i] = static_cast<uint8_t>(40 - i);
+    }
+    mavlink_message_t message;
+    (void) mavlink_msg_gps_status_pack_chan(1, 1, MAVLINK_COMM_0, &message, 20, prn, prn, prn, prn, snr);
+    const Payload_t payload(message);
+
+    const MAVLinkFieldDecoder satelliteSnr = _decoder(message, "satellite_snr");
+    QVERIFY(satelliteSnr.numeric());
+    // Arrays chart their first element
+    QCOMPARE(satelliteSnr.value(payload.bytes), 40.);
+
+    const QStringList elements = satelliteSnr.format(payload.bytes).split(QStringLiteral(", "));
+    QCOMPARE(elements.count(), 20);
+    QCOMPARE(elements.first(), QStringLiteral("40"));
+    QCOMPARE(elements.last(), QStringLiteral("21"));
+}
+
+void MAVLinkFieldDecoderTest::_textTest()
+{
+    // Fill the whole array so there is no null terminator
+    const QByteArray text(MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN, 'x');
+    mavlink_message_t message;
+    (void) mavlink_msg_statustext_pack_chan(1, 1, MAVLINK_COMM_0, &message, MAV_SEVERITY_INFO, text.constData(), 7, 0);
+    const Payload_t payload(message);
+
+    const MAVLinkFieldDecoder textDecoder = _decoder(message, "text");
+    QVERIFY(!textDecoder.numeric());
+    QCOMPARE(QString(textDecoder.typeName()), QStringLiteral("char"));
+    QCOMPARE(textDecoder.format(payload.bytes), QString::fromLatin1(text));
+    QCOMPARE(_decoder(message, "id").format(payload.bytes), QStringLiteral("7"));
+
+    (void) mavlink_msg_statustext_pack_chan(1, 1, MAVLINK_COMM_0, &message, MAV_SEVERITY_INFO, "Armed", 0, 0);
+    QCOMPARE(textDecoder.format(Payload_t(message).bytes), QStringLiteral("Armed"));
+}
+
+void MAVLinkFieldDecoderTest::_systemTimeTest()
+{
+    // 2024-01-02 03:04:05 UTC
+    const uint64_t unixUSecs = 1704164645ull * 1000000ull;
+    const uint32_t bootMSecs = ((1 * 60 * 60) + (2 * 60) + 3) * 1000;
+    mavlink_message_t message;
+    (void) mavlink_msg_system_time_pack_chan(1, 1, MAVLINK_COMM_0, &message, unixUSecs, bootMSecs);
+    const Payload_t payload(message);
+
+    const MAVLinkFieldDecoder timeUnixUsec = _decoder(message, "time_unix_usec");
+    QCOMPARE(timeUnixUsec.format(payload.bytes), QStringLiteral("2024 01 02 03:04:05"));
+    QCOMPARE(timeUnixUsec.value(payload.bytes), static_cast<qreal>(unixUSecs));
+    QCOMPARE(_decoder(message, "time_boot_ms").format(payload.bytes), QStringLiteral("01:02:03"));
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkFieldDecoderTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    MAVLinkFieldDecoderTest() = default;
+
+private slots:
+    void _numericTest();
+    void _arrayTest();
+    void _textTest();
+    void _systemTimeTest();
+};
@@ -0,0 +1,132 @@
+#include "TimeSeriesStoreTest.h"
+#include "TimeSeriesStore.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+void TimeSeriesStoreTest::_minMaxTest()
+{
+    TimeSeriesStore store(1000000, 100);
+    const int seriesId = store.addSeries();
+    QVERIFY(qIsNaN(store.minimum(seriesId)));
+    QVERIFY(qIsNaN(store.maximum(seriesId)));
+
+    // Compare against a brute force scan while the window slides over random data
+    QRandomGenerator random(7);
+    QList<double> window;
+    for (int i = 0; i < 1000; i++) {
+        const double value = random.bounded(200.0) - 100;
+        store.append(seriesId, i, value);
+        window.append(value);
+        if (window.count() > 100) {
+            window.removeFirst();
+        }
+        QCOMPARE(store.count(seriesId), window.count());
+        QCOMPARE(store.minimum(seriesId), *std::min_element(window.cbegin(), window.cend()));
+        QCOMPARE(store.maximum(seriesId), *std::max_element(window.cbegin(), window.cend()));
+    }
+
+    // Series are independent
+    const int otherId = store.addSeries();
+    QVERIFY(otherId != seriesId);
+    store.append(otherId, 0, 1000);
+    QCOMPARE(store.maximum(otherId), 1000.);
+    QVERIFY(store.maximum(seriesId) < 100);
+
+    store.clear(seriesId);
+    QCOMPARE(store.count(seriesId), 0);
+    QVERIFY(qIsNaN(store.minimum(seriesId)));
+
+    store.removeSeries(seriesId);
+    QCOMPARE(store.addSeries(), seriesId);
+}
+
+void TimeSeriesStoreTest::_retentionTest()
+{
+    TimeSeriesStore store(1000, 1000);
+    const int seriesId = store.addSeries();
+
+    // 100Hz for 5 secs, only the last second is kept
+    for (int i = 0; i < 500; i++) {
+        store.append(seriesId, i * 10, i);
+    }
+    QCOMPARE(store.count(seriesId), 101);
+    QCOMPARE(store.minimum(seriesId), 399.);
+    QCOMPARE(store.maximum(seriesId), 499.);
+
+    // Shrinking keeps the newest samples
+    store.setRetention(1000, 10);
+    QCOMPARE(store.count(seriesId), 10);
+    QCOMPARE(store.minimum(seriesId), 490.);
+    QCOMPARE(store.maximum(seriesId), 499.);
+
+    QList<QPointF> points;
+    store.points(seriesId, 0, 10000, 0, points);
+    QCOMPARE(points.count(), 10);
+    QCOMPARE(points.first(), QPointF(4900, 490));
+    QCOMPARE(points.last(), QPointF(4990, 499));
+}
+
+void TimeSeriesStoreTest::_decimationTest()
+{
+    TimeSeriesStore store(100000, 100000);
+    const int seriesId = store.addSeries();
+
+    // Saw tooth with a spike, 10 samples per pixel over 100 pixels
+    for (int i = 0; i < 1000; i++) {
+        store.append(seriesId, i, (i == 555) ? 1000 : (i % 10));
+    }
+
+    QList<QPointF> points;
+    store.points(seriesId, 0, 999, 100, points);
+    QVERIFY(points.count() <= 200);
+    QVERIFY(points.count() >= 100);
+    // Extremes survive
+    QVERIFY(points.contains(QPointF(555, 1000)));
+    QCOMPARE(std::min_element(points.cbegin(), points.cend(), [](const QPointF &a, const QPointF &b) { return a.y() < b.y(); })->y(), 0.);
+    // In time order
+    QVERIFY(std::is_sorted(points.cbegin(), points.cend(), [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); }));
+
+    // Sparse data is passed through, including one sample before the range
+    store.points(seriesId, 500, 509, 100, points);
+    QCOMPARE(points.count(), 11);
+    QCOMPARE(points.first().x(), 499.);
+
+    store.points(seriesId, 2000, 3000, 100, points);
+    QCOMPARE(points.count(), 1);
+}
+
+void TimeSeriesStoreTest::_streamTest()
+{
+    // 10 fields at 50Hz for a minute, all of which fit in the retention window
+    constexpr int fieldCount = 10;
+    constexpr int rateHz = 50;
+    constexpr int seconds = 60;
+
+    TimeSeriesStore store(seconds * 1000, seconds * 200);
+    QList<int> seriesIds;
+    for (int i = 0; i < fieldCount; i++) {
+        seriesIds.append(store.addSeries());
+    }
+
+    QRandomGenerator random(1);
+    for (int sample = 0; sample < (rateHz * seconds); sample++) {
+        const qint64 timeMSecs = (sample * 1000) / rateHz;
+        for (const int seriesId : seriesIds) {
+            store.append(seriesId, timeMSecs, random.bounded(1.0));
+        }
+    }
+
+    // A full window refresh on a 1000 pixel wide plot is decimated to at most a min/max pair per pixel
+    QList<QPointF> points;
+    for (const int seriesId : seriesIds) {
+        QCOMPARE(store.count(seriesId), rateHz * seconds);
+        QVERIFY(store.minimum(seriesId) >= 0);
+        QVERIFY(store.maximum(seriesId) < 1);
+        store.points(seriesId, 0, seconds * 1000, 1000, points);
+        QVERIFY(!points.isEmpty());
+        QVERIFY(points.count() <= 2000);
+    }
+}
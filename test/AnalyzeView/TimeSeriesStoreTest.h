@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TimeSeriesStoreTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    TimeSeriesStoreTest() = default;
+
+private slots:
+    void _minMaxTest();
+    void _retentionTest();
+    void _decimationTest();
+    void _streamTest();
+};
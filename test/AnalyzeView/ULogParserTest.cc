@@ -2,8 +2,87 @@
 #include "ULogParser.h"
 #include "GeoTagWorker.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
 #include <QtTest/QTest>
 
+namespace {
+
+void _appendMessage(QByteArray &log, char type, const QByteArray &payload)
+{
+    const quint16 size = qToLittleEndian<quint16>(static_cast<quint16>(payload.size()));
+    (void) log.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    (void) log.append(type);
+    (void) log.append(payload);
+}
+
+template<typename T>
+void _appendValue(QByteArray &payload, T value)
+{
+    const T le = qToLittleEndian<T>(value);
+    (void) payload.append(reinterpret_cast<const char*>(&le), sizeof(T));
+}
+
+QByteArray _subscription(quint16 msgId, const QByteArray &name)
+{
+    QByteArray payload;
+    _appendValue<quint8>(payload, 0);
+    _appendValue<quint16>(payload, msgId);
+    return payload + name;
+}
+
+QByteArray _data(quint16 msgId, const QByteArray &data)
+{
+    QByteArray payload;
+    _appendValue<quint16>(payload, msgId);
+    return payload + data;
+}
+
+/// Header, formats and subscriptions followed by chunks of 1000 high rate gyro samples, with a camera capture after
+/// every captureInterval chunks
+QByteArray _syntheticLog(int chunkCount, int captureInterval)
+{
+    QByteArray log("ULog\x01\x12\x35\x01", 8);
+    _appendValue<quint64>(log, 0);
+    _appendMessage(log, 'B', QByteArray(40, '\0'));
+    _appendMessage(log, 'F', "camera_capture:uint64_t timestamp;uint64_t timestamp_utc;double lat;double lon;float alt;float ground_distance;float[4] q;uint32_t seq;int8_t result;uint8_t[3] _padding0;");
+    _appendMessage(log, 'F', "sensor_gyro:uint64_t timestamp;float x;float y;float z;");
+    _appendMessage(log, 'A', _subscription(0, "camera_capture"));
+    _appendMessage(log, 'A', _subscription(1, "sensor_gyro"));
+
+    quint64 timestamp = 0;
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        for (int i = 0; i < 1000; i++) {
+            QByteArray gyro;
+            _appendValue<quint64>(gyro, timestamp += 1000);
+            _appendValue<float>(gyro, 0.1f);
+            _appendValue<float>(gyro, 0.2f);
+            _appendValue<float>(gyro, 0.3f);
+            _appendMessage(log, 'D', _data(1, gyro));
+        }
+        if ((chunk % captureInterval) == 0) {
+            QByteArray capture;
+            _appendValue<quint64>(capture, timestamp);
+            _appendValue<quint64>(capture, 1700000000000000 + timestamp);
+            _appendValue<double>(capture, 47.0 + (chunk * 1e-6));
+            _appendValue<double>(capture, 8.0);
+            _appendValue<float>(capture, 500);
+            _appendValue<float>(capture, 100);
+            for (int i = 0; i < 4; i++) {
+                _appendValue<float>(capture, 0);
+            }
+            _appendValue<quint32>(capture, static_cast<quint32>(chunk + 1));
+            _appendValue<qint8>(capture, 1);
+            capture.append(3, '\0');
+            _appendMessage(log, 'D', _data(0, capture));
+        }
+    }
+    return log;
+}
+
+} // namespace
+
 void ULogParserTest::_getTagsFromLogTest()
 {
     QFile file(":/SampleULog.ulg");
@@ -22,3 +101,68 @@ void ULogParserTest::_getTagsFromLogTest()
     // QVERIFY(!qFuzzyIsNull(firstCameraFeedback.timestamp));
     QVERIFY(firstCameraFeedback.imageSequence != 0);
 }
+
+void ULogParserTest::_getTagsFromLogFileTest()
+{
+    QTemporaryDir tempDir;
+    const QString logFile = tempDir.filePath(QStringLiteral("SampleULog.ulg"));
+    QVERIFY(QFile::copy(QStringLiteral(":/SampleULog.ulg"), logFile));
+
+    QFile file(logFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QList<GeoTagWorker::cameraFeedbackPacket> bufferFeedback;
+    QString errorMessage;
+    QVERIFY(ULogParser::getTagsFromLog(file.readAll(), bufferFeedback, errorMessage));
+    file.close();
+
+    // Streaming the file gives the same tags as parsing it from memory
+    QList<GeoTagWorker::cameraFeedbackPacket> fileFeedback;
+    QVERIFY(ULogParser::getTagsFromLogFile(logFile, fileFeedback, errorMessage));
+    QVERIFY(errorMessage.isEmpty());
+    QCOMPARE(fileFeedback.count(), bufferFeedback.count());
+    for (qsizetype i = 0; i < fileFeedback.count(); i++) {
+        QCOMPARE(fileFeedback[i].imageSequence, bufferFeedback[i].imageSequence);
+        QCOMPARE(fileFeedback[i].latitude, bufferFeedback[i].latitude);
+    }
+
+    QVERIFY(!ULogParser::getTagsFromLogFile(tempDir.filePath(QStringLiteral("missing.ulg")), fileFeedback, errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+}
+
+void ULogParserTest::_streamedLogTest()
+{
+    // A few MB so the captures are spread over several read chunks, with messages split across reads
+    constexpr int chunkCount = 200;
+    constexpr int captureInterval = 2;
+    const QByteArray log = _syntheticLog(chunkCount, captureInterval);
+
+    QTemporaryDir tempDir;
+    const QString logFile = tempDir.filePath(QStringLiteral("streamed.ulg"));
+    {
+        QFile file(logFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(log), log.size());
+    }
+
+    QList<GeoTagWorker::cameraFeedbackPacket> bufferFeedback;
+    QString errorMessage;
+    QVERIFY(ULogParser::getTagsFromLog(log, bufferFeedback, errorMessage));
+    QCOMPARE(bufferFeedback.count(), chunkCount / captureInterval);
+
+    QList<GeoTagWorker::cameraFeedbackPacket> fileFeedback;
+    QVERIFY(ULogParser::getTagsFromLogFile(logFile, fileFeedback, errorMessage));
+    QVERIFY(errorMessage.isEmpty());
+    QCOMPARE(fileFeedback.count(), bufferFeedback.count());
+    for (qsizetype i = 0; i < fileFeedback.count(); i++) {
+        QCOMPARE(fileFeedback[i].timestamp, bufferFeedback[i].timestamp);
+        QCOMPARE(fileFeedback[i].timestampUTC, bufferFeedback[i].timestampUTC);
+        QCOMPARE(fileFeedback[i].imageSequence, bufferFeedback[i].imageSequence);
+        QCOMPARE(fileFeedback[i].latitude, bufferFeedback[i].latitude);
+        QCOMPARE(fileFeedback[i].longitude, bufferFeedback[i].longitude);
+        QCOMPARE(fileFeedback[i].altitude, bufferFeedback[i].altitude);
+        QCOMPARE(fileFeedback[i].captureResult, bufferFeedback[i].captureResult);
+    }
+    QCOMPARE(fileFeedback.constFirst().imageSequence, 1u);
+    QCOMPARE(fileFeedback.constLast().imageSequence, static_cast<uint32_t>(chunkCount - captureInterval + 1));
+    QCOMPARE(fileFeedback.constFirst().longitude, 8.0);
+}
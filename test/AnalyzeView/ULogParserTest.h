@@ -11,4 +11,6 @@ public:
 
 private slots:
     void _getTagsFromLogTest();
+    void _getTagsFromLogFileTest();
+    void _streamedLogTest();
 };
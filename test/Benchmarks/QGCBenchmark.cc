@@ -0,0 +1,1195 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCBenchmark.h"
+#include "QGCApplication.h"
+#include "QGCToolbox.h"
+#include "QGCMetrics.h"
+#include "LinkManager.h"
+#include "MAVLinkProtocol.h"
+#include "MAVLinkLib.h"
+#include "MockLink.h"
+#include "Vehicle.h"
+#include "ParameterManager.h"
+#include "MissionManager.h"
+#include "MissionController.h"
+#include "PlanMasterController.h"
+#include "SurveyComplexItem.h"
+#include "CameraCalc.h"
+#include "QGCMapPolygon.h"
+#include "FactMetaData.h"
+#include "JsonHelper.h"
+#include "QGCTileCacheWorker.h"
+#include "QGCMapTasks.h"
+#include "QGCCacheTile.h"
+#include "QGCMapUrlEngine.h"
+#include "TerrainTileCopernicus.h"
+#include "TerrainTileManager.h"
+#include "LogAnalysisIndex.h"
+#include "ADSBSBSParser.h"
+#include "ADSBConflictDetector.h"
+#include "ULogParser.h"
+#include "GeoTagMatcher.h"
+#include "GeoTagWorker.h"
+#include "LogDownloadController.h"
+#include "LogEntry.h"
+#include "QmlObjectListModel.h"
+#include "TimeSeriesStore.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSysInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtCore/QtEndian>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include <algorithm>
+#include <cmath>
+
+void QGCBenchmark::cleanupTestCase(void)
+{
+    const QString fileName = qEnvironmentVariable("QGC_BENCH_OUTPUT", QDir::temp().filePath(QStringLiteral("qgc_bench.json")));
+
+    QJsonObject root;
+    root[QStringLiteral("timestamp")]           = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root[QStringLiteral("qgcVersion")]          = QCoreApplication::applicationVersion();
+    root[QStringLiteral("qtVersion")]           = QString::fromLatin1(qVersion());
+    root[QStringLiteral("os")]                  = QSysInfo::prettyProductName();
+    root[QStringLiteral("cpuArchitecture")]     = QSysInfo::currentCpuArchitecture();
+    root[QStringLiteral("idealThreadCount")]    = QThread::idealThreadCount();
+    root[QStringLiteral("repetitions")]         = _repetitions;
+    root[QStringLiteral("benchmarks")]          = _results;
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(file.write(QJsonDocument(root).toJson()) > 0);
+    qDebug() << "Benchmark results written to" << fileName;
+}
+
+void QGCBenchmark::_addResult(const QString& name, int iterations, const QList<qint64>& repetitionNSecs, const QJsonObject& extra)
+{
+    QList<double> perOpNSecs;
+    for (const qint64 nsecs: repetitionNSecs) {
+        perOpNSecs.append(static_cast<double>(nsecs) / iterations);
+    }
+    std::sort(perOpNSecs.begin(), perOpNSecs.end());
+    const double median = perOpNSecs[perOpNSecs.count() / 2];
+
+    QJsonObject result = extra;
+    result[QStringLiteral("name")]              = name;
+    result[QStringLiteral("iterations")]        = iterations;
+    result[QStringLiteral("medianNSecsPerOp")]  = median;
+    result[QStringLiteral("minNSecsPerOp")]     = perOpNSecs.first();
+    result[QStringLiteral("maxNSecsPerOp")]     = perOpNSecs.last();
+    result[QStringLiteral("opsPerSec")]         = (median > 0) ? (1e9 / median) : 0;
+    _results.append(result);
+
+    qDebug() << "Benchmark" << name << "median" << median << "nsecs/op," << result[QStringLiteral("opsPerSec")].toDouble() << "ops/sec";
+}
+
+QJsonObject QGCBenchmark::_histogramPercentiles(const QString& name, const QString& labels)
+{
+    QJsonObject percentiles;
+
+    QGCMetrics::instance()->visit([&](const QGCMetrics::Metric_t& metric) {
+        if (!metric.histogram || (metric.name != name) || (QGCMetrics::labelsToString(metric.labels) != labels)) {
+            return;
+        }
+        const QGCMetricHistogram::Snapshot_t snapshot = metric.histogram->snapshot();
+        if (snapshot.count == 0) {
+            return;
+        }
+        for (const double percentile: QGCMetrics::percentiles) {
+            percentiles[QString::number(percentile)] = static_cast<double>(snapshot.percentileNSecs(percentile));
+        }
+        percentiles[QStringLiteral("count")] = static_cast<double>(snapshot.count);
+    });
+
+    return percentiles;
+}
+
+void QGCBenchmark::_mavlinkParseBenchmark(void)
+{
+    static constexpr int messageCount = 1000;
+    static constexpr int passes = 20;
+
+    LinkManager* const linkManager = qgcApp()->toolbox()->linkManager();
+    const uint8_t channel = linkManager->allocateMavlinkChannel();
+    QVERIFY(channel != LinkManager::invalidMavlinkChannel());
+
+    // A telemetry like mix of message types and sizes
+    QByteArray stream;
+    for (int i = 0; i < messageCount; i++) {
+        mavlink_message_t message;
+        switch (i % 5) {
+        case 0:
+        {
+            mavlink_heartbeat_t heartbeat{};
+            heartbeat.type = MAV_TYPE_QUADROTOR;
+            heartbeat.autopilot = MAV_AUTOPILOT_PX4;
+            heartbeat.system_status = MAV_STATE_ACTIVE;
+            (void) mavlink_msg_heartbeat_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, &heartbeat);
+            break;
+        }
+        case 1:
+        {
+            mavlink_attitude_t attitude{};
+            attitude.time_boot_ms = i;
+            attitude.roll = 0.001f * i;
+            attitude.pitch = -0.002f * i;
+            attitude.yaw = 0.003f * i;
+            (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, &attitude);
+            break;
+        }
+        case 2:
+        {
+            mavlink_global_position_int_t position{};
+            position.time_boot_ms = i;
+            position.lat = 473977420 + i;
+            position.lon = 85455940 + i;
+            position.alt = 488000 + i;
+            position.relative_alt = 10000 + i;
+            (void) mavlink_msg_global_position_int_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, &position);
+            break;
+        }
+        case 3:
+        {
+            mavlink_sys_status_t sysStatus{};
+            sysStatus.voltage_battery = 16000 - i;
+            sysStatus.battery_remaining = 90;
+            (void) mavlink_msg_sys_status_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, &sysStatus);
+            break;
+        }
+        default:
+        {
+            mavlink_vfr_hud_t vfrHud{};
+            vfrHud.groundspeed = 0.01f * i;
+            vfrHud.alt = 10.0f + (0.1f * i);
+            (void) mavlink_msg_vfr_hud_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, &vfrHud);
+            break;
+        }
+        }
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+        stream.append(reinterpret_cast<const char*>(buffer), length);
+    }
+
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        int parsed = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int pass = 0; pass < passes; pass++) {
+            for (const char byte: stream) {
+                mavlink_message_t message;
+                mavlink_status_t status;
+                if (mavlink_parse_char(channel, static_cast<uint8_t>(byte), &message, &status) == MAVLINK_FRAMING_OK) {
+                    parsed++;
+                }
+            }
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+        QCOMPARE(parsed, messageCount * passes);
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    linkManager->freeMavlinkChannel(channel);
+
+    std::sort(repetitionNSecs.begin(), repetitionNSecs.end());
+    const double medianSecs = repetitionNSecs[repetitionNSecs.count() / 2] / 1e9;
+    QJsonObject extra;
+    extra[QStringLiteral("bytesPerSec")] = (static_cast<double>(stream.size()) * passes) / medianSecs;
+    _addResult(QStringLiteral("mavlink_parse"), messageCount * passes, repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_vehicleDispatchBenchmark(void)
+{
+    static constexpr int messageCount = 20000;
+
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    MAVLinkProtocol* const mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
+    LinkManager* const linkManager = qgcApp()->toolbox()->linkManager();
+    const uint8_t channel = linkManager->allocateMavlinkChannel();
+    QVERIFY(channel != LinkManager::invalidMavlinkChannel());
+
+    // Telemetry which updates fact groups, the bulk of what a vehicle handles in flight
+    QList<mavlink_message_t> messages;
+    for (int i = 0; i < 100; i++) {
+        mavlink_message_t message;
+        switch (i % 4) {
+        case 0:
+        {
+            mavlink_attitude_t attitude{};
+            attitude.time_boot_ms = i;
+            attitude.roll = 0.001f * i;
+            attitude.pitch = -0.002f * i;
+            attitude.yaw = 0.003f * i;
+            (void) mavlink_msg_attitude_encode_chan(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1, channel, &message, &attitude);
+            break;
+        }
+        case 1:
+        {
+            mavlink_global_position_int_t position{};
+            position.time_boot_ms = i;
+            position.lat = 473977420 + i;
+            position.lon = 85455940 + i;
+            position.alt = 488000 + i;
+            position.relative_alt = 10000 + i;
+            (void) mavlink_msg_global_position_int_encode_chan(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1, channel, &message, &position);
+            break;
+        }
+        case 2:
+        {
+            mavlink_sys_status_t sysStatus{};
+            sysStatus.voltage_battery = 16000 - i;
+            sysStatus.battery_remaining = 90;
+            (void) mavlink_msg_sys_status_encode_chan(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1, channel, &message, &sysStatus);
+            break;
+        }
+        default:
+        {
+            mavlink_vfr_hud_t vfrHud{};
+            vfrHud.groundspeed = 0.01f * i;
+            vfrHud.alt = 10.0f + (0.1f * i);
+            (void) mavlink_msg_vfr_hud_encode_chan(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1, channel, &message, &vfrHud);
+            break;
+        }
+        }
+        messages.append(message);
+    }
+    linkManager->freeMavlinkChannel(channel);
+
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        if (repetition == 0) {
+            QGCMetrics::instance()->reset();
+        }
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < messageCount; i++) {
+            emit mavlinkProtocol->messageReceived(_mockLink, messages[i % messages.count()]);
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+        QCoreApplication::processEvents();
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("latencyNSecs")] = _histogramPercentiles(QStringLiteral("qgc_vehicle_dispatch_seconds"));
+    extra[QStringLiteral("factGroupUpdateNSecs")] = _histogramPercentiles(QStringLiteral("qgc_vehicle_fact_group_update_seconds"));
+    _addResult(QStringLiteral("vehicle_dispatch"), messageCount, repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_parameterLoadBenchmark(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    ParameterManager* const parameterManager = _vehicle->parameterManager();
+    int parameterCount = 0;
+    for (const int componentId: parameterManager->componentIds()) {
+        parameterCount += parameterManager->parameterNames(componentId).count();
+    }
+    QVERIFY(parameterCount > 0);
+
+    // A full refresh goes through the same request/receive path as the initial load, without the rest of the
+    // initial connect sequence
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QSignalSpy spyProgress(parameterManager, &ParameterManager::loadProgressChanged);
+        QElapsedTimer timer;
+        timer.start();
+        parameterManager->refreshAllParameters();
+        do {
+            QVERIFY(spyProgress.wait(30000));
+        } while (parameterManager->loadProgress() != 0.0);
+        const qint64 nsecs = timer.nsecsElapsed();
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("parameters")] = parameterCount;
+    _addResult(QStringLiteral("parameter_load"), parameterCount, repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_missionUploadBenchmark(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    PlanMasterController* const masterController = new PlanMasterController(this);
+    masterController->setFlyView(false);
+    masterController->start();
+    masterController->loadFromFile(QStringLiteral(":/unittest/800Waypoints.mission"));
+    QVERIFY(masterController->missionController()->visualItems()->count() > 800);
+
+    MissionManager* const missionManager = _vehicle->missionManager();
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QSignalSpy spySendComplete(missionManager, &MissionManager::sendComplete);
+        QElapsedTimer timer;
+        timer.start();
+        masterController->sendToVehicle();
+        QVERIFY(spySendComplete.wait(60000));
+        const qint64 nsecs = timer.nsecsElapsed();
+        QCOMPARE(spySendComplete.first().first().toBool(), false);
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+
+        // Let the fence and rally point sends finish before starting again
+        QSignalSpy spySync(masterController, &PlanMasterController::syncInProgressChanged);
+        while (masterController->syncInProgress()) {
+            QVERIFY(spySync.wait(10000));
+        }
+    }
+
+    const int itemCount = missionManager->missionItems().count();
+    delete masterController;
+
+    QJsonObject extra;
+    extra[QStringLiteral("missionItems")] = itemCount;
+    _addResult(QStringLiteral("mission_upload"), itemCount, repetitionNSecs, extra);
+}
+
+/// PX4 reads one item per round trip, ArduPilot keeps a window of requests outstanding
+void QGCBenchmark::_missionDownloadBenchmark(void)
+{
+    for (const MAV_AUTOPILOT autopilot: { MAV_AUTOPILOT_PX4, MAV_AUTOPILOT_ARDUPILOTMEGA }) {
+        _connectMockLink(autopilot);
+
+        PlanMasterController* const masterController = new PlanMasterController(this);
+        masterController->setFlyView(false);
+        masterController->start();
+        masterController->loadFromFile(QStringLiteral(":/unittest/800Waypoints.mission"));
+
+        MissionManager* const missionManager = _vehicle->missionManager();
+        QSignalSpy spySendComplete(missionManager, &MissionManager::sendComplete);
+        masterController->sendToVehicle();
+        QVERIFY(spySendComplete.wait(60000));
+        QCOMPARE(spySendComplete.first().first().toBool(), false);
+        QSignalSpy spySync(masterController, &PlanMasterController::syncInProgressChanged);
+        while (masterController->syncInProgress()) {
+            QVERIFY(spySync.wait(10000));
+        }
+
+        // Only the read itself is timed, without a controller rebuilding its visual items
+        delete masterController;
+
+        QList<qint64> repetitionNSecs;
+        for (int repetition = -1; repetition < _repetitions; repetition++) {
+            QSignalSpy spyNewItems(missionManager, &MissionManager::newMissionItemsAvailable);
+            QElapsedTimer timer;
+            timer.start();
+            missionManager->loadFromVehicle();
+            QVERIFY(spyNewItems.wait(60000));
+            const qint64 nsecs = timer.nsecsElapsed();
+            if (repetition >= 0) {
+                repetitionNSecs.append(nsecs);
+            }
+        }
+
+        const int itemCount = missionManager->missionItems().count();
+        QVERIFY(itemCount > 800);
+        _disconnectMockLink();
+
+        QJsonObject extra;
+        extra[QStringLiteral("missionItems")] = itemCount;
+        _addResult(autopilot == MAV_AUTOPILOT_PX4 ? QStringLiteral("mission_download_px4") : QStringLiteral("mission_download_apm"), itemCount, repetitionNSecs, extra);
+    }
+}
+
+void QGCBenchmark::_surveyTransectBenchmark(void)
+{
+    static constexpr int angleCount = 180;
+    static constexpr double edgeDistance = 2000;
+
+    PlanMasterController* const masterController = new PlanMasterController(this);
+    SurveyComplexItem* const surveyItem = new SurveyComplexItem(masterController, false /* flyView */, QString() /* kmlFile */);
+
+    QList<QGeoCoordinate> vertices;
+    vertices.append(QGeoCoordinate(47.633550640000003, -122.08982199));
+    vertices.append(vertices[0].atDistanceAndAzimuth(edgeDistance, 90));
+    vertices.append(vertices[1].atDistanceAndAzimuth(edgeDistance, 180));
+    vertices.append(vertices[2].atDistanceAndAzimuth(edgeDistance, -90.0));
+    surveyItem->surveyAreaPolygon()->appendVertices(vertices);
+    surveyItem->cameraCalc()->adjustedFootprintSide()->setRawValue(10);
+    surveyItem->cameraCalc()->adjustedFootprintFrontal()->setRawValue(10);
+    surveyItem->gridAngle()->setRawValue(angleCount / 2);
+
+    // Each grid angle change rebuilds the transects synchronously
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int angle = 0; angle < angleCount; angle++) {
+            surveyItem->gridAngle()->setRawValue(angle);
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    const int transectCount = surveyItem->_transectCount();
+    QVERIFY(transectCount > 100);
+    delete masterController;
+
+    QJsonObject extra;
+    extra[QStringLiteral("transects")] = transectCount;
+    _addResult(QStringLiteral("survey_transects"), angleCount, repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_tileCacheBenchmark(void)
+{
+    static constexpr int tileCount = 1000;
+    static constexpr int tileZoom = 17;
+    const QString tileType = QStringLiteral("Bing Satellite");
+    const QString tileFormat = QStringLiteral("png");
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QGCMetrics::instance()->reset();
+
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath(QStringLiteral("qgcMapCache.db")));
+    QSignalSpy spyTotals(&worker, &QGCCacheWorker::updateTotals);
+    QVERIFY(worker.enqueueTask(new QGCMapTask(QGCMapTask::taskInit)));
+    QVERIFY(spyTotals.wait(10000));
+
+    // Fixed size tile of fixed content, distinct per repetition so every insert is a new row
+    QByteArray image(16 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < image.size(); i++) {
+        image[i] = static_cast<char>((i * 31) & 0xff);
+    }
+    const auto tileHash = [&](int repetition, int tile) {
+        return UrlFactory::getTileHash(tileType, tile % 100, (repetition * 100) + (tile / 100), tileZoom);
+    };
+
+    // Fetches are answered on the gui thread, wait for expected answers
+    const auto fetchTiles = [&](const QStringList& hashes) {
+        int answered = 0;
+        int errors = 0;
+        QEventLoop loop;
+        for (const QString& hash: hashes) {
+            QGCFetchTileTask* const task = new QGCFetchTileTask(hash);
+            (void) connect(task, &QGCFetchTileTask::tileFetched, &loop, [&](QGCCacheTile* tile) {
+                delete tile;
+                if (++answered == hashes.count()) {
+                    loop.quit();
+                }
+            });
+            (void) connect(task, &QGCMapTask::error, &loop, [&](QGCMapTask::TaskType, const QString&) {
+                errors++;
+                if (++answered == hashes.count()) {
+                    loop.quit();
+                }
+            });
+            (void) worker.enqueueTask(task);
+        }
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        (void) loop.exec();
+        return (answered == hashes.count()) && (errors == 0);
+    };
+
+    QList<qint64> insertNSecs;
+    QList<qint64> lookupNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QStringList hashes;
+        for (int tile = 0; tile < tileCount; tile++) {
+            hashes.append(tileHash(repetition + 1, tile));
+        }
+
+        // Tasks run in order, the fetch of the last tile completes after every insert
+        QElapsedTimer timer;
+        timer.start();
+        for (const QString& hash: hashes) {
+            QVERIFY(worker.enqueueTask(new QGCSaveTileTask(new QGCCacheTile(hash, image, tileFormat, tileType))));
+        }
+        QVERIFY(fetchTiles({ hashes.last() }));
+        const qint64 insertElapsed = timer.nsecsElapsed();
+
+        timer.restart();
+        QVERIFY(fetchTiles(hashes));
+        const qint64 lookupElapsed = timer.nsecsElapsed();
+
+        if (repetition >= 0) {
+            insertNSecs.append(insertElapsed);
+            lookupNSecs.append(lookupElapsed);
+        }
+    }
+
+    worker.stop();
+    QVERIFY(worker.wait(10000));
+    QCoreApplication::processEvents();
+
+    QJsonObject insertExtra;
+    insertExtra[QStringLiteral("tileBytes")] = image.size();
+    insertExtra[QStringLiteral("taskNSecs")] = _histogramPercentiles(QStringLiteral("qgc_tile_cache_task_seconds"), QStringLiteral("task=\"taskCacheTile\""));
+    _addResult(QStringLiteral("tile_cache_insert"), tileCount, insertNSecs, insertExtra);
+
+    QJsonObject lookupExtra;
+    lookupExtra[QStringLiteral("tileBytes")] = image.size();
+    lookupExtra[QStringLiteral("taskNSecs")] = _histogramPercentiles(QStringLiteral("qgc_tile_cache_task_seconds"), QStringLiteral("task=\"taskFetchTile\""));
+    _addResult(QStringLiteral("tile_cache_lookup"), tileCount, lookupNSecs, lookupExtra);
+}
+
+void QGCBenchmark::_terrainQueryBenchmark(void)
+{
+    static constexpr int tileParseCount = 200;
+    static constexpr int pathCount = 2000;
+
+    // Terrain tiles come from the elevation server, so a synthetic tile in the server format stands in for one.
+    // Queries against it take the same tile decode and lookup paths as the cached tiles in TerrainTileManager.
+    const QGeoCoordinate southWest(47.63, -122.09);
+    const QGeoCoordinate northEast(southWest.latitude() + TerrainTileCopernicus::tileSizeDegrees, southWest.longitude() + TerrainTileCopernicus::tileSizeDegrees);
+    const int gridSize = qRound(TerrainTileCopernicus::tileSizeDegrees / TerrainTileCopernicus::tileValueSpacingDegrees) + 1;
+
+    QJsonArray carpet;
+    for (int lat = 0; lat < gridSize; lat++) {
+        QJsonArray row;
+        for (int lon = 0; lon < gridSize; lon++) {
+            row.append(100 + (((lat * 7) + (lon * 13)) % 200));
+        }
+        carpet.append(row);
+    }
+    QJsonObject data;
+    data[QStringLiteral("bounds")] = QJsonObject {
+        { QStringLiteral("sw"), QJsonArray { southWest.latitude(), southWest.longitude() } },
+        { QStringLiteral("ne"), QJsonArray { northEast.latitude(), northEast.longitude() } },
+    };
+    data[QStringLiteral("stats")] = QJsonObject {
+        { QStringLiteral("min"), 100 },
+        { QStringLiteral("max"), 299 },
+        { QStringLiteral("avg"), 199.5 },
+    };
+    data[QStringLiteral("carpet")] = carpet;
+    const QByteArray json = QJsonDocument(QJsonObject { { QStringLiteral("status"), QStringLiteral("success") }, { QStringLiteral("data"), data } }).toJson(QJsonDocument::Compact);
+
+    QList<qint64> parseNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < tileParseCount; i++) {
+            const TerrainTileCopernicus tile(TerrainTileCopernicus::serializeFromJson(json));
+            QVERIFY(tile.isValid());
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+        if (repetition >= 0) {
+            parseNSecs.append(nsecs);
+        }
+    }
+    QJsonObject parseExtra;
+    parseExtra[QStringLiteral("tileJsonBytes")] = json.size();
+    _addResult(QStringLiteral("terrain_tile_decode"), tileParseCount, parseNSecs, parseExtra);
+
+    // Path queries across the tile, fanning around its center
+    const TerrainTileCopernicus tile(TerrainTileCopernicus::serializeFromJson(json));
+    QVERIFY(tile.isValid());
+    const QGeoCoordinate center(southWest.latitude() + (TerrainTileCopernicus::tileSizeDegrees / 2), southWest.longitude() + (TerrainTileCopernicus::tileSizeDegrees / 2));
+    const double radius = qMin(center.distanceTo(QGeoCoordinate(southWest.latitude(), center.longitude())), center.distanceTo(QGeoCoordinate(center.latitude(), southWest.longitude()))) * 0.9;
+
+    int coordinateCount = 0;
+    QList<qint64> pathNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        double elevationSum = 0;
+        coordinateCount = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < pathCount; i++) {
+            const double azimuth = (i * 360.0) / pathCount;
+            double distanceBetween;
+            double finalDistanceBetween;
+            const QList<QGeoCoordinate> coordinates = TerrainTileManager::pathQueryToCoords(center.atDistanceAndAzimuth(radius, azimuth), center.atDistanceAndAzimuth(radius, azimuth + 180), distanceBetween, finalDistanceBetween);
+            for (const QGeoCoordinate& coordinate: coordinates) {
+                elevationSum += tile.elevation(coordinate);
+            }
+            coordinateCount += coordinates.count();
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+        QVERIFY(!qIsNaN(elevationSum));
+        if (repetition >= 0) {
+            pathNSecs.append(nsecs);
+        }
+    }
+    QJsonObject pathExtra;
+    pathExtra[QStringLiteral("coordinatesPerPath")] = static_cast<double>(coordinateCount) / pathCount;
+    _addResult(QStringLiteral("terrain_path_query"), pathCount, pathNSecs, pathExtra);
+}
+
+void QGCBenchmark::_logAnalysisBenchmark(void)
+{
+    static constexpr qint64 startUSecs = 1700000000000000;
+    static constexpr int chunkSecs = 600;
+    static constexpr int windowCount = 100;
+    static constexpr int pixelWidth = 1920;
+
+    // Default is sized for CI. Set QGC_LOG_ANALYSIS_BENCHMARK_MB to benchmark multi GB logs.
+    const int targetMB = qEnvironmentVariableIsSet("QGC_LOG_ANALYSIS_BENCHMARK_MB") ? qEnvironmentVariableIntValue("QGC_LOG_ANALYSIS_BENCHMARK_MB") : 16;
+
+    // ATTITUDE at 100Hz and SYS_STATUS at 1Hz, a ten minute chunk repeated with timestamps moved on so the log
+    // stays in time order
+    QTemporaryDir tempDir;
+    const QString fileName = tempDir.filePath(QStringLiteral("benchmark.tlog"));
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const auto appendRecord = [&buffer](QByteArray& log, qint64 timeUSecs, const mavlink_message_t& message) {
+            const quint64 timestamp = qToBigEndian<quint64>(static_cast<quint64>(timeUSecs));
+            log.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+            const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+            log.append(reinterpret_cast<const char*>(buffer), length);
+        };
+
+        for (int chunk = 0; file.size() < (static_cast<qint64>(targetMB) * 1024 * 1024); chunk++) {
+            QByteArray log;
+            mavlink_message_t message;
+            for (int i = 0; i < chunkSecs * 100; i++) {
+                const qint64 timeUSecs = startUSecs + (static_cast<qint64>(chunk) * chunkSecs * 1000000) + (i * 10000);
+                (void) mavlink_msg_attitude_pack_chan(1, 1, MAVLINK_COMM_0, &message, i * 10, static_cast<float>(i), 0.5f, -1, 0, 0, 0);
+                appendRecord(log, timeUSecs, message);
+                if ((i % 100) == 0) {
+                    (void) mavlink_msg_sys_status_pack_chan(1, 1, MAVLINK_COMM_0, &message, 0, 0, 0, 500, 12600, -1, 90, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+                    appendRecord(log, timeUSecs, message);
+                }
+            }
+            QCOMPARE(file.write(log), log.size());
+        }
+    }
+
+    qint64 bytesIndexed = 0;
+    int sampleCount = 0;
+    QList<qint64> indexNSecs;
+    QList<qint64> columnNSecs;
+    QList<qint64> windowNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QElapsedTimer timer;
+        timer.start();
+        LogAnalysisIndex index;
+        QString errorMessage;
+        QVERIFY2(index.open(fileName, errorMessage), qPrintable(errorMessage));
+        const qint64 indexElapsed = timer.nsecsElapsed();
+
+        const int attitude = index.messageIndex(QStringLiteral("ATTITUDE (1:1)"));
+        QVERIFY(attitude >= 0);
+        const int roll = index.fieldIndex(attitude, QStringLiteral("roll"));
+        QVERIFY(roll >= 0);
+        timer.restart();
+        (void) index.value(attitude, roll, 0);
+        const qint64 columnElapsed = timer.nsecsElapsed();
+
+        // Scrubbing: windows stepping through the whole log
+        QList<QPointF> points;
+        const qint64 windowUSecs = (index.endUSecs() - index.startUSecs()) / windowCount;
+        timer.restart();
+        for (int i = 0; i < windowCount; i++) {
+            const qint64 windowStartUSecs = index.startUSecs() + (i * windowUSecs);
+            index.points(attitude, roll, windowStartUSecs, windowStartUSecs + windowUSecs, pixelWidth, points);
+            (void) index.statistics(attitude, roll, windowStartUSecs, windowStartUSecs + windowUSecs);
+        }
+        const qint64 windowElapsed = timer.nsecsElapsed();
+        QVERIFY(points.count() <= (2 * pixelWidth) + 2);
+
+        bytesIndexed = index.bytesIndexed();
+        sampleCount = index.sampleCount(attitude);
+        if (repetition >= 0) {
+            indexNSecs.append(indexElapsed);
+            columnNSecs.append(columnElapsed);
+            windowNSecs.append(windowElapsed);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("logBytes")] = static_cast<double>(bytesIndexed);
+    extra[QStringLiteral("samples")] = sampleCount;
+    _addResult(QStringLiteral("log_analysis_index_mb"), qMax(1, static_cast<int>(bytesIndexed / (1024 * 1024))), indexNSecs, extra);
+    _addResult(QStringLiteral("log_analysis_column_build"), sampleCount, columnNSecs, extra);
+    _addResult(QStringLiteral("log_analysis_window"), windowCount, windowNSecs, extra);
+}
+
+void QGCBenchmark::_adsbSBSParseBenchmark(void)
+{
+    // A busy dump1090 feed is a few thousand lines/sec
+    static constexpr int aircraftCount = 500;
+    static constexpr int lineCount = 200000;
+    static constexpr qsizetype chunkSize = 1460;
+
+    QByteArray stream;
+    for (int i = 0; i < lineCount; i++) {
+        const int aircraft = i % aircraftCount;
+        const QByteArray icao = QByteArray::number(0x400000 + aircraft, 16).toUpper();
+        switch (i % 4) {
+        case 0:
+            stream += "MSG,1,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,T" + QByteArray::number(aircraft) + ",,,,,,,,,,,\r\n";
+            break;
+        case 1:
+            stream += "MSG,4,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,420," + QByteArray::number(i % 360) + ",,,0,,,,,0\r\n";
+            break;
+        default:
+            stream += "MSG,3,1,1," + icao + ",1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,37000,,,"
+                + QByteArray::number(47.0 + aircraft * 0.001, 'f', 5) + "," + QByteArray::number(8.0 + i * 0.000001, 'f', 5) + ",,,0,0,0,0\r\n";
+            break;
+        }
+    }
+
+    int batchedCount = 0;
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        ADSBSBSParser parser;
+        batchedCount = 0;
+
+        // Socket sized chunks so lines are split, with a batch taken about as often as the link does
+        QElapsedTimer timer;
+        timer.start();
+        for (qsizetype offset = 0; offset < stream.size(); offset += chunkSize) {
+            parser.append(QByteArrayView(stream).sliced(offset, qMin(chunkSize, stream.size() - offset)));
+            if ((offset / chunkSize) % 64 == 0) {
+                batchedCount += parser.takeBatch().count();
+            }
+        }
+        batchedCount += parser.takeBatch().count();
+        const qint64 nsecs = timer.nsecsElapsed();
+
+        QCOMPARE(parser.lineCount(), static_cast<quint64>(lineCount));
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("streamBytes")] = stream.size();
+    extra[QStringLiteral("batchedUpdates")] = batchedCount;
+    _addResult(QStringLiteral("adsb_sbs_parse"), lineCount, repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_adsbConflictBenchmark(void)
+{
+    // Synthetic scenarios with a fixed seed so runs are comparable: a busy terminal area with a few of our
+    // vehicles inside it, plus enroute traffic spread over a much larger area
+    struct Scenario_t {
+        const char *name;
+        int ownshipCount;
+        int localTrafficCount;
+        int enrouteTrafficCount;
+    };
+    static constexpr Scenario_t scenarios[] = {
+        { "adsb_conflicts_light", 1, 50, 200 },
+        { "adsb_conflicts_airport", 8, 400, 1000 },
+        { "adsb_conflicts_dense", 32, 1500, 3000 },
+    };
+    static constexpr int passes = 20;
+
+    ADSBConflictDetector::Thresholds_t thresholds;
+    const QGeoCoordinate center(47.45, 8.56, 450);
+
+    const auto trafficInfo = [](uint32_t icaoAddress, const QGeoCoordinate &location, double altitude, double heading, double groundSpeed) {
+        ADSB::VehicleInfo_t vehicleInfo{};
+        vehicleInfo.icaoAddress = icaoAddress;
+        vehicleInfo.location = location;
+        vehicleInfo.altitude = altitude;
+        vehicleInfo.heading = heading;
+        vehicleInfo.groundSpeed = groundSpeed;
+        vehicleInfo.verticalRate = 0;
+        vehicleInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::HeadingAvailable | ADSB::VelocityAvailable;
+        return vehicleInfo;
+    };
+
+    for (const Scenario_t &scenario : scenarios) {
+        QRandomGenerator random(42);
+
+        QList<ADSBConflictDetector::Ownship_t> ownships;
+        for (int i = 0; i < scenario.ownshipCount; i++) {
+            ADSBConflictDetector::Ownship_t ownship;
+            ownship.vehicleId = i + 1;
+            ownship.location = center.atDistanceAndAzimuth(random.bounded(10000.0), random.bounded(360.0));
+            ownship.location.setAltitude(450 + random.bounded(120.0));
+            ownship.velocityNorth = random.bounded(30.0) - 15;
+            ownship.velocityEast = random.bounded(30.0) - 15;
+            ownships.append(ownship);
+        }
+
+        ADSBConflictDetector::Traffic_t traffic;
+        uint32_t icaoAddress = 0x100000;
+        for (int i = 0; i < scenario.localTrafficCount; i++) {
+            const QGeoCoordinate location = center.atDistanceAndAzimuth(random.bounded(30000.0), random.bounded(360.0));
+            traffic.append(trafficInfo(icaoAddress++, location, 300 + random.bounded(3000.0), random.bounded(360.0), 30 + random.bounded(100.0)));
+        }
+        for (int i = 0; i < scenario.enrouteTrafficCount; i++) {
+            const QGeoCoordinate location = center.atDistanceAndAzimuth(30000 + random.bounded(400000.0), random.bounded(360.0));
+            traffic.append(trafficInfo(icaoAddress++, location, 3000 + random.bounded(9000.0), random.bounded(360.0), 150 + random.bounded(100.0)));
+        }
+
+        qsizetype conflictCount = 0;
+        QList<qint64> repetitionNSecs;
+        for (int repetition = -1; repetition < _repetitions; repetition++) {
+            QElapsedTimer timer;
+            timer.start();
+            for (int pass = 0; pass < passes; pass++) {
+                conflictCount = ADSBConflictDetector::detect(ownships, traffic, thresholds).count();
+            }
+            const qint64 nsecs = timer.nsecsElapsed();
+            if (repetition >= 0) {
+                repetitionNSecs.append(nsecs);
+            }
+        }
+
+        QJsonObject extra;
+        extra[QStringLiteral("vehicles")] = scenario.ownshipCount;
+        extra[QStringLiteral("traffic")] = static_cast<int>(traffic.count());
+        extra[QStringLiteral("conflicts")] = static_cast<int>(conflictCount);
+        _addResult(QString::fromLatin1(scenario.name), passes, repetitionNSecs, extra);
+    }
+}
+
+void QGCBenchmark::_ulogGeoTagBenchmark(void)
+{
+    // Default is sized for CI. Set QGC_ULOG_BENCHMARK_MB to benchmark multi GB logs.
+    const qint64 targetMB = qEnvironmentVariableIsSet("QGC_ULOG_BENCHMARK_MB") ? qEnvironmentVariableIntValue("QGC_ULOG_BENCHMARK_MB") : 64;
+    static constexpr qint64 captureCount = 500;
+    static constexpr int samplesPerChunk = 1000;
+    const qint64 chunkCount = (targetMB * 1024 * 1024) / (samplesPerChunk * 25);
+
+    const auto appendMessage = [](QByteArray &log, char type, const QByteArray &payload) {
+        const quint16 size = qToLittleEndian<quint16>(static_cast<quint16>(payload.size()));
+        (void) log.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        (void) log.append(type);
+        (void) log.append(payload);
+    };
+    const auto appendValue = [](QByteArray &payload, auto value) {
+        const auto le = qToLittleEndian(value);
+        (void) payload.append(reinterpret_cast<const char*>(&le), sizeof(le));
+    };
+    const auto subscription = [&appendValue](quint16 msgId, const QByteArray &name) {
+        QByteArray payload;
+        appendValue(payload, quint8(0));
+        appendValue(payload, msgId);
+        return payload + name;
+    };
+
+    // High rate gyro data with camera captures spread through it. The parser only decodes camera_capture, so this
+    // measures how fast everything else is skipped.
+    QTemporaryDir tempDir;
+    const QString logFile = tempDir.filePath(QStringLiteral("benchmark.ulg"));
+    {
+        QFile file(logFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+
+        QByteArray header("ULog\x01\x12\x35\x01", 8);
+        appendValue(header, quint64(0));
+        appendMessage(header, 'B', QByteArray(40, '\0'));
+        appendMessage(header, 'F', "camera_capture:uint64_t timestamp;uint64_t timestamp_utc;double lat;double lon;float alt;float ground_distance;float[4] q;uint32_t seq;int8_t result;uint8_t[3] _padding0;");
+        appendMessage(header, 'F', "sensor_gyro:uint64_t timestamp;float x;float y;float z;");
+        appendMessage(header, 'A', subscription(0, "camera_capture"));
+        appendMessage(header, 'A', subscription(1, "sensor_gyro"));
+        QCOMPARE(file.write(header), header.size());
+
+        quint64 timestamp = 0;
+        for (qint64 chunk = 0; chunk < chunkCount; chunk++) {
+            QByteArray data;
+            data.reserve((samplesPerChunk * 25) + 100);
+            for (int i = 0; i < samplesPerChunk; i++) {
+                QByteArray gyro;
+                appendValue(gyro, quint16(1));
+                appendValue(gyro, timestamp += 1000);
+                appendValue(gyro, 0.1f);
+                appendValue(gyro, 0.2f);
+                appendValue(gyro, 0.3f);
+                appendMessage(data, 'D', gyro);
+            }
+            if ((chunk % qMax<qint64>(1, chunkCount / captureCount)) == 0) {
+                QByteArray capture;
+                appendValue(capture, quint16(0));
+                appendValue(capture, timestamp);
+                appendValue(capture, quint64(1700000000000000 + timestamp));
+                appendValue(capture, 47.0 + (chunk * 1e-6));
+                appendValue(capture, 8.0);
+                appendValue(capture, 500.0f);
+                appendValue(capture, 100.0f);
+                for (int i = 0; i < 4; i++) {
+                    appendValue(capture, 0.0f);
+                }
+                appendValue(capture, static_cast<quint32>(chunk + 1));
+                appendValue(capture, qint8(1));
+                capture.append(3, '\0');
+                appendMessage(data, 'D', capture);
+            }
+            QCOMPARE(file.write(data), data.size());
+        }
+    }
+    const qint64 logBytes = QFileInfo(logFile).size();
+
+#ifdef Q_OS_LINUX
+    const auto procStatusKB = [](const QByteArray &key) -> qint64 {
+        QFile status(QStringLiteral("/proc/self/status"));
+        if (status.open(QIODevice::ReadOnly)) {
+            for (const QByteArray &line : status.readAll().split('\n')) {
+                if (line.startsWith(key)) {
+                    return line.mid(key.size()).trimmed().split(' ').constFirst().toLongLong();
+                }
+            }
+        }
+        return -1;
+    };
+#endif
+
+    qint64 peakIncreaseKB = -1;
+    qsizetype tagCount = 0;
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+#ifdef Q_OS_LINUX
+        // Resets the peak resident set size so the parse can be measured on its own
+        QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+        const bool peakReset = clearRefs.open(QIODevice::WriteOnly) && (clearRefs.write("5") == 1);
+        clearRefs.close();
+        const qint64 rssBeforeKB = procStatusKB("VmRSS:");
+#endif
+
+        QList<GeoTagWorker::cameraFeedbackPacket> cameraFeedback;
+        QString errorMessage;
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY2(ULogParser::getTagsFromLogFile(logFile, cameraFeedback, errorMessage), qPrintable(errorMessage));
+        const qint64 nsecs = timer.nsecsElapsed();
+        tagCount = cameraFeedback.count();
+
+#ifdef Q_OS_LINUX
+        if (peakReset) {
+            peakIncreaseKB = qMax(peakIncreaseKB, procStatusKB("VmHWM:") - rssBeforeKB);
+        }
+#endif
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("logBytes")] = static_cast<double>(logBytes);
+    extra[QStringLiteral("tags")] = static_cast<int>(tagCount);
+    extra[QStringLiteral("peakMemoryIncreaseKB")] = static_cast<double>(peakIncreaseKB);
+    _addResult(QStringLiteral("ulog_geotag_mb"), qMax<int>(1, static_cast<int>(logBytes / (1024 * 1024))), repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_logDownloadBenchmark(void)
+{
+    static constexpr uint32_t logSize = MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN * 2000;
+
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _mockLink->setLogDownloadFileSize(logSize);
+
+    LogDownloadController* const controller = new LogDownloadController();
+    controller->refresh();
+    QTRY_VERIFY_WITH_TIMEOUT(!controller->requestingList(), 10000);
+    QmlObjectListModel* const model = controller->model();
+    QVERIFY(model->count() > 0);
+    QGCLogEntry* const entry = model->value<QGCLogEntry*>(0);
+    QCOMPARE(entry->size(), logSize);
+
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        // A fresh directory each time so nothing is resumed from the previous download
+        QTemporaryDir downloadDir;
+        entry->setSelected(true);
+
+        QElapsedTimer timer;
+        timer.start();
+        controller->downloadToDirectory(downloadDir.path());
+        QTRY_VERIFY_WITH_TIMEOUT(!controller->downloadingLogs(), 60000);
+        const qint64 nsecs = timer.nsecsElapsed();
+
+        QVERIFY(UnitTest::fileCompare(QDir(downloadDir.path()).filePath(QStringLiteral("log_0_UnknownDate.ulg")), _mockLink->logDownloadFile()));
+        if (repetition >= 0) {
+            repetitionNSecs.append(nsecs);
+        }
+    }
+
+    delete controller;
+    _disconnectMockLink();
+
+    // Per bin so the result is comparable across log sizes
+    QJsonObject extra;
+    extra[QStringLiteral("logBytes")] = static_cast<double>(logSize);
+    _addResult(QStringLiteral("log_download_bin"), static_cast<int>(logSize / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN), repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_timeSeriesBenchmark(void)
+{
+    // 10 inspector fields charted at 50Hz for a minute, with the chart refreshing at 15Hz on a 1000 pixel wide plot
+    static constexpr int fieldCount = 10;
+    static constexpr int rateHz = 50;
+    static constexpr int seconds = 60;
+    static constexpr int refreshHz = 15;
+    static constexpr int pixelWidth = 1000;
+    static constexpr int sampleCount = fieldCount * rateHz * seconds;
+
+    int refreshCount = 0;
+    QList<qint64> appendNSecs;
+    QList<qint64> refreshNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        TimeSeriesStore store(seconds * 1000, seconds * 200);
+        QList<int> seriesIds;
+        for (int i = 0; i < fieldCount; i++) {
+            seriesIds.append(store.addSeries());
+        }
+
+        QRandomGenerator random(1);
+        QList<QPointF> points;
+        qint64 appendElapsed = 0;
+        qint64 refreshElapsed = 0;
+        refreshCount = 0;
+        QElapsedTimer timer;
+        for (int sample = 0; sample < (rateHz * seconds); sample++) {
+            const qint64 timeMSecs = (sample * 1000) / rateHz;
+
+            // Each sample also updates the auto range
+            timer.start();
+            for (const int seriesId : seriesIds) {
+                store.append(seriesId, timeMSecs, random.bounded(1.0));
+                (void) store.minimum(seriesId);
+                (void) store.maximum(seriesId);
+            }
+            appendElapsed += timer.nsecsElapsed();
+
+            if ((sample % (rateHz / refreshHz)) == 0) {
+                timer.start();
+                for (const int seriesId : seriesIds) {
+                    store.points(seriesId, timeMSecs - (seconds * 1000), timeMSecs, pixelWidth, points);
+                }
+                refreshElapsed += timer.nsecsElapsed();
+                refreshCount++;
+            }
+        }
+        QVERIFY(points.count() <= (2 * pixelWidth));
+
+        if (repetition >= 0) {
+            appendNSecs.append(appendElapsed);
+            refreshNSecs.append(refreshElapsed);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("fields")] = fieldCount;
+    extra[QStringLiteral("pixelWidth")] = pixelWidth;
+    _addResult(QStringLiteral("time_series_append"), sampleCount, appendNSecs, extra);
+    _addResult(QStringLiteral("time_series_refresh"), refreshCount, refreshNSecs, extra);
+}
+
+void QGCBenchmark::_geoTagMatchBenchmark(void)
+{
+    // A long survey: triggers every 2 to 2.5 secs on the log clock, Exif times an hour and a bit behind with one second
+    // resolution, and about one percent of the frames and log entries dropped
+    static constexpr int triggerCount = 20000;
+
+    QRandomGenerator random(11);
+    QList<double> allTriggerSecs;
+    double secs = 1.7e9;
+    for (int i = 0; i < triggerCount; i++) {
+        secs += 2 + random.bounded(0.5);
+        allTriggerSecs.append(secs);
+    }
+    QList<double> triggerSecs;
+    QList<double> imageSecs;
+    for (int i = 0; i < triggerCount; i++) {
+        if ((i % 131) != 50) {
+            triggerSecs.append(allTriggerSecs[i]);
+        }
+        if ((i % 97) != 0) {
+            imageSecs.append(std::floor(allTriggerSecs[i] - 3600.4));
+        }
+    }
+
+    int matchCount = 0;
+    QList<qint64> repetitionNSecs;
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QElapsedTimer timer;
+        timer.start();
+        GeoTagMatcher matcher;
+        matcher.setTriggers(triggerSecs);
+        QVERIFY(matcher.match(imageSecs));
+        const qint64 elapsed = timer.nsecsElapsed();
+        matchCount = matcher.matchCount();
+
+        if (repetition >= 0) {
+            repetitionNSecs.append(elapsed);
+        }
+    }
+
+    QJsonObject extra;
+    extra[QStringLiteral("images")] = imageSecs.count();
+    extra[QStringLiteral("triggers")] = triggerSecs.count();
+    extra[QStringLiteral("matched")] = matchCount;
+    _addResult(QStringLiteral("geotag_match"), imageSecs.count(), repetitionNSecs, extra);
+}
+
+void QGCBenchmark::_factMetaDataBenchmark(void)
+{
+    // Loading the meta data of a plan item's settings json by parsing it every time, versus copying from the shared
+    // prototypes, and what that leaves for creating whole survey items
+    static constexpr int itemCount = 100;
+    const QString jsonFile = QStringLiteral(":/json/Survey.SettingsGroup.json");
+
+    QList<qint64> parseNSecs;
+    QList<qint64> sharedNSecs;
+    QList<qint64> itemNSecs;
+    PlanMasterController* const masterController = new PlanMasterController(this);
+    for (int repetition = -1; repetition < _repetitions; repetition++) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < itemCount; i++) {
+            QString errorString;
+            int version;
+            const QJsonObject jsonObject = JsonHelper::openInternalQGCJsonFile(jsonFile, FactMetaData::qgcFileType, 1, 1, version, errorString);
+            FactMetaData::DefineMap_t defineMap;
+            qDeleteAll(FactMetaData::createMapFromJsonArray(jsonObject[QStringLiteral("QGC.MetaData.Facts")].toArray(), defineMap, nullptr));
+        }
+        const qint64 parseElapsed = timer.nsecsElapsed();
+
+        timer.start();
+        for (int i = 0; i < itemCount; i++) {
+            qDeleteAll(FactMetaData::createMapFromJsonFile(jsonFile, nullptr));
+        }
+        const qint64 sharedElapsed = timer.nsecsElapsed();
+
+        QList<SurveyComplexItem*> items;
+        timer.start();
+        for (int i = 0; i < itemCount; i++) {
+            items.append(new SurveyComplexItem(masterController, false /* flyView */, QString() /* kmlFile */));
+        }
+        const qint64 itemElapsed = timer.nsecsElapsed();
+        qDeleteAll(items);
+
+        if (repetition >= 0) {
+            parseNSecs.append(parseElapsed);
+            sharedNSecs.append(sharedElapsed);
+            itemNSecs.append(itemElapsed);
+        }
+    }
+    delete masterController;
+
+    _addResult(QStringLiteral("fact_metadata_parse"), itemCount, parseNSecs);
+    _addResult(QStringLiteral("fact_metadata_shared"), itemCount, sharedNSecs);
+    _addResult(QStringLiteral("survey_item_create"), itemCount, itemNSecs);
+}
@@ -0,0 +1,62 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+/// Throughput and latency benchmarks for the hot paths: MAVLink parsing, vehicle message dispatch, and parameter
+/// load, mission upload and download and log download over MockLink. Also survey transect generation, plan item
+/// meta data loading, the map tile cache, terrain lookups, MAVLink Inspector chart series, offline log analysis, the
+/// ADS-B SBS-1 feed and conflict detection, and reading geotags from a ULog and matching them to images.
+/// Each benchmark runs a fixed amount of work on fixed data, once to warm up and then _repetitions times, and
+/// reports the median and min time per operation. Where a subsystem keeps a QGCMetrics histogram its percentiles
+/// are reported as well.
+/// Results are written as JSON to $QGC_BENCH_OUTPUT, or qgc_bench.json in the temp directory. Standalone, run with
+/// --unittest:QGCBenchmark or the qgc_bench build target.
+class QGCBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void cleanupTestCase(void);
+
+    void _mavlinkParseBenchmark(void);
+    void _vehicleDispatchBenchmark(void);
+    void _parameterLoadBenchmark(void);
+    void _missionUploadBenchmark(void);
+    void _missionDownloadBenchmark(void);
+    void _surveyTransectBenchmark(void);
+    void _factMetaDataBenchmark(void);
+    void _tileCacheBenchmark(void);
+    void _terrainQueryBenchmark(void);
+    void _logAnalysisBenchmark(void);
+    void _adsbSBSParseBenchmark(void);
+    void _adsbConflictBenchmark(void);
+    void _ulogGeoTagBenchmark(void);
+    void _logDownloadBenchmark(void);
+    void _timeSeriesBenchmark(void);
+    void _geoTagMatchBenchmark(void);
+
+private:
+    /// Adds a result given the time of each repetition of iterations operations
+    void _addResult(const QString& name, int iterations, const QList<qint64>& repetitionNSecs, const QJsonObject& extra = QJsonObject());
+
+    /// @return Percentiles of the named QGCMetrics histogram, empty if it has no values
+    static QJsonObject _histogramPercentiles(const QString& name, const QString& labels = QString());
+
+    QJsonArray _results;
+
+    static constexpr int _repetitions = 5;
+};
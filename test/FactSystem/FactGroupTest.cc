@@ -0,0 +1,64 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactGroupTest.h"
+#include "FactGroup.h"
+
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+namespace {
+
+class ImmediateFactGroup : public FactGroup
+{
+public:
+    ImmediateFactGroup(void)
+        : FactGroup(0 /* updateRateMsecs */)
+    {
+        _addFact(&valueFact, QStringLiteral("value"));
+    }
+
+    Fact valueFact { 0, QStringLiteral("value"), FactMetaData::valueTypeDouble, this };
+};
+
+}
+
+void FactGroupTest::_subscriptionTest(void)
+{
+    ImmediateFactGroup factGroup;
+    QSignalSpy spyValueChanged(&factGroup.valueFact, &Fact::valueChanged);
+
+    // Without subscribers values are published as usual
+    factGroup.valueFact.setRawValue(1.0);
+    QCOMPARE(spyValueChanged.count(), 1);
+
+    QObject* inactiveSubscriber = new QObject();
+    QObject activeSubscriber;
+
+    factGroup.setSubscriberActive(inactiveSubscriber, false);
+    QVERIFY(factGroup.publishingSuspended());
+    factGroup.valueFact.setRawValue(2.0);
+    factGroup.valueFact.setRawValue(3.0);
+    QCOMPARE(spyValueChanged.count(), 1);
+
+    // A single active subscriber resumes publishing, catching up with the latest value
+    factGroup.setSubscriberActive(&activeSubscriber, true);
+    QVERIFY(!factGroup.publishingSuspended());
+    QCOMPARE(spyValueChanged.count(), 2);
+    QCOMPARE(spyValueChanged.last()[0].toDouble(), 3.0);
+
+    factGroup.setSubscriberActive(&activeSubscriber, false);
+    QVERIFY(factGroup.publishingSuspended());
+
+    // Destroyed subscribers are removed, once none are left the group publishes again
+    delete inactiveSubscriber;
+    QVERIFY(factGroup.publishingSuspended());
+    factGroup.removeSubscriber(&activeSubscriber);
+    QVERIFY(!factGroup.publishingSuspended());
+}
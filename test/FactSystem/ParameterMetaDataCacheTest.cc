@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataCacheTest.h"
+#include "ParameterMetaDataCache.h"
+#include "FactMetaData.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+static bool _writeFile(const QString& fileName, const QByteArray& contents)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(contents) == contents.size();
+}
+
+void ParameterMetaDataCacheTest::_cacheHitTest(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString metaDataFile = tempDir.filePath(QStringLiteral("metadata.xml"));
+    QVERIFY(_writeFile(metaDataFile, QByteArrayLiteral("<parameters><parameter name=\"FOO\"/></parameters>")));
+
+    int parseCount = 0;
+    const ParameterMetaDataCache::Parser parser = [&parseCount](const QByteArray& fileContents, QDataStream& stream) {
+        parseCount++;
+        stream << static_cast<qint64>(fileContents.size()) << QStringLiteral("parsed");
+        return true;
+    };
+
+    bool parsed = false;
+    {
+        ParameterMetaDataCache cache(tempDir.filePath(QStringLiteral("cache")), 5);
+
+        const QByteArray first = cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed);
+        QVERIFY(parsed);
+        QVERIFY(!first.isEmpty());
+        QCOMPARE(parseCount, 1);
+
+        // Memory cache
+        QCOMPARE(cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed), first);
+        QVERIFY(!parsed);
+        QCOMPARE(parseCount, 1);
+
+        // Disk cache
+        cache.clearMemoryCache();
+        QCOMPARE(cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed), first);
+        QVERIFY(!parsed);
+        QCOMPARE(parseCount, 1);
+
+        // A different format version must not pick up the entry
+        (void) cache.metaData(metaDataFile, QStringLiteral("Test"), 2, parser, &parsed);
+        QVERIFY(parsed);
+        QCOMPARE(parseCount, 2);
+    }
+
+    // New session on the same cache directory, preload reads what is already on disk and only parses on a miss
+    ParameterMetaDataCache cache(tempDir.filePath(QStringLiteral("cache")), 5);
+    QVERIFY(cache.preload(metaDataFile, QStringLiteral("Test"), 1, parser));
+    QCOMPARE(parseCount, 2);
+    QVERIFY(cache.preload(metaDataFile, QStringLiteral("Test"), 3, parser));
+    QCOMPARE(parseCount, 3);
+    QVERIFY(!cache.preload(tempDir.filePath(QStringLiteral("missing.xml")), QStringLiteral("Test"), 1, parser));
+    QCOMPARE(parseCount, 3);
+
+    // The first load after a preload never parses, whether the preload hit the disk cache or parsed
+    const QByteArray binaryMetaData = cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed);
+    QVERIFY(!parsed);
+    (void) cache.metaData(metaDataFile, QStringLiteral("Test"), 3, parser, &parsed);
+    QVERIFY(!parsed);
+    QCOMPARE(parseCount, 3);
+
+    QDataStream stream(binaryMetaData);
+    stream.setVersion(ParameterMetaDataCache::streamVersion);
+    qint64 size = 0;
+    QString text;
+    stream >> size >> text;
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QVERIFY(size > 0);
+    QCOMPARE(text, QStringLiteral("parsed"));
+}
+
+void ParameterMetaDataCacheTest::_changedFileTest(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString metaDataFile = tempDir.filePath(QStringLiteral("metadata.xml"));
+    QVERIFY(_writeFile(metaDataFile, QByteArrayLiteral("version 1")));
+
+    const ParameterMetaDataCache::Parser parser = [](const QByteArray& fileContents, QDataStream& stream) {
+        stream << fileContents;
+        return true;
+    };
+
+    ParameterMetaDataCache cache(tempDir.filePath(QStringLiteral("cache")), 5);
+    bool parsed = false;
+    QByteArray binaryMetaData = cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed);
+    QVERIFY(parsed);
+
+    // Same name, new contents must parse again
+    QVERIFY(_writeFile(metaDataFile, QByteArrayLiteral("version 2")));
+    binaryMetaData = cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed);
+    QVERIFY(parsed);
+
+    QDataStream stream(binaryMetaData);
+    stream.setVersion(ParameterMetaDataCache::streamVersion);
+    QByteArray contents;
+    stream >> contents;
+    QCOMPARE(contents, QByteArrayLiteral("version 2"));
+
+    // Failed parses are not cached
+    const ParameterMetaDataCache::Parser failingParser = [](const QByteArray&, QDataStream&) {
+        return false;
+    };
+    QVERIFY(_writeFile(metaDataFile, QByteArrayLiteral("version 3")));
+    QVERIFY(cache.metaData(metaDataFile, QStringLiteral("Test"), 1, failingParser, &parsed).isEmpty());
+    QVERIFY(parsed);
+    QVERIFY(!cache.metaData(metaDataFile, QStringLiteral("Test"), 1, parser, &parsed).isEmpty());
+    QVERIFY(parsed);
+
+    // Missing files return nothing without calling the parser
+    QVERIFY(cache.metaData(tempDir.filePath(QStringLiteral("missing.xml")), QStringLiteral("Test"), 1, parser, &parsed).isEmpty());
+    QVERIFY(!parsed);
+}
+
+void ParameterMetaDataCacheTest::_factMetaDataStreamTest(void)
+{
+    FactMetaData source(FactMetaData::valueTypeFloat, QStringLiteral("TEST_PARAM"));
+    source.setCategory(QStringLiteral("Standard"));
+    source.setGroup(QStringLiteral("Test"));
+    source.setShortDescription(QStringLiteral("Short"));
+    source.setLongDescription(QStringLiteral("Long"));
+    source.setRawUnits(QStringLiteral("norm"));
+    source.setRawMin(0.0f);
+    source.setRawMax(1.0f);
+    source.setRawDefaultValue(0.5f);
+    source.setRawIncrement(0.01);
+    source.setDecimalPlaces(3);
+    source.setVehicleRebootRequired(true);
+    source.setVolatileValue(true);
+
+    QByteArray binaryMetaData;
+    {
+        QDataStream stream(&binaryMetaData, QIODevice::WriteOnly);
+        stream.setVersion(ParameterMetaDataCache::streamVersion);
+        stream << source;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+
+    FactMetaData copy;
+    QDataStream stream(binaryMetaData);
+    stream.setVersion(ParameterMetaDataCache::streamVersion);
+    stream >> copy;
+    QCOMPARE(stream.status(), QDataStream::Ok);
+
+    QCOMPARE(copy.type(),                   source.type());
+    QCOMPARE(copy.name(),                   source.name());
+    QCOMPARE(copy.category(),               source.category());
+    QCOMPARE(copy.group(),                  source.group());
+    QCOMPARE(copy.shortDescription(),       source.shortDescription());
+    QCOMPARE(copy.longDescription(),        source.longDescription());
+    QCOMPARE(copy.rawMin(),                 source.rawMin());
+    QCOMPARE(copy.rawMax(),                 source.rawMax());
+    QCOMPARE(copy.rawDefaultValue(),        source.rawDefaultValue());
+    QCOMPARE(copy.rawIncrement(),           source.rawIncrement());
+    QCOMPARE(copy.decimalPlaces(),          source.decimalPlaces());
+    QCOMPARE(copy.vehicleRebootRequired(),  source.vehicleRebootRequired());
+    QCOMPARE(copy.volatileValue(),          source.volatileValue());
+    QCOMPARE(copy.readOnly(),               source.readOnly());
+
+    // Translators are restored from the units
+    QCOMPARE(copy.rawUnits(),               source.rawUnits());
+    QCOMPARE(copy.cookedUnits(),            source.cookedUnits());
+    QCOMPARE(copy.cookedMax(),              source.cookedMax());
+}
@@ -11,6 +11,7 @@
 #include "MissionManagerTest.h"
 #include "MissionManager.h"
 #include "MultiSignalSpy.h"
+#include "QGCMetrics.h"
 
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
@@ -333,6 +334,110 @@ void MissionManagerTest::_testReadFailureHandlingPX4(void)
     _testReadFailureHandlingWorker();
 }
 
+/// Round trips a survey sized mission. PX4 runs the classic one item per round trip sequence, ArduPilot uses the
+/// pipelined read window and write look ahead.
+void MissionManagerTest::_largeMissionTransferWorker(int itemCount, int readDropInterval)
+{
+    QList<MissionItem*> missionItems;
+    for (int i=0; i<=itemCount; i++) {
+        MissionItem* missionItem = new MissionItem(i,
+                                                   MAV_CMD_NAV_WAYPOINT,
+                                                   MAV_FRAME_GLOBAL_RELATIVE_ALT,
+                                                   0, 0, 0, 0,
+                                                   47.3769 + (i * 0.0001), 8.549444, 50,
+                                                   true,    // autoContinue
+                                                   false,   // isCurrentItem
+                                                   this);
+        missionItems.append(missionItem);
+    }
+
+    const int expectedCount = _mockLink->getFirmwareType() == MAV_AUTOPILOT_ARDUPILOTMEGA ? itemCount + 1 : itemCount;
+
+    _missionManager->writeMissionItems(missionItems);
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime * 10));
+    QCOMPARE(_multiSpyMissionManager->pullBoolFromSignalIndex(sendCompleteSignalIndex), false);
+    _multiSpyMissionManager->clearAllSignals();
+
+    _mockLink->setMissionItemReadDropInterval(readDropInterval);
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime * 10));
+    _multiSpyMissionManager->clearAllSignals();
+    _mockLink->setMissionItemReadDropInterval(0);
+
+    QCOMPARE(_missionManager->missionItems().count(), expectedCount);
+    for (int i=0; i<expectedCount; i++) {
+        QCOMPARE(_missionManager->missionItems()[i]->sequenceNumber(), i);
+    }
+}
+
+void MissionManagerTest::_testLargeMissionTransferPX4(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+    _largeMissionTransferWorker(800);
+}
+
+void MissionManagerTest::_testLargeMissionTransferAPM(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+    _largeMissionTransferWorker(800);
+}
+
+/// Lost responses must leave the read window as soon as a later item arrives. If they stayed counted as in flight the
+/// window would shrink to nothing and the rest of the read would crawl along one ack timeout per item.
+void MissionManagerTest::_testReadWindowRecoveryAPM(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+
+    const QGCMetrics::Labels labels = { { QStringLiteral("plan"), QStringLiteral("T:Mission") } };
+    QGCMetricCounter* const lostMetric      = QGCMetrics::instance()->counter(QStringLiteral("qgc_plan_read_lost_items"), QString(), labels);
+    QGCMetricCounter* const timeoutMetric   = QGCMetrics::instance()->counter(QStringLiteral("qgc_plan_read_timeouts"), QString(), labels);
+    const quint64 lostStart     = lostMetric->value();
+    const quint64 timeoutStart  = timeoutMetric->value();
+
+    // One in ten responses lost, many more than the read window
+    _largeMissionTransferWorker(300, 10);
+
+    QVERIFY(lostMetric->value() - lostStart >= 20);
+
+    // Only lost requests at the very end of the read have no later item to reveal them
+    QVERIFY(timeoutMetric->value() - timeoutStart <= 2);
+}
+
+/// A vehicle which reports plan identifiers has its plan read back from the plan cache instead of downloaded
+void MissionManagerTest::_testPlanCachePX4(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+    _mockLink->setMissionItemSendOpaqueId(true);
+
+    // Writing the plan is what fills the cache
+    _writeItems(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ACCEPTED, false);
+    QCOMPARE(_mockLink->missionItemRequestCount(), 0);
+
+    // Hit: nothing is requested from the vehicle
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    _multiSpyMissionManager->clearAllSignals();
+    QCOMPARE(_mockLink->missionItemRequestCount(), 0);
+    QCOMPARE(_missionManager->missionItems().count(), static_cast<int>(_cTestCases));
+    for (size_t i=0; i<_cTestCases; i++) {
+        const ItemInfo_t& expectedItem = _rgTestCases[i].expectedItem;
+        MissionItem* actual = _missionManager->missionItems()[static_cast<int>(i)];
+        QCOMPARE(actual->sequenceNumber(),          expectedItem.sequenceNumber);
+        QCOMPARE(actual->coordinate().latitude(),   expectedItem.coordinate.latitude());
+        QCOMPARE((int)actual->command(),            (int)expectedItem.command);
+        QCOMPARE(actual->param1(),                  expectedItem.param1);
+        QCOMPARE(actual->frame(),                   expectedItem.frame);
+    }
+
+    // Miss: without a plan identifier the plan is downloaded
+    _mockLink->setMissionItemSendOpaqueId(false);
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    _multiSpyMissionManager->clearAllSignals();
+    QCOMPARE(_mockLink->missionItemRequestCount(), static_cast<int>(_cTestCases));
+    QCOMPARE(_missionManager->missionItems().count(), static_cast<int>(_cTestCases));
+}
+
 void MissionManagerTest::_testErrorAckFailureStrings(void)
 {
     _initForFirmwareType(MAV_AUTOPILOT_PX4);
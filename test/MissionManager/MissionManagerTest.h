@@ -25,6 +25,10 @@ private slots:
     //void _testWriteFailureHandlingAPM(void);
     void _testReadFailureHandlingPX4(void);
     //void _testReadFailureHandlingAPM(void);
+    void _testLargeMissionTransferPX4(void);
+    void _testLargeMissionTransferAPM(void);
+    void _testReadWindowRecoveryAPM(void);
+    void _testPlanCachePX4(void);
     //void _testErrorAckFailureStrings(void);
 
 private:
@@ -37,6 +41,7 @@ private:
     void _writeItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult, bool shouldFail);
     void _testWriteFailureHandlingWorker(void);
     void _testReadFailureHandlingWorker(void);
+    void _largeMissionTransferWorker(int itemCount, int readDropInterval = 0);
     
     static const TestCase_t _rgTestCases[];
     static const size_t     _cTestCases;
@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PlanCacheTest.h"
+#include "PlanCache.h"
+#include "ComponentInformationBlobCache.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+QList<mavlink_mission_item_int_t> PlanCacheTest::_testItems(int count)
+{
+    QList<mavlink_mission_item_int_t> items;
+    for (int i=0; i<count; i++) {
+        mavlink_mission_item_int_t item;
+        memset(&item, 0, sizeof(item));
+        item.seq            = i;
+        item.command        = MAV_CMD_NAV_WAYPOINT;
+        item.frame          = MAV_FRAME_GLOBAL_RELATIVE_ALT_INT;
+        item.autocontinue   = 1;
+        item.x              = 473769000 + (i * 1000);
+        item.y              = 85494440;
+        item.z              = 50.0f + i;
+        item.mission_type   = MAV_MISSION_TYPE_MISSION;
+        items.append(item);
+    }
+    return items;
+}
+
+bool PlanCacheTest::_itemsEqual(const QList<mavlink_mission_item_int_t>& items1, const QList<mavlink_mission_item_int_t>& items2)
+{
+    return items1.count() == items2.count() && memcmp(items1.constData(), items2.constData(), items1.count() * sizeof(mavlink_mission_item_int_t)) == 0;
+}
+
+void PlanCacheTest::_fileTagTest(void)
+{
+    // No plan identifier, nothing is cached
+    QVERIFY(PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0, 10).isEmpty());
+
+    const QString tag = PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0x1234, 10);
+    QVERIFY(!tag.isEmpty());
+    QVERIFY(tag != PlanCache::fileTag(2, MAV_AUTOPILOT_PX4,             MAV_MISSION_TYPE_MISSION,   0x1234, 10));
+    QVERIFY(tag != PlanCache::fileTag(1, MAV_AUTOPILOT_ARDUPILOTMEGA,   MAV_MISSION_TYPE_MISSION,   0x1234, 10));
+    QVERIFY(tag != PlanCache::fileTag(1, MAV_AUTOPILOT_PX4,             MAV_MISSION_TYPE_FENCE,     0x1234, 10));
+    QVERIFY(tag != PlanCache::fileTag(1, MAV_AUTOPILOT_PX4,             MAV_MISSION_TYPE_MISSION,   0x1235, 10));
+    QVERIFY(tag != PlanCache::fileTag(1, MAV_AUTOPILOT_PX4,             MAV_MISSION_TYPE_MISSION,   0x1234, 11));
+}
+
+void PlanCacheTest::_roundTripTest(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QList<mavlink_mission_item_int_t> items = _testItems(25);
+    const QString tag = PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0xcafe, items.count());
+    QList<mavlink_mission_item_int_t> loadedItems;
+
+    {
+        PlanCache cache(tempDir.path(), 5);
+
+        // Miss
+        QVERIFY(!cache.load(tag, loadedItems));
+        QVERIFY(loadedItems.isEmpty());
+
+        // Hit
+        cache.save(tag, items);
+        QVERIFY(cache.load(tag, loadedItems));
+        QVERIFY(_itemsEqual(loadedItems, items));
+
+        // A different plan identifier is a miss
+        QVERIFY(!cache.load(PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0xbeef, items.count()), loadedItems));
+        QVERIFY(loadedItems.isEmpty());
+
+        // Vehicles without plan identifiers are never cached
+        cache.save(QString(), items);
+        QVERIFY(!cache.load(QString(), loadedItems));
+    }
+
+    // New session on the same directory
+    PlanCache cache(tempDir.path(), 5);
+    QVERIFY(cache.load(tag, loadedItems));
+    QVERIFY(_itemsEqual(loadedItems, items));
+}
+
+void PlanCacheTest::_corruptFileTest(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QList<mavlink_mission_item_int_t> items = _testItems(10);
+    const QString tag = PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0xcafe, items.count());
+
+    {
+        PlanCache cache(tempDir.path(), 5);
+        cache.save(tag, items);
+    }
+
+    const QStringList cacheFiles = QDir(tempDir.path()).entryList({ tag + QStringLiteral(".cache") }, QDir::Files);
+    QCOMPARE(cacheFiles.count(), 1);
+
+    // Flip a byte near the end of the file, inside the items
+    QFile file(QDir(tempDir.path()).filePath(cacheFiles.first()));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray contents = file.readAll();
+    QVERIFY(contents.size() > 16);
+    contents[contents.size() - 8] = ~contents[contents.size() - 8];
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(contents), contents.size());
+    file.close();
+
+    PlanCache cache(tempDir.path(), 5);
+    QList<mavlink_mission_item_int_t> loadedItems;
+    QVERIFY(!cache.load(tag, loadedItems));
+    QVERIFY(loadedItems.isEmpty());
+
+    // Truncated file
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(contents.left(contents.size() / 2)), contents.size() / 2);
+    file.close();
+    QVERIFY(!cache.load(tag, loadedItems));
+    QVERIFY(loadedItems.isEmpty());
+}
+
+void PlanCacheTest::_staleFileTest(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QList<mavlink_mission_item_int_t> items = _testItems(10);
+    const QString tag = PlanCache::fileTag(1, MAV_AUTOPILOT_PX4, MAV_MISSION_TYPE_MISSION, 0xcafe, items.count());
+
+    // Entry left under the same tag by the first version of the plan cache format
+    {
+        ComponentInformationBlobCache blobCache(tempDir.path(), 5, 0x51504c43 /* "QPLC" */, 1);
+        QVERIFY(blobCache.save(tag, QByteArray(reinterpret_cast<const char*>(items.constData()), items.count() * sizeof(mavlink_mission_item_int_t))));
+    }
+
+    PlanCache cache(tempDir.path(), 5);
+    QList<mavlink_mission_item_int_t> loadedItems;
+    QVERIFY(!cache.load(tag, loadedItems));
+    QVERIFY(loadedItems.isEmpty());
+}
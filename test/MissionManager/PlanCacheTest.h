@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QList>
+
+class PlanCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _fileTagTest(void);
+    void _roundTripTest(void);
+    void _corruptFileTest(void);
+    void _staleFileTest(void);
+
+private:
+    static QList<mavlink_mission_item_int_t> _testItems(int count);
+    static bool _itemsEqual(const QList<mavlink_mission_item_int_t>& items1, const QList<mavlink_mission_item_int_t>& items2);
+};
@@ -11,6 +11,7 @@
 #include "SurveyComplexItem.h"
 #include "PlanViewSettings.h"
 #include "MultiSignalSpy.h"
+#include "JsonHelper.h"
 
 SurveyComplexItemTest::SurveyComplexItemTest(void)
 {
@@ -355,3 +356,54 @@ void SurveyComplexItemTest::_testHoverCaptureItemGeneration(void)
     _testItemGenerationWorker(false /* imagesInTurnaround */, true /* hasTurnaround */, true /* useConditionGate */, expectedCommands);
     _testItemGenerationWorker(false /* imagesInTurnaround */, true /* hasTurnaround */, false /* useConditionGate */, expectedCommands);
 }
+
+void SurveyComplexItemTest::_testMetaDataSharing(void)
+{
+    const QString jsonFile = QStringLiteral(":/json/Survey.SettingsGroup.json");
+
+    // Meta data from the shared prototypes must match a fresh parse of the json
+    QString errorString;
+    int version;
+    QJsonObject jsonObject = JsonHelper::openInternalQGCJsonFile(jsonFile, FactMetaData::qgcFileType, 1, 1, version, errorString);
+    QVERIFY(errorString.isEmpty());
+    FactMetaData::DefineMap_t defineMap;
+    QMap<QString, FactMetaData*> parsedMap = FactMetaData::createMapFromJsonArray(jsonObject[QStringLiteral("QGC.MetaData.Facts")].toArray(), defineMap, this);
+    QMap<QString, FactMetaData*> sharedMap = FactMetaData::createMapFromJsonFile(jsonFile, this);
+    QCOMPARE(sharedMap.keys(), parsedMap.keys());
+    for (const QString& name: parsedMap.keys()) {
+        QCOMPARE(sharedMap[name]->type(),               parsedMap[name]->type());
+        QCOMPARE(sharedMap[name]->shortDescription(),   parsedMap[name]->shortDescription());
+        QCOMPARE(sharedMap[name]->cookedUnits(),        parsedMap[name]->cookedUnits());
+        QCOMPARE(sharedMap[name]->rawMin(),             parsedMap[name]->rawMin());
+        QCOMPARE(sharedMap[name]->rawMax(),             parsedMap[name]->rawMax());
+        QCOMPARE(sharedMap[name]->decimalPlaces(),      parsedMap[name]->decimalPlaces());
+        QCOMPARE(sharedMap[name]->enumStrings(),        parsedMap[name]->enumStrings());
+    }
+    qDeleteAll(sharedMap);
+
+    // A language change drops the prototypes. Meta data created before keeps working, the next load parses again.
+    sharedMap = FactMetaData::createMapFromJsonFile(jsonFile, this);
+    FactMetaData::clearJsonFileCache();
+    QMap<QString, FactMetaData*> reparsedMap = FactMetaData::createMapFromJsonFile(jsonFile, this);
+    for (const QString& name: parsedMap.keys()) {
+        QCOMPARE(sharedMap[name]->shortDescription(),   parsedMap[name]->shortDescription());
+        QCOMPARE(reparsedMap[name]->shortDescription(), parsedMap[name]->shortDescription());
+        QCOMPARE(reparsedMap[name]->enumStrings(),      parsedMap[name]->enumStrings());
+    }
+    qDeleteAll(parsedMap);
+    qDeleteAll(sharedMap);
+    qDeleteAll(reparsedMap);
+
+    QList<SurveyComplexItem*> items;
+    for (int i=0; i<2; i++) {
+        items.append(new SurveyComplexItem(_masterController, false /* flyView */, QString() /* kmlFile */));
+    }
+
+    // The items have their own meta data objects, but the data inside them is shared
+    FactMetaData* metaData1 = items[0]->gridAngle()->metaData();
+    FactMetaData* metaData2 = items[1]->gridAngle()->metaData();
+    QVERIFY(metaData1 != metaData2);
+    QVERIFY(metaData1->shortDescription().constData() == metaData2->shortDescription().constData());
+
+    qDeleteAll(items);
+}
@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "AppLogModelTest.h"
+#include "AppMessages.h"
+#include "QGCSignalCoalescer.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+void AppLogModelTest::_drain(AppLogModel& model)
+{
+    // A drain which finds a line counted but not yet linked posts another one
+    do {
+        QGCSignalCoalescer::instance()->drain();
+    } while (model._drainPending.load());
+}
+
+QString AppLogModelTest::_row(const AppLogModel& model, int row)
+{
+    return model.data(model.index(row)).toString();
+}
+
+void AppLogModelTest::_multiThreadTest(void)
+{
+    constexpr int threadCount = 4;
+    constexpr int lineCount = 2000;
+
+    AppLogModel model;
+    QList<QThread*> threads;
+    for (int thread = 0; thread < threadCount; thread++) {
+        threads.append(QThread::create([&model, thread]() {
+            for (int i = 0; i < lineCount; i++) {
+                model._log(QStringLiteral("%1 %2").arg(thread).arg(i));
+            }
+        }));
+    }
+    for (QThread* thread: threads) {
+        thread->start();
+    }
+    for (QThread* thread: threads) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+    _drain(model);
+
+    // Every line arrives once, in the order its thread logged it
+    QCOMPARE(model.rowCount(), threadCount * lineCount);
+    QCOMPARE(model._queuedCount.load(), 0);
+    QCOMPARE(model._droppedCount.load(), 0);
+    QList<int> nextLine(threadCount, 0);
+    for (int row = 0; row < model.rowCount(); row++) {
+        const QStringList fields = _row(model, row).split(QLatin1Char(' '));
+        QCOMPARE(fields.count(), 2);
+        const int thread = fields[0].toInt();
+        QCOMPARE(fields[1].toInt(), nextLine[thread]);
+        nextLine[thread]++;
+    }
+    for (int thread = 0; thread < threadCount; thread++) {
+        QCOMPARE(nextLine[thread], lineCount);
+    }
+}
+
+void AppLogModelTest::_droppedLinesTest(void)
+{
+    constexpr int droppedCount = 500;
+
+    // The gui thread does not drain while it logs, so the queue fills up
+    AppLogModel model;
+    for (int i = 0; i < AppLogModel::_maxQueuedLines + droppedCount; i++) {
+        model._log(QString::number(i));
+    }
+    QCOMPARE(model._queuedCount.load(), AppLogModel::_maxQueuedLines);
+    QCOMPARE(model._droppedCount.load(), droppedCount);
+    _drain(model);
+
+    // Only the newest lines fit the ring, the last one reports the lines which were dropped
+    QCOMPARE(model.rowCount(), AppLogModel::_maxLines);
+    QCOMPARE(model._queuedCount.load(), 0);
+    QCOMPARE(model._droppedCount.load(), 0);
+    QCOMPARE(_row(model, 0), QString::number(AppLogModel::_maxQueuedLines - AppLogModel::_maxLines + 1));
+    QCOMPARE(_row(model, AppLogModel::_maxLines - 2), QString::number(AppLogModel::_maxQueuedLines - 1));
+    QCOMPARE(_row(model, AppLogModel::_maxLines - 1), AppLogModel::tr("%1 log messages dropped").arg(droppedCount));
+
+    // Logging works again once the queue is drained
+    model._log(QStringLiteral("after"));
+    _drain(model);
+    QCOMPARE(_row(model, AppLogModel::_maxLines - 1), QStringLiteral("after"));
+}
+
+void AppLogModelTest::_lateLineTest(void)
+{
+    AppLogModel model;
+
+    // A producer has counted its line and seen the drain pending, but not yet linked the line into the queue
+    model._queuedCount.fetch_add(1);
+    model._drainPending.store(true);
+    model._drain();
+    QCOMPARE(model.rowCount(), 0);
+    QVERIFY(model._drainPending.load());
+
+    // The drain re-posted itself, so the line is picked up without another one being logged
+    model._queue.push(QStringLiteral("late"));
+    _drain(model);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(_row(model, 0), QStringLiteral("late"));
+    QCOMPARE(model._queuedCount.load(), 0);
+}
+
+void AppLogModelTest::_ringOverflowTest(void)
+{
+    constexpr int batchCount = 3;
+    constexpr int batchLines = 4000;
+
+    AppLogModel model;
+    int line = 0;
+    for (int batch = 0; batch < batchCount; batch++) {
+        for (int i = 0; i < batchLines; i++) {
+            model._log(QString::number(line++));
+        }
+        _drain(model);
+        QCOMPARE(model.rowCount(), qMin(line, AppLogModel::_maxLines));
+    }
+
+    // The oldest lines were dropped to make room, the rest are still in order across the wrap
+    const int firstLine = batchCount * batchLines - AppLogModel::_maxLines;
+    QCOMPARE(model.rowCount(), AppLogModel::_maxLines);
+    for (int row = 0; row < model.rowCount(); row++) {
+        QCOMPARE(_row(model, row), QString::number(firstLine + row));
+    }
+    QVERIFY(!model.data(model.index(AppLogModel::_maxLines)).isValid());
+}
+
+void AppLogModelTest::_fileRotationTest(void)
+{
+    constexpr int maxFiles = 3;
+    constexpr int batchCount = 5;
+    constexpr int batchLines = 20;
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QDir dir(tempDir.path());
+    const QString fileName = dir.absoluteFilePath(QStringLiteral("QGCConsole.log"));
+
+    QFile previous(fileName);
+    QVERIFY(previous.open(QIODevice::WriteOnly | QIODevice::Text));
+    (void) previous.write("previous\n");
+    previous.close();
+
+    // Each batch is over the size limit, so every write rotates
+    AppLogFileWriter writer(100, maxFiles);
+    QVERIFY(writer.open(fileName));
+    QCOMPARE(dir.entryList(QDir::Files, QDir::Name), QStringList({ "QGCConsole.1.log", "QGCConsole.log" }));
+
+    for (int batch = 0; batch < batchCount; batch++) {
+        QStringList lines;
+        for (int i = 0; i < batchLines; i++) {
+            lines.append(QStringLiteral("batch %1 line %2").arg(batch).arg(i));
+        }
+        writer.write(lines);
+    }
+
+    // Only maxFiles files are kept: the new empty file and the newest batches, the previous session is gone
+    QCOMPARE(dir.entryList(QDir::Files, QDir::Name), QStringList({ "QGCConsole.1.log", "QGCConsole.2.log", "QGCConsole.log" }));
+    QCOMPARE(QFileInfo(fileName).size(), 0);
+    for (int index = 1; index < maxFiles; index++) {
+        QFile rotated(dir.absoluteFilePath(QStringLiteral("QGCConsole.%1.log").arg(index)));
+        QVERIFY(rotated.open(QIODevice::ReadOnly | QIODevice::Text));
+        QCOMPARE(QString::fromUtf8(rotated.readLine()).trimmed(), QStringLiteral("batch %1 line 0").arg(batchCount - index));
+    }
+}
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class AppLogModel;
+
+class AppLogModelTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _multiThreadTest(void);
+    void _droppedLinesTest(void);
+    void _lateLineTest(void);
+    void _ringOverflowTest(void);
+    void _fileRotationTest(void);
+
+private:
+    void _drain(AppLogModel& model);
+    QString _row(const AppLogModel& model, int row);
+};
@@ -17,9 +17,14 @@
 
 // AnalyzeView
 #include "ExifParserTest.h"
+#include "GeoTagMatcherTest.h"
+#include "LogAnalysisIndexTest.h"
 // #include "MavlinkLogTest.h"
 // #include "LogDownloadTest.h"
+#include "MAVLinkConsoleControllerTest.h"
+#include "MAVLinkFieldDecoderTest.h"
 #include "PX4LogParserTest.h"
+#include "TimeSeriesStoreTest.h"
 #include "ULogParserTest.h"
 
 // Audio
@@ -28,13 +33,18 @@
 // AutoPilotPlugins
 // #include "RadioConfigTest.h"
 
+// Benchmarks
+#include "QGCBenchmark.h"
+
 // Comms
 #include "QGCSerialPortInfoTest.h"
 
 // FactSystem
+#include "FactGroupTest.h"
 #include "FactSystemTestGeneric.h"
 #include "FactSystemTestPX4.h"
 #include "ParameterManagerTest.h"
+#include "ParameterMetaDataCacheTest.h"
 
 // FollowMe
 #include "FollowMeTest.h"
@@ -59,6 +69,7 @@
 #include "MissionItemTest.h"
 #include "MissionManagerTest.h"
 #include "MissionSettingsTest.h"
+#include "PlanCacheTest.h"
 #include "PlanMasterControllerTest.h"
 #include "QGCMapPolygonTest.h"
 #include "QGCMapPolylineTest.h"
@@ -78,6 +89,7 @@
 // #include "MessageBoxTest.h"
 
 // QmlControls
+#include "AppLogModelTest.h"
 
 // Terrain
 #include "TerrainQueryTest.h"
@@ -85,6 +97,9 @@
 // UI
 
 // Utilities
+#include "QGCMetricsTest.h"
+#include "QGCMPSCQueueTest.h"
+#include "QGCSignalCoalescerTest.h"
 // Compression
 #include "DecompressionTest.h"
 
@@ -97,6 +112,7 @@
 // #include "RequestMessageTest.h"
 // #include "SendMavCommandWithHandlerTest.h"
 // #include "SendMavCommandWithSignalingTest.h"
+#include "TrajectoryPointsTest.h"
 
 // Missing
 // #include "FlightGearUnitTest.h"
@@ -113,9 +129,14 @@ int runTests(bool stress, QStringView unitTestOptions)
 
 	// AnalyzeView
 	UT_REGISTER_TEST(ExifParserTest)
+	UT_REGISTER_TEST(GeoTagMatcherTest)
+	UT_REGISTER_TEST(LogAnalysisIndexTest)
 	// UT_REGISTER_TEST(MavlinkLogTest)
 	// UT_REGISTER_TEST(LogDownloadTest)
+	UT_REGISTER_TEST(MAVLinkConsoleControllerTest)
+	UT_REGISTER_TEST(MAVLinkFieldDecoderTest)
 	UT_REGISTER_TEST(PX4LogParserTest)
+	UT_REGISTER_TEST(TimeSeriesStoreTest)
 	UT_REGISTER_TEST(ULogParserTest)
 
 	// Audio
@@ -124,13 +145,18 @@ int runTests(bool stress, QStringView unitTestOptions)
 	// AutoPilotPlugins
 	// UT_REGISTER_TEST(RadioConfigTest)
 
+	// Benchmarks
+	UT_REGISTER_TEST_STANDALONE(QGCBenchmark)
+
 	// Comms
 	UT_REGISTER_TEST(QGCSerialPortInfoTest)
 
 	// FactSystem
+	UT_REGISTER_TEST(FactGroupTest)
 	UT_REGISTER_TEST(FactSystemTestGeneric)
 	UT_REGISTER_TEST(FactSystemTestPX4)
 	UT_REGISTER_TEST(ParameterManagerTest)
+	UT_REGISTER_TEST(ParameterMetaDataCacheTest)
 
 	// FollowMe
 	UT_REGISTER_TEST(FollowMeTest)
@@ -155,6 +181,7 @@ int runTests(bool stress, QStringView unitTestOptions)
 	UT_REGISTER_TEST(MissionItemTest)
 	UT_REGISTER_TEST(MissionManagerTest)
 	UT_REGISTER_TEST(MissionSettingsTest)
+	UT_REGISTER_TEST(PlanCacheTest)
 	UT_REGISTER_TEST(PlanMasterControllerTest)
 	UT_REGISTER_TEST(QGCMapPolygonTest)
 	UT_REGISTER_TEST(QGCMapPolylineTest)
@@ -172,6 +199,7 @@ int runTests(bool stress, QStringView unitTestOptions)
 	// UT_REGISTER_TEST(MessageBoxTest)
 
 	// QmlControls
+	UT_REGISTER_TEST(AppLogModelTest)
 
 	// Terrain
 	UT_REGISTER_TEST(TerrainQueryTest)
@@ -179,6 +207,9 @@ int runTests(bool stress, QStringView unitTestOptions)
 	// UI
 
 	// Utilities
+	UT_REGISTER_TEST(QGCMetricsTest)
+	UT_REGISTER_TEST(QGCMPSCQueueTest)
+	UT_REGISTER_TEST(QGCSignalCoalescerTest)
 	// Compression
 	UT_REGISTER_TEST(DecompressionTest)
 
@@ -191,6 +222,7 @@ int runTests(bool stress, QStringView unitTestOptions)
 	// UT_REGISTER_TEST(RequestMessageTest)
 	// UT_REGISTER_TEST(SendMavCommandWithHandlerTest)
 	// UT_REGISTER_TEST(SendMavCommandWithSignalingTest)
+	UT_REGISTER_TEST(TrajectoryPointsTest)
 
 	// Missing
 	// UT_REGISTER_TEST(FlightGearUnitTest)
@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCMPSCQueueTest.h"
+#include "QGCMPSCQueue.h"
+
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+void QGCMPSCQueueTest::_fifoTest(void)
+{
+    QGCMPSCQueue<QString> queue;
+    QString value;
+    QVERIFY(!queue.pop(value));
+
+    // Emptying the queue and filling it again goes through the stub node each time
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10; i++) {
+            queue.push(QString::number(i));
+        }
+        for (int i = 0; i < 10; i++) {
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, QString::number(i));
+        }
+        QVERIFY(!queue.pop(value));
+    }
+
+    // Items left in the queue are freed with it
+    QGCMPSCQueue<QString>* leftover = new QGCMPSCQueue<QString>();
+    leftover->push(QStringLiteral("a"));
+    leftover->push(QStringLiteral("b"));
+    delete leftover;
+}
+
+void QGCMPSCQueueTest::_multiProducerTest(void)
+{
+    constexpr int producerCount = 4;
+    constexpr int itemCount = 50000;
+
+    QGCMPSCQueue<QPair<int, int>> queue;
+    QList<QThread*> producers;
+    for (int producer = 0; producer < producerCount; producer++) {
+        producers.append(QThread::create([&queue, producer]() {
+            for (int i = 0; i < itemCount; i++) {
+                queue.push(qMakePair(producer, i));
+            }
+        }));
+    }
+    for (QThread* thread: producers) {
+        thread->start();
+    }
+
+    // Every item arrives once, in the order its producer pushed it
+    QList<int> nextItem(producerCount, 0);
+    int received = 0;
+    QPair<int, int> item;
+    while (received < producerCount * itemCount) {
+        if (queue.pop(item)) {
+            QCOMPARE(item.second, nextItem[item.first]);
+            nextItem[item.first]++;
+            received++;
+        } else {
+            QThread::yieldCurrentThread();
+        }
+    }
+    QVERIFY(!queue.pop(item));
+
+    for (QThread* thread: producers) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+}
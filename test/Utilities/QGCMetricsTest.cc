@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCMetricsTest.h"
+#include "QGCMetrics.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+void QGCMetricsTest::_histogramTest(void)
+{
+    // Every value lands in a bucket which holds it, and the bucket is no more than 12.5% wider than the value
+    for (quint64 value = 0; value < (Q_UINT64_C(1) << 40); value = (value * 3 / 2) + 1) {
+        const int index = QGCMetricHistogram::bucketIndex(value);
+        QVERIFY(QGCMetricHistogram::bucketMaxNSecs(index) >= value);
+        QVERIFY(QGCMetricHistogram::bucketMaxNSecs(index) <= (value + (value / 8)));
+        if (index > 0) {
+            QVERIFY(QGCMetricHistogram::bucketMaxNSecs(index - 1) < value);
+        }
+    }
+    QCOMPARE(QGCMetricHistogram::bucketIndex(Q_UINT64_C(1) << 50), QGCMetricHistogram::_bucketCount - 1);
+
+    QGCMetricHistogram histogram;
+    QCOMPARE(histogram.snapshot().percentileNSecs(0.5), Q_UINT64_C(0));
+
+    // 1..1000 usecs
+    for (int i = 1; i <= 1000; i++) {
+        histogram.record(i * 1000);
+    }
+    const QGCMetricHistogram::Snapshot_t snapshot = histogram.snapshot();
+    QCOMPARE(snapshot.count, Q_UINT64_C(1000));
+    QCOMPARE(snapshot.maxNSecs, Q_UINT64_C(1000000));
+    QCOMPARE(snapshot.sumNSecs, Q_UINT64_C(500500000));
+    const quint64 p50 = snapshot.percentileNSecs(0.5);
+    QVERIFY((p50 >= 500000) && (p50 <= 562500));
+    const quint64 p99 = snapshot.percentileNSecs(0.99);
+    QVERIFY((p99 >= 990000) && (p99 <= 1000000));
+    QCOMPARE(snapshot.percentileNSecs(1.0), Q_UINT64_C(1000000));
+
+    histogram.reset();
+    QCOMPARE(histogram.snapshot().count, Q_UINT64_C(0));
+}
+
+void QGCMetricsTest::_registryTest(void)
+{
+    QGCMetrics* const metrics = QGCMetrics::instance();
+
+    // The same name and labels always give the same metric
+    QGCMetricCounter* const counterA = metrics->counter(QStringLiteral("qgc_test_registry"), QStringLiteral("Test"), { { QStringLiteral("link"), QStringLiteral("a") } });
+    QGCMetricCounter* const counterB = metrics->counter(QStringLiteral("qgc_test_registry"), QStringLiteral("Test"), { { QStringLiteral("link"), QStringLiteral("b") } });
+    QVERIFY(counterA != counterB);
+    QCOMPARE(metrics->counter(QStringLiteral("qgc_test_registry"), QStringLiteral("Test"), { { QStringLiteral("link"), QStringLiteral("a") } }), counterA);
+
+    counterA->add(3);
+    counterB->add();
+    QCOMPARE(counterA->value(), Q_UINT64_C(3));
+    QCOMPARE(counterB->value(), Q_UINT64_C(1));
+
+    // A name registered as a different type gives a metric which isn't exported
+    QGCMetricHistogram* const clash = metrics->histogram(QStringLiteral("qgc_test_registry"), QStringLiteral("Test"), { { QStringLiteral("link"), QStringLiteral("a") } });
+    QVERIFY(clash);
+    clash->record(1);
+
+    metrics->reset();
+    QCOMPARE(counterA->value(), Q_UINT64_C(0));
+}
+
+void QGCMetricsTest::_exportTest(void)
+{
+    QGCMetrics* const metrics = QGCMetrics::instance();
+    metrics->counter(QStringLiteral("qgc_test_export_messages"), QStringLiteral("Test messages"), { { QStringLiteral("link"), QStringLiteral("one") } })->add(5);
+    metrics->counter(QStringLiteral("qgc_test_export_messages"), QStringLiteral("Test messages"), { { QStringLiteral("link"), QStringLiteral("t\"wo") } })->add(7);
+    metrics->histogram(QStringLiteral("qgc_test_export_seconds"), QStringLiteral("Test latency"))->record(2000000);
+
+    const QString prometheus = QString::fromUtf8(metrics->toPrometheus());
+    QCOMPARE(prometheus.count(QStringLiteral("# HELP qgc_test_export_messages_total Test messages\n")), 1);
+    QCOMPARE(prometheus.count(QStringLiteral("# TYPE qgc_test_export_messages_total counter\n")), 1);
+    QVERIFY(prometheus.contains(QStringLiteral("qgc_test_export_messages_total{link=\"one\"} 5\n")));
+    QVERIFY(prometheus.contains(QStringLiteral("qgc_test_export_messages_total{link=\"t\\\"wo\"} 7\n")));
+    QVERIFY(prometheus.contains(QStringLiteral("# TYPE qgc_test_export_seconds summary\n")));
+    QVERIFY(prometheus.contains(QStringLiteral("qgc_test_export_seconds{quantile=\"0.5\"} ")));
+    QVERIFY(prometheus.contains(QStringLiteral("qgc_test_export_seconds_sum 0.002\n")));
+    QVERIFY(prometheus.contains(QStringLiteral("qgc_test_export_seconds_count 1\n")));
+
+    QJsonParseError error;
+    const QJsonDocument json = QJsonDocument::fromJson(metrics->toJson(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    bool foundHistogram = false;
+    for (const QJsonValue& value: json.object()[QStringLiteral("histograms")].toArray()) {
+        const QJsonObject histogram = value.toObject();
+        if (histogram[QStringLiteral("name")].toString() == QStringLiteral("qgc_test_export_seconds")) {
+            foundHistogram = true;
+            QCOMPARE(histogram[QStringLiteral("count")].toInteger(), 1);
+            QCOMPARE(histogram[QStringLiteral("maxNSecs")].toInteger(), 2000000);
+            QVERIFY(histogram[QStringLiteral("percentilesNSecs")].toObject().contains(QStringLiteral("0.99")));
+        }
+    }
+    QVERIFY(foundHistogram);
+}
@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCSignalCoalescerTest.h"
+#include "QGCSignalCoalescer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+void QGCSignalCoalescerTest::_latestValueTest(void)
+{
+    QList<int> received;
+    QObject receiver;
+    QMetaObject::Connection connection = QGCSignalCoalescer::connect(this, &QGCSignalCoalescerTest::_valueSignal, &receiver, [&received](int value) { received.append(value); });
+
+    for (int i = 0; i < 100; i++) {
+        emit _valueSignal(i);
+    }
+    QVERIFY(received.isEmpty());
+
+    // All emissions collapse into a single call with the latest value
+    QTRY_COMPARE(received.count(), 1);
+    QCOMPARE(received[0], 99);
+
+    emit _valueSignal(100);
+    QTRY_COMPARE(received.count(), 2);
+    QCOMPARE(received[1], 100);
+
+    disconnect(connection);
+}
+
+void QGCSignalCoalescerTest::_contextDestroyedTest(void)
+{
+    static const int key = QGCSignalCoalescer::newKey();
+
+    bool called = false;
+    QObject* context = new QObject();
+    QGCSignalCoalescer::instance()->post(context, key, [&called]() { called = true; });
+    delete context;
+
+    QGCSignalCoalescer::instance()->drain();
+    QVERIFY(!called);
+}
+
+void QGCSignalCoalescerTest::_crossThreadTest(void)
+{
+    static const int key = QGCSignalCoalescer::newKey();
+
+    int lastValue = -1;
+    int callCount = 0;
+    QThread* thread = QThread::create([this, &lastValue, &callCount]() {
+        for (int i = 0; i < 1000; i++) {
+            QGCSignalCoalescer::instance()->post(this, key, [i, &lastValue, &callCount]() {
+                lastValue = i;
+                callCount++;
+            });
+        }
+    });
+    thread->start();
+    QVERIFY(thread->wait(5000));
+    delete thread;
+
+    // The gui thread was blocked in wait, so every post landed in the same slot and only the last one runs
+    QTRY_COMPARE(lastValue, 999);
+    QCOMPARE(callCount, 1);
+}
+
+void QGCSignalCoalescerTest::_framePacedTest(void)
+{
+    static const int key = QGCSignalCoalescer::newKey();
+
+    QGCSignalCoalescer* coalescer = QGCSignalCoalescer::instance();
+    int frameRequests = 0;
+    int callCount = 0;
+    coalescer->setFrameRequester([&frameRequests]() { frameRequests++; });
+    QVERIFY(coalescer->framePaced());
+
+    for (int i = 0; i < 10; i++) {
+        coalescer->post(this, key, [&callCount]() { callCount++; });
+    }
+    QCOMPARE(frameRequests, 1);
+
+    // Nothing runs from the event loop while waiting on the frame
+    QCoreApplication::processEvents();
+    QCOMPARE(callCount, 0);
+
+    // Frame is being prepared
+    coalescer->drain();
+    QCOMPARE(callCount, 1);
+
+    // If the frame never comes the fallback timer drains anyway
+    coalescer->post(this, key, [&callCount]() { callCount++; });
+    QCOMPARE(frameRequests, 2);
+    QTRY_COMPARE(callCount, 2);
+
+    coalescer->setFrameRequester(nullptr);
+    QVERIFY(!coalescer->framePaced());
+}
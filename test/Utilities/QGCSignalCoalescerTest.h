@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCSignalCoalescerTest : public UnitTest
+{
+    Q_OBJECT
+
+signals:
+    void _valueSignal(int value);
+
+private slots:
+    void _latestValueTest(void);
+    void _contextDestroyedTest(void);
+    void _crossThreadTest(void);
+    void _framePacedTest(void);
+};
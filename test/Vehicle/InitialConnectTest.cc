@@ -13,6 +13,7 @@
 #include "LinkManager.h"
 #include "MockLink.h"
 #include "Vehicle.h"
+#include "InitialConnectStateMachine.h"
 
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
@@ -63,3 +64,30 @@ void InitialConnectTest::_boardVendorProductId(void)
 
     _linkManager->disconnectAll();
 }
+
+void InitialConnectTest::_stageDependencies(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QVERIFY(_vehicle->isInitialConnectComplete());
+
+    InitialConnectStateMachine* connectMachine = _vehicle->initialConnectStateMachine();
+    for (int i = 0; i < InitialConnectStateMachine::StageCount; i++) {
+        const InitialConnectStateMachine::Stage_t stage = static_cast<InitialConnectStateMachine::Stage_t>(i);
+
+        // Every stage ran and completed
+        QVERIFY(connectMachine->stageStartMSecs(stage) >= 0);
+        QVERIFY(connectMachine->stageEndMSecs(stage) >= connectMachine->stageStartMSecs(stage));
+
+        // No stage started before all of its dependencies completed
+        for (int j = 0; j < InitialConnectStateMachine::StageCount; j++) {
+            if (InitialConnectStateMachine::stageDependencies(stage) & (1u << j)) {
+                QVERIFY(connectMachine->stageStartMSecs(stage) >= connectMachine->stageEndMSecs(static_cast<InitialConnectStateMachine::Stage_t>(j)));
+            }
+        }
+    }
+
+    // Plan download runs alongside component information instead of waiting for it and the parameters
+    QVERIFY(connectMachine->stageStartMSecs(InitialConnectStateMachine::StageMission) <= connectMachine->stageEndMSecs(InitialConnectStateMachine::StageCompInfo));
+
+    _disconnectMockLink();
+}
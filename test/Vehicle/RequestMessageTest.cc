@@ -51,16 +51,31 @@ void RequestMessageTest::_testCaseWorker(TestCase_t& testCase)
 
     vehicle->requestMessage(_requestMessageResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
     QVERIFY(QTest::qWaitFor([&]() { return testCase.resultHandlerCalled; }, 10000));
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
     QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), testCase.expectedSendCount);
 
-    // We should be able to do it twice in a row without any duplicate command problems
+    // We should be able to do it twice in a row without any duplicate command problems. A plain request always goes
+    // to the vehicle, even right after the same message was received.
+    const int roundTripsSaved = vehicle->requestMessageRoundTripsSaved();
     testCase.resultHandlerCalled = false;
     _mockLink->clearReceivedMavCommandCounts();
     vehicle->requestMessage(_requestMessageResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
+    QCOMPARE(testCase.resultHandlerCalled, false);
     QVERIFY(QTest::qWaitFor([&]() { return testCase.resultHandlerCalled; }, 10000));
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
     QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), testCase.expectedSendCount);
+    QCOMPARE(vehicle->requestMessageRoundTripsSaved(), roundTripsSaved);
+
+    // A cached request is answered immediately after a success
+    const bool expectCached = testCase.expectedFailureCode == Vehicle::RequestMessageNoFailure;
+    testCase.resultHandlerCalled = false;
+    _mockLink->clearReceivedMavCommandCounts();
+    vehicle->requestMessageCached(_requestMessageResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
+    QCOMPARE(testCase.resultHandlerCalled, expectCached);
+    QVERIFY(QTest::qWaitFor([&]() { return testCase.resultHandlerCalled; }, 10000));
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
+    QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), expectCached ? 0 : testCase.expectedSendCount);
+    QCOMPARE(vehicle->requestMessageRoundTripsSaved(), roundTripsSaved + (expectCached ? 1 : 0));
 
     _disconnectMockLink();
 }
@@ -79,12 +94,16 @@ void RequestMessageTest::_duplicateCommand(void)
     _connectMockLinkNoInitialConnectSequence();
 
     RequestMessageTest::TestCase_t testCase = {
-        MockLink::FailRequestMessageCommandNoResponse, MAV_RESULT_FAILED, Vehicle::RequestMessageFailureDuplicateCommand, 1, false
+        MockLink::FailRequestMessageCommandNoResponse, MAV_RESULT_FAILED, Vehicle::RequestMessageFailureCommandNotAcked, 1, false
     };
+    RequestMessageTest::TestCase_t duplicateTestCase = testCase;
 
     MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
     Vehicle*                vehicle     = vehicleMgr->activeVehicle();
 
+    vehicle->deleteGimbalController();
+    vehicle->deleteCameraManager();
+
     _mockLink->clearReceivedMavCommandCounts();
     _mockLink->setRequestMessageFailureMode(testCase.failureMode);
 
@@ -93,22 +112,58 @@ void RequestMessageTest::_duplicateCommand(void)
     vehicle->requestMessage(_requestMessageResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
     QVERIFY(QTest::qWaitFor([&]() { return _mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE) == 1; }, 10));
     QCOMPARE(testCase.resultHandlerCalled, false);
-    vehicle->requestMessage(_requestMessageResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
 
-    // Duplicate command returns immediately
-    QCOMPARE(testCase.resultHandlerCalled, true);
-    QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), testCase.expectedSendCount);
-    QVERIFY(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE) != -1);
+    // Duplicate request is merged into the pending one instead of sending another command
+    const int roundTripsSaved = vehicle->requestMessageRoundTripsSaved();
+    vehicle->requestMessage(_requestMessageResultHandler, &duplicateTestCase, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
+    QCOMPARE(duplicateTestCase.resultHandlerCalled, false);
+    QCOMPARE(vehicle->requestMessageRoundTripsSaved(), roundTripsSaved + 1);
     QVERIFY(true == vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
 
     // MockLink does not ack messages?
-    // So wait for Vehicle to exhaust retries and then report that failure.
+    // So wait for Vehicle to exhaust retries and then report that failure to both requesters.
     // We should then observe that the command is no longer pending and may send again.
-    testCase.resultHandlerCalled = false;
-    testCase.expectedFailureCode = Vehicle::RequestMessageFailureCommandNotAcked;
     auto timeout = Vehicle::_mavCommandMaxRetryCount * (Vehicle::_mavCommandResponseCheckTimeoutMSecs + Vehicle::_mavCommandAckTimeoutMSecs);
-    QVERIFY(QTest::qWaitFor([&]() { return testCase.resultHandlerCalled; }, timeout));
+    QVERIFY(QTest::qWaitFor([&]() { return testCase.resultHandlerCalled && duplicateTestCase.resultHandlerCalled; }, timeout));
     QVERIFY(false == vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
+    QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), Vehicle::_mavCommandMaxRetryCount);
+}
+
+void RequestMessageTest::_queuedRequestMessageResultHandler(void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message)
+{
+    QList<int>* receivedMsgIds = static_cast<QList<int>*>(resultHandlerData);
+
+    QCOMPARE((int)commandResult, (int)MAV_RESULT_ACCEPTED);
+    QCOMPARE((int)failureCode, (int)Vehicle::RequestMessageNoFailure);
+    receivedMsgIds->append(message.msgid);
+}
+
+void RequestMessageTest::_queuedRequests(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
+    Vehicle*                vehicle     = vehicleMgr->activeVehicle();
+
+    vehicle->deleteGimbalController();
+    vehicle->deleteCameraManager();
+
+    _mockLink->clearReceivedMavCommandCounts();
+    _mockLink->setRequestMessageFailureMode(MockLink::FailRequestMessageNone);
+
+    // Requests for different messages from the same component used to fail as duplicate commands, now they queue up
+    QList<int> receivedMsgIds;
+    vehicle->requestMessage(_queuedRequestMessageResultHandler, &receivedMsgIds, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
+    vehicle->requestMessage(_queuedRequestMessageResultHandler, &receivedMsgIds, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_PROTOCOL_VERSION);
+    vehicle->requestMessage(_queuedRequestMessageResultHandler, &receivedMsgIds, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_DEBUG);
+
+    QVERIFY(QTest::qWaitFor([&]() { return receivedMsgIds.count() == 3; }, 10000));
+    QCOMPARE(receivedMsgIds.count(MAVLINK_MSG_ID_DEBUG),            2);
+    QCOMPARE(receivedMsgIds.count(MAVLINK_MSG_ID_PROTOCOL_VERSION), 1);
+    QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), 2);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_REQUEST_MESSAGE));
+
+    _disconnectMockLink();
 }
 
 void RequestMessageTest::_compIdAllRequestMessageResultHandler(void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& /*message*/)
@@ -136,7 +191,7 @@ void RequestMessageTest::_compIdAllFailure(void)
 
     vehicle->requestMessage(_requestMessageResultHandler, &testCase, MAV_COMP_ID_ALL, MAVLINK_MSG_ID_DEBUG);
     QCOMPARE(testCase.resultHandlerCalled, true);
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_ALL, MAV_CMD_REQUEST_MESSAGE), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_ALL, MAV_CMD_REQUEST_MESSAGE));
     QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_REQUEST_MESSAGE), 0);
 
     _disconnectMockLink();
@@ -24,6 +24,7 @@ private slots:
     void _performTestCases(void);
     void _compIdAllFailure(void);
     void _duplicateCommand(void);
+    void _queuedRequests(void);
 
 private:
     typedef struct {
@@ -37,6 +38,7 @@ private:
     void _testCaseWorker(TestCase_t& testCase);
 
     static void _requestMessageResultHandler            (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
+    static void _queuedRequestMessageResultHandler      (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
     static void _compIdAllRequestMessageResultHandler   (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
 
     bool _resultHandlerCalled;
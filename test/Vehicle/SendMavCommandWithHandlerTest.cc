@@ -53,7 +53,7 @@ void SendMavCommandWithHandlerTest::_mavCmdProgressHandler(void* progressHandler
     QCOMPARE(1,                                         ack.progress);
 
     // Command should still be in list
-    QVERIFY(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, testCase->command) != -1);
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, testCase->command));
 }
 
 void SendMavCommandWithHandlerTest::_testCaseWorker(TestCase_t& testCase)
@@ -81,7 +81,7 @@ void SendMavCommandWithHandlerTest::_testCaseWorker(TestCase_t& testCase)
     
     QVERIFY(QTest::qWaitFor([&]() { return _resultHandlerCalled; }, 10000));
     QCOMPARE(_mockLink->receivedMavCommandCount(testCase.command), testCase.expectedSendCount);
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, testCase.command), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, testCase.command));
 
     _disconnectMockLink();
 }
@@ -124,7 +124,7 @@ void SendMavCommandWithHandlerTest::_duplicateCommand(void)
 
     // Duplicate command response should happen immediately
     QVERIFY(_resultHandlerCalled);
-    QVERIFY(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, testCase.command) != -1);
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, testCase.command));
     QCOMPARE(_mockLink->receivedMavCommandCount(testCase.command), 1);
 }
 
@@ -157,7 +157,7 @@ void SendMavCommandWithHandlerTest::_compIdAllFailure(void)
     vehicle->sendMavCommandWithHandler(&handlerInfo, MAV_COMP_ID_ALL, testCase.command);
 
     QCOMPARE(_resultHandlerCalled,                                                      true);
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_ALL, testCase.command), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_ALL, testCase.command));
     QCOMPARE(_mockLink->receivedMavCommandCount(testCase.command),                      testCase.expectedSendCount);
 
     _disconnectMockLink();
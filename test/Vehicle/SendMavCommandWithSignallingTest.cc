@@ -11,6 +11,7 @@
 #include "MultiVehicleManager.h"
 #include "QGCApplication.h"
 #include "MockLink.h"
+#include "QGCMetrics.h"
 
 SendMavCommandWithSignallingTest::TestCase_t SendMavCommandWithSignallingTest::_rgTestCases[] = {
     {  MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED,           MAV_RESULT_ACCEPTED,    Vehicle::MavCmdResultCommandResultOnly,             1 },
@@ -56,7 +57,7 @@ void SendMavCommandWithSignallingTest::_testCaseWorker(TestCase_t& testCase)
     QCOMPARE(arguments.at(2).toInt(),                                       testCase.command);
     QCOMPARE(arguments.at(3).toInt(),                                       testCase.expectedCommandResult);
     QCOMPARE(arguments.at(4).value<Vehicle::MavCmdResultFailureCode_t>(),   testCase.expectedFailureCode);
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED), -1);
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED));
     QCOMPARE(_mockLink->receivedMavCommandCount(testCase.command),          testCase.expectedSendCount);
 
     _disconnectMockLink();
@@ -92,5 +93,89 @@ void SendMavCommandWithSignallingTest::_duplicateCommand(void)
     QCOMPARE(arguments.at(3).toInt(),                                                   (int)MAV_RESULT_FAILED);
     QCOMPARE(arguments.at(4).value<Vehicle::MavCmdResultFailureCode_t>(),               Vehicle::MavCmdResultFailureDuplicateCommand);
     QCOMPARE(_mockLink->receivedMavCommandCount(MockLink::MAV_CMD_MOCKLINK_NO_RESPONSE),    1);
-    QVERIFY(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_NO_RESPONSE) != -1);
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_NO_RESPONSE));
+}
+
+void SendMavCommandWithSignallingTest::_concurrentComponents(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
+    Vehicle*                vehicle     = vehicleMgr->activeVehicle();
+    QSignalSpy              spyResult(vehicle, &Vehicle::mavCommandResult);
+
+    _mockLink->clearReceivedMavCommandCounts();
+
+    // The latency metric is shared by every vehicle, so only the acks from here on are counted
+    QGCMetricHistogram* latencyMetric = vehicle->_mavCommandLatencyMetric(MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED);
+    const quint64 latencyCount = latencyMetric->snapshot().count;
+
+    // Leave a command outstanding against the autopilot, then send the same command to other components. None of them
+    // should have to wait for the outstanding one.
+    const QList<int> compIds = { MAV_COMP_ID_CAMERA, MAV_COMP_ID_GIMBAL, MAV_COMP_ID_CAMERA2 };
+    vehicle->sendMavCommand(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_NO_RESPONSE, false /* showError */);
+    for (int compId: compIds) {
+        vehicle->sendMavCommand(compId, MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED, false /* showError */);
+    }
+    for (int compId: compIds) {
+        QVERIFY(vehicle->isMavCommandPending(compId, MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED));
+    }
+
+    QList<int> ackedCompIds;
+    QVERIFY(QTest::qWaitFor([&]() {
+        while (spyResult.count()) {
+            QList<QVariant> arguments = spyResult.takeFirst();
+            if (arguments.at(2).toInt() == MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED && arguments.at(3).toInt() == MAV_RESULT_ACCEPTED) {
+                ackedCompIds.append(arguments.at(1).toInt());
+            }
+        }
+        return ackedCompIds.count() == compIds.count();
+    }, 1000));
+
+    for (int compId: compIds) {
+        QVERIFY(ackedCompIds.contains(compId));
+        QVERIFY(!vehicle->isMavCommandPending(compId, MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED));
+    }
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MockLink::MAV_CMD_MOCKLINK_NO_RESPONSE));
+    QCOMPARE(_mockLink->receivedMavCommandCount(MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED), compIds.count());
+
+    // Every ack shows up in the latency metric for the command
+    QCOMPARE(latencyMetric->snapshot().count, latencyCount + compIds.count());
+
+    _disconnectMockLink();
+}
+
+void SendMavCommandWithSignallingTest::_duplicatableCommandQueue(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
+    Vehicle*                vehicle     = vehicleMgr->activeVehicle();
+    QSignalSpy              spyResult(vehicle, &Vehicle::mavCommandResult);
+
+    _mockLink->clearReceivedMavCommandCounts();
+
+    // Commands which can be duplicated queue up behind each other and each ack completes the oldest one
+    const int commandCount = 3;
+    for (int i=0; i<commandCount; i++) {
+        vehicle->sendMavCommand(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_DO_MOTOR_TEST, false /* showError */, i + 1);
+    }
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_DO_MOTOR_TEST));
+
+    int resultCount = 0;
+    QVERIFY(QTest::qWaitFor([&]() {
+        while (spyResult.count()) {
+            QList<QVariant> arguments = spyResult.takeFirst();
+            // A result from the vehicle, not a local duplicate/no response failure
+            if (arguments.at(2).toInt() == MAV_CMD_DO_MOTOR_TEST && arguments.at(4).value<Vehicle::MavCmdResultFailureCode_t>() == Vehicle::MavCmdResultCommandResultOnly) {
+                resultCount++;
+            }
+        }
+        return resultCount == commandCount;
+    }, 1000));
+
+    QVERIFY(!vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, MAV_CMD_DO_MOTOR_TEST));
+    QCOMPARE(_mockLink->receivedMavCommandCount(MAV_CMD_DO_MOTOR_TEST), commandCount);
+
+    _disconnectMockLink();
 }
@@ -22,6 +22,8 @@ class SendMavCommandWithSignallingTest : public UnitTest
 private slots:
     void _performTestCases(void);
     void _duplicateCommand(void);
+    void _concurrentComponents(void);
+    void _duplicatableCommandQueue(void);
 
 private:
     typedef struct {
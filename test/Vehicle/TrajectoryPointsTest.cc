@@ -0,0 +1,70 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryPointsTest.h"
+#include "TrajectoryPoints.h"
+
+#include <QtTest/QTest>
+
+void TrajectoryPointsTest::_simplifyKeepsShapeTest(void)
+{
+    // Two straight legs with a right angle corner between them
+    const QGeoCoordinate start(47.3977, 8.5456);
+    const QGeoCoordinate corner = start.atDistanceAndAzimuth(2000, 90);
+
+    QList<QGeoCoordinate> points;
+    for (int i = 0; i < 200; i++) {
+        points.append(start.atDistanceAndAzimuth(i * 10, 90));
+    }
+    points.append(corner);
+    for (int i = 1; i <= 200; i++) {
+        points.append(corner.atDistanceAndAzimuth(i * 10, 0));
+    }
+    const QGeoCoordinate first = points.first();
+    const QGeoCoordinate end = points.last();
+
+    TrajectoryPoints::simplify(points, 10, 1);
+
+    QVERIFY(points.count() <= 10);
+    QCOMPARE(points.first(), first);
+    QCOMPARE(points.last(), end);
+    QVERIFY(points.contains(corner));
+}
+
+void TrajectoryPointsTest::_simplifyKeepsTailTest(void)
+{
+    const QGeoCoordinate center(47.3977, 8.5456);
+
+    QList<QGeoCoordinate> points;
+    for (int i = 0; i < 2000; i++) {
+        points.append(center.atDistanceAndAzimuth(500, i * 0.5));
+    }
+    const QList<QGeoCoordinate> tail = points.mid(points.count() - 100);
+
+    TrajectoryPoints::simplify(points, 500, 100);
+
+    QVERIFY(points.count() <= 500);
+    QCOMPARE(points.mid(points.count() - 100), tail);
+}
+
+void TrajectoryPointsTest::_dropOldestTest(void)
+{
+    const QGeoCoordinate center(47.3977, 8.5456);
+
+    QList<QGeoCoordinate> points;
+    for (int i = 0; i < 100; i++) {
+        points.append(center.atDistanceAndAzimuth(100, i * 3.6));
+    }
+    const QList<QGeoCoordinate> newest = points.mid(50);
+
+    // Everything is in the exact tail, so the only way to make room is to drop the oldest points
+    TrajectoryPoints::simplify(points, 50, 100);
+
+    QCOMPARE(points, newest);
+}